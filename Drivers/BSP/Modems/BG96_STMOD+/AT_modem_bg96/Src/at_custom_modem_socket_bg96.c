@@ -672,7 +672,15 @@ at_action_rsp_t fRspAnalyze_QIRD_data_BG96(at_context_t *p_at_ctxt, atcustom_mod
 
   PrintDBG("DATA received: size=%ld vs %d", p_modem_ctxt->socket_ctxt.socket_rx_expected_buf_size,
            element_infos->str_size)
-  if (p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv != NULL)
+  if (p_modem_ctxt->socket_ctxt.socketReceivedata.rcv_cb != NULL)
+  {
+    /* lend data to client, no more valid when the callback returns */
+    (* p_modem_ctxt->socket_ctxt.socketReceivedata.rcv_cb)((const CS_CHAR_t *)&p_msg_in->buffer[element_infos->str_start_idx],
+                                                           (uint32_t) element_infos->str_size,
+                                                           p_modem_ctxt->socket_ctxt.socketReceivedata.p_rcv_cb_ctx);
+    p_modem_ctxt->socket_ctxt.socketReceivedata.buffer_size = element_infos->str_size;
+  }
+  else if (p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv != NULL)
   {
     /* recopy data to client buffer */
     (void) memcpy((void *)p_modem_ctxt->socket_ctxt.socketReceivedata.p_buffer_addr_rcv,
@@ -253,12 +253,14 @@ void ATCustom_BG96_init(atparser_context_t *p_atp_ctxt)
   };
 #define size_ATCMD_BG96_LUT ((uint16_t) (sizeof (ATCMD_BG96_LUT) / sizeof (atcustom_LUT_t)))
 
+  /* set the LUT before common init which indexes it */
+  BG96_ctxt.modem_LUT_size = size_ATCMD_BG96_LUT;
+  BG96_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_BG96_LUT;
+
   /* common init */
   bg96_modem_init(&BG96_ctxt);
 
   /* ###########################  START CUSTOMIZATION PART  ########################### */
-  BG96_ctxt.modem_LUT_size = size_ATCMD_BG96_LUT;
-  BG96_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_BG96_LUT;
 
   /* override default termination string for AT command: <CR> */
   (void) sprintf((bg96_TYPE_CHAR_t *)p_atp_ctxt->endstr, "\r");
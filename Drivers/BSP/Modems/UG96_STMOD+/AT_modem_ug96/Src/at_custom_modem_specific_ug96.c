@@ -219,12 +219,14 @@ void ATCustom_UG96_init(atparser_context_t *p_atp_ctxt)
   };
 #define size_ATCMD_UG96_LUT ((uint16_t) (sizeof (ATCMD_UG96_LUT) / sizeof (atcustom_LUT_t)))
 
+  /* set the LUT before common init which indexes it */
+  UG96_ctxt.modem_LUT_size = size_ATCMD_UG96_LUT;
+  UG96_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_UG96_LUT;
+
   /* common init */
   ug96_modem_init(&UG96_ctxt);
 
   /* ###########################  START CUSTOMIZATION PART  ########################### */
-  UG96_ctxt.modem_LUT_size = size_ATCMD_UG96_LUT;
-  UG96_ctxt.p_modem_LUT = (const atcustom_LUT_t *)ATCMD_UG96_LUT;
 
   /* override default termination string for AT command: <CR> */
   (void) sprintf((ug96_TYPE_CHAR_t *)p_atp_ctxt->endstr, "\r");
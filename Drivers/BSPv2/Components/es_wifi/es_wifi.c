@@ -48,6 +48,8 @@
 
 #define CHARISNUM(x)                    ((x) >= '0' && (x) <= '9')
 #define CHAR2NUM(x)                     ((x) - '0')
+
+#define AT_PARAM_MASK(p)                (1UL << (uint32_t)(p))
 /* Private function prototypes -----------------------------------------------*/
 static  uint8_t Hex2Num(char a);
 static uint32_t ParseHexNumber(char* ptr, uint8_t* cnt);
@@ -63,6 +65,8 @@ static void AT_ParseConnSettings(char *pdata, ES_WIFI_Network_t *NetSettings);
 static void AT_ParseTransportSettings(char *pdata, ES_WIFI_Transport_t *TransportSettings);
 static void AT_ParseIsConnected(char *pdata, uint8_t *isConnected);
 static ES_WIFI_Status_t AT_ExecuteCommand(ES_WIFIObject_t *Obj, uint8_t* cmd, uint8_t *pdata);
+static void AT_InvalidateParams(ES_WIFIObject_t *Obj, uint32_t keep_mask);
+static ES_WIFI_Status_t AT_SetParam(ES_WIFIObject_t *Obj, ES_WIFI_CachedParam_t param, uint32_t value);
 
 uint32_t HAL_GetTick(void);
 /* Private functions ---------------------------------------------------------*/
@@ -714,16 +718,19 @@ static ES_WIFI_Status_t AT_ExecuteCommand(ES_WIFIObject_t *Obj, uint8_t* cmd, ui
       }
       else if(strstr((char *)pdata, AT_ERROR_STRING))
       {
+        AT_InvalidateParams(Obj, 0);
         UNLOCK_WIFI();
         return ES_WIFI_STATUS_UNEXPECTED_CLOSED_SOCKET;
       }
     }
     if (recv_len == ES_WIFI_ERROR_STUFFING_FOREVER )
     {
+      AT_InvalidateParams(Obj, 0);
       UNLOCK_WIFI();
       return ES_WIFI_STATUS_MODULE_CRASH;
     }
   }
+  AT_InvalidateParams(Obj, 0);
   UNLOCK_WIFI();
   return ES_WIFI_STATUS_IO_ERROR;
 }
@@ -767,15 +774,18 @@ static ES_WIFI_Status_t AT_RequestSendData(ES_WIFIObject_t *Obj, uint8_t* cmd, u
         }
         else if(strstr((char *)pdata, AT_ERROR_STRING))
         {
+          AT_InvalidateParams(Obj, 0);
           UNLOCK_WIFI();
           return ES_WIFI_STATUS_UNEXPECTED_CLOSED_SOCKET;
         }
         else
         {
+          AT_InvalidateParams(Obj, 0);
           UNLOCK_WIFI();
           return ES_WIFI_STATUS_ERROR;
         }
       }
+      AT_InvalidateParams(Obj, 0);
       UNLOCK_WIFI();
       if (recv_len == ES_WIFI_ERROR_STUFFING_FOREVER )
       {
@@ -785,9 +795,11 @@ static ES_WIFI_Status_t AT_RequestSendData(ES_WIFIObject_t *Obj, uint8_t* cmd, u
     }
     else
     {
+      AT_InvalidateParams(Obj, 0);
       return ES_WIFI_STATUS_ERROR;
     }
   }
+  AT_InvalidateParams(Obj, 0);
   return ES_WIFI_STATUS_IO_ERROR;
 }
 
@@ -812,6 +824,7 @@ static ES_WIFI_Status_t AT_RequestReceiveData(ES_WIFIObject_t *Obj, uint8_t* cmd
     len = Obj->fops.IO_Receive(p, 0 , Obj->Timeout);
     if ((p[0]!='\r') || (p[1]!='\n'))
     {
+     AT_InvalidateParams(Obj, 0);
      return  ES_WIFI_STATUS_IO_ERROR;
     }
     len-=2;
@@ -834,24 +847,75 @@ static ES_WIFI_Status_t AT_RequestReceiveData(ES_WIFIObject_t *Obj, uint8_t* cmd
      else if(memcmp((char *)p + len - AT_DELIMETER_LEN , AT_DELIMETER_STRING, AT_DELIMETER_LEN) == 0)
      {
        *ReadData = 0;
+       AT_InvalidateParams(Obj, 0);
        UNLOCK_WIFI();
        return ES_WIFI_STATUS_UNEXPECTED_CLOSED_SOCKET;
      }
 
+     AT_InvalidateParams(Obj, 0);
      UNLOCK_WIFI();
      *ReadData = 0;
      return ES_WIFI_STATUS_UNEXPECTED_CLOSED_SOCKET;
    }
    if (len == ES_WIFI_ERROR_STUFFING_FOREVER )
    {
+     AT_InvalidateParams(Obj, 0);
      UNLOCK_WIFI();
      return ES_WIFI_STATUS_MODULE_CRASH;
    }
   }
+  AT_InvalidateParams(Obj, 0);
   UNLOCK_WIFI();
   return ES_WIFI_STATUS_IO_ERROR;
 }
 
+/**
+  * @brief  Forget the socket parameters tracked for the module.
+  * @param  Obj: pointer to module handle
+  * @param  keep_mask: mask of the parameters which are still known to be in effect
+  * @retval None.
+  */
+static void AT_InvalidateParams(ES_WIFIObject_t *Obj, uint32_t keep_mask)
+{
+  Obj->CmdCache.Valid &= keep_mask;
+}
+
+/**
+  * @brief  Set a socket parameter, skipping the command if already in effect.
+  * @param  Obj: pointer to module handle
+  * @param  param: parameter to set
+  * @param  value: parameter value
+  * @retval Operation Status.
+  */
+static ES_WIFI_Status_t AT_SetParam(ES_WIFIObject_t *Obj, ES_WIFI_CachedParam_t param, uint32_t value)
+{
+  static const char * const param_fmt[ES_WIFI_PARAM_NBR] = { "P0=%lu\r", "R1=%lu\r", "R2=%lu\r", "S2=%lu\r" };
+  ES_WIFI_Status_t ret;
+
+#if (ES_WIFI_USE_CMD_CACHE == 1)
+  if (((Obj->CmdCache.Valid & AT_PARAM_MASK(param)) != 0U) && (Obj->CmdCache.Value[param] == value))
+  {
+    Obj->CmdCache.ElidedCount++;
+    return ES_WIFI_STATUS_OK;
+  }
+#endif
+
+  if (param == ES_WIFI_PARAM_SOCKET)
+  {
+    /* the read and write settings may be held per socket by the module */
+    AT_InvalidateParams(Obj, 0);
+  }
+
+  sprintf((char*)Obj->CmdData, param_fmt[param], (unsigned long) value);
+  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  if (ret == ES_WIFI_STATUS_OK)
+  {
+    Obj->CmdCache.Value[param] = value;
+    Obj->CmdCache.Valid |= AT_PARAM_MASK(param);
+  }
+  return ret;
+}
+
 
 /**
   * @brief  Initialize WIFI module.
@@ -865,6 +929,7 @@ ES_WIFI_Status_t  ES_WIFI_Init(ES_WIFIObject_t *Obj)
   LOCK_WIFI();
 
   Obj->Timeout = ES_WIFI_TIMEOUT;
+  memset(&Obj->CmdCache, 0, sizeof(Obj->CmdCache));
 
   if (Obj->fops.IO_Init(ES_WIFI_INIT) == 0)
   {
@@ -951,6 +1016,16 @@ ES_WIFI_Status_t  ES_WIFI_GetRTOSRev(ES_WIFIObject_t *Obj, uint8_t *RTOSRev)
   return ES_WIFI_STATUS_OK;
 }
 
+/**
+  * @brief  Return the number of AT commands skipped because already in effect.
+  * @param  Obj: pointer to module handle
+  * @retval Number of elided commands.
+  */
+uint32_t ES_WIFI_GetElidedCmdCount(ES_WIFIObject_t *Obj)
+{
+  return Obj->CmdCache.ElidedCount;
+}
+
 
 /**
   * @brief  Initialize WIFI module.
@@ -1359,6 +1434,7 @@ ES_WIFI_Status_t ES_WIFI_ResetToFactoryDefault(ES_WIFIObject_t *Obj)
   LOCK_WIFI();
   sprintf((char*)Obj->CmdData,"Z0\r");
   ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  AT_InvalidateParams(Obj, 0);
   UNLOCK_WIFI();
   return ret;
 }
@@ -1375,6 +1451,7 @@ ES_WIFI_Status_t ES_WIFI_ResetModule(ES_WIFIObject_t *Obj)
 
   sprintf((char*)Obj->CmdData,"ZR\r");
   ret = Obj->fops.IO_Send(Obj->CmdData, strlen((char*)Obj->CmdData), Obj->Timeout);
+  AT_InvalidateParams(Obj, 0);
 #if (ES_WIFI_USE_UART == 0)
  if (ret==3)
   {
@@ -1397,6 +1474,7 @@ ES_WIFI_Status_t ES_WIFI_HardResetModule(ES_WIFIObject_t *Obj)
   int ret;
   LOCK_WIFI();
   ret = Obj->fops.IO_Init(ES_WIFI_RESET);
+  AT_InvalidateParams(Obj, 0);
   UNLOCK_WIFI();
   return (ret > 0) ? ES_WIFI_STATUS_OK : ES_WIFI_STATUS_ERROR;
 }
@@ -1590,8 +1668,7 @@ ES_WIFI_Status_t ES_WIFI_StartClientConnection(ES_WIFIObject_t *Obj, ES_WIFI_Con
 
   LOCK_WIFI();
 
-  sprintf((char*)Obj->CmdData,"P0=%d\r", conn->Number);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, conn->Number);
 
   if (ret == ES_WIFI_STATUS_OK)
   {
@@ -1630,6 +1707,8 @@ ES_WIFI_Status_t ES_WIFI_StartClientConnection(ES_WIFIObject_t *Obj, ES_WIFI_Con
     ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
   }
 
+  /* a new connection starts with the module default read/write settings */
+  AT_InvalidateParams(Obj, AT_PARAM_MASK(ES_WIFI_PARAM_SOCKET));
   UNLOCK_WIFI();
   return ret;
 }
@@ -1645,14 +1724,14 @@ ES_WIFI_Status_t ES_WIFI_StopClientConnection(ES_WIFIObject_t *Obj, ES_WIFI_Conn
   ES_WIFI_Status_t ret;
   LOCK_WIFI();
 
-  sprintf((char*)Obj->CmdData,"P0=%d\r", conn->Number);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, conn->Number);
 
   if (ret == ES_WIFI_STATUS_OK)
   {
     sprintf((char*)Obj->CmdData,"P6=0\r");
     ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
   }
+  AT_InvalidateParams(Obj, AT_PARAM_MASK(ES_WIFI_PARAM_SOCKET));
   UNLOCK_WIFI();
   return ret;
 }
@@ -1670,8 +1749,7 @@ ES_WIFI_Status_t ES_WIFI_StartAWSClientConnection(ES_WIFIObject_t *Obj, ES_WIFI_
   ES_WIFI_Status_t ret;
   LOCK_WIFI();
 
-  sprintf((char*)Obj->CmdData,"P0=%d\r", conn->Number);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, conn->Number);
 
   if(ret == ES_WIFI_STATUS_OK)
   {
@@ -1718,6 +1796,7 @@ ES_WIFI_Status_t ES_WIFI_StartAWSClientConnection(ES_WIFIObject_t *Obj, ES_WIFI_
       }
     }
   }
+  AT_InvalidateParams(Obj, AT_PARAM_MASK(ES_WIFI_PARAM_SOCKET));
   UNLOCK_WIFI();
   return ret;
 }
@@ -1733,8 +1812,7 @@ ES_WIFI_Status_t ES_WIFI_StartServerSingleConn(ES_WIFIObject_t *Obj, ES_WIFI_Con
   ES_WIFI_Status_t ret = ES_WIFI_STATUS_OK;
   LOCK_WIFI();
 
-  sprintf((char*)Obj->CmdData,"P0=%d\r", conn->Number);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, conn->Number);
   if(ret != ES_WIFI_STATUS_OK)
   {
     UNLOCK_WIFI();
@@ -1784,6 +1862,7 @@ ES_WIFI_Status_t ES_WIFI_StartServerSingleConn(ES_WIFIObject_t *Obj, ES_WIFI_Con
         }
       }
 	}
+  AT_InvalidateParams(Obj, AT_PARAM_MASK(ES_WIFI_PARAM_SOCKET));
   UNLOCK_WIFI();
   return ret;
 }
@@ -1888,8 +1967,7 @@ ES_WIFI_Status_t ES_WIFI_CloseServerConnection(ES_WIFIObject_t *Obj, int socket)
 {
   ES_WIFI_Status_t ret;
   LOCK_WIFI();
-  sprintf((char*)Obj->CmdData,"P0=%d\r", socket);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, socket);
   if(ret != ES_WIFI_STATUS_OK)
   {
     DEBUG(" Can not select socket %s\n", Obj->CmdData);
@@ -1903,6 +1981,7 @@ ES_WIFI_Status_t ES_WIFI_CloseServerConnection(ES_WIFIObject_t *Obj, int socket)
   {
     DEBUG(" Open next failed %s\n", Obj->CmdData);
   }
+  AT_InvalidateParams(Obj, AT_PARAM_MASK(ES_WIFI_PARAM_SOCKET));
 
   UNLOCK_WIFI();
   return ret;
@@ -1919,8 +1998,7 @@ ES_WIFI_Status_t ES_WIFI_StopServerSingleConn(ES_WIFIObject_t *Obj, int socket)
 {
   ES_WIFI_Status_t ret;
   LOCK_WIFI();
-  sprintf((char*)Obj->CmdData,"P0=%d\r", socket);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, socket);
   if(ret != ES_WIFI_STATUS_OK)
   {
     DEBUG("Selecting socket failed: %s\n", Obj->CmdData);
@@ -1930,6 +2008,7 @@ ES_WIFI_Status_t ES_WIFI_StopServerSingleConn(ES_WIFIObject_t *Obj, int socket)
 
   sprintf((char*)Obj->CmdData,"P5=0\r");
   ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  AT_InvalidateParams(Obj, AT_PARAM_MASK(ES_WIFI_PARAM_SOCKET));
   if(ret != ES_WIFI_STATUS_OK)
   {
     DEBUG("Stopping server failed %s\n", Obj->CmdData);
@@ -1957,8 +2036,7 @@ ES_WIFI_Status_t ES_WIFI_StartServerMultiConn(ES_WIFIObject_t *Obj, ES_WIFI_Conn
   ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
   if(ret == ES_WIFI_STATUS_OK)
   {
-    sprintf((char*)Obj->CmdData,"P0=%d\r", conn->Number);
-    ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+    ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, conn->Number);
     if(ret == ES_WIFI_STATUS_OK)
     {
       sprintf((char*)Obj->CmdData,"P1=%d\r", conn->Type);
@@ -2000,6 +2078,8 @@ ES_WIFI_Status_t ES_WIFI_StartServerMultiConn(ES_WIFIObject_t *Obj, ES_WIFI_Conn
       }
     }
   }
+  /* the module now switches the active socket on its own */
+  AT_InvalidateParams(Obj, 0);
   UNLOCK_WIFI();
   return ret;
 }
@@ -2058,6 +2138,7 @@ ES_WIFI_Status_t ES_WIFI_StopServerMultiConn(ES_WIFIObject_t *Obj)
 #endif
     }
   }
+  AT_InvalidateParams(Obj, 0);
   UNLOCK_WIFI();
   return ret;
 }
@@ -2088,12 +2169,10 @@ ES_WIFI_Status_t ES_WIFI_SendData(ES_WIFIObject_t *Obj, uint8_t Socket, uint8_t
   if(Reqlen >= ES_WIFI_PAYLOAD_SIZE ) Reqlen= ES_WIFI_PAYLOAD_SIZE;
 
   *SentLen = Reqlen;
-  sprintf((char*)Obj->CmdData,"P0=%d\r", Socket);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, Socket);
   if(ret == ES_WIFI_STATUS_OK)
   {
-    sprintf((char*)Obj->CmdData,"S2=%lu\r",wkgTimeOut);
-    ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+    ret = AT_SetParam(Obj, ES_WIFI_PARAM_WRITE_TIMEOUT, wkgTimeOut);
 
     if(ret == ES_WIFI_STATUS_OK)
     {
@@ -2148,8 +2227,7 @@ ES_WIFI_Status_t  ES_WIFI_SendDataTo(ES_WIFIObject_t *Obj, uint8_t Socket, uint8
 
   LOCK_WIFI();
 
-  sprintf((char*)Obj->CmdData,"P0=%d\r", Socket);
-  ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+  ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, Socket);
 
   if (ret == ES_WIFI_STATUS_OK)
   {
@@ -2180,8 +2258,7 @@ ES_WIFI_Status_t  ES_WIFI_SendDataTo(ES_WIFIObject_t *Obj, uint8_t Socket, uint8
 
   if(ret == ES_WIFI_STATUS_OK)
   {
-    sprintf((char*)Obj->CmdData, "S2=%lu\r", wkgTimeOut);
-    ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+    ret = AT_SetParam(Obj, ES_WIFI_PARAM_WRITE_TIMEOUT, wkgTimeOut);
   }
 
   if(ret == ES_WIFI_STATUS_OK)
@@ -2248,17 +2325,14 @@ ES_WIFI_Status_t ES_WIFI_ReceiveData(ES_WIFIObject_t *Obj, uint8_t Socket, uint8
 
   if(Reqlen <= ES_WIFI_PAYLOAD_SIZE )
   {
-    sprintf((char*)Obj->CmdData,"P0=%d\r", Socket);
-    ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+    ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, Socket);
 
     if(ret == ES_WIFI_STATUS_OK)
     {
-      sprintf((char*)Obj->CmdData,"R1=%d\r", Reqlen);
-      ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+      ret = AT_SetParam(Obj, ES_WIFI_PARAM_READ_LEN, Reqlen);
       if(ret == ES_WIFI_STATUS_OK)
       {
-        sprintf((char*)Obj->CmdData,"R2=%lu\r", wkgTimeOut);
-        ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+        ret = AT_SetParam(Obj, ES_WIFI_PARAM_READ_TIMEOUT, wkgTimeOut);
         if(ret == ES_WIFI_STATUS_OK)
         {
           sprintf((char*)Obj->CmdData,"R0\r");
@@ -2311,14 +2385,12 @@ ES_WIFI_Status_t  ES_WIFI_ReceiveDataFrom(ES_WIFIObject_t *Obj, uint8_t Socket,
 
   if (Reqlen <= ES_WIFI_PAYLOAD_SIZE )
   {
-    sprintf((char*)Obj->CmdData, "P0=%d\r", Socket);
-    ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+    ret = AT_SetParam(Obj, ES_WIFI_PARAM_SOCKET, Socket);
   }
 
   if(ret == ES_WIFI_STATUS_OK)
   {
-    sprintf((char*)Obj->CmdData,"R1=%d\r", Reqlen);
-    ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+    ret = AT_SetParam(Obj, ES_WIFI_PARAM_READ_LEN, Reqlen);
   }
   else
   {
@@ -2327,8 +2399,7 @@ ES_WIFI_Status_t  ES_WIFI_ReceiveDataFrom(ES_WIFIObject_t *Obj, uint8_t Socket,
 
   if(ret == ES_WIFI_STATUS_OK)
   {
-    sprintf((char*)Obj->CmdData,"R2=%lu\r", wkgTimeOut);
-    ret = AT_ExecuteCommand(Obj, Obj->CmdData, Obj->CmdData);
+    ret = AT_SetParam(Obj, ES_WIFI_PARAM_READ_TIMEOUT, wkgTimeOut);
   }
   else
   {
@@ -36,6 +36,12 @@
 #define ES_WIFI_PAYLOAD_SIZE     1200
 #define ES_WIFI_MAX_SO_TIMEOUT  30000
 
+/* Skip the socket selection and read/write parameter commands whose value is
+   already in effect on the module. */
+#ifndef ES_WIFI_USE_CMD_CACHE
+#define ES_WIFI_USE_CMD_CACHE    1
+#endif
+
 /* Exported macro-------------------------------------------------------------*/
 #define MIN(a, b)  ((a) < (b) ? (a) : (b))
 
@@ -225,6 +231,21 @@ typedef struct {
   uint8_t            Backlog;
 } ES_WIFI_Conn_t;
 
+/* Socket parameters tracked by the driver to elide redundant commands */
+typedef enum {
+  ES_WIFI_PARAM_SOCKET          = 0,  /*!< P0: selected socket */
+  ES_WIFI_PARAM_READ_LEN        = 1,  /*!< R1: read packet size */
+  ES_WIFI_PARAM_READ_TIMEOUT    = 2,  /*!< R2: read timeout */
+  ES_WIFI_PARAM_WRITE_TIMEOUT   = 3,  /*!< S2: write timeout */
+  ES_WIFI_PARAM_NBR             = 4
+} ES_WIFI_CachedParam_t;
+
+typedef struct {
+  uint32_t           Valid;                     /*!< Bit n set when Value[n] is known to be in effect */
+  uint32_t           Value[ES_WIFI_PARAM_NBR];  /*!< Last value acknowledged by the module */
+  uint32_t           ElidedCount;               /*!< Number of commands skipped */
+} ES_WIFI_CmdCache_t;
+
 typedef struct {
   IO_Init_Func       IO_Init;
   IO_DeInit_Func     IO_DeInit;
@@ -248,6 +269,7 @@ typedef struct {
   uint8_t            CmdData[ES_WIFI_DATA_SIZE];
   uint32_t           Timeout;
   uint32_t           BufferSize;
+  ES_WIFI_CmdCache_t CmdCache;
 } ES_WIFIObject_t;
 
 
@@ -268,6 +290,7 @@ ES_WIFI_Status_t  ES_WIFI_GetRTOSRev(ES_WIFIObject_t *Obj, uint8_t *RTOSRev);
 ES_WIFI_Status_t  ES_WIFI_GetProductName(ES_WIFIObject_t *Obj, uint8_t *productName);
 ES_WIFI_Status_t  ES_WIFI_GetAPIRev(ES_WIFIObject_t *Obj, uint8_t *APIRev);
 ES_WIFI_Status_t  ES_WIFI_GetStackRev(ES_WIFIObject_t *Obj, uint8_t *StackRev);
+uint32_t          ES_WIFI_GetElidedCmdCount(ES_WIFIObject_t *Obj);
 
 
 ES_WIFI_Status_t  ES_WIFI_SetMACAddress(ES_WIFIObject_t *Obj, uint8_t *mac);
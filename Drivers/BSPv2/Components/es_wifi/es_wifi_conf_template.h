@@ -68,6 +68,7 @@ extern osMutexId es_wifi_mutex;
 #define ES_WIFI_USE_AWS                             0
 #define ES_WIFI_USE_FIRMWAREUPDATE                  0
 #define ES_WIFI_USE_WPS                             0
+#define ES_WIFI_USE_CMD_CACHE                       1
 
 #define ES_WIFI_USE_SPI                             0
 #define ES_WIFI_USE_UART                            (!ES_WIFI_USE_SPI)
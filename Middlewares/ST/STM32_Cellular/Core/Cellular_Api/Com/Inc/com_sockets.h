@@ -33,7 +33,20 @@ extern "C" {
 #include "com_sockets_err_compat.h"
 
 /* Exported constants --------------------------------------------------------*/
+/* Events used with com_poll */
+#define COM_POLLIN          0x01  /* Data can be received without waiting */
+#define COM_POLLOUT         0x04  /* Data can be sent without waiting     */
+#define COM_POLLERR         0x08  /* Error, always reported               */
+#define COM_POLLHUP         0x10  /* Closed by the remote, always reported */
+
 /* Exported types ------------------------------------------------------------*/
+/* Called each time the readiness of a socket may have changed */
+typedef void (* com_ready_callback_t)(void);
+
+/* Called by com_recv_zc with the received data
+   buf is only valid until the callback returns */
+typedef void (* com_recv_callback_t)(const com_char_t *buf, uint32_t len, void *ctx);
+
 /* External variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
@@ -142,6 +155,44 @@ int32_t com_recv(int32_t sock,
                  com_char_t *buf, int32_t len,
                  int32_t flags);
 
+/**
+  * @brief  Socket receive data without copy
+  * @note   Same as com_recv but the received data are lent to callback
+  *         instead of being copied to an application buffer
+  *         callback is called at most once, from the cellular service context,
+  *         it must not block nor call com_sockets and must copy or consume
+  *         the data before returning
+  *         Only supported with USE_SOCKETS_MODEM
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  len       - maximum number of bytes to receive
+  * @param  flags     - options
+  * @param  callback  - function to which the data are lent
+  * @param  ctx       - context passed to callback
+  * @retval int32_t   - number of bytes received or error value
+  */
+int32_t com_recv_zc(int32_t sock, int32_t len, int32_t flags,
+                    com_recv_callback_t callback, void *ctx);
+
+/**
+  * @brief  Socket readiness
+  * @note   Report, without waiting, which of the requested events are ready
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  events    - COM_POLLIN and/or COM_POLLOUT
+  * @retval int32_t   - ready events or error value
+  */
+int32_t com_poll(int32_t sock, int32_t events);
+
+/**
+  * @brief  Socket readiness callback
+  * @note   Register the function called when a socket may have become ready
+  *         (data ready or closing URC), NULL to unregister
+  * @param  callback  - function to call, from the cellular service context
+  * @retval None
+  */
+void com_set_ready_callback(com_ready_callback_t callback);
+
 
 /*** Client - Server functionalities ******************************************/
 
@@ -29,6 +29,7 @@ extern "C" {
 #include <stdint.h>
 
 #include "com_sockets_addr_compat.h"
+#include "com_sockets.h"
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
@@ -184,6 +185,40 @@ int32_t com_recv_ip_modem(int32_t sock,
                           com_char_t *buf, int32_t len,
                           int32_t flags);
 
+/**
+  * @brief  Socket receive data without copy
+  * @note   Same as com_recv_ip_modem but the data are lent to callback
+  *         directly in the AT response buffer, valid only during the call
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  len       - maximum number of bytes to receive
+  * @param  flags     - options, see com_recv_ip_modem
+  * @param  callback  - function to which data are lent
+  * @param  ctx       - context passed to callback
+  * @retval int32_t   - number of bytes received or error value
+  */
+int32_t com_recv_zc_ip_modem(int32_t sock, int32_t len, int32_t flags,
+                             com_recv_callback_t callback, void *ctx);
+
+/**
+  * @brief  Socket readiness
+  * @note   Report, without waiting, which of the requested events are ready
+  *         COM_POLLIN is based on the data ready URC not yet consumed by a receive
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  events    - COM_POLLIN and/or COM_POLLOUT
+  * @retval int32_t   - ready events or error value
+  */
+int32_t com_poll_ip_modem(int32_t sock, int32_t events);
+
+/**
+  * @brief  Socket readiness callback
+  * @note   Register the function called on data ready and closing URC
+  * @param  callback  - function to call, NULL to unregister
+  * @retval None
+  */
+void com_set_ready_callback_ip_modem(com_ready_callback_t callback);
+
 
 /*** Client - Server functionalities ******************************************/
 
@@ -29,6 +29,7 @@ extern "C" {
 #include <stdint.h>
 
 #include "com_sockets_addr_compat.h"
+#include "com_sockets.h"
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
@@ -149,6 +150,30 @@ int32_t com_recv_lwip_mcu(int32_t sock,
                           com_char_t *buf, int32_t len,
                           int32_t flags);
 
+/**
+  * @brief  Socket receive data without copy
+  * @note   Not supported, LwIP socket API only copies data to application
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  len       - maximum number of bytes to receive
+  * @param  flags     - options
+  * @param  callback  - function to which data are lent
+  * @param  ctx       - context passed to callback
+  * @retval int32_t   - COM_SOCKETS_ERR_UNSUPPORTED
+  */
+int32_t com_recv_zc_lwip_mcu(int32_t sock, int32_t len, int32_t flags,
+                             com_recv_callback_t callback, void *ctx);
+
+/**
+  * @brief  Socket readiness
+  * @note   Report, without waiting, which of the requested events are ready
+  *         Restrictions, if any, are linked to LwIP module used
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  events    - COM_POLLIN and/or COM_POLLOUT
+  * @retval int32_t   - ready events or error value
+  */
+int32_t com_poll_lwip_mcu(int32_t sock, int32_t events);
+
 /**
   * @brief  Socket send to data
   * @note   Send data to a remote host
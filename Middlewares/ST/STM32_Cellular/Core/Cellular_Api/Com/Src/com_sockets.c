@@ -295,6 +295,60 @@ int32_t com_recv(int32_t sock,
 #endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
 }
 
+/**
+  * @brief  Socket receive data without copy
+  * @note   Same as com_recv but the received data are lent to callback
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  len       - maximum number of bytes to receive
+  * @param  flags     - options
+  * @param  callback  - function to which the data are lent
+  * @param  ctx       - context passed to callback
+  * @retval int32_t   - number of bytes received or error value
+  */
+int32_t com_recv_zc(int32_t sock, int32_t len, int32_t flags,
+                    com_recv_callback_t callback, void *ctx)
+{
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+  return com_recv_zc_ip_modem(sock, len, flags, callback, ctx);
+#else
+  return com_recv_zc_lwip_mcu(sock, len, flags, callback, ctx);
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+}
+
+/**
+  * @brief  Socket readiness
+  * @note   Report, without waiting, which of the requested events are ready
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  events    - COM_POLLIN and/or COM_POLLOUT
+  * @retval int32_t   - ready events or error value
+  */
+int32_t com_poll(int32_t sock, int32_t events)
+{
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+  return com_poll_ip_modem(sock, events);
+#else
+  return com_poll_lwip_mcu(sock, events);
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+}
+
+/**
+  * @brief  Socket readiness callback
+  * @note   Register the function called when a socket may have become ready
+  * @param  callback  - function to call, NULL to unregister
+  * @retval None
+  */
+void com_set_ready_callback(com_ready_callback_t callback)
+{
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+  com_set_ready_callback_ip_modem(callback);
+#else
+  /* No hook in the LwIP stack: the caller has to poll periodically */
+  UNUSED(callback);
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+}
+
 
 /*** Client - Server functionalities ******************************************/
 
@@ -19,6 +19,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "com_sockets_ip_modem.h"
+#include "com_sockets.h"
 #include "plf_config.h"
 
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
@@ -113,6 +114,7 @@ typedef struct _socket_desc_t
   com_bool_t            local;       /*   internal id - e.g for ping
                                        or external id - e.g modem    */
   com_bool_t            closing;     /* close recv from remote  */
+  com_bool_t            data_ready;  /* data ready URC not yet consumed by a receive */
   uint8_t               type;        /* Socket Type TCP/UDP/RAW */
   int32_t               error;       /* last command status     */
   int32_t               id;          /* identifier */
@@ -191,6 +193,9 @@ static com_bool_t network_is_up;
 /* local port allocated */
 static uint16_t local_port;
 
+/* Socket readiness callback */
+static com_ready_callback_t com_ip_modem_ready_cb;
+
 /* Global variables ----------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
@@ -198,6 +203,14 @@ static uint16_t local_port;
 
 static void com_ip_modem_data_ready_cb(socket_handle_t sock);
 static void com_ip_modem_closing_cb(socket_handle_t sock);
+static void com_ip_modem_notify_ready(void);
+static int32_t com_ip_modem_receive_data(const socket_desc_t *socket_desc,
+                                         com_char_t *buf, uint32_t len,
+                                         com_recv_callback_t callback, void *ctx);
+static int32_t com_ip_modem_recv(int32_t sock,
+                                 com_char_t *buf, int32_t len,
+                                 int32_t flags,
+                                 com_recv_callback_t callback, void *ctx);
 
 #if (USE_DATACACHE == 1)
 static void com_socket_datacache_cb(dc_com_event_id_t dc_event_id,
@@ -241,6 +254,7 @@ static void com_ip_modem_init_socket_desc(socket_desc_t *socket_desc)
   socket_desc->state            = COM_SOCKET_INVALID;
   socket_desc->local            = COM_SOCKETS_FALSE;
   socket_desc->closing          = COM_SOCKETS_FALSE;
+  socket_desc->data_ready       = COM_SOCKETS_FALSE;
   socket_desc->id               = COM_SOCKET_INVALID_ID;
   socket_desc->local_port       = 0U;
   socket_desc->remote_port      = 0U;
@@ -701,6 +715,9 @@ static void com_ip_modem_data_ready_cb(socket_handle_t sock)
   {
     if (socket_desc->closing != COM_SOCKETS_TRUE)
     {
+      /* Kept whatever the state so that a poll reports it */
+      socket_desc->data_ready = COM_SOCKETS_TRUE;
+      com_ip_modem_notify_ready();
       if (socket_desc->state == COM_SOCKET_WAITING_RSP)
       {
         PrintINFO("cb socket %ld data ready called: waiting rsp", socket_desc->id)
@@ -768,6 +785,7 @@ static void com_ip_modem_closing_cb(socket_handle_t sock)
       PrintDBG("cb socket %ld MSGput %lu queue %p", socket_desc->id, msg, socket_desc->queue)
       (void)osMessagePut(socket_desc->queue, msg, 0U);
     }
+    com_ip_modem_notify_ready();
   }
   else
   {
@@ -775,6 +793,50 @@ static void com_ip_modem_closing_cb(socket_handle_t sock)
   }
 }
 
+/**
+  * @brief  Notify the readiness callback
+  * @note   Called on data ready and socket closing URC
+  * @param  None
+  * @retval None
+  */
+static void com_ip_modem_notify_ready(void)
+{
+  com_ready_callback_t callback = com_ip_modem_ready_cb;
+
+  if (callback != NULL)
+  {
+    callback();
+  }
+}
+
+/**
+  * @brief  Read data available in the modem
+  * @note   Data are copied to buf or, if callback is not NULL, lent to callback
+  * @param  socket_desc - socket descriptor
+  * @param  buf         - application data buffer, not used if callback is not NULL
+  * @param  len         - maximum length to read
+  * @param  callback    - callback to lend data to, NULL to copy them to buf
+  * @param  ctx         - context passed to callback
+  * @retval int32_t     - number of bytes read or < 0 on error
+  */
+static int32_t com_ip_modem_receive_data(const socket_desc_t *socket_desc,
+                                         com_char_t *buf, uint32_t len,
+                                         com_recv_callback_t callback, void *ctx)
+{
+  int32_t result;
+
+  if (callback != NULL)
+  {
+    result = osCDS_socket_receive_zc(socket_desc->id, len, callback, ctx);
+  }
+  else
+  {
+    result = osCDS_socket_receive(socket_desc->id, buf, len);
+  }
+
+  return result;
+}
+
 #if (USE_DATACACHE == 1)
 /**
   * @brief  Callback called when a value in datacache changed
@@ -1667,6 +1729,54 @@ int32_t com_send_ip_modem(int32_t sock,
 int32_t com_recv_ip_modem(int32_t sock,
                           com_char_t *buf, int32_t len,
                           int32_t flags)
+{
+  return com_ip_modem_recv(sock, buf, len, flags, NULL, NULL);
+}
+
+/**
+  * @brief  Socket receive data without copy
+  * @note   Same as com_recv_ip_modem but the data are lent to callback
+  *         in the AT response buffer, see com_recv_zc
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  len       - maximum number of bytes to receive
+  * @param  flags     - options, see com_recv_ip_modem
+  * @param  callback  - function to which data are lent
+  * @param  ctx       - context passed to callback
+  * @retval int32_t   - number of bytes received or error value
+  */
+int32_t com_recv_zc_ip_modem(int32_t sock, int32_t len, int32_t flags,
+                             com_recv_callback_t callback, void *ctx)
+{
+  int32_t result;
+
+  if (callback == NULL)
+  {
+    result = COM_SOCKETS_ERR_PARAMETER;
+  }
+  else
+  {
+    result = com_ip_modem_recv(sock, NULL, len, flags, callback, ctx);
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Socket receive data
+  * @note   Common part of com_recv_ip_modem and com_recv_zc_ip_modem
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  buf       - application data buffer, not used if callback is not NULL
+  * @param  len       - maximum number of bytes to receive
+  * @param  flags     - options
+  * @param  callback  - function to which data are lent, NULL to copy them to buf
+  * @param  ctx       - context passed to callback
+  * @retval int32_t   - number of bytes received or error value
+  */
+static int32_t com_ip_modem_recv(int32_t sock,
+                                 com_char_t *buf, int32_t len,
+                                 int32_t flags,
+                                 com_recv_callback_t callback, void *ctx)
 {
   int32_t result;
   int32_t len_rcv;
@@ -1680,7 +1790,7 @@ int32_t com_recv_ip_modem(int32_t sock,
                                          COM_SOCKETS_FALSE);
 
   if ((socket_desc != NULL)
-      && (buf != NULL)
+      && ((buf != NULL) || (callback != NULL))
       && (len > 0))
   {
     /* Closing maybe received or Network maybe done
@@ -1690,6 +1800,7 @@ int32_t com_recv_ip_modem(int32_t sock,
       uint32_t length_to_read;
       length_to_read = COM_MIN((uint32_t)len, MODEM_MAX_RX_DATA_SIZE);
       socket_desc->state = COM_SOCKET_WAITING_RSP;
+      socket_desc->data_ready = COM_SOCKETS_FALSE;
 
       do
       {
@@ -1703,8 +1814,9 @@ int32_t com_recv_ip_modem(int32_t sock,
       if (flags == COM_MSG_DONTWAIT)
       {
         /* Application don't want to wait if there is no data available */
-        len_rcv = osCDS_socket_receive(socket_desc->id,
-                                       buf, length_to_read);
+        len_rcv = com_ip_modem_receive_data(socket_desc,
+                                            buf, length_to_read,
+                                            callback, ctx);
         result = (len_rcv < 0) ? COM_SOCKETS_ERR_GENERAL : COM_SOCKETS_ERR_OK;
         socket_desc->state = COM_SOCKET_CONNECTED;
         PrintINFO("rcv data DONTWAIT")
@@ -1714,8 +1826,9 @@ int32_t com_recv_ip_modem(int32_t sock,
         /* Maybe still some data available
            because application don't read all data with previous calls */
         PrintDBG("rcv data waiting")
-        len_rcv = osCDS_socket_receive(socket_desc->id,
-                                       buf, length_to_read);
+        len_rcv = com_ip_modem_receive_data(socket_desc,
+                                            buf, length_to_read,
+                                            callback, ctx);
         PrintDBG("rcv data waiting exit")
 
         if (len_rcv == 0)
@@ -1739,8 +1852,9 @@ int32_t com_recv_ip_modem(int32_t sock,
               {
                 case DATA_RCV :
                 {
-                  len_rcv = osCDS_socket_receive(socket_desc->id,
-                                                 buf, (uint32_t)length_to_read);
+                  len_rcv = com_ip_modem_receive_data(socket_desc,
+                                                      buf, length_to_read,
+                                                      callback, ctx);
                   result = (len_rcv < 0) ? \
                            COM_SOCKETS_ERR_GENERAL : COM_SOCKETS_ERR_OK;
                   socket_desc->state = COM_SOCKET_CONNECTED;
@@ -1793,6 +1907,12 @@ int32_t com_recv_ip_modem(int32_t sock,
           PrintDBG("rcv data exit cleanup MSGqueue")
         }
       } while (event.status == osEventMessage);
+
+      /* Buffer filled: more data may still be available in the modem */
+      if (len_rcv == (int32_t)length_to_read)
+      {
+        socket_desc->data_ready = COM_SOCKETS_TRUE;
+      }
     }
     else
     {
@@ -2125,6 +2245,7 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
           uint32_t length_to_read;
           length_to_read = COM_MIN((uint32_t)len, MODEM_MAX_RX_DATA_SIZE);
           socket_desc->state = COM_SOCKET_WAITING_FROM;
+          socket_desc->data_ready = COM_SOCKETS_FALSE;
 
           do
           {
@@ -2240,6 +2361,12 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
               PrintDBG("rcvfrom data exit cleanup MSGqueue")
             }
           } while (event.status == osEventMessage);
+
+          /* Buffer filled: more data may still be available in the modem */
+          if (len_rcv == (int32_t)length_to_read)
+          {
+            socket_desc->data_ready = COM_SOCKETS_TRUE;
+          }
         }
         else
         {
@@ -2275,6 +2402,67 @@ int32_t com_recvfrom_ip_modem(int32_t sock,
   return ((result == COM_SOCKETS_ERR_OK) ? len_rcv : result);
 }
 
+/**
+  * @brief  Socket readiness
+  * @note   Report, without waiting, which of the requested events are ready
+  *         COM_POLLIN is based on the data ready URC not yet consumed by a receive
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  events    - COM_POLLIN and/or COM_POLLOUT
+  * @retval int32_t   - ready events or error value
+  */
+int32_t com_poll_ip_modem(int32_t sock, int32_t events)
+{
+  int32_t result;
+  socket_desc_t *socket_desc;
+
+  socket_desc = com_ip_modem_find_socket(sock,
+                                         COM_SOCKETS_FALSE);
+
+  if (socket_desc == NULL)
+  {
+    result = COM_SOCKETS_ERR_DESCRIPTOR;
+  }
+  else
+  {
+    result = 0;
+    if ((socket_desc->closing == COM_SOCKETS_TRUE)
+        || (socket_desc->state == COM_SOCKET_CLOSING))
+    {
+      /* Remaining data can still be read, a receive reports the closure */
+      result |= (COM_POLLHUP | (events & COM_POLLIN));
+    }
+    else
+    {
+      if (((events & COM_POLLIN) != 0)
+          && (socket_desc->data_ready == COM_SOCKETS_TRUE))
+      {
+        result |= COM_POLLIN;
+      }
+      if (((events & COM_POLLOUT) != 0)
+          && ((socket_desc->state == COM_SOCKET_CONNECTED)
+              || ((socket_desc->type == (uint8_t)COM_SOCK_DGRAM)
+                  && (socket_desc->state == COM_SOCKET_CREATED))))
+      {
+        result |= COM_POLLOUT;
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Socket readiness callback
+  * @note   Register the function called on data ready and closing URC
+  * @param  callback  - function to call, NULL to unregister
+  * @retval None
+  */
+void com_set_ready_callback_ip_modem(com_ready_callback_t callback)
+{
+  com_ip_modem_ready_cb = callback;
+}
+
 
 /*** Server functionalities - NOT yet supported *******************************/
 
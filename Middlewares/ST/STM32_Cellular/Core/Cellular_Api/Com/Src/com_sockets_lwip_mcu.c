@@ -19,6 +19,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "com_sockets_lwip_mcu.h"
+#include "com_sockets.h"
 #include "plf_config.h"
 
 #if (USE_SOCKETS_TYPE == USE_SOCKETS_LWIP)
@@ -239,6 +240,87 @@ int32_t com_recv_lwip_mcu(int32_t sock,
                    flags);
 }
 
+/**
+  * @brief  Socket receive data without copy
+  * @note   Not supported, LwIP socket API only copies data to application
+  * @param  sock      - socket handle obtained with com_socket
+  * @param  len       - maximum number of bytes to receive
+  * @param  flags     - options
+  * @param  callback  - function to which data are lent
+  * @param  ctx       - context passed to callback
+  * @retval int32_t   - COM_SOCKETS_ERR_UNSUPPORTED
+  */
+int32_t com_recv_zc_lwip_mcu(int32_t sock, int32_t len, int32_t flags,
+                             com_recv_callback_t callback, void *ctx)
+{
+  UNUSED(sock);
+  UNUSED(len);
+  UNUSED(flags);
+  UNUSED(callback);
+  UNUSED(ctx);
+
+  return COM_SOCKETS_ERR_UNSUPPORTED;
+}
+
+/**
+  * @brief  Socket readiness
+  * @note   Report, without waiting, which of the requested events are ready
+  *         Restrictions, if any, are linked to LwIP module used
+  * @param  sock      - socket handle obtained with com_socket
+  * @note   socket handle on which operation has to be done
+  * @param  events    - COM_POLLIN and/or COM_POLLOUT
+  * @retval int32_t   - ready events or error value
+  */
+int32_t com_poll_lwip_mcu(int32_t sock, int32_t events)
+{
+  int32_t result;
+  fd_set rd_set;
+  fd_set wr_set;
+  fd_set ex_set;
+  struct timeval timeout = {0, 0};
+
+  FD_ZERO(&rd_set);
+  FD_ZERO(&wr_set);
+  FD_ZERO(&ex_set);
+  if ((events & COM_POLLIN) != 0)
+  {
+    FD_SET(sock, &rd_set);
+  }
+  if ((events & COM_POLLOUT) != 0)
+  {
+    FD_SET(sock, &wr_set);
+  }
+  FD_SET(sock, &ex_set);
+
+  result = lwip_select(sock + 1, &rd_set, &wr_set, &ex_set, &timeout);
+  if (result > 0)
+  {
+    result = 0;
+    if (FD_ISSET(sock, &rd_set) != 0)
+    {
+      result |= COM_POLLIN;
+    }
+    if (FD_ISSET(sock, &wr_set) != 0)
+    {
+      result |= COM_POLLOUT;
+    }
+    if (FD_ISSET(sock, &ex_set) != 0)
+    {
+      result |= COM_POLLERR;
+    }
+  }
+  else if (result < 0)
+  {
+    result = COM_SOCKETS_ERR_DESCRIPTOR;
+  }
+  else
+  {
+    /* Nothing ready */
+  }
+
+  return result;
+}
+
 /**
   * @brief  Socket send to data
   * @note   Send data to a remote host
@@ -39,6 +39,11 @@ extern "C" {
 #define MODEM_PDP_MAX_APN_SIZE     ((uint32_t) 64U)
 #define MODEM_MAX_NB_PDP_CTXT      ((uint8_t) CS_PDN_CONFIG_MAX + 1U) /* max. nbr of local PDP context configs */
 
+/* LUT index built at modem init (command ids and strings resolved without scanning the LUT) */
+#define ATCM_LUT_INDEX_MAX_CMD_ID  ((uint32_t) 128U) /* cmd ids >= this value are searched in the LUT */
+#define ATCM_LUT_INDEX_HASH_SIZE   ((uint32_t) 128U) /* power of 2, greater than the LUT size */
+#define ATCM_LUT_INDEX_NONE        ((uint8_t) 0xFFU)
+
 /* Exported types ------------------------------------------------------------*/
 typedef enum
 {
@@ -267,10 +272,24 @@ typedef struct
 
 } atcustom_SOCKET_context_t;
 
+typedef struct
+{
+  uint8_t   lut_rank;  /* rank of the command in the LUT or ATCM_LUT_INDEX_NONE */
+  uint8_t   str_size;  /* length of the command string */
+} atcustom_LUT_hash_entry_t;
+
+typedef struct
+{
+  at_bool_t                 valid;                                  /* index usable for this LUT */
+  uint8_t                   id_to_rank[ATCM_LUT_INDEX_MAX_CMD_ID];  /* cmd id -> LUT rank */
+  atcustom_LUT_hash_entry_t str_hash[ATCM_LUT_INDEX_HASH_SIZE];     /* cmd string -> LUT rank */
+} atcustom_LUT_index_t;
+
 typedef struct
 {
   uint32_t                           modem_LUT_size;
   const struct atcustom_LUT_struct   *p_modem_LUT;
+  atcustom_LUT_index_t               LUT_index;
 
   /* received command syntax analysis: state of automaton which analyzes cmd syntax */
   atcustom_modem_SyntaxAutomatonState_t   state_SyntaxAutomaton;
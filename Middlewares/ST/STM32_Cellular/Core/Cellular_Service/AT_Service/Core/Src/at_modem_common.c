@@ -77,6 +77,11 @@ static void reserve_user_modem_cid(atcustom_persistent_context_t *p_persistent_c
                                    uint8_t reserved_modem_cid);
 static void affect_modem_cid(atcustom_persistent_context_t *p_persistent_ctxt,
                              CS_PDN_conf_id_t conf_id);
+static uint32_t LUT_hash_string(const uint8_t *p_str, uint32_t str_size);
+static uint8_t LUT_search_string(const atcustom_modem_context_t *p_modem_ctxt,
+                                 const uint8_t *p_str, uint32_t str_size, uint32_t *p_slot);
+static void build_LUT_index(atcustom_modem_context_t *p_modem_ctxt);
+static uint32_t get_LUT_rank(const atcustom_modem_context_t *p_modem_ctxt, uint32_t cmd_id);
 
 /* Private function Definition -----------------------------------------------*/
 /*
@@ -319,6 +324,141 @@ CS_PDN_conf_id_t atcm_get_cid_current_SID(atcustom_modem_context_t *p_modem_ctxt
   return (current_conf_id);
 }
 
+/*
+*  Hash of a command string (FNV-1a) used to index the LUT
+*/
+static uint32_t LUT_hash_string(const uint8_t *p_str, uint32_t str_size)
+{
+  uint32_t hash = 2166136261U;
+  uint32_t i;
+
+  for (i = 0U; i < str_size; i++)
+  {
+    hash ^= (uint32_t) p_str[i];
+    hash *= 16777619U;
+  }
+
+  return (hash);
+}
+
+/*
+*  Search a command string in the LUT index
+*  returns the LUT rank of the command or ATCM_LUT_INDEX_NONE
+*  p_slot is set to the hash slot of the command or to the free slot where to insert it
+*/
+static uint8_t LUT_search_string(const atcustom_modem_context_t *p_modem_ctxt,
+                                 const uint8_t *p_str, uint32_t str_size, uint32_t *p_slot)
+{
+  const atcustom_LUT_index_t *p_index = &p_modem_ctxt->LUT_index;
+  uint32_t slot = LUT_hash_string(p_str, str_size) & (ATCM_LUT_INDEX_HASH_SIZE - 1U);
+  uint32_t probe;
+  uint8_t retval = ATCM_LUT_INDEX_NONE;
+
+  /* linear probing, ends on first free slot */
+  for (probe = 0U; probe < ATCM_LUT_INDEX_HASH_SIZE; probe++)
+  {
+    const atcustom_LUT_hash_entry_t *p_entry = &p_index->str_hash[slot];
+    if (p_entry->lut_rank == ATCM_LUT_INDEX_NONE)
+    {
+      break;
+    }
+    if (((uint32_t) p_entry->str_size == str_size) &&
+        (0 == memcmp((const void *)p_str,
+                     (const void *)p_modem_ctxt->p_modem_LUT[p_entry->lut_rank].cmd_str,
+                     (size_t) str_size)))
+    {
+      retval = p_entry->lut_rank;
+      break;
+    }
+    slot = (slot + 1U) & (ATCM_LUT_INDEX_HASH_SIZE - 1U);
+  }
+
+  *p_slot = slot;
+  return (retval);
+}
+
+/*
+*  Build the LUT index: cmd id to LUT rank table and hash of the command strings
+*  When several LUT entries match, the first one is kept (same result as a linear search)
+*/
+static void build_LUT_index(atcustom_modem_context_t *p_modem_ctxt)
+{
+  atcustom_LUT_index_t *p_index = &p_modem_ctxt->LUT_index;
+  uint32_t i;
+  uint32_t slot;
+
+  p_index->valid = AT_FALSE;
+  (void) memset((void *)p_index->id_to_rank, (int32_t) ATCM_LUT_INDEX_NONE, sizeof(p_index->id_to_rank));
+  (void) memset((void *)p_index->str_hash, (int32_t) ATCM_LUT_INDEX_NONE, sizeof(p_index->str_hash));
+
+  if ((p_modem_ctxt->p_modem_LUT == NULL) ||
+      (p_modem_ctxt->modem_LUT_size >= ATCM_LUT_INDEX_HASH_SIZE) ||
+      (p_modem_ctxt->modem_LUT_size >= (uint32_t) ATCM_LUT_INDEX_NONE))
+  {
+    /* LUT will be searched linearly */
+    PrintINFO("LUT index not available")
+    return;
+  }
+
+  for (i = 0U; i < p_modem_ctxt->modem_LUT_size; i++)
+  {
+    const atcustom_LUT_t *p_LUT_entry = &p_modem_ctxt->p_modem_LUT[i];
+    uint32_t str_size = (uint32_t) strlen((const atcm_TYPE_CHAR_t *)p_LUT_entry->cmd_str);
+
+    if ((p_LUT_entry->cmd_id < ATCM_LUT_INDEX_MAX_CMD_ID) &&
+        (p_index->id_to_rank[p_LUT_entry->cmd_id] == ATCM_LUT_INDEX_NONE))
+    {
+      p_index->id_to_rank[p_LUT_entry->cmd_id] = (uint8_t) i;
+    }
+
+    /* empty strings are never matched */
+    if ((str_size > 0U) &&
+        (LUT_search_string(p_modem_ctxt, p_LUT_entry->cmd_str, str_size, &slot) == ATCM_LUT_INDEX_NONE))
+    {
+      p_index->str_hash[slot].lut_rank = (uint8_t) i;
+      p_index->str_hash[slot].str_size = (uint8_t) str_size;
+    }
+  }
+
+  p_index->valid = AT_TRUE;
+}
+
+/*
+*  Get the LUT rank of a command Id
+*  returns modem_LUT_size if not found
+*/
+static uint32_t get_LUT_rank(const atcustom_modem_context_t *p_modem_ctxt, uint32_t cmd_id)
+{
+  uint32_t rank = p_modem_ctxt->modem_LUT_size;
+  uint32_t i;
+
+  /* check if this is the invalid cmd id */
+  if (cmd_id != CMD_AT_INVALID)
+  {
+    if ((p_modem_ctxt->LUT_index.valid == AT_TRUE) && (cmd_id < ATCM_LUT_INDEX_MAX_CMD_ID))
+    {
+      if (p_modem_ctxt->LUT_index.id_to_rank[cmd_id] != ATCM_LUT_INDEX_NONE)
+      {
+        rank = (uint32_t) p_modem_ctxt->LUT_index.id_to_rank[cmd_id];
+      }
+    }
+    else
+    {
+      /* search in LUT the cmd ID */
+      for (i = 0U; i < p_modem_ctxt->modem_LUT_size; i++)
+      {
+        if (p_modem_ctxt->p_modem_LUT[i].cmd_id == cmd_id)
+        {
+          rank = i;
+          break;
+        }
+      }
+    }
+  }
+
+  return (rank);
+}
+
 /* functions ------------------------------------------------------------------ */
 
 /**
@@ -330,19 +470,11 @@ CS_PDN_conf_id_t atcm_get_cid_current_SID(atcustom_modem_context_t *p_modem_ctxt
   */
 const AT_CHAR_t *atcm_get_CmdStr(const atcustom_modem_context_t *p_modem_ctxt, uint32_t cmd_id)
 {
-  uint16_t i;
+  uint32_t rank = get_LUT_rank(p_modem_ctxt, cmd_id);
 
-  /* check if this is the invalid cmd id*/
-  if (cmd_id != CMD_AT_INVALID)
+  if (rank < p_modem_ctxt->modem_LUT_size)
   {
-    /* search in LUT the cmd ID */
-    for (i = 0U; i < p_modem_ctxt->modem_LUT_size; i++)
-    {
-      if (p_modem_ctxt->p_modem_LUT[i].cmd_id == cmd_id)
-      {
-        return (const AT_CHAR_t *)(&p_modem_ctxt->p_modem_LUT[i].cmd_str);
-      }
-    }
+    return (const AT_CHAR_t *)(&p_modem_ctxt->p_modem_LUT[rank].cmd_str);
   }
 
   /* return default value */
@@ -359,19 +491,11 @@ const AT_CHAR_t *atcm_get_CmdStr(const atcustom_modem_context_t *p_modem_ctxt, u
   */
 uint32_t atcm_get_CmdTimeout(const atcustom_modem_context_t *p_modem_ctxt, uint32_t cmd_id)
 {
-  uint16_t i;
+  uint32_t rank = get_LUT_rank(p_modem_ctxt, cmd_id);
 
-  /* check if this is the invalid cmd id */
-  if (cmd_id != CMD_AT_INVALID)
+  if (rank < p_modem_ctxt->modem_LUT_size)
   {
-    /* search in LUT the cmd ID */
-    for (i = 0U; i < p_modem_ctxt->modem_LUT_size; i++)
-    {
-      if (p_modem_ctxt->p_modem_LUT[i].cmd_id == cmd_id)
-      {
-        return (p_modem_ctxt->p_modem_LUT[i].cmd_timeout);
-      }
-    }
+    return (p_modem_ctxt->p_modem_LUT[rank].cmd_timeout);
   }
 
   /* return default value */
@@ -388,18 +512,11 @@ uint32_t atcm_get_CmdTimeout(const atcustom_modem_context_t *p_modem_ctxt, uint3
   */
 CmdBuildFuncTypeDef atcm_get_CmdBuildFunc(const atcustom_modem_context_t *p_modem_ctxt, uint32_t cmd_id)
 {
-  uint16_t i;
+  uint32_t rank = get_LUT_rank(p_modem_ctxt, cmd_id);
 
-  if (cmd_id != CMD_AT_INVALID)
+  if (rank < p_modem_ctxt->modem_LUT_size)
   {
-    /* search in LUT the cmd ID */
-    for (i = 0U; i < p_modem_ctxt->modem_LUT_size; i++)
-    {
-      if (p_modem_ctxt->p_modem_LUT[i].cmd_id == cmd_id)
-      {
-        return (p_modem_ctxt->p_modem_LUT[i].cmd_BuildFunc);
-      }
-    }
+    return (p_modem_ctxt->p_modem_LUT[rank].cmd_BuildFunc);
   }
 
   /* return default value */
@@ -416,18 +533,11 @@ CmdBuildFuncTypeDef atcm_get_CmdBuildFunc(const atcustom_modem_context_t *p_mode
   */
 CmdAnalyzeFuncTypeDef atcm_get_CmdAnalyzeFunc(const atcustom_modem_context_t *p_modem_ctxt, uint32_t cmd_id)
 {
-  uint16_t i;
+  uint32_t rank = get_LUT_rank(p_modem_ctxt, cmd_id);
 
-  if (cmd_id != CMD_AT_INVALID)
+  if (rank < p_modem_ctxt->modem_LUT_size)
   {
-    /* search in LUT the cmd ID */
-    for (i = 0U; i < p_modem_ctxt->modem_LUT_size; i++)
-    {
-      if (p_modem_ctxt->p_modem_LUT[i].cmd_id == cmd_id)
-      {
-        return (p_modem_ctxt->p_modem_LUT[i].rsp_AnalyzeFunc);
-      }
-    }
+    return (p_modem_ctxt->p_modem_LUT[rank].rsp_AnalyzeFunc);
   }
 
   /* return default value */
@@ -580,6 +690,9 @@ void atcm_modem_init(atcustom_modem_context_t *p_modem_ctxt)
   atcm_reset_CMD_context(&p_modem_ctxt->CMD_ctxt);
   atcm_reset_SOCKET_context(p_modem_ctxt);
   p_modem_ctxt->state_SyntaxAutomaton = WAITING_FOR_INIT_CR;
+
+  /* index the modem LUT (LUT has to be set before init) */
+  build_LUT_index(p_modem_ctxt);
 }
 
 void atcm_modem_reset(atcustom_modem_context_t *p_modem_ctxt)
@@ -1529,6 +1642,8 @@ at_status_t atcm_searchCmdInLUT(atcustom_modem_context_t *p_modem_ctxt,
   UNUSED(p_atp_ctxt);
 
   uint16_t i;
+  uint32_t slot;
+  uint8_t rank;
 
   element_infos->cmd_id_received = CMD_AT_INVALID;
 
@@ -1541,6 +1656,23 @@ at_status_t atcm_searchCmdInLUT(atcustom_modem_context_t *p_modem_ctxt,
     return (ATSTATUS_OK);
   }
 
+  if (p_modem_ctxt->LUT_index.valid == AT_TRUE)
+  {
+    /* search in LUT index the ID corresponding to command received */
+    rank = LUT_search_string(p_modem_ctxt,
+                             (const uint8_t *) &p_msg_in->buffer[element_infos->str_start_idx],
+                             (uint32_t) element_infos->str_size,
+                             &slot);
+    if (rank != ATCM_LUT_INDEX_NONE)
+    {
+      PrintDBG("we received LUT#%ld : %s \r\n", (p_modem_ctxt->p_modem_LUT)[rank].cmd_id, (p_modem_ctxt->p_modem_LUT)[rank].cmd_str)
+
+      element_infos->cmd_id_received = (p_modem_ctxt->p_modem_LUT)[rank].cmd_id;
+      return (ATSTATUS_OK);
+    }
+    return (ATSTATUS_ERROR);
+  }
+
   /* search in LUT the ID corresponding to command received */
   for (i = 0U; i < p_modem_ctxt->modem_LUT_size; i++)
   {
@@ -384,6 +384,8 @@ typedef void (* cellular_pdn_event_callback_t)(CS_PDN_conf_id_t cid, CS_PDN_even
 typedef void (* cellular_socket_data_ready_callback_t)(socket_handle_t sockHandle);
 typedef void (* cellular_socket_data_sent_callback_t)(socket_handle_t sockHandle);
 typedef void (* cellular_socket_closed_callback_t)(socket_handle_t sockHandle);
+/* received data are only valid until this callback returns */
+typedef void (* cellular_socket_receive_callback_t)(const CS_CHAR_t *p_data, uint32_t length, void *p_ctx);
 typedef void (* cellular_ping_response_callback_t)(CS_Ping_response_t ping_response);
 typedef void (* cellular_direct_cmd_callback_t)(CS_direct_cmd_rx_t direct_cmd_rx);
 
@@ -460,6 +462,10 @@ CS_Status_t CDS_socket_sendto(socket_handle_t sockHandle,
 int32_t CDS_socket_receive(socket_handle_t sockHandle,
                            CS_CHAR_t *p_buf,
                            uint32_t max_buf_length);
+int32_t CDS_socket_receive_zc(socket_handle_t sockHandle,
+                              uint32_t max_buf_length,
+                              cellular_socket_receive_callback_t rcv_cb,
+                              void *p_ctx);
 int32_t CDS_socket_receivefrom(socket_handle_t sockHandle,
                                CS_CHAR_t *p_buf,
                                uint32_t max_buf_length,
@@ -225,6 +225,8 @@ typedef struct
   CS_CHAR_t        *p_buffer_addr_rcv;  /* receive buffer */
   uint32_t         buffer_size;         /* real buffer size */
   uint32_t         max_buffer_size;     /* maximum buffer size allowed by client - used on for RX data */
+  cellular_socket_receive_callback_t rcv_cb; /* if not NULL, RX data are lent to it instead of copied to p_buffer_addr_rcv */
+  void             *p_rcv_cb_ctx;       /* context passed to rcv_cb */
   /* following parameters are used only in sendto or receivefrom */
   CS_IPaddrType_t  ip_addr_type;
   CS_CHAR_t        ip_addr_value[MAX_IP_ADDR_SIZE]; /* remote IP address */
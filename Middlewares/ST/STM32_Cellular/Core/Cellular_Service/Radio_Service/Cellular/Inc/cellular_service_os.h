@@ -75,6 +75,11 @@ int32_t osCDS_socket_receive(socket_handle_t sockHandle,
                              CS_CHAR_t *p_buf,
                              uint32_t max_buf_length);
 
+int32_t osCDS_socket_receive_zc(socket_handle_t sockHandle,
+                                uint32_t max_buf_length,
+                                cellular_socket_receive_callback_t rcv_cb,
+                                void *p_ctx);
+
 CS_Status_t osCDS_socket_sendto(socket_handle_t sockHandle,
                                 const CS_CHAR_t *p_buf,
                                 uint32_t length,
@@ -154,6 +154,11 @@ static CS_Status_t socket_configure_remote(socket_handle_t sockhandle,
                                            uint16_t remote_port);
 static CS_PDN_event_t convert_to_PDN_event(csint_PDN_event_desc_t event_desc);
 static CS_PDN_conf_id_t convert_index_to_PDN_conf(uint8_t index);
+static int32_t socket_receive_data(socket_handle_t sockhandle,
+                                   CS_CHAR_t *p_buf,
+                                   uint32_t max_buf_length,
+                                   cellular_socket_receive_callback_t rcv_cb,
+                                   void *p_ctx);
 
 /* Functions Definition ------------------------------------------------------*/
 #if (RTOS_USED == 0)
@@ -1548,69 +1553,35 @@ int32_t CDS_socket_receive(socket_handle_t sockHandle,
                            CS_CHAR_t *p_buf,
                            uint32_t max_buf_length)
 {
-  CS_Status_t status = CELLULAR_ERROR;
-  at_status_t err;
-  uint32_t bytes_received = 0U;
-
   PrintAPI("CDS_socket_receive")
 
-  /* check that size does not exceed maximum buffers size */
-  if (max_buf_length > DEFAULT_IP_MAX_PACKET_SIZE)
-  {
-    PrintErr("<Cellular_Service> buffer size %ld exceed maximum value %d",
-             max_buf_length,
-             DEFAULT_IP_MAX_PACKET_SIZE)
-    return (-1);
-  }
-
-  /* check that socket has been allocated */
-  if (cs_ctxt_sockets_info[sockHandle].state != SOCKETSTATE_CONNECTED)
-  {
-    PrintErr("<Cellular_Service> socket not connected (state=%d) for handle %ld (rcv)",
-             cs_ctxt_sockets_info[sockHandle].state,
-             sockHandle)
-    return (-1);
-  }
+  return (socket_receive_data(sockHandle, p_buf, max_buf_length, NULL, NULL));
+}
 
-  csint_socket_data_buffer_t receive_data_struct = {0};
-  (void) memset((void *)&receive_data_struct, 0, sizeof(csint_socket_data_buffer_t));
-  receive_data_struct.socket_handle = sockHandle;
-  receive_data_struct.p_buffer_addr_send = NULL;
-  receive_data_struct.p_buffer_addr_rcv = p_buf;
-  receive_data_struct.buffer_size = 0U;
-  receive_data_struct.max_buffer_size = max_buf_length;
-  /* following parameters are not used (only in receivefrom) */
-  receive_data_struct.ip_addr_type = CS_IPAT_INVALID;
-  /* receive_data_struct.ip_addr_value already reset */
-  /* receive_data_struct.remote_port already reset */
-  if (DATAPACK_writeStruct(&cmd_buf[0],
-                           (uint16_t) CSMT_SOCKET_DATA_BUFFER,
-                           (uint16_t) sizeof(csint_socket_data_buffer_t),
-                           (void *)&receive_data_struct) == DATAPACK_OK)
-  {
-    err = AT_sendcmd(_Adapter_Handle, (at_msg_t) SID_CS_RECEIVE_DATA, &cmd_buf[0], &rsp_buf[0]);
-    if (err == ATSTATUS_OK)
-    {
-      if (DATAPACK_readStruct(&rsp_buf[0],
-                              (uint16_t) CSMT_SOCKET_RXDATA,
-                              (uint16_t) sizeof(uint32_t),
-                              &bytes_received) == DATAPACK_OK)
-      {
-        status = CELLULAR_OK;
-      }
-    }
-  }
+/**
+  * @brief  Receive data from the connected remote server without copy.
+  * @note   Same as CDS_socket_receive but the received data are lent to rcv_cb
+  *         in the AT response buffer instead of being copied to a client buffer.
+  *         rcv_cb is called from the AT core context: it must not block and must
+  *         not call the Cellular Service, the data are no more valid once it returns.
+  * @param  sockHandle Handle of the socket
+  * @param  max_buf_length Maximum size of data to receive.
+  * @param  rcv_cb Callback receiving the data.
+  * @param  p_ctx Context passed to rcv_cb.
+  * @retval Size of received data (in bytes).
+  */
+int32_t CDS_socket_receive_zc(socket_handle_t sockHandle,
+                              uint32_t max_buf_length,
+                              cellular_socket_receive_callback_t rcv_cb,
+                              void *p_ctx)
+{
+  PrintAPI("CDS_socket_receive_zc")
 
-  if (status == CELLULAR_ERROR)
+  if (rcv_cb == NULL)
   {
-    PrintErr("<Cellular_Service> error when receiving data from socket")
     return (-1);
   }
-  else
-  {
-    PrintINFO("Size of data received on the socket= %ld bytes", bytes_received)
-    return ((int32_t)bytes_received);
-  }
+  return (socket_receive_data(sockHandle, NULL, max_buf_length, rcv_cb, p_ctx));
 }
 
 /**
@@ -3195,6 +3166,88 @@ static CS_PDN_conf_id_t convert_index_to_PDN_conf(uint8_t index)
   }
   return (PDNconf);
 }
+
+/**
+  * @brief  Receive data from the connected remote server.
+  * @note   This function is blocking until expected data length is received or a receive timeout has expired.
+  * @param  sockhandle Handle of the socket
+  * @param  p_buf Pointer to the data buffer to received data (not used if rcv_cb is not NULL).
+  * @param  max_buf_length Maximum size of receive data buffer.
+  * @param  rcv_cb Callback to which data are lent, NULL to copy them to p_buf.
+  * @param  p_ctx Context passed to rcv_cb.
+  * @retval Size of received data (in bytes).
+  */
+static int32_t socket_receive_data(socket_handle_t sockhandle,
+                                   CS_CHAR_t *p_buf,
+                                   uint32_t max_buf_length,
+                                   cellular_socket_receive_callback_t rcv_cb,
+                                   void *p_ctx)
+{
+  CS_Status_t status = CELLULAR_ERROR;
+  at_status_t err;
+  uint32_t bytes_received = 0U;
+
+  /* check that size does not exceed maximum buffers size */
+  if (max_buf_length > DEFAULT_IP_MAX_PACKET_SIZE)
+  {
+    PrintErr("<Cellular_Service> buffer size %ld exceed maximum value %d",
+             max_buf_length,
+             DEFAULT_IP_MAX_PACKET_SIZE)
+    return (-1);
+  }
+
+  /* check that socket has been allocated */
+  if (cs_ctxt_sockets_info[sockhandle].state != SOCKETSTATE_CONNECTED)
+  {
+    PrintErr("<Cellular_Service> socket not connected (state=%d) for handle %ld (rcv)",
+             cs_ctxt_sockets_info[sockhandle].state,
+             sockhandle)
+    return (-1);
+  }
+
+  csint_socket_data_buffer_t receive_data_struct = {0};
+  (void) memset((void *)&receive_data_struct, 0, sizeof(csint_socket_data_buffer_t));
+  receive_data_struct.socket_handle = sockhandle;
+  receive_data_struct.p_buffer_addr_send = NULL;
+  receive_data_struct.p_buffer_addr_rcv = p_buf;
+  receive_data_struct.buffer_size = 0U;
+  receive_data_struct.max_buffer_size = max_buf_length;
+  receive_data_struct.rcv_cb = rcv_cb;
+  receive_data_struct.p_rcv_cb_ctx = p_ctx;
+  /* following parameters are not used (only in receivefrom) */
+  receive_data_struct.ip_addr_type = CS_IPAT_INVALID;
+  /* receive_data_struct.ip_addr_value already reset */
+  /* receive_data_struct.remote_port already reset */
+  if (DATAPACK_writeStruct(&cmd_buf[0],
+                           (uint16_t) CSMT_SOCKET_DATA_BUFFER,
+                           (uint16_t) sizeof(csint_socket_data_buffer_t),
+                           (void *)&receive_data_struct) == DATAPACK_OK)
+  {
+    err = AT_sendcmd(_Adapter_Handle, (at_msg_t) SID_CS_RECEIVE_DATA, &cmd_buf[0], &rsp_buf[0]);
+    if (err == ATSTATUS_OK)
+    {
+      if (DATAPACK_readStruct(&rsp_buf[0],
+                              (uint16_t) CSMT_SOCKET_RXDATA,
+                              (uint16_t) sizeof(uint32_t),
+                              &bytes_received) == DATAPACK_OK)
+      {
+        status = CELLULAR_OK;
+      }
+    }
+  }
+
+  if (status == CELLULAR_ERROR)
+  {
+    PrintErr("<Cellular_Service> error when receiving data from socket")
+    return (-1);
+  }
+  else
+  {
+    PrintINFO("Size of data received on the socket= %ld bytes", bytes_received)
+    return ((int32_t)bytes_received);
+  }
+}
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
 
 
@@ -219,6 +219,29 @@ int32_t osCDS_socket_receive(socket_handle_t sockHandle,
   return (result);
 }
 
+int32_t osCDS_socket_receive_zc(socket_handle_t sockHandle,
+                                uint32_t max_buf_length,
+                                cellular_socket_receive_callback_t rcv_cb,
+                                void *p_ctx)
+{
+  int32_t result;
+
+  result = 0;
+  if (CST_get_state() == CST_MODEM_DATA_READY_STATE)
+  {
+    (void)osMutexWait(CellularServiceMutexHandle, RTOS_WAIT_FOREVER);
+
+    result = CDS_socket_receive_zc(sockHandle,
+                                   max_buf_length,
+                                   rcv_cb,
+                                   p_ctx);
+
+    (void)osMutexRelease(CellularServiceMutexHandle);
+  }
+
+  return (result);
+}
+
 CS_Status_t osCDS_socket_sendto(socket_handle_t sockHandle,
                                 const CS_CHAR_t *p_buf,
                                 uint32_t length,
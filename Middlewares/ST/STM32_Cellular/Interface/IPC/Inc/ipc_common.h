@@ -38,6 +38,11 @@ extern "C" {
 * - IPC_RXBUF_THRESHOLD: if free space in RX queue is < to this value, the interface (UART,..) will be paused
 *                        until enough free space (ie previous msg have been read)
 * - IPC_USE_UART: set to 1 is IPC uses UART (ONLY UART IS SUPPORTED ACTUALLY)
+* - IPC_USE_UART_DMA_RX: set to 0 to receive characters one by one under UART RX interrupt
+*                        set to 1 to receive characters in a circular DMA buffer, processed on
+*                        idle line, half transfer and transfer complete events
+*                        (the UART handle must be linked to a circular RX DMA channel)
+* - IPC_RXBUF_DMA_SIZE: size of the circular DMA buffer (only if IPC_USE_UART_DMA_RX == 1)
 * - IPC_USE_SPI: 0
 * - IPC_USE_I2C: 0
 * - DBG_IPC_RX_FIFO: set to 1 for additional debug informations
@@ -209,6 +214,12 @@ typedef struct
   IPC_State_t              state;
   IPC_PhysicalInterface_t  phy_int;
   IPC_CHAR_t               RxChar[1];    /* RX DMA buffer (1 char) - common buffer for one physical interface  */
+#if (IPC_USE_UART_DMA_RX == 1U)
+  IPC_CHAR_t               RxDmaBuffer[IPC_RXBUF_DMA_SIZE]; /* RX circular DMA buffer - common buffer for one
+                                                             * physical interface
+                                                             */
+  uint16_t                 RxDmaReadPos; /* position of the next character to process in RxDmaBuffer */
+#endif /* IPC_USE_UART_DMA_RX */
   IPC_Handle_t             *h_current_channel;   /* current active IPC channel */
   IPC_Handle_t             *h_inactive_channel;  /* other IPC channel (exists if not NULL), currently not active */
 } IPC_ClientDescription_t;
@@ -39,6 +39,7 @@ extern "C" {
 /* Exported functions ------------------------------------------------------- */
 void RXFIFO_init(IPC_Handle_t *hipc);
 void RXFIFO_writeCharacter(IPC_Handle_t *hipc, uint8_t rxChar);
+uint16_t RXFIFO_writeBuffer(IPC_Handle_t *hipc, const uint8_t *p_buf, uint16_t size);
 int16_t RXFIFO_read(IPC_Handle_t *hipc, IPC_RxMessage_t *o_Msg);
 #if (IPC_USE_STREAM_MODE == 1U)
 void RXFIFO_stream_init(IPC_Handle_t *hipc);
@@ -54,6 +54,10 @@ void IPC_dump_RX_queue_uart(const IPC_Handle_t *hipc, uint8_t readable);
 void IPC_UART_RxCpltCallback(UART_HandleTypeDef *UartHandle);
 void IPC_UART_TxCpltCallback(UART_HandleTypeDef *UartHandle);
 void IPC_UART_ErrorCallback(UART_HandleTypeDef *UartHandle);
+#if (IPC_USE_UART_DMA_RX == 1U)
+void IPC_UART_RxHalfCpltCallback(UART_HandleTypeDef *UartHandle);
+void IPC_UART_IdleLineCallback(UART_HandleTypeDef *UartHandle);
+#endif /* IPC_USE_UART_DMA_RX */
 
 #ifdef __cplusplus
 }
@@ -128,6 +128,22 @@ void RXFIFO_writeCharacter(IPC_Handle_t *hipc, uint8_t rxChar)
   return;
 }
 
+uint16_t RXFIFO_writeBuffer(IPC_Handle_t *hipc, const uint8_t *p_buf, uint16_t size)
+{
+  uint16_t count = 0U;
+
+  /* same processing as character by character reception:
+   * stops after the character which has paused the queue
+   */
+  while ((count < size) && (hipc->State != IPC_STATE_PAUSED))
+  {
+    (* hipc->RxFifoWrite)(hipc, p_buf[count]);
+    count++;
+  }
+
+  return (count);
+}
+
 int16_t RXFIFO_read(IPC_Handle_t *hipc, IPC_RxMessage_t *o_Msg)
 {
   IPC_RxHeader_t header;
@@ -401,6 +417,10 @@ static void RXFIFO_prepareNextMsgHeader(IPC_Handle_t *hipc)
 
 static void rearm_RX_IT(IPC_Handle_t *hipc)
 {
+#if (IPC_USE_UART_DMA_RX == 1U)
+  /* circular DMA reception is not stopped after each character */
+  UNUSED(hipc);
+#else
   HAL_StatusTypeDef err ;
 
   /* Comment: specific to UART, should be in ipc_uart.c */
@@ -413,6 +433,7 @@ static void rearm_RX_IT(IPC_Handle_t *hipc)
       hipc->UartBusyFlag = 1U;
     }
   }
+#endif /* IPC_USE_UART_DMA_RX */
 }
 
 #if (DBG_IPC_RX_FIFO != 0U)
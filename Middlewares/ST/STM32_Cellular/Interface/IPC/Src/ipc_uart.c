@@ -65,6 +65,11 @@
 /* Private function prototypes -----------------------------------------------*/
 static uint8_t find_Device(const UART_HandleTypeDef *huart);
 static IPC_Status_t change_ipc_channel(IPC_Handle_t *hipc);
+static HAL_StatusTypeDef start_RX(const IPC_Handle_t *hipc);
+#if (IPC_USE_UART_DMA_RX == 1U)
+static void process_RX_DMA(uint8_t device_id);
+static void resume_RX_DMA(const IPC_Handle_t *hipc);
+#endif /* IPC_USE_UART_DMA_RX */
 
 /* Functions Definition ------------------------------------------------------*/
 /**
@@ -208,7 +213,7 @@ IPC_Status_t IPC_open_uart(IPC_Handle_t *hipc,
 #endif /* IPC_USE_STREAM_MODE */
 
   /* start RX IT */
-  uart_status = HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)g_IPC_Devices_List[device].RxChar, 1U);
+  uart_status = start_RX(hipc);
   if (HAL_OK != uart_status)
   {
     return (IPC_ERROR);
@@ -330,7 +335,11 @@ IPC_Status_t IPC_reset_uart(IPC_Handle_t *hipc)
         */
 
       /* rearm IT */
-      (void) HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)g_IPC_Devices_List[device_id].RxChar, 1U);
+#if (IPC_USE_UART_DMA_RX == 1U)
+      /* restart DMA reception from the beginning of the buffer */
+      (void) HAL_UART_AbortReceive(hipc->Interface.h_uart);
+#endif /* IPC_USE_UART_DMA_RX */
+      (void) start_RX(hipc);
       hipc->State = IPC_STATE_ACTIVE;
       retval = IPC_OK;
     }
@@ -468,7 +477,11 @@ IPC_Status_t IPC_receive_uart(IPC_Handle_t *hipc, IPC_RxMessage_t *p_msg)
 #endif /* DBG_IPC_RX_FIFO */
 
       hipc->State = IPC_STATE_ACTIVE;
+#if (IPC_USE_UART_DMA_RX == 1U)
+      resume_RX_DMA(hipc);
+#else
       (void) HAL_UART_Receive_IT(hipc->Interface.h_uart, (uint8_t *)g_IPC_Devices_List[hipc->Device_ID].RxChar, 1U);
+#endif /* IPC_USE_UART_DMA_RX */
     }
 
     if (unread_msg == 0)
@@ -618,11 +631,57 @@ void IPC_UART_RxCpltCallback(UART_HandleTypeDef *UartHandle)
   uint8_t device_id = find_Device(UartHandle);
   if (device_id < IPC_MAX_DEVICES)
   {
+#if (IPC_USE_UART_DMA_RX == 1U)
+    /* end of circular DMA buffer reached */
+    process_RX_DMA(device_id);
+#else
     g_IPC_Devices_List[device_id].h_current_channel->RxFifoWrite(g_IPC_Devices_List[device_id].h_current_channel,
                                                                  g_IPC_Devices_List[device_id].RxChar[0]);
+#endif /* IPC_USE_UART_DMA_RX */
   }
 }
 
+#if (IPC_USE_UART_DMA_RX == 1U)
+/**
+  * @brief  IPC uart RX half transfer callback (called under IT !).
+  * @param  UartHandle Ptr to the HAL UART handle.
+  * @retval none
+  */
+void IPC_UART_RxHalfCpltCallback(UART_HandleTypeDef *UartHandle)
+{
+  /* Warning ! this function is called under IT */
+  uint8_t device_id = find_Device(UartHandle);
+  if (device_id < IPC_MAX_DEVICES)
+  {
+    /* middle of circular DMA buffer reached */
+    process_RX_DMA(device_id);
+  }
+}
+
+/**
+  * @brief  IPC uart idle line detection (called under IT !).
+  * @note   To call from the UART IRQ handler, before HAL_UART_IRQHandler.
+  * @param  UartHandle Ptr to the HAL UART handle.
+  * @retval none
+  */
+void IPC_UART_IdleLineCallback(UART_HandleTypeDef *UartHandle)
+{
+  /* Warning ! this function is called under IT */
+  if ((__HAL_UART_GET_FLAG(UartHandle, UART_FLAG_IDLE) != RESET) &&
+      (__HAL_UART_GET_IT_SOURCE(UartHandle, UART_IT_IDLE) != RESET))
+  {
+    __HAL_UART_CLEAR_IDLEFLAG(UartHandle);
+
+    uint8_t device_id = find_Device(UartHandle);
+    if (device_id < IPC_MAX_DEVICES)
+    {
+      /* modem stopped sending: process what has been received so far */
+      process_RX_DMA(device_id);
+    }
+  }
+}
+#endif /* IPC_USE_UART_DMA_RX */
+
 /**
   * @brief  IPC uart TX callback (called under IT !).
   * @param  UartHandle Ptr to the HAL UART handle.
@@ -651,6 +710,19 @@ void IPC_UART_ErrorCallback(UART_HandleTypeDef *UartHandle)
   if (device_id != IPC_DEVICE_NOT_FOUND)
   {
     /* TODO: add an error callback ? */
+#if (IPC_USE_UART_DMA_RX == 1U)
+    /* a blocking error (overrun...) stops the DMA reception:
+     * process what has been received and restart it, unless the queue is paused (restarted on resume)
+     */
+    if (UartHandle->RxState == HAL_UART_STATE_READY)
+    {
+      process_RX_DMA(device_id);
+      if (g_IPC_Devices_List[device_id].h_current_channel->State != IPC_STATE_PAUSED)
+      {
+        (void) start_RX(g_IPC_Devices_List[device_id].h_current_channel);
+      }
+    }
+#endif /* IPC_USE_UART_DMA_RX */
   }
 }
 
@@ -691,5 +763,103 @@ static IPC_Status_t change_ipc_channel(IPC_Handle_t *hipc)
   return (IPC_OK);
 }
 
+static HAL_StatusTypeDef start_RX(const IPC_Handle_t *hipc)
+{
+  HAL_StatusTypeDef uart_status;
+  UART_HandleTypeDef *huart = hipc->Interface.h_uart;
+
+#if (IPC_USE_UART_DMA_RX == 1U)
+  IPC_ClientDescription_t *p_device = &g_IPC_Devices_List[hipc->Device_ID];
+
+  if (huart->RxState == HAL_UART_STATE_READY)
+  {
+    p_device->RxDmaReadPos = 0U;
+  }
+  /* circular DMA: reception never stops, characters are processed on idle line,
+   * half transfer and transfer complete events
+   */
+  uart_status = HAL_UART_Receive_DMA(huart, (uint8_t *)p_device->RxDmaBuffer, IPC_RXBUF_DMA_SIZE);
+  if (uart_status == HAL_OK)
+  {
+    __HAL_UART_CLEAR_IDLEFLAG(huart);
+    __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+  }
+#else
+  uart_status = HAL_UART_Receive_IT(huart, (uint8_t *)g_IPC_Devices_List[hipc->Device_ID].RxChar, 1U);
+#endif /* IPC_USE_UART_DMA_RX */
+
+  return (uart_status);
+}
+
+#if (IPC_USE_UART_DMA_RX == 1U)
+static void process_RX_DMA(uint8_t device_id)
+{
+  IPC_ClientDescription_t *p_device = &g_IPC_Devices_List[device_id];
+  IPC_Handle_t *hipc = p_device->h_current_channel;
+  UART_HandleTypeDef *huart = p_device->phy_int.h_uart;
+  uint16_t write_pos;
+  uint16_t read_pos;
+  uint16_t span;
+
+  if (hipc == NULL)
+  {
+    return;
+  }
+
+  /* position where the DMA will write the next character */
+  write_pos = (uint16_t)(IPC_RXBUF_DMA_SIZE - (uint16_t)__HAL_DMA_GET_COUNTER(huart->hdmarx));
+  if (write_pos >= IPC_RXBUF_DMA_SIZE)
+  {
+    write_pos = 0U;
+  }
+
+  /* process new characters in one or two contiguous spans (if buffer end is crossed) */
+  read_pos = p_device->RxDmaReadPos;
+  while ((read_pos != write_pos) && (hipc->State != IPC_STATE_PAUSED))
+  {
+    span = (write_pos > read_pos) ? (write_pos - read_pos) : (IPC_RXBUF_DMA_SIZE - read_pos);
+    read_pos += RXFIFO_writeBuffer(hipc, &p_device->RxDmaBuffer[read_pos], span);
+    if (read_pos >= IPC_RXBUF_DMA_SIZE)
+    {
+      read_pos = 0U;
+    }
+  }
+  p_device->RxDmaReadPos = read_pos;
+
+  if (hipc->State == IPC_STATE_PAUSED)
+  {
+    /* stop DMA requests: UART holds next character (and RTS if flow control) until resume,
+     * characters not yet processed stay in DMA buffer
+     */
+    (void) HAL_UART_DMAPause(huart);
+  }
+}
+
+static void resume_RX_DMA(const IPC_Handle_t *hipc)
+{
+  UART_HandleTypeDef *huart = hipc->Interface.h_uart;
+
+  /* DMA is paused: no DMA event, mask idle line event while processing
+   * the characters received before the pause
+   */
+  __HAL_UART_DISABLE_IT(huart, UART_IT_IDLE);
+  process_RX_DMA(hipc->Device_ID);
+
+  if (hipc->State != IPC_STATE_PAUSED)
+  {
+    if (huart->RxState == HAL_UART_STATE_READY)
+    {
+      /* DMA reception stopped by an error while paused */
+      (void) start_RX(hipc);
+    }
+    else
+    {
+      __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+      (void) HAL_UART_DMAResume(huart);
+    }
+  }
+}
+#endif /* IPC_USE_UART_DMA_RX */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
 
@@ -49,6 +49,15 @@ extern "C" {
 #ifdef NET_MBEDTLS_HOST_SUPPORT
 #define NET_MBEDTLS_DEBUG_LEVEL 1
 
+/* Parsed certificates/keys kept across connections, and server names kept for TLS session resumption.
+ * 0 disables the cache. */
+#ifndef NET_MBEDTLS_CRED_CACHE_SIZE
+#define NET_MBEDTLS_CRED_CACHE_SIZE     4
+#endif /* NET_MBEDTLS_CRED_CACHE_SIZE */
+#ifndef NET_MBEDTLS_SESSION_CACHE_SIZE
+#define NET_MBEDTLS_SESSION_CACHE_SIZE  2
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
+
 #if !defined(MBEDTLS_CONFIG_FILE)
 #define MBEDTLS_CONFIG_FILE "mbedtls/config.h"
 #endif /* MBEDTLS_CONFIG_FILE */
@@ -67,6 +76,7 @@ extern "C" {
 #define NET_SOCK_DEFAULT_SEND_TO       60000
 #define NET_UDP_MAX_SEND_BLOCK_TO      1024
 #define NET_USE_DEFAULT_INTERFACE      1
+#define NET_POLL_PERIOD                100
 
 #ifdef  ENABLE_NET_DBG_INFO
 #define NET_DBG_INFO(...)  do { \
@@ -93,6 +93,20 @@ net_socketoption_t;
   */
 #define NET_MSG_DONTWAIT      0x08    /* Nonblocking i/o for this operation only */
 
+/* Events used with net_poll */
+#define NET_POLLIN            0x01    /* Data can be received without blocking */
+#define NET_POLLOUT           0x04    /* Data can be sent without blocking */
+#define NET_POLLERR           0x08    /* Error condition, always reported */
+#define NET_POLLHUP           0x10    /* Connection closed, always reported */
+#define NET_POLLNVAL          0x20    /* Invalid socket, always reported */
+
+typedef struct net_pollfd_s
+{
+  int32_t sock;     /**< socket to watch, negative value to ignore the entry */
+  int16_t events;   /**< requested events (NET_POLLIN, NET_POLLOUT) */
+  int16_t revents;  /**< returned events */
+} net_pollfd_t;
+
 typedef struct pbuf net_buf_t;
 
 
@@ -248,6 +262,13 @@ int32_t net_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, socka
 int32_t net_recvfrom(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *from, int32_t *fromlen);
 int32_t net_getsockname(int32_t sock, sockaddr_t *name, int32_t *namelen);
 int32_t net_getpeername(int32_t sock, sockaddr_t *name, int32_t *namelen);
+int32_t net_poll(net_pollfd_t *fds, uint32_t nfds, int32_t timeout);
+
+#ifdef NET_MBEDTLS_HOST_SUPPORT
+/* Drop the parsed TLS credentials and the TLS sessions kept by the library.
+ * To be called when the credentials passed to the sockets are rewritten in place. */
+void net_mbedtls_flush_cache(void);
+#endif /* NET_MBEDTLS_HOST_SUPPORT */
 
 
 extern  const unsigned int net_tls_sizeof_suite_structure;
@@ -53,8 +53,10 @@ void net_unlock_nochk(int32_t idx);
 #define NET_LOCK_SOCKET_ARRAY   NET_MAX_SOCKETS_NBR
 #define NET_LOCK_NETIF_LIST     NET_MAX_SOCKETS_NBR+1
 #define NET_LOCK_STATE_EVENT    NET_MAX_SOCKETS_NBR+2
+#define NET_LOCK_TLS_CACHE      NET_MAX_SOCKETS_NBR+3
+#define NET_LOCK_POLL_EVENT     NET_MAX_SOCKETS_NBR+4
 
-#define NET_LOCK_NUMBER          (NET_LOCK_STATE_EVENT+1)
+#define NET_LOCK_NUMBER          (NET_LOCK_POLL_EVENT+1)
 
 #define  LOCK_SOCK(s)           net_lock((int32_t)s,NET_OS_WAIT_FOREVER)
 #define  UNLOCK_SOCK(s)         net_unlock(s)
@@ -68,6 +70,12 @@ void net_unlock_nochk(int32_t idx);
 #define  WAIT_STATE_CHANGE(to)  net_lock_nochk(NET_LOCK_STATE_EVENT,to )
 #define  SIGNAL_STATE_CHANGE()  net_unlock_nochk(NET_LOCK_STATE_EVENT )
 
+#define  LOCK_TLS_CACHE()       net_lock(NET_LOCK_TLS_CACHE,NET_OS_WAIT_FOREVER )
+#define  UNLOCK_TLS_CACHE()     net_unlock(NET_LOCK_TLS_CACHE )
+
+#define  WAIT_POLL_EVENT(to)    net_lock_nochk(NET_LOCK_POLL_EVENT,to )
+#define  SIGNAL_POLL_EVENT()    net_unlock_nochk(NET_LOCK_POLL_EVENT )
+
 #else
 
 #define  LOCK_SOCK(s)
@@ -78,11 +86,20 @@ void net_unlock_nochk(int32_t idx);
 #define  UNLOCK_NETIF_LIST()
 #define  WAIT_STATE_CHANGE(to)
 #define  SIGNAL_STATE_CHANGE()
+#define  LOCK_TLS_CACHE()
+#define  UNLOCK_TLS_CACHE()
+#define  WAIT_POLL_EVENT(to)
+#define  SIGNAL_POLL_EVENT()
 
 
 
 #endif /* NET_USE_RTOS */
 
+/* Longest sleep of net_poll between two scans, in ms, for drivers which do not call net_poll_notify */
+#ifndef NET_POLL_PERIOD
+#define NET_POLL_PERIOD                100
+#endif /* NET_POLL_PERIOD */
+
 
 
 typedef enum
@@ -140,6 +157,9 @@ struct net_if_drv_s
   int32_t (* getpeername)(int32_t sock, sockaddr_t *name, int32_t *namelen);
   int32_t (* close)(int32_t sock, bool Clone);
   int32_t (* shutdown)(int32_t sock, int32_t mode);
+  /* Return, without blocking, the ready NET_POLLxxx events among the requested ones, NULL if not supported,
+     NET_ERROR_UNSUPPORTED if the state of this socket is not known */
+  int32_t (* poll)(int32_t sock, int32_t events);
 
   /* Service */
   int32_t (* gethostbyname)(net_if_handle_t *, sockaddr_t *addr, char_t *name);
@@ -163,6 +183,7 @@ net_if_handle_t *netif_check(net_if_handle_t *pnetif);
 
 
 bool    net_access_control(net_if_handle_t *pnetif, net_access_t access, int32_t *l);
+void    net_poll_notify(void);
 
 typedef   void (*sock_notify_func)(int32_t, int32_t, const uint8_t *, uint32_t);
 
@@ -172,11 +193,15 @@ typedef int32_t net_ulsock_t;
 typedef enum { SOCKET_NOT_ALIVE = 0, SOCKET_ALLOCATED, SOCKET_CONNECTED  } socket_state_t;
 
 
+/* pnetif, ulsocket, status, generation and the timeouts are single word fields read without the socket
+   lock. generation is incremented each time the slot is released: the data calls check it to detect a
+   close, and a reuse of the slot, during their driver call */
 typedef struct net_socket_s
 {
-  net_if_handle_t  *pnetif;
-  net_ulsock_t     ulsocket;
-  socket_state_t   status;
+  net_if_handle_t  *volatile pnetif;
+  volatile net_ulsock_t   ulsocket;
+  volatile socket_state_t status;
+  volatile uint32_t generation;
   int32_t          domain;
   int32_t          type;
   int32_t          protocol;
@@ -187,8 +212,8 @@ typedef struct net_socket_s
   net_tls_data_t   *tlsData;
   bool             tls_started;
 #endif /* NET_MBEDTLS_HOST_SUPPORT */
-  int32_t          read_timeout;
-  int32_t          write_timeout;
+  volatile int32_t read_timeout;
+  volatile int32_t write_timeout;
   bool             blocking;
   int32_t         idx;
 } net_socket_t;
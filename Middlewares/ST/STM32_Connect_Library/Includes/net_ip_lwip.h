@@ -27,7 +27,7 @@
 
 #define NET_IP_IF_TIMEOUT              1000
 #define NET_IP_INPUT_QUEUE_TIMEOUT     1000
-#define NET_IP_INPUT_QUEUE_SIZE        128
+#define NET_IP_INPUT_QUEUE_SIZE        128  /* received frames per interface, must be a power of 2 */
 #define NET_IP_THREAD_SIZE             1024
 #define NET_IP_HOSTNAME_MAX_LEN        32
 
@@ -42,7 +42,10 @@ struct net_ip_if_s
   void *obj;
   int32_t (*input)(void *context, uint8_t *, uint16_t);
   void (*link_status)(void *context, uint8_t status);
-
+  /* received frames ring: head written by the driver thread, tail by the lwIP input task */
+  volatile uint32_t input_head;
+  volatile uint32_t input_tail;
+  net_buf_t *volatile input_ring[NET_IP_INPUT_QUEUE_SIZE];
 } ;
 
 
@@ -33,6 +33,18 @@
 
 /* Private defines -----------------------------------------------------------*/
 
+/* Number of parsed certificates / keys kept across connections, shared by all sockets */
+#ifndef NET_MBEDTLS_CRED_CACHE_SIZE
+#define NET_MBEDTLS_CRED_CACHE_SIZE     4
+#endif /* NET_MBEDTLS_CRED_CACHE_SIZE */
+
+/* Number of server names for which a TLS session is kept for resumption, 0 to disable */
+#ifndef NET_MBEDTLS_SESSION_CACHE_SIZE
+#define NET_MBEDTLS_SESSION_CACHE_SIZE  2
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
+
+typedef struct net_tls_cred net_tls_cred_t;
+
 struct net_tls_data
 {
   const char_t *tls_ca_certs;  /**< Socket option. */
@@ -47,19 +59,21 @@ struct net_tls_data
   mbedtls_ssl_context ssl;
   mbedtls_ssl_config conf;
   uint32_t flags;
-  mbedtls_x509_crt cacert;
-  mbedtls_x509_crt clicert;
-  mbedtls_pk_context pkey;
+  net_tls_cred_t *cacert;       /**< Shared parsed root CA, from the credential cache. */
+  net_tls_cred_t *clicert;      /**< Shared parsed device certificate, from the credential cache. */
+  net_tls_cred_t *pkey;         /**< Shared parsed device key, from the credential cache. */
   const mbedtls_x509_crt_profile *tls_cert_prof;  /**< Socket option. */
 } ;
 
 void net_tls_init(void);
 void net_tls_destroy(void);
+void net_mbedtls_flush_cache(void);
 
 int32_t net_mbedtls_start(net_socket_t *sockhnd);
 int32_t  net_mbedtls_stop(net_socket_t *sockhnd);
 int32_t net_mbedtls_sock_recv(net_socket_t *sockhnd, uint8_t *buf, size_t len);
 int32_t net_mbedtls_sock_send(net_socket_t *sockhnd, const uint8_t *buf, size_t len);
+bool net_mbedtls_sock_pending(net_socket_t *sockhnd);
 bool net_mbedtls_check_tlsdata(net_socket_t *sockhnd);
 void net_mbedtls_set_read_timeout(net_socket_t *sock);
 
@@ -25,13 +25,34 @@
 #define OPTCHECKTYPE(type,optlen)       if (sizeof(type)!= optlen) {ret = NET_ERROR_PARAMETER; goto END_SETSOCK;}
 #define OPTCHECKSTRING(opt,optlen)       if (strlen(opt)!= (optlen-1U)) { ret = NET_ERROR_PARAMETER;goto END_SETSOCK;}
 
+/* internal net_poll_socket result: the driver can not tell the state of the socket */
+#define NET_POLL_UNKNOWN                 0x4000
+
 
 static int32_t create_low_level_socket(int32_t sock);
 static int32_t check_low_level_socket(int32_t sock);
 static int32_t clone_socket(int32_t sock);
+static void release_socket(int32_t sock);
+static int32_t net_poll_socket(int32_t sock, int32_t events);
+
+uint32_t HAL_GetTick(void);
 
 static net_socket_t sockets[NET_MAX_SOCKETS_NBR] = {0};
 
+/* Socket slot allocator, protected by LOCK_SOCK_ARRAY: slots released by net_closesocket are
+   stacked in socket_free_stack, slots never used yet are taken from socket_unused_idx */
+static int32_t socket_free_stack[NET_MAX_SOCKETS_NBR];
+static int32_t socket_free_top = 0;
+static int32_t socket_unused_idx = 0;
+
+/* Socket as seen by a data call made without the socket lock */
+typedef struct
+{
+  net_if_handle_t *pnetif;
+  int32_t          ulsocket;
+  uint32_t         generation;
+} net_socket_ref_t;
+
 
 static net_socket_t *net_socket_get_and_lock(int32_t sock)
 {
@@ -68,17 +89,20 @@ static bool is_valid_socket(int32_t socketnum)
 static int32_t create_low_level_socket(int32_t sock)
 {
   net_socket_t *pSocket;
+  int32_t ulsocket;
   pSocket = &sockets[sock];
-  if (pSocket->ulsocket == -1)
+  ulsocket = pSocket->ulsocket;
+  if (ulsocket == -1)
   {
-    if (net_access_control(pSocket->pnetif, NET_ACCESS_SOCKET, &pSocket->ulsocket))
+    if (net_access_control(pSocket->pnetif, NET_ACCESS_SOCKET, &ulsocket))
     {
-      pSocket->ulsocket = pSocket->pnetif->pdrv->socket(sockets[sock].domain,
-                                                        sockets[sock].type,
-                                                        sockets[sock].protocol);
+      ulsocket = pSocket->pnetif->pdrv->socket(sockets[sock].domain,
+                                               sockets[sock].type,
+                                               sockets[sock].protocol);
     }
+    pSocket->ulsocket = ulsocket;
   }
-  return pSocket->ulsocket;
+  return ulsocket;
 }
 
 static int32_t check_low_level_socket(int32_t sock)
@@ -98,30 +122,87 @@ static int32_t find_free_socket(void)
 {
   int32_t sidx;
   LOCK_SOCK_ARRAY();
-  for (sidx = 0; sidx < NET_MAX_SOCKETS_NBR; sidx++)
+  if (socket_free_top > 0)
   {
-    if (sockets[sidx].status == SOCKET_NOT_ALIVE)
-    {
-      sockets[sidx].idx = sidx;
-      sockets[sidx].status = SOCKET_ALLOCATED;
-      sockets[sidx].domain   = 0;
-      sockets[sidx].type     = 0;
-      sockets[sidx].protocol = 0;
+    socket_free_top--;
+    sidx = socket_free_stack[socket_free_top];
+  }
+  else if (socket_unused_idx < NET_MAX_SOCKETS_NBR)
+  {
+    sidx = socket_unused_idx;
+    socket_unused_idx++;
+  }
+  else
+  {
+    UNLOCK_SOCK_ARRAY();
+    return NET_ERROR_INVALID_SOCKET;
+  }
+
+  sockets[sidx].idx = sidx;
+  sockets[sidx].pnetif   = NULL;
+  sockets[sidx].domain   = 0;
+  sockets[sidx].type     = 0;
+  sockets[sidx].protocol = 0;
+  sockets[sidx].cloneserver = false;
 #ifdef NET_MBEDTLS_HOST_SUPPORT
-      sockets[sidx].is_secure = false;
-      sockets[sidx].tlsData = 0;
+  sockets[sidx].is_secure = false;
+  sockets[sidx].tls_started = false;
+  sockets[sidx].tlsData = 0;
 #endif /* NET_MBEDTLS_HOST_SUPPORT */
-      sockets[sidx].read_timeout = NET_SOCK_DEFAULT_RECEIVE_TO;
-      sockets[sidx].write_timeout = NET_SOCK_DEFAULT_SEND_TO;
-      sockets[sidx].blocking = true;
-      sockets[sidx].ulsocket = -1;
-      LOCK_SOCK(sidx);
-      UNLOCK_SOCK_ARRAY();
-      return (int32_t) sidx;
-    }
+  sockets[sidx].read_timeout = NET_SOCK_DEFAULT_RECEIVE_TO;
+  sockets[sidx].write_timeout = NET_SOCK_DEFAULT_SEND_TO;
+  sockets[sidx].blocking = true;
+  sockets[sidx].ulsocket = -1;
+  sockets[sidx].status = SOCKET_ALLOCATED;
+  LOCK_SOCK(sidx);
+  UNLOCK_SOCK_ARRAY();
+  return (int32_t) sidx;
+}
+
+/**
+  * @brief  function description
+  * @param  Params
+  * @retval None
+  */
+static void release_socket(int32_t sock)
+{
+  LOCK_SOCK_ARRAY();
+  if (sockets[sock].status != SOCKET_NOT_ALIVE)
+  {
+    sockets[sock].generation++;
+    sockets[sock].status = SOCKET_NOT_ALIVE;
+    socket_free_stack[socket_free_top] = sock;
+    socket_free_top++;
   }
   UNLOCK_SOCK_ARRAY();
-  return NET_ERROR_INVALID_SOCKET;
+}
+
+/**
+  * @brief  Copy the interface and low level socket of a socket for a call made without the socket lock
+  * @param  sock [in] integer socket number
+  * @param  ref [out] interface, low level socket and generation of the slot
+  * @retval false if the socket is closed, or has no low level socket
+  */
+static bool socket_ref_get(int32_t sock, net_socket_ref_t *ref)
+{
+  net_socket_t *pSocket = &sockets[sock];
+
+  ref->generation = pSocket->generation;
+  ref->pnetif = pSocket->pnetif;
+  ref->ulsocket = pSocket->ulsocket;
+  return (pSocket->status != SOCKET_NOT_ALIVE) && (ref->pnetif != NULL) && (ref->ulsocket >= 0) &&
+         (pSocket->generation == ref->generation);
+}
+
+/**
+  * @brief  Check that a socket copied by socket_ref_get has not been closed since, its slot may be reused
+  * @param  sock [in] integer socket number
+  * @param  ref [in] socket copy
+  * @retval true if the slot still holds the same socket
+  */
+static bool socket_ref_valid(int32_t sock, const net_socket_ref_t *ref)
+{
+  return (sockets[sock].status != SOCKET_NOT_ALIVE) && (sockets[sock].generation == ref->generation);
 }
 
 static int32_t   clone_socket(int32_t sock)
@@ -130,7 +211,15 @@ static int32_t   clone_socket(int32_t sock)
   newsock = find_free_socket();
   if (newsock >= 0)
   {
-    (void) memcpy(&sockets[newsock], &sockets[sock], sizeof(net_socket_t));
+    /* TLS context is not inherited, only the attributes of the listening socket */
+    sockets[newsock].pnetif        = sockets[sock].pnetif;
+    sockets[newsock].domain        = sockets[sock].domain;
+    sockets[newsock].type          = sockets[sock].type;
+    sockets[newsock].protocol      = sockets[sock].protocol;
+    sockets[newsock].read_timeout  = sockets[sock].read_timeout;
+    sockets[newsock].write_timeout = sockets[sock].write_timeout;
+    sockets[newsock].blocking      = sockets[sock].blocking;
+    sockets[newsock].status        = sockets[sock].status;
   }
   return newsock;
 }
@@ -448,21 +537,31 @@ int32_t net_send(int32_t sock, uint8_t *buf, uint32_t len, int32_t flags)
       }
       else
       {
-        pSocket = net_socket_get_and_lock(sock);
+        pSocket = &sockets[sock];
 
 #ifdef NET_MBEDTLS_HOST_SUPPORT
         if (pSocket->is_secure)
         {
+          LOCK_SOCK(sock);
           ret = (int32_t) net_mbedtls_sock_send(pSocket,  buf,  len);
+          UNLOCK_SOCK(sock);
         }
         else
 #endif /* NET_MBEDTLS_HOST_SUPPORT */
         {
-          if (net_access_control(pSocket->pnetif, NET_ACCESS_SEND, &ret))
+          /* No socket lock: the socket may be closed, and its slot reused, during the driver call */
+          net_socket_ref_t ref;
+          if (!socket_ref_get(sock, &ref))
           {
-            UNLOCK_SOCK(sock);
-            ret = pSocket->pnetif->pdrv->send(pSocket->ulsocket, buf, len, flags);
-            LOCK_SOCK(sock);
+            ret = NET_ERROR_INVALID_SOCKET;
+          }
+          else if (net_access_control(ref.pnetif, NET_ACCESS_SEND, &ret))
+          {
+            ret = ref.pnetif->pdrv->send(ref.ulsocket, buf, len, flags);
+            if (!socket_ref_valid(sock, &ref))
+            {
+              ret = NET_ERROR_INVALID_SOCKET;
+            }
 
             if ((ret < 0) && (ret != NET_ERROR_CLOSE_SOCKET))
             {
@@ -470,7 +569,6 @@ int32_t net_send(int32_t sock, uint8_t *buf, uint32_t len, int32_t flags)
             }
           }
         }
-        UNLOCK_SOCK(sock);
       }
     }
   }
@@ -510,32 +608,41 @@ int32_t net_recv(int32_t sock, uint8_t *buf, uint32_t len, int32_t flags)
       }
       else
       {
-        pSocket = net_socket_get_and_lock(sock);
+        pSocket = &sockets[sock];
 
 #ifdef NET_MBEDTLS_HOST_SUPPORT
         if (pSocket->is_secure)
         {
+          LOCK_SOCK(sock);
           ret = net_mbedtls_sock_recv(pSocket,  buf,  len);
+          UNLOCK_SOCK(sock);
         }
         else
 #endif /* NET_MBEDTLS_HOST_SUPPORT */
         {
-          if (net_access_control(pSocket->pnetif, NET_ACCESS_RECV, &ret))
+          /* No socket lock, see net_send */
+          net_socket_ref_t ref;
+          if (!socket_ref_get(sock, &ref))
+          {
+            ret = NET_ERROR_INVALID_SOCKET;
+          }
+          else if (net_access_control(ref.pnetif, NET_ACCESS_RECV, &ret))
           {
-            UNLOCK_SOCK(sock);
             if (pSocket->read_timeout == 0)
             {
               flags = NET_MSG_DONTWAIT;
             }
-            ret = pSocket->pnetif->pdrv->recv(pSocket->ulsocket, buf, len, flags);
-            LOCK_SOCK(sock);
+            ret = ref.pnetif->pdrv->recv(ref.ulsocket, buf, len, flags);
+            if (!socket_ref_valid(sock, &ref))
+            {
+              ret = NET_ERROR_INVALID_SOCKET;
+            }
             if ((ret < 0) && (ret != NET_TIMEOUT) && (ret != NET_ERROR_CLOSE_SOCKET))
             {
               NET_DBG_ERROR("Error during receiving data. %ld\n", ret);
             }
           }
         }
-        UNLOCK_SOCK(sock);
       }
     }
   }
@@ -556,7 +663,6 @@ int32_t net_recv(int32_t sock, uint8_t *buf, uint32_t len, int32_t flags)
 int32_t net_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *to, int32_t tolen)
 {
   int32_t ret = NET_ERROR_FRAMEWORK;
-  net_socket_t *pSocket;
 
   if (!is_valid_socket(sock))
   {
@@ -578,18 +684,24 @@ int32_t net_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, socka
       }
       else
       {
-        pSocket = net_socket_get_and_lock(sock);
-        if (net_access_control(pSocket->pnetif, NET_ACCESS_SENDTO, &ret))
+        /* No socket lock, see net_send */
+        net_socket_ref_t ref;
+        if (!socket_ref_get(sock, &ref))
         {
-          UNLOCK_SOCK(sock);
-          ret = pSocket->pnetif->pdrv->sendto(pSocket->ulsocket, buf, len, flags, to, tolen);
-          LOCK_SOCK(sock);
+          ret = NET_ERROR_INVALID_SOCKET;
+        }
+        else if (net_access_control(ref.pnetif, NET_ACCESS_SENDTO, &ret))
+        {
+          ret = ref.pnetif->pdrv->sendto(ref.ulsocket, buf, len, flags, to, tolen);
+          if (!socket_ref_valid(sock, &ref))
+          {
+            ret = NET_ERROR_INVALID_SOCKET;
+          }
           if ((ret < 0) && (ret != NET_ERROR_CLOSE_SOCKET))
           {
             NET_DBG_ERROR("Error during sending data.\n");
           }
         }
-        UNLOCK_SOCK(sock);
       }
     }
   }
@@ -631,22 +743,29 @@ int32_t net_recvfrom(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, soc
       }
       else
       {
-        pSocket = net_socket_get_and_lock(sock);
-        if (net_access_control(pSocket->pnetif, NET_ACCESS_RECVFROM, &ret))
+        /* No socket lock, see net_send */
+        net_socket_ref_t ref;
+        pSocket = &sockets[sock];
+        if (!socket_ref_get(sock, &ref))
+        {
+          ret = NET_ERROR_INVALID_SOCKET;
+        }
+        else if (net_access_control(ref.pnetif, NET_ACCESS_RECVFROM, &ret))
         {
-          UNLOCK_SOCK(sock);
           if (pSocket->read_timeout == 0)
           {
             flags = NET_MSG_DONTWAIT;
           }
-          ret = pSocket->pnetif->pdrv->recvfrom(pSocket->ulsocket, buf, len, flags, from, fromlen);
-          LOCK_SOCK(sock);
+          ret = ref.pnetif->pdrv->recvfrom(ref.ulsocket, buf, len, flags, from, fromlen);
+          if (!socket_ref_valid(sock, &ref))
+          {
+            ret = NET_ERROR_INVALID_SOCKET;
+          }
           if ((ret < 0) && (ret != NET_TIMEOUT) && (ret != NET_ERROR_CLOSE_SOCKET))
           {
             NET_DBG_ERROR("Error during receiving data %ld\n", ret);
           }
         }
-        UNLOCK_SOCK(sock);
       }
     }
   }
@@ -688,8 +807,7 @@ int32_t net_shutdown(int32_t sock, int32_t      mode)
     if (check_low_level_socket(sock) < 0)
     {
       NET_DBG_ERROR("failed to shutdown :low level socket not existing.\n");
-      pSocket = &sockets[sock];
-      pSocket->status = SOCKET_NOT_ALIVE;
+      release_socket(sock);
       ret = NET_OK;
     }
     else
@@ -747,8 +865,7 @@ int32_t net_closesocket(int32_t sock)
     if (check_low_level_socket(sock) < 0)
     {
       NET_DBG_ERROR("failed to close :low level socket not existing.\n");
-      pSocket = &sockets[sock];
-      pSocket->status = SOCKET_NOT_ALIVE;
+      release_socket(sock);
       ret = NET_OK;
     }
     else
@@ -764,7 +881,7 @@ int32_t net_closesocket(int32_t sock)
           NET_DBG_ERROR("Socket cannot be closed.\n");
         }
         pSocket->ulsocket = -1;
-        pSocket->status = SOCKET_NOT_ALIVE;
+        release_socket(sock);
       }
     }
     UNLOCK_SOCK(sock);
@@ -1067,6 +1184,152 @@ END_SETSOCK:
   return ret;
 }
 
+/**
+  * @brief  function description
+  * @param  Params
+  * @retval ready events of one socket, without blocking
+  */
+static int32_t net_poll_socket(int32_t sock, int32_t events)
+{
+  int32_t ret;
+  net_socket_t *pSocket;
+  net_socket_ref_t ref;
+
+  if (!is_valid_socket(sock))
+  {
+    ret = NET_POLLNVAL;
+  }
+  else
+  {
+    pSocket = &sockets[sock];
+    if (!socket_ref_get(sock, &ref))
+    {
+      /* Nothing can happen before the low level socket exists, or the socket has just been closed */
+      ret = is_valid_socket(sock) ? 0 : NET_POLLNVAL;
+    }
+    else if (ref.pnetif->pdrv->poll == NULL)
+    {
+      /* Driver can not tell, net_poll decides when to report the socket ready */
+      ret = NET_POLL_UNKNOWN;
+    }
+    else
+    {
+      ret = ref.pnetif->pdrv->poll(ref.ulsocket, events);
+      if (!socket_ref_valid(sock, &ref))
+      {
+        ret = NET_POLLNVAL;
+      }
+      else if (ret == NET_ERROR_UNSUPPORTED)
+      {
+        ret = NET_POLL_UNKNOWN;
+      }
+      else if (ret < 0)
+      {
+        ret = NET_POLLERR;
+      }
+      else
+      {
+        /* ready events of the socket */
+      }
+    }
+#ifdef NET_MBEDTLS_HOST_SUPPORT
+    if (pSocket->is_secure)
+    {
+      LOCK_SOCK(sock);
+      if (pSocket->tls_started && net_mbedtls_sock_pending(pSocket))
+      {
+        ret |= (events & NET_POLLIN);
+      }
+      UNLOCK_SOCK(sock);
+    }
+#endif /* NET_MBEDTLS_HOST_SUPPORT */
+  }
+  return ret;
+}
+
+/**
+  * @brief  wait until one of a set of sockets is ready for I/O
+  * @param  fds [in,out] array of net_pollfd_t, revents is filled on return
+  * @param  nfds [in] number of entries in fds
+  * @param  timeout [in] maximum time to wait in ms, 0 to only check, negative value to wait forever
+  * @note   drivers which do not call net_poll_notify are checked every NET_POLL_PERIOD ms
+  * @note   a socket whose driver can not tell its state is reported ready for the requested events
+  *         at once when timeout is 0, else after the first wait (NET_POLL_PERIOD ms at most), so that
+  *         the caller finds out with a non blocking call without spinning
+  * @retval number of sockets with a non null revents, 0 on timeout, negative value in case of error
+  */
+int32_t net_poll(net_pollfd_t *fds, uint32_t nfds, int32_t timeout)
+{
+  int32_t ready;
+  uint32_t start;
+  uint32_t elapsed;
+  uint32_t wait;
+  bool waited = false;
+  int32_t revents;
+
+  if ((fds == NULL) && (nfds > 0U))
+  {
+    return NET_ERROR_PARAMETER;
+  }
+
+  start = HAL_GetTick();
+  for (;;)
+  {
+    ready = 0;
+    for (uint32_t i = 0U; i < nfds; i++)
+    {
+      fds[i].revents = 0;
+      if (fds[i].sock >= 0)
+      {
+        revents = net_poll_socket(fds[i].sock, fds[i].events);
+        if (revents & NET_POLL_UNKNOWN)
+        {
+          revents &= ~NET_POLL_UNKNOWN;
+          if ((timeout == 0) || waited)
+          {
+            revents |= (fds[i].events & (NET_POLLIN | NET_POLLOUT));
+          }
+        }
+        fds[i].revents = (int16_t) revents;
+        if (fds[i].revents != 0)
+        {
+          ready++;
+        }
+      }
+    }
+
+    if ((ready > 0) || (timeout == 0))
+    {
+      break;
+    }
+
+    elapsed = HAL_GetTick() - start;
+    if ((timeout > 0) && (elapsed >= (uint32_t) timeout))
+    {
+      break;
+    }
+
+    wait = NET_POLL_PERIOD;
+    if ((timeout > 0) && (((uint32_t) timeout - elapsed) < wait))
+    {
+      wait = (uint32_t) timeout - elapsed;
+    }
+    WAIT_POLL_EVENT(wait);
+    waited = true;
+  }
+  return ready;
+}
+
+/**
+  * @brief  wake up net_poll callers, called by drivers when a socket may have become ready
+  * @param  None
+  * @retval None
+  */
+void net_poll_notify(void)
+{
+  SIGNAL_POLL_EVENT();
+}
+
 /** @defgroup Socket
   * @}
   */
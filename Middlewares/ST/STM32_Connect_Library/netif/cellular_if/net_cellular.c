@@ -62,6 +62,15 @@ typedef struct
   uint8_t  status;
 } cellular_Channel_t;
 
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+/* Application buffer to which net_cellular_recv_cb copies the data lent by com_recv_zc */
+typedef struct
+{
+  uint8_t *buf;
+  int32_t  len;
+} cellular_recv_ctx_t;
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+
 /* Private variables ---------------------------------------------------------*/
 static osThreadId CellIfThreadId = NULL;
 static osMessageQId cellular_queue;
@@ -99,6 +108,9 @@ static int32_t net_cellular_accept(int32_t sock, sockaddr_t *addr, int32_t *addr
 static int32_t net_cellular_connect(int32_t sock, const sockaddr_t *addr, int32_t addrlen);
 static int32_t net_cellular_send(int32_t sock, uint8_t *buf, int32_t len, int32_t flags);
 static int32_t net_cellular_recv(int32_t sock, uint8_t *buf, int32_t len, int32_t flags);
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+static void net_cellular_recv_cb(const com_char_t *data, uint32_t len, void *ctx);
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
 static int32_t net_cellular_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *to,
                                    int32_t tolen);
 static int32_t net_cellular_recvfrom(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *from,
@@ -110,6 +122,7 @@ static int32_t net_cellular_getsockname(int32_t sock, sockaddr_t *name, int32_t
 static int32_t net_cellular_getpeername(int32_t sock, sockaddr_t *name, int32_t *namelen);
 static int32_t net_cellular_close(int32_t sock, bool isaclone);
 static int32_t net_cellular_shutdown(int32_t sock, int32_t mode);
+static int32_t net_cellular_poll(int32_t sock, int32_t events);
 
 /* Service APIs */
 static int32_t net_cellular_if_gethostbyname(net_if_handle_t *pnetif, sockaddr_t *addr, char_t *name);
@@ -163,6 +176,7 @@ static net_if_drv_t   *net_cellular_init_class(void)
     p->getpeername   = net_cellular_getpeername;
     p->close         = net_cellular_close;
     p->shutdown      = net_cellular_shutdown;
+    p->poll          = net_cellular_poll;
 
     /* Service */
     p->gethostbyname = net_cellular_if_gethostbyname;
@@ -227,6 +241,8 @@ static int32_t net_cellular_if_init(net_if_handle_t *pnetif)
   connection_requested = false;
   stop_requested = false;
   cellular_init();
+  /* wake up net_poll on modem data ready and closing URC */
+  com_set_ready_callback(net_poll_notify);
   net_if_notify(pnetif, NET_EVENT_STATE_CHANGE, NET_STATE_INITIALIZED, NULL);
   return  NET_OK;
 }
@@ -699,6 +715,9 @@ static int32_t net_cellular_send(int32_t sock, uint8_t *buf, int32_t len, int32_
 static int32_t net_cellular_recv(int32_t sock, uint8_t *buf, int32_t len, int32_t flags)
 {
   int32_t ret = -1;
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+  cellular_recv_ctx_t ctx;
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
 
   if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
   {
@@ -715,10 +734,21 @@ static int32_t net_cellular_recv(int32_t sock, uint8_t *buf, int32_t len, int32_
     else
     {
       NET_DBG_INFO("com_recv in progress of %ld bytes\n", len);
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+      /* The payload is copied from the AT response straight to buf */
+      ctx.buf = buf;
+      ctx.len = len;
+      ret = com_recv_zc(sock,
+                        len,
+                        (flags & NET_MSG_DONTWAIT) ? COM_MSG_DONTWAIT : COM_MSG_WAIT,
+                        net_cellular_recv_cb,
+                        &ctx);
+#else
       ret = com_recv(sock,
                      buf,
                      len,
                      (flags & NET_MSG_DONTWAIT) ? COM_MSG_DONTWAIT : COM_MSG_WAIT);
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
 
       if (ret > 0)
       {
@@ -730,6 +760,27 @@ static int32_t net_cellular_recv(int32_t sock, uint8_t *buf, int32_t len, int32_
   return ret;
 }
 
+#if (USE_SOCKETS_TYPE == USE_SOCKETS_MODEM)
+/**
+  * @brief  Copy the data lent by com_recv_zc to the application buffer
+  * @note   Called from the cellular service context while net_cellular_recv waits
+  * @param  data [in] received data, only valid until the function returns
+  * @param  len [in] length of the received data
+  * @param  ctx [in] application buffer, cellular_recv_ctx_t
+  * @retval None
+  */
+static void net_cellular_recv_cb(const com_char_t *data, uint32_t len, void *ctx)
+{
+  cellular_recv_ctx_t *recv_ctx = (cellular_recv_ctx_t *) ctx;
+
+  if (len > (uint32_t) recv_ctx->len)
+  {
+    len = (uint32_t) recv_ctx->len;
+  }
+  memcpy(recv_ctx->buf, data, len);
+}
+#endif /* USE_SOCKETS_TYPE == USE_SOCKETS_MODEM */
+
 static int32_t net_cellular_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *to,
                                    int32_t tolen)
 {
@@ -912,6 +963,56 @@ static int32_t net_cellular_shutdown(int32_t sock, int32_t mode)
   return ret;
 }
 
+static int32_t net_cellular_poll(int32_t sock, int32_t events)
+{
+  int32_t ret = 0;
+  int32_t com_events = 0;
+  int32_t com_ret;
+
+  if ((sock < 0) || (sock >= NET_CELLULAR_MAX_CHANNEL_NBR))
+  {
+    NET_DBG_ERROR("invalid socket");
+    ret = NET_ERROR_INVALID_SOCKET;
+  }
+  else
+  {
+    if (((events & NET_POLLIN) != 0) && ((CellularChannel[sock].status & CELLULAR_RECV_OK) != 0U))
+    {
+      com_events |= COM_POLLIN;
+    }
+    if (((events & NET_POLLOUT) != 0) && ((CellularChannel[sock].status & CELLULAR_SEND_OK) != 0U))
+    {
+      com_events |= COM_POLLOUT;
+    }
+
+    com_ret = com_poll(sock, com_events);
+    if (com_ret < 0)
+    {
+      ret = NET_ERROR_INVALID_SOCKET;
+    }
+    else
+    {
+      if ((com_ret & COM_POLLIN) != 0)
+      {
+        ret |= NET_POLLIN;
+      }
+      if ((com_ret & COM_POLLOUT) != 0)
+      {
+        ret |= NET_POLLOUT;
+      }
+      if ((com_ret & COM_POLLERR) != 0)
+      {
+        ret |= NET_POLLERR;
+      }
+      if ((com_ret & COM_POLLHUP) != 0)
+      {
+        ret |= NET_POLLHUP;
+      }
+    }
+  }
+  return ret;
+}
+
 static int32_t net_cellular_if_gethostbyname(net_if_handle_t *pnetif, sockaddr_t *addr, char_t *name)
 {
   int32_t ret = NET_ERROR_DNS_FAILURE;
@@ -23,6 +23,12 @@
 
 #define ESWIFI_MAX_CHANNEL_NBR           4
 
+/* The module has no data ready indication: es_wifi_poll reads up to this number of bytes of a TCP
+   socket with a non blocking receive, and keeps them for the next es_wifi_recv */
+#ifndef ESWIFI_POLL_LOOKAHEAD_SIZE
+#define ESWIFI_POLL_LOOKAHEAD_SIZE       64
+#endif /* ESWIFI_POLL_LOOKAHEAD_SIZE */
+
 #define WIFI_FREE_SOCKET                 0U
 #define WIFI_ALLOCATED_SOCKET            1U
 #define WIFI_BIND_SOCKET                 2U
@@ -62,6 +68,7 @@ static int32_t es_wifi_getsockname(int32_t sock, sockaddr_t *name, int32_t *name
 static int32_t es_wifi_getpeername(int32_t sock, sockaddr_t *name, int32_t *namelen);
 static int32_t es_wifi_close(int32_t sock, bool isaclone);
 static int32_t es_wifi_shutdown(int32_t sock, int32_t mode);
+static int32_t es_wifi_poll(int32_t sock, int32_t events);
 
 static int32_t es_wifi_gethostbyname(net_if_handle_t *pnetif, sockaddr_t *addr, char_t *name);
 static int32_t es_wifi_ping(net_if_handle_t *pnetif, sockaddr_t *addr, int32_t count, int32_t delay,
@@ -98,6 +105,9 @@ typedef struct WIFI_Channel_s
   net_if_notify_func notify_callback;
   void          *notify_context;
   net_if_handle_t  *pnetif;
+  uint8_t  lookahead[ESWIFI_POLL_LOOKAHEAD_SIZE];  /* TCP data read by es_wifi_poll */
+  uint16_t lookahead_pos;
+  uint16_t lookahead_len;
 
 #ifdef NET_MBEDTLS_WIFI_MODULE_SUPPORT
   eswifi_tls_data_t        tlsData;
@@ -150,6 +160,7 @@ int32_t  es_wifi_if_init(net_if_handle_t *pnetif)
     p->getpeername = es_wifi_getpeername;
     p->close = es_wifi_close;
     p->shutdown = es_wifi_shutdown;
+    p->poll = es_wifi_poll;
 
     p->gethostbyname = es_wifi_gethostbyname;
     p->ping = es_wifi_ping;
@@ -351,6 +362,8 @@ static int32_t es_wifi_socket(int32_t domain, int32_t type, int32_t protocol)
         }
         WifiChannel[i].protocol        = protocol;
         WifiChannel[i].type            = type;
+        WifiChannel[i].lookahead_pos   = 0U;
+        WifiChannel[i].lookahead_len   = 0U;
         ret = i;
         break;
       }
@@ -601,6 +614,9 @@ static int32_t es_wifi_close(int32_t sock, bool isaclone)
     return  NET_ERROR_INVALID_SOCKET;
   }
 
+  WifiChannel[sock].lookahead_pos = 0U;
+  WifiChannel[sock].lookahead_len = 0U;
+
   if (WifiChannel [sock].status & WIFI_STARTED_SERVER_SOCKET)
   {
     if (isaclone)
@@ -639,6 +655,64 @@ static int32_t es_wifi_close(int32_t sock, bool isaclone)
 }
 
 
+/**
+  * @brief  Ready events of a socket, without blocking. Data ready to be received is found out with a non
+  *         blocking receive of up to ESWIFI_POLL_LOOKAHEAD_SIZE bytes, kept for es_wifi_recv. A datagram
+  *         can not be read partly: the readiness of the UDP sockets is not known.
+  * @param  sock [in] channel number
+  * @param  events [in] requested NET_POLLIN / NET_POLLOUT events
+  * @retval ready events, NET_ERROR_UNSUPPORTED for a UDP socket, negative value in case of error
+  */
+static int32_t es_wifi_poll(int32_t sock, int32_t events)
+{
+  int32_t ret = 0;
+  uint16_t ReceivedDatalen = 0;
+
+  if ((sock < 0) || (sock >= ESWIFI_MAX_CHANNEL_NBR))
+  {
+    return NET_ERROR_INVALID_SOCKET;
+  }
+
+  if (WifiChannel[sock].protocol != NET_IPPROTO_TCP)
+  {
+    return NET_ERROR_UNSUPPORTED;
+  }
+
+  if ((events & NET_POLLIN) && (WifiChannel[sock].status & WIFI_RECV_OK))
+  {
+    if (WifiChannel[sock].lookahead_pos == WifiChannel[sock].lookahead_len)
+    {
+      WifiChannel[sock].lookahead_pos = 0U;
+      WifiChannel[sock].lookahead_len = 0U;
+      if (NET_OK == ES_WIFI_ReceiveData(WifiChannel[sock].pnetif->pdrv->context,
+                                        sock,
+                                        WifiChannel[sock].lookahead,
+                                        ESWIFI_POLL_LOOKAHEAD_SIZE,
+                                        &ReceivedDatalen,
+                                        0))
+      {
+        WifiChannel[sock].lookahead_len = ReceivedDatalen;
+      }
+      else
+      {
+        ret = NET_ERROR_SOCKET_FAILURE;
+        check_connection_lost(WifiChannel[sock].pnetif, ret);
+      }
+    }
+    if (WifiChannel[sock].lookahead_pos < WifiChannel[sock].lookahead_len)
+    {
+      ret = NET_POLLIN;
+    }
+  }
+
+  /* data is sent synchronously by the module */
+  if ((ret >= 0) && (events & NET_POLLOUT) && (WifiChannel[sock].status & WIFI_SEND_OK))
+  {
+    ret |= NET_POLLOUT;
+  }
+  return ret;
+}
+
 static void check_connection_lost(net_if_handle_t *pnetif, int32_t n)
 {
   if (n <= 0)
@@ -729,6 +803,14 @@ static int32_t es_wifi_recv(int32_t sock, uint8_t *buf, int32_t len, int32_t fla
     return NET_ERROR_SOCKET_FAILURE;
   }
 
+  /* data already read by es_wifi_poll */
+  if (WifiChannel[sock].lookahead_pos < WifiChannel[sock].lookahead_len)
+  {
+    ret = MIN(len, (int32_t)(WifiChannel[sock].lookahead_len - WifiChannel[sock].lookahead_pos));
+    memcpy(buf, &WifiChannel[sock].lookahead[WifiChannel[sock].lookahead_pos], ret);
+    WifiChannel[sock].lookahead_pos += (uint16_t) ret;
+    return ret;
+  }
 
   if (flags == NET_MSG_DONTWAIT)
   {
@@ -160,6 +160,7 @@ int32_t net_ethernetif_output(net_buf_t *netbuf)
   uint16_t        len = 0u;
   int32_t        nb = 0;
   net_buf_t      *q;
+  net_buf_t      *sent = NULL;
 
   /* release returned buffers */
   while (busy_buffer_index != free_buffer_index)
@@ -178,10 +179,26 @@ int32_t net_ethernetif_output(net_buf_t *netbuf)
   if (nb == 1)
   {
     NET_BUF_REF(netbuf);
-    CIRCULAR_INC(write_buffer_index);
-    sent_write_buffer[write_buffer_index] = netbuf;
+    sent = netbuf;
     ret = ethernetif_low_output(netbuf->payload, netbuf->len);
   }
+#if defined(ETHERNETIF_LOW_OUTPUT_SG_MAX)
+  else if (nb <= ETHERNETIF_LOW_OUTPUT_SG_MAX)
+  {
+    /* hand every segment of the chain to the driver, the chain is kept until the frame is sent */
+    ethernetif_low_segment_t segments[ETHERNETIF_LOW_OUTPUT_SG_MAX];
+    nb = 0;
+    for (q = netbuf; q != NULL ; q = q->next)
+    {
+      segments[nb].payload = q->payload;
+      segments[nb].len = q->len;
+      nb++;
+    }
+    NET_BUF_REF(netbuf);
+    sent = netbuf;
+    ret = ethernetif_low_output_sg(segments, (uint8_t) nb);
+  }
+#endif /* ETHERNETIF_LOW_OUTPUT_SG_MAX */
   else
   {
     net_buf_t    *p;
@@ -195,8 +212,7 @@ int32_t net_ethernetif_output(net_buf_t *netbuf)
         pp = &pp[q->len];
       }
       p->len = (uint16_t) len;
-      CIRCULAR_INC(write_buffer_index);
-      sent_write_buffer[write_buffer_index] = p;
+      sent = p;
       ret = ethernetif_low_output(p->payload, p->len);
     }
     else
@@ -204,6 +220,17 @@ int32_t net_ethernetif_output(net_buf_t *netbuf)
       while (true) {};
     }
   }
+
+  /* a frame refused by the driver is never reported as sent: do not wait for it */
+  if (ret == 0)
+  {
+    CIRCULAR_INC(write_buffer_index);
+    sent_write_buffer[write_buffer_index] = sent;
+  }
+  else
+  {
+    (void) NET_BUF_FREE(sent);
+  }
   return ret;
 }
 
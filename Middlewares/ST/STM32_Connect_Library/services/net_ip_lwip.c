@@ -26,19 +26,18 @@
 #include "lwip/dhcp.h"
 #include "lwip/tcpip.h"
 #include "netif/etharp.h"
+#include "netif/ethernet.h"
 
 #define MAX_MTU 1500
 
-typedef struct
-{
-  struct netif *netif;
-  net_buf_t      *p;
-  uint32_t       tin;
-} net_ip_input_queue_item_t;
+#if (NET_IP_INPUT_QUEUE_SIZE & (NET_IP_INPUT_QUEUE_SIZE - 1)) != 0
+#error NET_IP_INPUT_QUEUE_SIZE must be a power of 2
+#endif /* NET_IP_INPUT_QUEUE_SIZE */
+
+#define NET_IP_INPUT_QUEUE_MASK  ((uint32_t) NET_IP_INPUT_QUEUE_SIZE - 1U)
 
 extern struct netif *netif_list;
 
-static osMessageQId net_ip_input_queue_handle = NULL;
 static osSemaphoreId net_ip_input_semaphore_handle = NULL;
 static osSemaphoreId net_ip_if_semaphore_handle = NULL;
 static osThreadId net_ip_input_thread_handle = NULL;
@@ -82,6 +81,7 @@ static int32_t net_lwip_getsockname(int32_t sock, sockaddr_t *name, int32_t *nam
 static int32_t net_lwip_getpeername(int32_t sock, sockaddr_t *name, int32_t *namelen);
 static int32_t net_lwip_close(int32_t sock, bool clone);
 static int32_t net_lwip_shutdown(int32_t sock, int32_t mode);
+static int32_t net_lwip_poll(int32_t sock, int32_t events);
 static int32_t net_lwip_gethostbyname(net_if_handle_t *pnetif, sockaddr_t *addr, char_t *name);
 
 /*************************************************************************************************************/
@@ -132,16 +132,13 @@ static void net_ip_deinit(void)
 static int32_t net_ip_start(void)
 {
   int32_t  ret;
+  /* signals the input task that at least one interface ring holds frames */
   osSemaphoreDef(net_ip_input_semaphore);
   net_ip_input_semaphore_handle = (osSemaphoreId) osSemaphoreCreate(osSemaphore(net_ip_input_semaphore), 1);
 
-  osMessageQDef(net_ip_input_queue, NET_IP_INPUT_QUEUE_SIZE, net_ip_input_queue_item_t *);
-  net_ip_input_queue_handle = osMessageCreate(osMessageQ(net_ip_input_queue), NULL);
-
   osThreadDef(NET_IP_INPUT, net_ip_input_task, osPriorityAboveNormal, 0, NET_IP_THREAD_SIZE);
   net_ip_input_thread_handle = osThreadCreate(osThread(NET_IP_INPUT), NULL);
-  if ((net_ip_input_semaphore_handle == NULL) || (net_ip_input_queue_handle == NULL)
-      || (net_ip_input_thread_handle == NULL))
+  if ((net_ip_input_semaphore_handle == NULL) || (net_ip_input_thread_handle == NULL))
   {
     net_ip_stop();
     ret = NET_ERROR_NO_MEMORY;
@@ -164,12 +161,6 @@ static void net_ip_stop(void)
     net_ip_input_thread_handle = NULL;
   }
 
-  if (net_ip_input_queue_handle != NULL)
-  {
-    (void) osMessageDelete(net_ip_input_queue_handle);
-    net_ip_input_queue_handle = NULL;
-  }
-
   if (net_ip_input_semaphore_handle != NULL)
   {
     (void) osSemaphoreDelete(net_ip_input_semaphore_handle);
@@ -403,59 +394,85 @@ static void net_ip_clear_connect(net_ip_if_t *net_ip_if)
 }
 #endif /* 0 */
 
+/* Drain the received frames of all interfaces. The frames queued since the
+   last wake-up are handed to lwIP in one batch, under a single core lock. */
 static void net_ip_input_task(void const *param)
 {
-  osEvent event;
   struct netif *netif;
-  net_ip_input_queue_item_t *queue_item;
+  net_if_handle_t *pnetif;
+  net_ip_if_t *net_ip_if;
+  net_buf_t *p;
+  uint32_t tail;
 
   while (true)
   {
-    event = osMessageGet(net_ip_input_queue_handle, osWaitForever);
-    if (event.status == osEventMessage)
-    {
-      queue_item = (net_ip_input_queue_item_t *) event.value.p;
-
-      (void) osSemaphoreWait(net_ip_input_semaphore_handle, osWaitForever);
+    (void) osSemaphoreWait(net_ip_input_semaphore_handle, osWaitForever);
 
-      for (netif = netif_list; netif != NULL; netif = netif->next)
+#if LWIP_TCPIP_CORE_LOCKING
+    LOCK_TCPIP_CORE();
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+    for (netif = netif_list; netif != NULL; netif = netif->next)
+    {
+      pnetif = (net_if_handle_t *) netif->state;
+      if ((netif->linkoutput == lwip_output_to_driver) && (pnetif != NULL) && (pnetif->net_ip_if != NULL))
       {
-        if (netif == queue_item->netif)
+        net_ip_if = pnetif->net_ip_if;
+        for (tail = net_ip_if->input_tail; tail != net_ip_if->input_head; tail++)
         {
-          break;
+          p = net_ip_if->input_ring[tail & NET_IP_INPUT_QUEUE_MASK];
+#if LWIP_TCPIP_CORE_LOCKING
+          /* ethernet_input always takes ownership of the buffer */
+          (void) ethernet_input(net_buf2pbuf(&p), netif);
+#else
+          if (netif->input(net_buf2pbuf(&p), netif) != ERR_OK)
+          {
+            (void) pbuf_free(net_buf2pbuf(&p));
+          }
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+          /* release the slot to the producer */
+          net_ip_if->input_tail = tail + 1U;
         }
       }
-
-      if ((netif == NULL) || (netif->input(net_buf2pbuf(&queue_item->p), netif) != ERR_OK))
-      {
-        (void) pbuf_free((struct pbuf *) queue_item->p);
-      }
-
-      (void) osSemaphoreRelease(net_ip_input_semaphore_handle);
-      NET_FREE(queue_item);
     }
+#if LWIP_TCPIP_CORE_LOCKING
+    UNLOCK_TCPIP_CORE();
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+    /* frames have been processed, sockets may have become readable */
+    net_poll_notify();
   }
 }
 
+/* Called by the network interface driver for each received frame. The driver
+   thread is the only producer of its interface ring, so no lock is needed. */
 static int32_t net_ip_queue_input(void *context, net_buf_t *p)
 {
   net_ip_if_t *net_ip_if = ((net_if_handle_t *) context)->net_ip_if;
-  struct netif *netif;
+  uint32_t head;
 
-  /* check netif validity */
-  for (netif = netif_list; netif != NULL; netif = netif->next)
+  if (p == NULL)
   {
-    if (netif == net_ip_if->obj)
-    {
-      break;
-    }
+    return (int32_t) ERR_MEM;
   }
-  if (netif == NULL)
+
+  if (net_ip_if == NULL)
   {
+    (void) pbuf_free(net_buf2pbuf(&p));
     return (int32_t) ERR_IF;
   }
 
-  netif->input((struct pbuf *) p, netif);
+  head = net_ip_if->input_head;
+  if ((head - net_ip_if->input_tail) >= (uint32_t) NET_IP_INPUT_QUEUE_SIZE)
+  {
+    /* ring full: the input task is late, drop the frame */
+    (void) pbuf_free(net_buf2pbuf(&p));
+    return (int32_t) ERR_MEM;
+  }
+
+  net_ip_if->input_ring[head & NET_IP_INPUT_QUEUE_MASK] = p;
+  /* publish the slot only once it is filled */
+  net_ip_if->input_head = head + 1U;
+
+  (void) osSemaphoreRelease(net_ip_input_semaphore_handle);
   return (int32_t) ERR_OK;
 }
 
@@ -555,6 +572,7 @@ static void link_socket_to_lwip(net_if_drv_t *drv)
   drv->getpeername = net_lwip_getpeername;
   drv->close = net_lwip_close;
   drv->shutdown = net_lwip_shutdown;
+  drv->poll = net_lwip_poll;
 
   /* Service */
   drv->gethostbyname = net_lwip_gethostbyname;
@@ -805,6 +823,52 @@ static int32_t net_lwip_shutdown(int32_t sock, int32_t mode)
   return ret;
 }
 
+/**
+  * @brief  Function description
+  * @param  Params
+  * @retval ready events, without blocking
+  */
+static int32_t net_lwip_poll(int32_t sock, int32_t events)
+{
+  int32_t   ret;
+  fd_set    rd_set;
+  fd_set    wr_set;
+  fd_set    ex_set;
+  struct timeval no_wait = {0, 0};
+
+  FD_ZERO(&rd_set);
+  FD_ZERO(&wr_set);
+  FD_ZERO(&ex_set);
+  if ((events & NET_POLLIN) != 0)
+  {
+    FD_SET(sock, &rd_set);
+  }
+  if ((events & NET_POLLOUT) != 0)
+  {
+    FD_SET(sock, &wr_set);
+  }
+  FD_SET(sock, &ex_set);
+
+  ret = lwip_select(sock + 1, &rd_set, &wr_set, &ex_set, &no_wait);
+  if (ret > 0)
+  {
+    ret = 0;
+    if (FD_ISSET(sock, &rd_set) != 0)
+    {
+      ret |= NET_POLLIN;
+    }
+    if (FD_ISSET(sock, &wr_set) != 0)
+    {
+      ret |= NET_POLLOUT;
+    }
+    if (FD_ISSET(sock, &ex_set) != 0)
+    {
+      ret |= NET_POLLERR;
+    }
+  }
+  return ret;
+}
+
 /**
   * @brief  Function description
   * @param  Params
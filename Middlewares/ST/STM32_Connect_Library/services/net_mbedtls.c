@@ -26,9 +26,70 @@ extern struct __RNG_HandleTypeDef hrng;
 
 /* Private defines -----------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  NET_TLS_CRED_CRT,
+  NET_TLS_CRED_KEY
+} net_tls_cred_type_t;
+
+/* A parsed certificate chain or private key, keyed by the address and length of its PEM source.
+ * Entries stay parsed while unreferenced so that a reconnection does not parse again; they are
+ * only released when evicted for another credential or when the cache is flushed.
+ */
+struct net_tls_cred
+{
+  net_tls_cred_type_t type;
+  const char_t *pem;
+  size_t pem_len;
+  const uint8_t *pwd;
+  size_t pwd_len;
+  uint32_t refcount;
+  bool cached;
+  union
+  {
+    mbedtls_x509_crt crt;
+    mbedtls_pk_context pk;
+  } obj;
+};
+
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+/* A session is resumed only by a connection with the same server name, server verification
+ * and credentials as the connection which negotiated it: the resumption skips the certificate checks.
+ */
+typedef struct
+{
+  char_t *srv_name;
+  bool srv_verification;
+  const char_t *ca_certs;       /* Root CA PEM the server was verified against */
+  const char_t *dev_cert;       /* Device certificate PEM presented to the server */
+  mbedtls_ssl_session session;
+} net_tls_session_entry_t;
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
+
 /* Private variables ---------------------------------------------------------*/
+#if (NET_MBEDTLS_CRED_CACHE_SIZE > 0)
+static net_tls_cred_t *net_tls_cred_cache[NET_MBEDTLS_CRED_CACHE_SIZE];
+#endif /* NET_MBEDTLS_CRED_CACHE_SIZE */
+
+/* Empty chain used when no root CA is set, as mbedtls_x509_crt_init() would do */
+static mbedtls_x509_crt net_tls_no_cacert;
+
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+static net_tls_session_entry_t net_tls_session_cache[NET_MBEDTLS_SESSION_CACHE_SIZE];
+static uint32_t net_tls_session_next;
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
+
 /* Private function prototypes -----------------------------------------------*/
 static void mbedtls_free_resource(net_socket_t *sock);
+static void net_tls_cred_free(net_tls_cred_t *cred);
+static int32_t net_tls_cred_get(net_tls_cred_t **cred, net_tls_cred_type_t type, const char_t *pem,
+                                const uint8_t *pwd, size_t pwd_len);
+static void net_tls_cred_release(net_tls_cred_t **cred);
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+static bool net_tls_session_load(net_tls_data_t *tlsData);
+static void net_tls_session_save(net_tls_data_t *tlsData);
+static void net_tls_session_forget(net_tls_data_t *tlsData);
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
 static int  mbedtls_net_recv(void *ctx, unsigned char *buf, size_t len, uint32_t timeout);
 static int  mbedtls_net_send(void *ctx, const unsigned char *buf, size_t len);
 
@@ -80,11 +141,289 @@ void net_tls_init(void)
 
 void net_tls_destroy(void)
 {
+  net_mbedtls_flush_cache();
 #ifdef MBEDTLS_THREADING_ALT
   mbedtls_threading_free_alt();
 #endif /* MBEDTLS_THREADING_ALT */
 }
 
+/* Drop unreferenced parsed credentials and all kept TLS sessions.
+ * To be called when the credential buffers are rewritten (e.g. after provisioning),
+ * since cached credentials are looked up by the address of their PEM source.
+ */
+void net_mbedtls_flush_cache(void)
+{
+  LOCK_TLS_CACHE();
+#if (NET_MBEDTLS_CRED_CACHE_SIZE > 0)
+  for (uint32_t i = 0U; i < (uint32_t) NET_MBEDTLS_CRED_CACHE_SIZE; i++)
+  {
+    net_tls_cred_t *cred = net_tls_cred_cache[i];
+    if (cred != NULL)
+    {
+      net_tls_cred_cache[i] = NULL;
+      if (cred->refcount == 0U)
+      {
+        net_tls_cred_free(cred);
+      }
+      else
+      {
+        /* still used by a socket, freed on its last release */
+        cred->cached = false;
+      }
+    }
+  }
+#endif /* NET_MBEDTLS_CRED_CACHE_SIZE */
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+  for (uint32_t i = 0U; i < (uint32_t) NET_MBEDTLS_SESSION_CACHE_SIZE; i++)
+  {
+    if (net_tls_session_cache[i].srv_name != NULL)
+    {
+      NET_FREE(net_tls_session_cache[i].srv_name);
+      net_tls_session_cache[i].srv_name = NULL;
+      mbedtls_ssl_session_free(&net_tls_session_cache[i].session);
+    }
+  }
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
+  UNLOCK_TLS_CACHE();
+}
+
+static void net_tls_cred_free(net_tls_cred_t *cred)
+{
+  if (cred->type == NET_TLS_CRED_CRT)
+  {
+    mbedtls_x509_crt_free(&cred->obj.crt);
+  }
+  else
+  {
+    mbedtls_pk_free(&cred->obj.pk);
+  }
+  NET_FREE(cred);
+}
+
+/* Get a reference on the parsed form of a PEM certificate or key, parsing it on first use only.
+ * When every cache slot is in use, or without cache (NET_MBEDTLS_CRED_CACHE_SIZE 0), the credential
+ * is parsed for this connection only.
+ */
+static int32_t net_tls_cred_get(net_tls_cred_t **cred, net_tls_cred_type_t type, const char_t *pem,
+                                const uint8_t *pwd, size_t pwd_len)
+{
+  int32_t ret = 0;
+  size_t pem_len = strlen((char const *) pem) + 1U;
+  net_tls_cred_t *entry = NULL;
+#if (NET_MBEDTLS_CRED_CACHE_SIZE > 0)
+  int32_t free_slot = -1;
+  int32_t evict_slot = -1;
+#endif /* NET_MBEDTLS_CRED_CACHE_SIZE */
+
+  LOCK_TLS_CACHE();
+#if (NET_MBEDTLS_CRED_CACHE_SIZE > 0)
+  for (int32_t i = 0; i < (int32_t) NET_MBEDTLS_CRED_CACHE_SIZE; i++)
+  {
+    net_tls_cred_t *c = net_tls_cred_cache[i];
+    if (c == NULL)
+    {
+      if (free_slot < 0)
+      {
+        free_slot = i;
+      }
+    }
+    else if ((c->type == type) && (c->pem == pem) && (c->pem_len == pem_len)
+             && (c->pwd == pwd) && (c->pwd_len == pwd_len))
+    {
+      entry = c;
+      break;
+    }
+    else if ((c->refcount == 0U) && (evict_slot < 0))
+    {
+      evict_slot = i;
+    }
+    else
+    {
+      /* in use by another connection, keep it */
+    }
+  }
+#endif /* NET_MBEDTLS_CRED_CACHE_SIZE */
+
+  if (entry == NULL)
+  {
+    entry = NET_MALLOC(sizeof(net_tls_cred_t));
+    if (entry == NULL)
+    {
+      ret = MBEDTLS_ERR_X509_ALLOC_FAILED;
+    }
+    else
+    {
+      (void) memset(entry, 0, sizeof(net_tls_cred_t));
+      entry->type = type;
+      entry->pem = pem;
+      entry->pem_len = pem_len;
+      entry->pwd = pwd;
+      entry->pwd_len = pwd_len;
+      if (type == NET_TLS_CRED_CRT)
+      {
+        mbedtls_x509_crt_init(&entry->obj.crt);
+        ret = mbedtls_x509_crt_parse(&entry->obj.crt, (unsigned char const *) pem, pem_len);
+      }
+      else
+      {
+        mbedtls_pk_init(&entry->obj.pk);
+        ret = mbedtls_pk_parse_key(&entry->obj.pk, (unsigned char const *) pem, pem_len,
+                                   (unsigned char const *) pwd, pwd_len);
+      }
+
+      if (ret != 0)
+      {
+        net_tls_cred_free(entry);
+        entry = NULL;
+      }
+#if (NET_MBEDTLS_CRED_CACHE_SIZE > 0)
+      else
+      {
+        if (free_slot < 0)
+        {
+          free_slot = evict_slot;
+          if (evict_slot >= 0)
+          {
+            net_tls_cred_free(net_tls_cred_cache[evict_slot]);
+          }
+        }
+        if (free_slot >= 0)
+        {
+          net_tls_cred_cache[free_slot] = entry;
+          entry->cached = true;
+        }
+      }
+#endif /* NET_MBEDTLS_CRED_CACHE_SIZE */
+    }
+  }
+
+  if (entry != NULL)
+  {
+    entry->refcount++;
+  }
+  UNLOCK_TLS_CACHE();
+
+  *cred = entry;
+  return ret;
+}
+
+static void net_tls_cred_release(net_tls_cred_t **cred)
+{
+  net_tls_cred_t *entry = *cred;
+
+  if (entry != NULL)
+  {
+    LOCK_TLS_CACHE();
+    entry->refcount--;
+    if ((entry->refcount == 0U) && (entry->cached == false))
+    {
+      net_tls_cred_free(entry);
+    }
+    UNLOCK_TLS_CACHE();
+    *cred = NULL;
+  }
+}
+
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+static net_tls_session_entry_t *net_tls_session_find(net_tls_data_t *tlsData)
+{
+  net_tls_session_entry_t *entry = NULL;
+
+  for (uint32_t i = 0U; i < (uint32_t) NET_MBEDTLS_SESSION_CACHE_SIZE; i++)
+  {
+    if ((net_tls_session_cache[i].srv_name != NULL)
+        && (net_tls_session_cache[i].srv_verification == tlsData->tls_srv_verification)
+        && (net_tls_session_cache[i].ca_certs == tlsData->tls_ca_certs)
+        && (net_tls_session_cache[i].dev_cert == tlsData->tls_dev_cert)
+        && (strcmp((char const *) net_tls_session_cache[i].srv_name, (char const *) tlsData->tls_srv_name) == 0))
+    {
+      entry = &net_tls_session_cache[i];
+      break;
+    }
+  }
+  return entry;
+}
+
+/* Offer the session kept for this server and credentials, if any, so that the handshake can be abbreviated */
+static bool net_tls_session_load(net_tls_data_t *tlsData)
+{
+  bool ret = false;
+  net_tls_session_entry_t *entry;
+
+  LOCK_TLS_CACHE();
+  entry = net_tls_session_find(tlsData);
+  if ((entry != NULL) && (mbedtls_ssl_set_session(&tlsData->ssl, &entry->session) == 0))
+  {
+    ret = true;
+  }
+  UNLOCK_TLS_CACHE();
+  return ret;
+}
+
+/* Keep the negotiated session (ID and ticket if any) for the next connection to the same server.
+ * Only a session whose server certificate was required and verified is kept.
+ */
+static void net_tls_session_save(net_tls_data_t *tlsData)
+{
+  net_tls_session_entry_t *entry;
+
+  if ((tlsData->tls_srv_verification == false) || (mbedtls_ssl_get_verify_result(&tlsData->ssl) != 0U))
+  {
+    return;
+  }
+
+  LOCK_TLS_CACHE();
+  entry = net_tls_session_find(tlsData);
+  if (entry == NULL)
+  {
+    entry = &net_tls_session_cache[net_tls_session_next];
+    net_tls_session_next = (net_tls_session_next + 1U) % (uint32_t) NET_MBEDTLS_SESSION_CACHE_SIZE;
+    if (entry->srv_name != NULL)
+    {
+      NET_FREE(entry->srv_name);
+      mbedtls_ssl_session_free(&entry->session);
+    }
+    entry->srv_name = NET_MALLOC(strlen((char const *) tlsData->tls_srv_name) + 1U);
+    if (entry->srv_name != NULL)
+    {
+      (void) strcpy((char *) entry->srv_name, (char const *) tlsData->tls_srv_name);
+      entry->srv_verification = tlsData->tls_srv_verification;
+      entry->ca_certs = tlsData->tls_ca_certs;
+      entry->dev_cert = tlsData->tls_dev_cert;
+      mbedtls_ssl_session_init(&entry->session);
+    }
+  }
+  else
+  {
+    mbedtls_ssl_session_free(&entry->session);
+    mbedtls_ssl_session_init(&entry->session);
+  }
+
+  if ((entry->srv_name != NULL) && (mbedtls_ssl_get_session(&tlsData->ssl, &entry->session) != 0))
+  {
+    NET_FREE(entry->srv_name);
+    entry->srv_name = NULL;
+    mbedtls_ssl_session_free(&entry->session);
+  }
+  UNLOCK_TLS_CACHE();
+}
+
+static void net_tls_session_forget(net_tls_data_t *tlsData)
+{
+  net_tls_session_entry_t *entry;
+
+  LOCK_TLS_CACHE();
+  entry = net_tls_session_find(tlsData);
+  if (entry != NULL)
+  {
+    NET_FREE(entry->srv_name);
+    entry->srv_name = NULL;
+    mbedtls_ssl_session_free(&entry->session);
+  }
+  UNLOCK_TLS_CACHE();
+}
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
+
 /* Functions Definition ------------------------------------------------------*/
 bool net_mbedtls_check_tlsdata(net_socket_t *sock)
 {
@@ -138,6 +477,7 @@ void net_mbedtls_set_read_timeout(net_socket_t *sock)
 int32_t net_mbedtls_start(net_socket_t *sock)
 {
   int32_t       ret;
+  bool          resumed = false;
   net_tls_data_t *tlsData = sock->tlsData;
 
   (void)   mbedtls_platform_set_calloc_free(NET_CALLOC, NET_FREE);
@@ -146,21 +486,11 @@ int32_t net_mbedtls_start(net_socket_t *sock)
   mbedtls_ssl_conf_dbg(&tlsData->conf, DebugPrint, NULL);
 
   mbedtls_debug_set_threshold(NET_MBEDTLS_DEBUG_LEVEL);
-  mbedtls_x509_crt_init(&tlsData->cacert);
-  if (tlsData->tls_dev_cert != NULL)
-  {
-    mbedtls_x509_crt_init(&tlsData->clicert);
-  }
-  if (tlsData->tls_dev_key != NULL)
-  {
-    mbedtls_pk_init(&tlsData->pkey);
-  }
 
-  /* Root CA */
+  /* Root CA, parsed once and shared by all connections */
   if (tlsData->tls_ca_certs != NULL)
   {
-    if ((ret = mbedtls_x509_crt_parse(&tlsData->cacert, (unsigned char const *)tlsData->tls_ca_certs,
-                                      strlen((char const *) tlsData->tls_ca_certs) + 1U)) != 0)
+    if ((ret = net_tls_cred_get(&tlsData->cacert, NET_TLS_CRED_CRT, tlsData->tls_ca_certs, NULL, 0U)) != 0)
     {
       NET_DBG_ERROR(" failed\n  !  mbedtls_x509_crt_parse returned -0x%lx while parsing root cert\n", -ret);
       mbedtls_free_resource(sock);
@@ -177,17 +507,15 @@ int32_t net_mbedtls_start(net_socket_t *sock)
   /* Client cert. and key */
   if ((tlsData->tls_dev_cert != NULL) && (tlsData->tls_dev_key != NULL))
   {
-    if ((ret = mbedtls_x509_crt_parse(&tlsData->clicert, (unsigned char const *)tlsData->tls_dev_cert,
-                                      strlen((char const *)tlsData->tls_dev_cert) + 1U)) != 0)
+    if ((ret = net_tls_cred_get(&tlsData->clicert, NET_TLS_CRED_CRT, tlsData->tls_dev_cert, NULL, 0U)) != 0)
     {
       NET_DBG_ERROR(" failed\n  !  mbedtls_x509_crt_parse returned -0x%lx while parsing device cert\n", -ret);
       mbedtls_free_resource(sock);
       return NET_ERROR_MBEDTLS_CRT_PARSE;
     }
 
-    if ((ret = mbedtls_pk_parse_key(&tlsData->pkey, (unsigned char const *)tlsData->tls_dev_key,
-                                    strlen((char const *)tlsData->tls_dev_key) + 1U,
-                                    (unsigned char const *)tlsData->tls_dev_pwd, tlsData->tls_dev_pwd_len)) != 0)
+    if ((ret = net_tls_cred_get(&tlsData->pkey, NET_TLS_CRED_KEY, tlsData->tls_dev_key,
+                                tlsData->tls_dev_pwd, tlsData->tls_dev_pwd_len)) != 0)
     {
       NET_DBG_ERROR(" failed\n  !  mbedtls_pk_parse_key returned -0x%lx while parsing private key\n\n", -ret);
       mbedtls_free_resource(sock);
@@ -229,11 +557,18 @@ int32_t net_mbedtls_start(net_socket_t *sock)
   }
   */
   mbedtls_ssl_conf_rng(&tlsData->conf, mbedtls_rng_raw, &hrng);
-  mbedtls_ssl_conf_ca_chain(&tlsData->conf, &tlsData->cacert, NULL);
+  if (tlsData->cacert != NULL)
+  {
+    mbedtls_ssl_conf_ca_chain(&tlsData->conf, &tlsData->cacert->obj.crt, NULL);
+  }
+  else
+  {
+    mbedtls_ssl_conf_ca_chain(&tlsData->conf, &net_tls_no_cacert, NULL);
+  }
 
   if ((tlsData->tls_dev_cert != NULL) && (tlsData->tls_dev_key != NULL))
   {
-    if ((ret = mbedtls_ssl_conf_own_cert(&tlsData->conf, &tlsData->clicert, &tlsData->pkey)) != 0)
+    if ((ret = mbedtls_ssl_conf_own_cert(&tlsData->conf, &tlsData->clicert->obj.crt, &tlsData->pkey->obj.pk)) != 0)
     {
       NET_DBG_ERROR(" failed\n  ! mbedtls_ssl_conf_own_cert returned -0x%lx\n\n", -ret);
       mbedtls_free_resource(sock);
@@ -255,6 +590,10 @@ int32_t net_mbedtls_start(net_socket_t *sock)
       mbedtls_free_resource(sock);
       return NET_ERROR_MBEDTLS_SET_HOSTNAME;
     }
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+    /* Offer the session of a previous connection to this server: the server may then skip the key exchange */
+    resumed = net_tls_session_load(tlsData);
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
   }
 
   mbedtls_ssl_set_bio(&tlsData->ssl, (void *) sock, mbedtls_net_send, NULL, mbedtls_net_recv);
@@ -286,6 +625,12 @@ int32_t net_mbedtls_start(net_socket_t *sock)
       }
       NET_DBG_ERROR(" failed\n  ! mbedtls_ssl_handshake returned -0x%lx\n", -ret);
 
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+      if (resumed == true)
+      {
+        net_tls_session_forget(tlsData);
+      }
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
       mbedtls_free_resource(sock);
       return (ret == MBEDTLS_ERR_X509_CERT_VERIFY_FAILED) ? NET_ERROR_MBEDTLS_REMOTE_AUTH : NET_ERROR_MBEDTLS_CONNECT;
     }
@@ -295,6 +640,16 @@ int32_t net_mbedtls_start(net_socket_t *sock)
                mbedtls_ssl_get_version(&sock->tlsData->ssl),
                mbedtls_ssl_get_ciphersuite(&sock->tlsData->ssl));
 
+#if (NET_MBEDTLS_SESSION_CACHE_SIZE > 0)
+  if (tlsData->tls_srv_name != NULL)
+  {
+    NET_DBG_INFO("    [ Session %s ]\n", (resumed == true) ? "offered for resumption" : "not resumed");
+    net_tls_session_save(tlsData);
+  }
+#else
+  (void) resumed;
+#endif /* NET_MBEDTLS_SESSION_CACHE_SIZE */
+
   if ((ret = mbedtls_ssl_get_record_expansion(&tlsData->ssl)) >= 0)
   {
     NET_DBG_INFO("    [ Record expansion is %d ]\n", ret);
@@ -364,6 +719,15 @@ int32_t net_mbedtls_sock_recv(net_socket_t *sock, uint8_t *buf, size_t len)
 }
 
 
+/* Data already decrypted by mbedTLS are not visible to the driver, report them for net_poll */
+bool net_mbedtls_sock_pending(net_socket_t *sock)
+{
+  net_tls_data_t *tlsData = sock->tlsData;
+
+  return (mbedtls_ssl_get_bytes_avail(&tlsData->ssl) > 0U);
+}
+
+
 int32_t net_mbedtls_sock_send(net_socket_t *sock, const uint8_t *buf, size_t len)
 {
   int32_t ret;
@@ -410,9 +774,9 @@ static void mbedtls_free_resource(net_socket_t *sock)
 {
   net_tls_data_t *tlsData = sock->tlsData;
 
-  mbedtls_x509_crt_free(&tlsData->clicert);
-  mbedtls_pk_free(&tlsData->pkey);
-  mbedtls_x509_crt_free(&tlsData->cacert);
+  net_tls_cred_release(&tlsData->clicert);
+  net_tls_cred_release(&tlsData->pkey);
+  net_tls_cred_release(&tlsData->cacert);
   mbedtls_ssl_free(&tlsData->ssl);
   mbedtls_ssl_config_free(&tlsData->conf);
   NET_FREE(tlsData);
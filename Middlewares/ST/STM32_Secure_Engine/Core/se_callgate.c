@@ -79,6 +79,7 @@ typedef enum
                               ((ID) == SE_CRYPTO_LL_ENCRYPT_APPEND_ID) || \
                               ((ID) == SE_CRYPTO_LL_ENCRYPT_FINISH_ID) || \
                               ((ID) == SE_CRYPTO_HL_AUTHENTICATE_METADATA) || \
+                              ((ID) == SE_CRYPTO_HL_VERIFY_FW_TAG) || \
                               ((ID) == SE_CRYPTO_LL_DECRYPT_INIT_ID) || \
                               ((ID) == SE_CRYPTO_LL_DECRYPT_APPEND_ID) || \
                               ((ID) == SE_CRYPTO_LL_DECRYPT_FINISH_ID) || \
@@ -742,6 +743,52 @@ SE_ErrorStatus SE_CallGateService(SE_FunctionIDTypeDef eID, SE_StatusTypeDef *pe
       break;
     }
 
+    case SE_CRYPTO_HL_VERIFY_FW_TAG:
+    {
+      /*
+       * The whole Firmware image is verified in a single call: the FW image is read directly from the FLASH
+       * (no copy in the bootloader RAM) and the call gate is crossed only once.
+       */
+      SE_FwRawHeaderTypeDef *p_x_se_Metadata;
+      SE_FwAreaTypeDef      *p_x_se_FwArea;
+      uint32_t              flags;
+
+      p_x_se_Metadata = va_arg(arguments, SE_FwRawHeaderTypeDef *);
+      p_x_se_FwArea = va_arg(arguments, SE_FwAreaTypeDef *);
+      flags = va_arg(arguments, uint32_t);
+
+      /* CRC configuration may have been changed by application */
+      if (SE_LL_CRC_Config() == SE_ERROR)
+      {
+        e_ret_status = SE_ERROR;
+        break;
+      }
+
+      /* Check the metadata and FW image location structures allocation */
+      if (SE_BufferCheck_SBSFU(p_x_se_Metadata, sizeof(*p_x_se_Metadata)) == SE_ERROR)
+      {
+        e_ret_status = SE_ERROR;
+        break;
+      }
+      if (SE_BufferCheck_SBSFU(p_x_se_FwArea, sizeof(*p_x_se_FwArea)) == SE_ERROR)
+      {
+        e_ret_status = SE_ERROR;
+        break;
+      }
+
+      if (SE_LockRestrictedServices != SE_LOCKED)
+      {
+        /* The FW image areas are checked against the FW slots by SE_IMG_VerifyFwTag */
+        e_ret_status = SE_IMG_VerifyFwTag(peSE_Status, p_x_se_Metadata, p_x_se_FwArea, flags);
+      }
+      else
+      {
+        /* This function can be called only by the bootloader */
+        e_ret_status = SE_ERROR;
+      }
+      break;
+    }
+
     case SE_BOOT_INFO_READ_ALL_ID:
     {
       SE_BootInfoTypeDef    *p_boot_info;
@@ -67,6 +67,7 @@ typedef enum
 
   /* CRYPTO High level functions for bootloader only */
   SE_CRYPTO_HL_AUTHENTICATE_METADATA = 0x10U,       /*!< CRYPTO High level Authenticate Metadata */
+  SE_CRYPTO_HL_VERIFY_FW_TAG         = 0x11U,       /*!< CRYPTO High level Firmware Tag verification */
 
   /* Next ranges are kept for future use (additional crypto schemes, additional user code) */
   SE_APP_GET_ACTIVE_FW_INFO = 0x20U,                     /*!< User Application retrieves the Active Firmware Info */
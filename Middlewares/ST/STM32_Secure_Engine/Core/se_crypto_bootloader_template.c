@@ -136,6 +136,12 @@ SE_ErrorStatus SE_CRYPTO_AuthenticateFW_Finish(uint8_t *pOutputBuffer, int32_t *
   /* use the common cypto code from se_crypto_common.c when possible */
 }
 
+SE_ErrorStatus SE_CRYPTO_MAC_Compute(const uint8_t *pInputBuffer, int32_t InputSize, uint8_t *pOutputBuffer,
+                                     int32_t *pOutputSize)
+{
+  /* MAC under a secret key of the Secure Engine, SE_ERROR if the crypto scheme has no secret key */
+}
+
 
 /**
   * @}
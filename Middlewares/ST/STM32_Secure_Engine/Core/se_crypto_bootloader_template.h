@@ -47,6 +47,15 @@ extern "C" {
   * @{
   */
 
+/** @defgroup SE_CRYPTO_BOOTLOADER_Exported_Constants Exported Constants
+  * @{
+  */
+#define SE_CRYPTO_MAC_LEN       ((int32_t) 16)  /*!< Length of the MAC computed by SE_CRYPTO_MAC_Compute (bytes) */
+
+/**
+  * @}
+  */
+
 /** @addtogroup SE_CRYPTO_BOOTLOADER_Exported_Functions
   * @{
   */
@@ -64,6 +73,8 @@ SE_ErrorStatus SE_CRYPTO_AuthenticateFW_Append(const uint8_t *pInputBuffer, int3
 SE_ErrorStatus SE_CRYPTO_AuthenticateFW_Finish(uint8_t *pOutputBuffer, int32_t *pOutputSize);
 /*High level functions*/
 SE_ErrorStatus SE_CRYPTO_Authenticate_Metadata(SE_FwRawHeaderTypeDef *pxSE_Metadata);
+SE_ErrorStatus SE_CRYPTO_MAC_Compute(const uint8_t *pInputBuffer, int32_t InputSize, uint8_t *pOutputBuffer,
+                                     int32_t *pOutputSize);
 
 /**
   * @}
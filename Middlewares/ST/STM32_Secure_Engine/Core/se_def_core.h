@@ -71,6 +71,34 @@ typedef enum
   SE_ERR_FLASH_READ                                  /*!< An error occurred trying to read the Flash */
 } SE_StatusTypeDef;
 
+/**
+  * @brief  Firmware Tag verification flags (see SE_VerifyFwTag)
+  */
+#define SE_VERIFY_FW_FULL     (0x00000000U)  /*!< Always compute the Firmware Tag, forget the recorded Firmware */
+#define SE_VERIFY_FW_RECORD   (0x00000001U)  /*!< Skip the Firmware Tag computation if the Firmware is unchanged since its
+                                                  last recorded successful verification, record the Firmware once
+                                                  verified */
+#define SE_VERIFY_FW_FORCE    (0x00000002U)  /*!< With SE_VERIFY_FW_RECORD: ignore the current record, compute the
+                                                  Firmware Tag and record the Firmware once verified */
+
+/**
+  * @}
+  */
+
+/** @defgroup SE_DEF_CORE_Exported_Types Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Firmware image location.
+  *         A Firmware is stored in 1 contiguous area, or split in 2 areas (AreaSize[1] is 0 when not used).
+  */
+typedef struct
+{
+  const uint8_t *pArea[2];                           /*!< Start address of each area in Flash */
+  uint32_t AreaSize[2];                              /*!< Size of each area (bytes) */
+} SE_FwAreaTypeDef;
+
 /**
   * @}
   */
@@ -86,6 +86,9 @@ typedef struct
   uint32_t FwSize;                 /*!< Firmware size (bytes)*/
   /* If you want to support Firmware Authentication then the field below is also required */
   /* uint8_t  FwTag[SE_TAG_LEN]; */     /*!< Firmware Tag*/
+  /* If you want to support delta or compressed images (SFU_FWIMG_DELTA_UPDATE or SFU_FWIMG_COMPRESSED_UPDATE in SB_SFU)
+     then the field below is also required */
+  /* uint32_t PatchSize; */           /*!< Size of the payload (bytes) for a delta or compressed image, 0 for a full image */
   /* If you want to authenticate the Firmware metadata the the field below is also required */
   /* uint8_t  HeaderMAC[SE_TAG_LEN]; */  /*!< MAC of the full header message */
 } SE_FwRawHeaderTypeDef;
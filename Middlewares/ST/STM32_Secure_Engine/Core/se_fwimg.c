@@ -21,9 +21,11 @@
 /* Includes ------------------------------------------------------------------*/
 #include "se_def.h"
 #include "se_fwimg.h"
+#include "se_crypto_bootloader.h"
 #include "se_low_level.h"
 #include "se_exception.h"
 #include "string.h"
+#include "stddef.h"
 
 /** @addtogroup SE Secure Firmware Update
   * @{
@@ -39,6 +41,254 @@
   * @{
   */
 
+/** @defgroup SE_IMG_Private_Defines Private Defines
+  * @{
+  */
+
+/**
+  * @brief Size of the Firmware chunks re-encrypted by @ref SE_IMG_VerifyFwTag to compute an AES-GCM tag.
+  *        A SHA-256 digest is computed on each Firmware area in one go.
+  */
+#ifndef SE_IMG_VERIFY_CHUNK_SIZE
+#define SE_IMG_VERIFY_CHUNK_SIZE 256U
+#endif /* SE_IMG_VERIFY_CHUNK_SIZE */
+
+/**
+  * @}
+  */
+
+/** @defgroup SE_IMG_Private_Types Private Types
+  * @{
+  */
+
+/**
+  * @brief  Record of the last Firmware successfully verified by @ref SE_IMG_VerifyFwTag.
+  * @note   The MAC field must be kept as the last field of the structure.
+  */
+typedef struct
+{
+  uint32_t FwVersion;                   /*!< Version of the verified Firmware */
+  uint32_t FwSize;                      /*!< Size of the verified Firmware (bytes) */
+  uint8_t  FwTag[SE_TAG_LEN];           /*!< Tag of the verified Firmware */
+  uint32_t AreaBegin[2];                /*!< Location of the verified Firmware image */
+  uint32_t AreaSize[2];                 /*!< Size of each area of the verified Firmware image (bytes) */
+  uint32_t FwCRC;                       /*!< CRC of the verified Firmware image */
+  uint8_t  MAC[SE_CRYPTO_MAC_LEN];      /*!< MAC of the record, see SE_CRYPTO_MAC_Compute */
+} SE_IMG_VerifiedFwTypeDef;
+
+/**
+  * @}
+  */
+
+/** @defgroup SE_IMG_Private_Variables Private Variables
+  * @brief WARNING: the record is not initialized: it is kept in the same protected RAM section as the BootInfo so
+  *        that it survives the resets. It is only trusted if its MAC, computed with a secret key of the Secure
+  *        Engine, is correct: after a power-on it is not.
+  * @{
+  */
+
+/* placing data in a specific section named BOOTINFO_DATA */
+#if defined(__ICCARM__)
+#pragma default_variable_attributes = @ "BOOTINFO_DATA"
+static SE_IMG_VerifiedFwTypeDef xVerifiedFw;    /*!< Last Firmware successfully verified */
+#pragma default_variable_attributes =
+#else
+__attribute__((section("BOOTINFO_DATA")))
+static SE_IMG_VerifiedFwTypeDef xVerifiedFw;    /*!< Last Firmware successfully verified */
+#endif
+/* Stop placing data in a specific section named BOOTINFO_DATA */
+
+#if (SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM)
+static uint8_t aVerifyChunk[SE_IMG_VERIFY_CHUNK_SIZE];  /*!< Re-encrypted Firmware chunk (not used afterwards) */
+#endif /* SECBOOT_CRYPTO_SCHEME */
+
+/**
+  * @}
+  */
+
+/** @defgroup SE_IMG_Private_Functions Private Functions
+  * @{
+  */
+
+/**
+  * @brief  Check that a Firmware area is located inside a Firmware slot (or the swap area).
+  *         The header of slot #0, placed in the protected area, is excluded.
+  * @param  pArea start address of the area
+  * @param  AreaSize size of the area (bytes)
+  * @retval SE_SUCCESS if the area can be read, SE_ERROR otherwise
+  */
+static SE_ErrorStatus SE_IMG_CheckFwArea(const uint8_t *pArea, uint32_t AreaSize)
+{
+  uint32_t areabegin = (uint32_t)pArea;
+
+  if ((AreaSize == 0U) || ((areabegin & 3U) != 0U))
+  {
+    return SE_ERROR;
+  }
+
+  if ((areabegin >= (SFU_IMG_SLOT_0_REGION_BEGIN_VALUE + SFU_IMG_IMAGE_OFFSET)) &&
+      (areabegin < (SFU_IMG_SLOT_0_REGION_BEGIN_VALUE + SFU_IMG_SLOT_0_REGION_SIZE)) &&
+      (AreaSize <= (SFU_IMG_SLOT_0_REGION_BEGIN_VALUE + SFU_IMG_SLOT_0_REGION_SIZE - areabegin)))
+  {
+    return SE_SUCCESS;
+  }
+  if ((areabegin >= SFU_IMG_SLOT_1_REGION_BEGIN_VALUE) &&
+      (areabegin < (SFU_IMG_SLOT_1_REGION_BEGIN_VALUE + SFU_IMG_SLOT_1_REGION_SIZE)) &&
+      (AreaSize <= (SFU_IMG_SLOT_1_REGION_BEGIN_VALUE + SFU_IMG_SLOT_1_REGION_SIZE - areabegin)))
+  {
+    return SE_SUCCESS;
+  }
+  if ((areabegin >= SFU_IMG_SWAP_REGION_BEGIN_VALUE) &&
+      (areabegin < (SFU_IMG_SWAP_REGION_BEGIN_VALUE + SFU_IMG_SWAP_REGION_SIZE)) &&
+      (AreaSize <= (SFU_IMG_SWAP_REGION_BEGIN_VALUE + SFU_IMG_SWAP_REGION_SIZE - areabegin)))
+  {
+    return SE_SUCCESS;
+  }
+
+  /* Abnormal case: this primitive should not be used to access this address */
+  return SE_ERROR;
+}
+
+/**
+  * @brief  Compute the CRC of a Firmware image with the CRC peripheral.
+  *         The trailing bytes of each area, if any, are padded with 0 up to a 32-bit word.
+  * @param  pxFwArea Firmware image location (already checked)
+  * @retval uint32_t CRC of the Firmware image
+  */
+static uint32_t SE_IMG_ComputeFwCRC(const SE_FwAreaTypeDef *pxFwArea)
+{
+  uint32_t crc = 0U;
+  uint32_t crc_started = 0U;
+  uint32_t nb_words;
+  uint32_t nb_bytes;
+  uint32_t last_word;
+  uint32_t j;
+
+  for (j = 0U; j < 2U; j++)
+  {
+    nb_words = pxFwArea->AreaSize[j] / sizeof(uint32_t);
+    nb_bytes = pxFwArea->AreaSize[j] % sizeof(uint32_t);
+    if (nb_words != 0U)
+    {
+      crc = (crc_started == 0U) ? SE_LL_CRC_Calculate((uint32_t *)(uint32_t)pxFwArea->pArea[j], nb_words)
+            : SE_LL_CRC_Accumulate((uint32_t *)(uint32_t)pxFwArea->pArea[j], nb_words);
+      crc_started = 1U;
+    }
+    if (nb_bytes != 0U)
+    {
+      last_word = 0U;
+      (void)memcpy(&last_word, pxFwArea->pArea[j] + (nb_words * sizeof(uint32_t)), nb_bytes);
+      crc = (crc_started == 0U) ? SE_LL_CRC_Calculate(&last_word, 1U) : SE_LL_CRC_Accumulate(&last_word, 1U);
+      crc_started = 1U;
+    }
+  }
+  return crc;
+}
+
+/**
+  * @brief  Compute the Tag of a Firmware image read directly from the FLASH.
+  * @param  pxSE_Metadata Firmware metadata
+  * @param  pxFwArea Firmware image location (already checked)
+  * @param  pTag output buffer for the computed tag (SE_TAG_LEN bytes)
+  * @retval SE_SUCCESS if successful, SE_ERROR otherwise
+  */
+static SE_ErrorStatus SE_IMG_ComputeFwTag(SE_FwRawHeaderTypeDef *pxSE_Metadata, const SE_FwAreaTypeDef *pxFwArea,
+                                          uint8_t *pTag)
+{
+  SE_ErrorStatus e_ret_status;
+  int32_t tag_len = SE_TAG_LEN;
+  int32_t chunk_size;
+  uint32_t offset;
+  uint32_t j;
+#if (SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM)
+  uint8_t *p_chunk = aVerifyChunk;
+  const uint32_t max_chunk_size = SE_IMG_VERIFY_CHUNK_SIZE;
+#else
+  /* The hash procedure produces no output: each area is hashed in one go */
+  uint8_t *p_chunk = NULL;
+  const uint32_t max_chunk_size = 0xFFFFFFFFU;
+#endif /* SECBOOT_CRYPTO_SCHEME */
+
+  e_ret_status = SE_CRYPTO_AuthenticateFW_Init(pxSE_Metadata);
+
+  for (j = 0U; (j < 2U) && (e_ret_status == SE_SUCCESS); j++)
+  {
+    offset = 0U;
+    while ((offset < pxFwArea->AreaSize[j]) && (e_ret_status == SE_SUCCESS))
+    {
+      chunk_size = (int32_t)(((pxFwArea->AreaSize[j] - offset) < max_chunk_size) ?
+                             (pxFwArea->AreaSize[j] - offset) : max_chunk_size);
+      offset += (uint32_t)chunk_size;
+      e_ret_status = SE_CRYPTO_AuthenticateFW_Append(pxFwArea->pArea[j] + offset - (uint32_t)chunk_size, chunk_size,
+                                                     p_chunk, &chunk_size);
+    }
+  }
+
+  if (e_ret_status == SE_SUCCESS)
+  {
+    e_ret_status = SE_CRYPTO_AuthenticateFW_Finish(pTag, &tag_len);
+    if ((e_ret_status == SE_SUCCESS) && (tag_len != SE_TAG_LEN))
+    {
+      e_ret_status = SE_ERROR;
+    }
+  }
+#if (SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM)
+  (void)memset(aVerifyChunk, 0x00, sizeof(aVerifyChunk));
+#endif /* SECBOOT_CRYPTO_SCHEME */
+  return e_ret_status;
+}
+
+/**
+  * @brief  Compute the MAC of the record of the last verified Firmware.
+  * @param  pMAC output buffer for the MAC (SE_CRYPTO_MAC_LEN bytes)
+  * @retval SE_SUCCESS if successful, SE_ERROR otherwise (no secret key in the crypto scheme)
+  */
+static SE_ErrorStatus SE_IMG_VerifiedFwMAC(uint8_t *pMAC)
+{
+  int32_t mac_len = 0;
+
+  /* The MAC is computed with the structure without its MAC field */
+  if ((SE_CRYPTO_MAC_Compute((const uint8_t *)&xVerifiedFw, (int32_t)offsetof(SE_IMG_VerifiedFwTypeDef, MAC), pMAC,
+                             &mac_len) != SE_SUCCESS) || (mac_len != SE_CRYPTO_MAC_LEN))
+  {
+    return SE_ERROR;
+  }
+  return SE_SUCCESS;
+}
+
+/**
+  * @brief  Check the record of the last verified Firmware against a Firmware image.
+  * @param  pxSE_Metadata Firmware metadata
+  * @param  pxFwArea Firmware image location (already checked)
+  * @param  FwCRC CRC of the Firmware image
+  * @retval SE_SUCCESS if the record is authentic and describes the same Firmware image, SE_ERROR otherwise
+  */
+static SE_ErrorStatus SE_IMG_CheckVerifiedFw(const SE_FwRawHeaderTypeDef *pxSE_Metadata,
+                                             const SE_FwAreaTypeDef *pxFwArea, uint32_t FwCRC)
+{
+  SE_ErrorStatus e_ret_status = SE_ERROR;
+  uint8_t mac[SE_CRYPTO_MAC_LEN];
+
+  if ((xVerifiedFw.FwVersion == (uint32_t)pxSE_Metadata->FwVersion) &&
+      (xVerifiedFw.FwSize == pxSE_Metadata->FwSize) &&
+      (xVerifiedFw.AreaBegin[0] == (uint32_t)pxFwArea->pArea[0]) &&
+      (xVerifiedFw.AreaBegin[1] == (uint32_t)pxFwArea->pArea[1]) &&
+      (xVerifiedFw.AreaSize[0] == pxFwArea->AreaSize[0]) &&
+      (xVerifiedFw.AreaSize[1] == pxFwArea->AreaSize[1]) &&
+      (xVerifiedFw.FwCRC == FwCRC) &&
+      (memcmp(xVerifiedFw.FwTag, pxSE_Metadata->FwTag, SE_TAG_LEN) == 0) &&
+      (SE_IMG_VerifiedFwMAC(mac) == SE_SUCCESS) &&
+      (memcmp(xVerifiedFw.MAC, mac, SE_CRYPTO_MAC_LEN) == 0))
+  {
+    e_ret_status = SE_SUCCESS;
+  }
+  (void)memset(mac, 0x00, sizeof(mac));
+  return e_ret_status;
+}
+
+/**
+  * @}
+  */
 
 /** @defgroup SE_IMG_Exported_Functions Exported Functions
   * @{
@@ -101,6 +351,104 @@ SE_ErrorStatus SE_IMG_Read(void *pDestination, const void *pSource, uint32_t Len
   return ret;
 }
 
+/**
+  * @brief  Verify the Tag of a Firmware image, read directly from the FLASH.
+  * @note   The metadata must have been authenticated beforehand.
+  * @note   With SE_VERIFY_FW_RECORD, the Tag computation is skipped if the same Firmware (same version, size, tag,
+  *         location and image CRC) is recorded as successfully verified. The record is kept across the resets and
+  *         authenticated with a MAC under a secret key of the Secure Engine. Each successful verification is then
+  *         recorded. SE_VERIFY_FW_FORCE ignores the current record.
+  * @param  peSE_Status Secure Engine Status.
+  *         This parameter can be a value of @ref SE_Status_Structure_definition.
+  * @param  pxSE_Metadata Firmware metadata
+  * @param  pxFwArea Firmware image location
+  * @param  Flags SE_VERIFY_FW_FULL, SE_VERIFY_FW_RECORD or (SE_VERIFY_FW_RECORD | SE_VERIFY_FW_FORCE)
+  * @retval SE_SUCCESS if successful, otherwise SE_ERROR
+  */
+SE_ErrorStatus SE_IMG_VerifyFwTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata,
+                                  SE_FwAreaTypeDef *pxFwArea, uint32_t Flags)
+{
+  SE_ErrorStatus e_ret_status;
+  SE_FwAreaTypeDef x_fw_area;
+  uint8_t fw_tag[SE_TAG_LEN];
+  uint32_t fw_crc = 0U;
+
+  *peSE_Status = SE_OK;
+
+  /* Work on a copy of the location: the checked values cannot be changed afterwards */
+  (void)memcpy(&x_fw_area, pxFwArea, sizeof(x_fw_area));
+  if (x_fw_area.AreaSize[1] == 0U)
+  {
+    x_fw_area.pArea[1] = NULL;
+  }
+  if ((SE_IMG_CheckFwArea(x_fw_area.pArea[0], x_fw_area.AreaSize[0]) != SE_SUCCESS) ||
+      ((x_fw_area.AreaSize[1] != 0U) && (SE_IMG_CheckFwArea(x_fw_area.pArea[1], x_fw_area.AreaSize[1]) != SE_SUCCESS)) ||
+      ((x_fw_area.AreaSize[0] + x_fw_area.AreaSize[1]) != pxSE_Metadata->FwSize) ||
+      (x_fw_area.AreaSize[0] > pxSE_Metadata->FwSize))
+  {
+    return SE_ERROR;
+  }
+
+  SE_LL_FLASH_DirectReadStart();
+
+  if ((Flags & SE_VERIFY_FW_RECORD) != 0U)
+  {
+    fw_crc = SE_IMG_ComputeFwCRC(&x_fw_area);
+    if (SE_LL_FLASH_DirectReadStop() != SE_SUCCESS)
+    {
+      *peSE_Status = SE_ERR_FLASH_READ;
+      (void)memset(&xVerifiedFw, 0x00, sizeof(xVerifiedFw));
+      return SE_ERROR;
+    }
+
+    if (((Flags & SE_VERIFY_FW_FORCE) == 0U) && (SE_IMG_CheckVerifiedFw(pxSE_Metadata, &x_fw_area, fw_crc) == SE_SUCCESS))
+    {
+      /* Same Firmware as the one already verified */
+      return SE_SUCCESS;
+    }
+    SE_LL_FLASH_DirectReadStart();
+  }
+
+  /* Full verification */
+  e_ret_status = SE_IMG_ComputeFwTag(pxSE_Metadata, &x_fw_area, fw_tag);
+  if (SE_LL_FLASH_DirectReadStop() != SE_SUCCESS)
+  {
+    *peSE_Status = SE_ERR_FLASH_READ;
+    e_ret_status = SE_ERROR;
+  }
+  else if ((e_ret_status == SE_SUCCESS) && (memcmp(fw_tag, pxSE_Metadata->FwTag, SE_TAG_LEN) != 0))
+  {
+    *peSE_Status = SE_SIGNATURE_ERR;
+    e_ret_status = SE_ERROR;
+  }
+  else
+  {
+    /* nothing to do */
+  }
+
+  /* Record the verified Firmware (or forget the previous one) */
+  (void)memset(&xVerifiedFw, 0x00, sizeof(xVerifiedFw));
+  if ((e_ret_status == SE_SUCCESS) && ((Flags & SE_VERIFY_FW_RECORD) != 0U))
+  {
+    xVerifiedFw.FwVersion = (uint32_t)pxSE_Metadata->FwVersion;
+    xVerifiedFw.FwSize = pxSE_Metadata->FwSize;
+    (void)memcpy(xVerifiedFw.FwTag, pxSE_Metadata->FwTag, SE_TAG_LEN);
+    xVerifiedFw.AreaBegin[0] = (uint32_t)x_fw_area.pArea[0];
+    xVerifiedFw.AreaBegin[1] = (uint32_t)x_fw_area.pArea[1];
+    xVerifiedFw.AreaSize[0] = x_fw_area.AreaSize[0];
+    xVerifiedFw.AreaSize[1] = x_fw_area.AreaSize[1];
+    xVerifiedFw.FwCRC = fw_crc;
+    if (SE_IMG_VerifiedFwMAC(xVerifiedFw.MAC) != SE_SUCCESS)
+    {
+      /* The record can not be authenticated: it is not kept */
+      (void)memset(&xVerifiedFw, 0x00, sizeof(xVerifiedFw));
+    }
+  }
+  (void)memset(fw_tag, 0x00, sizeof(fw_tag));
+
+  return e_ret_status;
+}
+
 /**
   * @}
   */
@@ -43,6 +43,8 @@ extern "C" {
   */
 SE_ErrorStatus SE_IMG_Read(void *pDestination, const void *pSource, uint32_t Length);
 SE_ErrorStatus SE_IMG_Write(void *pDestination, const void *pSource, uint32_t Length);
+SE_ErrorStatus SE_IMG_VerifyFwTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata,
+                                  SE_FwAreaTypeDef *pxFwArea, uint32_t Flags);
 
 /**
   * @}
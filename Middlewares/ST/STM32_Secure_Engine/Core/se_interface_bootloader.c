@@ -772,6 +772,53 @@ SE_ErrorStatus SE_VerifyFwRawHeaderTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHe
 
 }
 
+/**
+  * @brief Secure Engine Firmware Tag verification.
+  *        It verifies the Tag of a complete Firmware image read directly from the FLASH, in a single Secure Engine call.
+  * @note  The metadata must have been authenticated first (see @ref SE_VerifyFwRawHeaderTag).
+  * @param peSE_Status Secure Engine Status.
+  *        This parameter can be a value of @ref SE_Status_Structure_definition.
+  * @param pxSE_Metadata Firmware metadata.
+  * @param pxFwArea Firmware image location.
+  * @param Flags SE_VERIFY_FW_FULL, SE_VERIFY_FW_RECORD or (SE_VERIFY_FW_RECORD | SE_VERIFY_FW_FORCE).
+  *        With SE_VERIFY_FW_RECORD, an unchanged Firmware (same metadata and same image CRC) which is recorded as
+  *        successfully verified (MAC-protected record kept across the resets) is only checked with the CRC.
+  *        SE_VERIFY_FW_FORCE ignores the record.
+  * @retval SE_ErrorStatus SE_SUCCESS if successful, SE_ERROR otherwise.
+  */
+SE_ErrorStatus SE_VerifyFwTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata, SE_FwAreaTypeDef *pxFwArea, uint32_t Flags)
+{
+  SE_ErrorStatus e_ret_status;
+
+  /* Check if the call is coming from SFU code*/
+  __IS_SFU_RESERVED();
+
+#ifdef SFU_ISOLATE_SE_WITH_MPU
+  if (0 != SE_IsUnprivileged())
+  {
+    uint32_t params[3] = {(uint32_t)pxSE_Metadata, (uint32_t)pxFwArea, Flags};
+    SE_SysCall(&e_ret_status, SE_CRYPTO_HL_VERIFY_FW_TAG, peSE_Status, &params);
+  }
+  else
+  {
+#endif /* SFU_ISOLATE_SE_WITH_MPU */
+    /* Set the CallGate function pointer */
+    SET_CALLGATE();
+
+    /*Enter Secure Mode*/
+    SE_EnterSecureMode();
+
+    e_ret_status = (*SE_CallGatePtr)(SE_CRYPTO_HL_VERIFY_FW_TAG, peSE_Status, pxSE_Metadata, pxFwArea, Flags);
+
+    /*Exit Secure Mode*/
+    SE_ExitSecureMode();
+#ifdef SFU_ISOLATE_SE_WITH_MPU
+  }
+#endif /* SFU_ISOLATE_SE_WITH_MPU */
+
+  return e_ret_status;
+}
+
 /**
   * @}
   */
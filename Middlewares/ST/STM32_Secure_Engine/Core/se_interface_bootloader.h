@@ -61,6 +61,7 @@ SE_ErrorStatus SE_LockRestrictServices(SE_StatusTypeDef *pSE_Status);
 SE_ErrorStatus SE_SFU_IMG_Read(SE_StatusTypeDef *pSE_Status, void *pDestination, const void *pSource, uint32_t Length);
 SE_ErrorStatus SE_SFU_IMG_Write(SE_StatusTypeDef *pSE_Status, void *pDestination, const void *pSource, uint32_t Length);
 SE_ErrorStatus SE_VerifyFwRawHeaderTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxFwRawHeader);
+SE_ErrorStatus SE_VerifyFwTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata, SE_FwAreaTypeDef *pxFwArea, uint32_t Flags);
 
 /* Crypto-agnostic functions */
 SE_ErrorStatus SE_Encrypt_Init(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata);
@@ -172,6 +172,7 @@ void SE_SVC_Handler(uint32_t *args)
     /* three extra parameters calls */
     case SE_IMG_READ:
     case SE_IMG_WRITE:
+    case SE_CRYPTO_HL_VERIFY_FW_TAG:
       ret = (*SE_CallGatePtr)((SE_FunctionIDTypeDef)args[1],
                                                        (SE_StatusTypeDef *)args[2],
                                                        (void *)(((uint32_t *)args[3])[0]),
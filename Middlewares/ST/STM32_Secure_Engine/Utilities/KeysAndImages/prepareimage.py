@@ -19,7 +19,31 @@ import argparse
 import os
 import hashlib
 from elftools.elf.elffile import ELFFile
-from struct import pack
+from struct import pack, unpack, calcsize
+
+#delta image : patch transforming the active firmware into the new firmware
+#patch header : magic, base size, target size, reserved, sha256 of base
+#then operations (little endian) :
+#  COPY   : 0x01, offset in base (4 bytes), length (4 bytes)
+#  INSERT : 0x02, length (4 bytes), bytes to insert
+#  END    : 0x00, followed by 0 padding up to a multiple of 16 bytes (AES block)
+DELTA_MAGIC = b'SFUD'
+DELTA_HEADER = '<4sIII32s'
+DELTA_OP_END = 0
+DELTA_OP_COPY = 1
+DELTA_OP_INSERT = 2
+#minimum match length to emit a copy , base is indexed on 4 bytes alignment
+DELTA_MIN_MATCH = 16
+DELTA_ALIGN = 4
+
+#compressed image : same header as a patch with magic, 0, target size, window size, 0
+#then LZ4 block sequences : token (literal length << 4 | match length - 4),
+#extra literal length bytes, literals, offset (2 bytes), extra match length bytes
+#the last sequence has only literals, followed by 0 padding up to a multiple of 16 bytes
+COMPRESS_MAGIC = b'SFUC'
+LZ_MIN_MATCH = 4
+#history of the bootloader decompressor (LZ_WINDOW_SIZE in sfu_fwimg_core.c)
+LZ_WINDOW = 1024
 
 def gen_ecdsa_p256(args):
     keys.ECDSA256P1.generate().export_private(args.key)
@@ -146,6 +170,216 @@ def do_encrypt(args):
         print("Key does not support encrypt")
         exit(1)
 
+def delta_diff(base, target):
+    #greedy matching : continue the previous copy if possible, else look up
+    #the base index, then extend the match forward and backward
+    index = {}
+    for i in range(0, len(base) - DELTA_MIN_MATCH + 1, DELTA_ALIGN):
+        index.setdefault(base[i:i+DELTA_MIN_MATCH], i)
+    ops = []
+    literal = bytearray()
+    last = 0
+    t = 0
+    while t < len(target):
+        key = target[t:t+DELTA_MIN_MATCH]
+        if len(key) < DELTA_MIN_MATCH:
+            b = None
+        elif base[last:last+DELTA_MIN_MATCH] == key:
+            b = last
+        else:
+            b = index.get(key)
+        if b is None:
+            literal.append(target[t])
+            t += 1
+            continue
+        n = DELTA_MIN_MATCH
+        while t + n < len(target) and b + n < len(base) and target[t+n] == base[b+n]:
+            n += 1
+        k = 0
+        while k < len(literal) and k < b and literal[-1-k] == base[b-1-k]:
+            k += 1
+        if k:
+            del literal[-k:]
+        if literal:
+            ops.append((DELTA_OP_INSERT, bytes(literal)))
+            literal = bytearray()
+        ops.append((DELTA_OP_COPY, b - k, n + k))
+        last = b + n
+        t += n
+    if literal:
+        ops.append((DELTA_OP_INSERT, bytes(literal)))
+    patch = pack(DELTA_HEADER, DELTA_MAGIC, len(base), len(target), 0, hashlib.sha256(base).digest())
+    for op in ops:
+        if op[0] == DELTA_OP_COPY:
+            patch += pack('<BII', DELTA_OP_COPY, op[1], op[2])
+        else:
+            patch += pack('<BI', DELTA_OP_INSERT, len(op[1])) + op[1]
+    patch += pack('B', DELTA_OP_END)
+    patch += b'\0' * (-len(patch) % 16)
+    return patch, ops
+
+def delta_apply(base, patch):
+    #same checks as the bootloader (sfu_fwimg_core.c)
+    magic, base_size, target_size, reserved, base_tag = unpack(DELTA_HEADER, patch[0:calcsize(DELTA_HEADER)])
+    if magic != DELTA_MAGIC or base_size != len(base) or base_tag != hashlib.sha256(base).digest():
+        raise ValueError("patch does not apply to this base")
+    target = bytearray()
+    p = calcsize(DELTA_HEADER)
+    while True:
+        op = patch[p]
+        p += 1
+        if op == DELTA_OP_COPY:
+            offset, length = unpack('<II', patch[p:p+8])
+            p += 8
+            if offset + length > len(base):
+                raise ValueError("copy out of base")
+            target += base[offset:offset+length]
+        elif op == DELTA_OP_INSERT:
+            length, = unpack('<I', patch[p:p+4])
+            p += 4
+            target += patch[p:p+length]
+            p += length
+        elif op == DELTA_OP_END:
+            break
+        else:
+            raise ValueError("unknown operation "+str(op))
+        if len(target) > target_size:
+            raise ValueError("target too large")
+    if len(target) != target_size:
+        raise ValueError("target size mismatch")
+    return bytes(target)
+
+def lz_length(n):
+    out = bytearray()
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+    return out
+
+def lz_sequence(out, literal, offset, length):
+    lit = len(literal)
+    match = length - LZ_MIN_MATCH if offset else 0
+    out.append((min(lit, 15) << 4) | min(match, 15))
+    if lit >= 15:
+        out += lz_length(lit - 15)
+    out += literal
+    if offset:
+        out += pack('<H', offset)
+        if match >= 15:
+            out += lz_length(match - 15)
+
+def lz_compress(data, window):
+    #greedy matching on the last position of each 4 bytes key within the window
+    out = bytearray(pack(DELTA_HEADER, COMPRESS_MAGIC, 0, len(data), window, b'\0'*32))
+    last = {}
+    anchor = 0
+    i = 0
+    while i + LZ_MIN_MATCH <= len(data):
+        key = data[i:i+LZ_MIN_MATCH]
+        m = last.get(key)
+        last[key] = i
+        if m is None or i - m > window:
+            i += 1
+            continue
+        n = LZ_MIN_MATCH
+        while i + n < len(data) and data[m+n] == data[i+n]:
+            n += 1
+        lz_sequence(out, data[anchor:i], i - m, n)
+        for k in range(i + 1, min(i + n, len(data) - LZ_MIN_MATCH + 1)):
+            last[data[k:k+LZ_MIN_MATCH]] = k
+        i += n
+        anchor = i
+    if anchor < len(data):
+        lz_sequence(out, data[anchor:], 0, 0)
+    out += b'\0' * (-len(out) % 16)
+    return bytes(out)
+
+def lz_decompress(payload):
+    #same checks as the bootloader (sfu_fwimg_core.c)
+    magic, base_size, target_size, window, base_tag = unpack(DELTA_HEADER, payload[0:calcsize(DELTA_HEADER)])
+    if magic != COMPRESS_MAGIC or window == 0 or window > LZ_WINDOW:
+        raise ValueError("not a compressed firmware for this bootloader")
+    data = bytearray()
+    p = calcsize(DELTA_HEADER)
+    while len(data) < target_size:
+        token = payload[p]
+        p += 1
+        lit = token >> 4
+        if lit == 15:
+            while True:
+                lit += payload[p]
+                p += 1
+                if payload[p-1] != 255:
+                    break
+        data += payload[p:p+lit]
+        p += lit
+        if len(data) >= target_size:
+            break
+        offset, = unpack('<H', payload[p:p+2])
+        p += 2
+        if offset == 0 or offset > window or offset > len(data):
+            raise ValueError("match out of window")
+        length = (token & 15) + LZ_MIN_MATCH
+        if token & 15 == 15:
+            while True:
+                length += payload[p]
+                p += 1
+                if payload[p-1] != 255:
+                    break
+        for k in range(length):
+            data.append(data[-offset])
+    if len(data) != target_size:
+        raise ValueError("target size mismatch")
+    return bytes(data)
+
+def do_compress(args):
+    with open(args.infile, 'rb') as f:
+        data = f.read()
+    if args.window < 1 or args.window > LZ_WINDOW:
+        print("window must be between 1 and "+str(LZ_WINDOW))
+        exit(1)
+    if len(data) % 16:
+        print("warning : binary size not a multiple of 16, the FW size in header will not match")
+    payload = lz_compress(data, args.window)
+    #check the compressed firmware before using it
+    if lz_decompress(payload) != data:
+        print("error compressed firmware does not rebuild the binary")
+        exit(1)
+    print("compressed size "+str(len(payload))+" for "+str(len(data))+" bytes")
+    with open(args.outfile, 'wb') as f:
+        f.write(payload)
+
+def do_diff(args):
+    with open(args.base, 'rb') as f:
+        base = f.read()
+    with open(args.infile, 'rb') as f:
+        target = f.read()
+    if (len(base) % 16) or (len(target) % 16):
+        print("warning : binary size not a multiple of 16, the FW size in header will not match")
+    patch, ops = delta_diff(base, target)
+    #check the patch before using it
+    if delta_apply(base, patch) != target:
+        print("error patch does not rebuild the binary")
+        exit(1)
+    copied = sum(op[2] for op in ops if op[0] == DELTA_OP_COPY)
+    print("patch size "+str(len(patch))+" for "+str(len(target))+" bytes ("+str(copied)+" bytes copied from base)")
+    with open(args.outfile, 'wb') as f:
+        f.write(patch)
+
+def do_patch(args):
+    with open(args.base, 'rb') as f:
+        base = f.read()
+    with open(args.infile, 'rb') as f:
+        patch = f.read()
+    try:
+        target = delta_apply(base, patch)
+    except (ValueError, IndexError) as e:
+        print("error "+str(e))
+        exit(1)
+    with open(args.outfile, 'wb') as f:
+        f.write(target)
+
 def do_header_lib(args):
     if (os.path.isfile(args.firmware)):
         size = os.path.getsize(args.firmware)
@@ -162,6 +396,13 @@ def do_header_lib(args):
     magic = args.magic.encode()
     version = args.version
     reserved = b'\0'*args.reserved
+    delta = getattr(args, 'delta', None)
+    if delta:
+        #the patch size is stored in the first 4 reserved bytes
+        if args.reserved < 4:
+            print("at least 4 reserved bytes required for a delta or compressed image")
+            exit(1)
+        reserved = pack('<I', os.path.getsize(delta)) + b'\0'*(args.reserved - 4)
     if args.nonce and args.iv:
         print("either IV or Nonce Required !!!")
         exit(1)
@@ -245,8 +486,8 @@ def do_pack(args):
     tmp = (args.offset-len(header))*b'\xff'
     #write to file
     f.write(tmp)
-    #recopy encrypted file
-    binary=open(args.firmware,'rb')
+    #recopy encrypted file (encrypted patch or compressed firmware for a delta or compressed image)
+    binary=open(args.delta if args.delta else args.firmware,'rb')
     tmp=binary.read()
     f.write(tmp)
     binary.close()
@@ -360,6 +601,17 @@ subcmds = {
         # offset default 512
         #
         'pack':do_pack,
+        #build a patch from the active firmware binary to the new one
+        #-b base binary (clear)
+        #input file new binary (clear)
+        #output file patch to encrypt and pack with -d
+        'diff':do_diff,
+        #apply a patch to a base binary (to check a patch on host)
+        'patch':do_patch,
+        #compress a binary for a compressed image
+        #input file binary (clear)
+        #output file compressed binary to encrypt and pack with -d
+        'compress':do_compress,
         #merge appli.elf , header binary and sbsfu elf in a big binary
         #input file appli.elf
         #-h header file
@@ -432,8 +684,22 @@ def args():
     pack.add_argument('-r', '--reserved',type=int, default=8)
     pack.add_argument('-o', '--offset', help='offset between start of header and binary', type=int, default=512)
     pack.add_argument('-e', '--elf', help='elf type set to 1 for GNU, 0 for other by default', type=int, default=1) 
+    pack.add_argument('-d', '--delta', metavar='filename', help='encrypted patch or compressed firmware packed instead of the firmware (delta or compressed image)')
     pack.add_argument("outfile")
 
+    diff = subs.add_parser('diff', help='build a patch from the active firmware binary to a new firmware binary')
+    diff.add_argument('-b', '--base', metavar='filename', help='binary of the active firmware', required = True)
+    diff.add_argument("infile", help="binary of the new firmware")
+    diff.add_argument("outfile", help="patch")
+    patchp = subs.add_parser('patch', help='apply a patch to the active firmware binary')
+    patchp.add_argument('-b', '--base', metavar='filename', help='binary of the active firmware', required = True)
+    patchp.add_argument("infile", help="patch")
+    patchp.add_argument("outfile", help="binary of the new firmware")
+    comp = subs.add_parser('compress', help='compress a firmware binary')
+    comp.add_argument('-w', '--window', help='maximum match offset', type=int, default=LZ_WINDOW)
+    comp.add_argument("infile", help="binary of the firmware")
+    comp.add_argument("outfile", help="compressed firmware")
+
     mrg = subs.add_parser('merge', help='merge elf appli , install header and sbsfu.elf in a contiguous binary')
     mrg.add_argument('-i', '--install', metavar='filename',  help="filename of installed binary header", required = True)
     mrg.add_argument('-s', '--sbsfu', metavar='filename', help="filename of sbsfu elf", required = True)
@@ -3,10 +3,10 @@
 
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include "azure_c_shared_utility/socketio.h"
-#include "azure_c_shared_utility/singlylinkedlist.h"
 #include "azure_c_shared_utility/tcpsocketconnection_c.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
@@ -14,6 +14,18 @@
 #define UNABLE_TO_COMPLETE -2
 #define MBED_RECEIVE_BYTES_VALUE    128
 
+/* Number of preallocated slots for the sends waiting for the socket to accept them.
+   When they are all used, the following sends are queued in heap allocated nodes. */
+#ifndef SOCKETIO_PENDING_IO_SLOTS
+#define SOCKETIO_PENDING_IO_SLOTS   8
+#endif
+
+/* A slot buffer larger than this is released when its send completes,
+   so that a burst of large sends does not stay allocated for the life of the connection. */
+#ifndef SOCKETIO_PENDING_IO_KEEP_SIZE
+#define SOCKETIO_PENDING_IO_KEEP_SIZE   1024
+#endif
+
 typedef enum IO_STATE_TAG
 {
     IO_STATE_CLOSED,
@@ -25,11 +37,13 @@ typedef enum IO_STATE_TAG
 
 typedef struct PENDING_SOCKET_IO_TAG
 {
-    unsigned char* bytes;
+    unsigned char* bytes;       /* slot: kept allocated and reused by the next send using the slot */
+    size_t capacity;
     size_t size;
+    size_t offset;              /* bytes already accepted by the socket */
     ON_SEND_COMPLETE on_send_complete;
     void* callback_context;
-    SINGLYLINKEDLIST_HANDLE pending_io_list;
+    struct PENDING_SOCKET_IO_TAG* next; /* overflow node only */
 } PENDING_SOCKET_IO;
 
 typedef struct SOCKET_IO_INSTANCE_TAG
@@ -42,7 +56,12 @@ typedef struct SOCKET_IO_INSTANCE_TAG
     char* hostname;
     int port;
     IO_STATE io_state;
-    SINGLYLINKEDLIST_HANDLE pending_io_list;
+    PENDING_SOCKET_IO pending_io[SOCKETIO_PENDING_IO_SLOTS];
+    size_t pending_io_head;
+    size_t pending_io_count;
+    PENDING_SOCKET_IO* overflow_io_head;    /* sends queued after the slots, all newer than the slot ones */
+    PENDING_SOCKET_IO* overflow_io_tail;
+    unsigned char recv_bytes[MBED_RECEIVE_BYTES_VALUE];
 } SOCKET_IO_INSTANCE;
 
 /*this function will clone an option given by name and value*/
@@ -99,43 +118,122 @@ static void indicate_error(SOCKET_IO_INSTANCE* socket_io_instance)
 static int add_pending_io(SOCKET_IO_INSTANCE* socket_io_instance, const unsigned char* buffer, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context)
 {
     int result;
-    PENDING_SOCKET_IO* pending_socket_io = (PENDING_SOCKET_IO*)malloc(sizeof(PENDING_SOCKET_IO));
-    if (pending_socket_io == NULL)
-    {
-        result = MU_FAILURE;
-    }
-    else
+    PENDING_SOCKET_IO* pending_socket_io;
+
+    if ((socket_io_instance->pending_io_count >= SOCKETIO_PENDING_IO_SLOTS) ||
+        (socket_io_instance->overflow_io_head != NULL))
     {
-        pending_socket_io->bytes = (unsigned char*)malloc(size);
-        if (pending_socket_io->bytes == NULL)
+        /* no free slot, or older sends already in overflow: queue a heap node, bytes stored after it */
+        pending_socket_io = (PENDING_SOCKET_IO*)malloc(sizeof(PENDING_SOCKET_IO) + size);
+        if (pending_socket_io == NULL)
         {
-            free(pending_socket_io);
+            LogError("Socketio_Failure: cannot allocate the pending IO.");
             result = MU_FAILURE;
         }
         else
         {
-            pending_socket_io->size = size;
-            pending_socket_io->on_send_complete = on_send_complete;
-            pending_socket_io->callback_context = callback_context;
-            pending_socket_io->pending_io_list = socket_io_instance->pending_io_list;
-            (void)memcpy(pending_socket_io->bytes, buffer, size);
+            pending_socket_io->bytes = (unsigned char*)(pending_socket_io + 1);
+            pending_socket_io->capacity = size;
+            pending_socket_io->next = NULL;
+            if (socket_io_instance->overflow_io_tail == NULL)
+            {
+                socket_io_instance->overflow_io_head = pending_socket_io;
+            }
+            else
+            {
+                socket_io_instance->overflow_io_tail->next = pending_socket_io;
+            }
+            socket_io_instance->overflow_io_tail = pending_socket_io;
+            result = 0;
+        }
+    }
+    else
+    {
+        pending_socket_io = &socket_io_instance->pending_io[(socket_io_instance->pending_io_head + socket_io_instance->pending_io_count) % SOCKETIO_PENDING_IO_SLOTS];
 
-            if (singlylinkedlist_add(socket_io_instance->pending_io_list, pending_socket_io) == NULL)
+        if (pending_socket_io->capacity < size)
+        {
+            unsigned char* new_bytes = (unsigned char*)malloc(size);
+            if (new_bytes == NULL)
             {
-                free(pending_socket_io->bytes);
-                free(pending_socket_io);
                 result = MU_FAILURE;
             }
             else
             {
+                free(pending_socket_io->bytes);
+                pending_socket_io->bytes = new_bytes;
+                pending_socket_io->capacity = size;
                 result = 0;
             }
         }
+        else
+        {
+            result = 0;
+        }
+
+        if (result == 0)
+        {
+            socket_io_instance->pending_io_count++;
+        }
+    }
+
+    if (result == 0)
+    {
+        pending_socket_io->size = size;
+        pending_socket_io->offset = 0;
+        pending_socket_io->on_send_complete = on_send_complete;
+        pending_socket_io->callback_context = callback_context;
+        (void)memcpy(pending_socket_io->bytes, buffer, size);
+    }
+
+    return result;
+}
+
+static PENDING_SOCKET_IO* get_first_pending_io(SOCKET_IO_INSTANCE* socket_io_instance)
+{
+    PENDING_SOCKET_IO* result;
+
+    if (socket_io_instance->pending_io_count > 0)
+    {
+        result = &socket_io_instance->pending_io[socket_io_instance->pending_io_head];
+    }
+    else
+    {
+        result = socket_io_instance->overflow_io_head;
     }
 
     return result;
 }
 
+/* Remove the first pending IO once sent: the slot is released, an overflow node is freed */
+static void remove_first_pending_io(SOCKET_IO_INSTANCE* socket_io_instance)
+{
+    if (socket_io_instance->pending_io_count > 0)
+    {
+        PENDING_SOCKET_IO* pending_socket_io = &socket_io_instance->pending_io[socket_io_instance->pending_io_head];
+
+        if (pending_socket_io->capacity > SOCKETIO_PENDING_IO_KEEP_SIZE)
+        {
+            free(pending_socket_io->bytes);
+            pending_socket_io->bytes = NULL;
+            pending_socket_io->capacity = 0;
+        }
+        socket_io_instance->pending_io_head = (socket_io_instance->pending_io_head + 1) % SOCKETIO_PENDING_IO_SLOTS;
+        socket_io_instance->pending_io_count--;
+    }
+    else if (socket_io_instance->overflow_io_head != NULL)
+    {
+        PENDING_SOCKET_IO* pending_socket_io = socket_io_instance->overflow_io_head;
+
+        socket_io_instance->overflow_io_head = pending_socket_io->next;
+        if (socket_io_instance->overflow_io_head == NULL)
+        {
+            socket_io_instance->overflow_io_tail = NULL;
+        }
+        free(pending_socket_io);
+    }
+}
+
 CONCRETE_IO_HANDLE socketio_create(void* io_create_parameters)
 {
     SOCKETIO_CONFIG* socket_io_config = io_create_parameters;
@@ -150,32 +248,27 @@ CONCRETE_IO_HANDLE socketio_create(void* io_create_parameters)
         result = malloc(sizeof(SOCKET_IO_INSTANCE));
         if (result != NULL)
         {
-            result->pending_io_list = singlylinkedlist_create();
-            if (result->pending_io_list == NULL)
+            result->hostname = (char*)malloc(strlen(socket_io_config->hostname) + 1);
+            if (result->hostname == NULL)
             {
                 free(result);
                 result = NULL;
             }
             else
             {
-                result->hostname = (char*)malloc(strlen(socket_io_config->hostname) + 1);
-                if (result->hostname == NULL)
-                {
-                    singlylinkedlist_destroy(result->pending_io_list);
-                    free(result);
-                    result = NULL;
-                }
-                else
-                {
-                    strcpy(result->hostname, socket_io_config->hostname);
-                    result->port = socket_io_config->port;
-                    result->on_bytes_received = NULL;
-                    result->on_io_error = NULL;
-                    result->on_bytes_received_context = NULL;
-                    result->on_io_error_context = NULL;
-                    result->io_state = IO_STATE_CLOSED;
-                    result->tcp_socket_connection = NULL;
-                }
+                strcpy(result->hostname, socket_io_config->hostname);
+                result->port = socket_io_config->port;
+                result->on_bytes_received = NULL;
+                result->on_io_error = NULL;
+                result->on_bytes_received_context = NULL;
+                result->on_io_error_context = NULL;
+                result->io_state = IO_STATE_CLOSED;
+                result->tcp_socket_connection = NULL;
+                (void)memset(result->pending_io, 0, sizeof(result->pending_io));
+                result->pending_io_head = 0;
+                result->pending_io_count = 0;
+                result->overflow_io_head = NULL;
+                result->overflow_io_tail = NULL;
             }
         }
     }
@@ -191,22 +284,19 @@ void socketio_destroy(CONCRETE_IO_HANDLE socket_io)
 
         tcpsocketconnection_destroy(socket_io_instance->tcp_socket_connection);
 
-        /* clear all pending IOs */
-        LIST_ITEM_HANDLE first_pending_io = singlylinkedlist_get_head_item(socket_io_instance->pending_io_list);
-        while (first_pending_io != NULL)
+        /* release the pending IO slots and the overflow nodes */
+        size_t i;
+        for (i = 0; i < SOCKETIO_PENDING_IO_SLOTS; i++)
         {
-            PENDING_SOCKET_IO* pending_socket_io = (PENDING_SOCKET_IO*)singlylinkedlist_item_get_value(first_pending_io);
-            if (pending_socket_io != NULL)
-            {
-                free(pending_socket_io->bytes);
-                free(pending_socket_io);
-            }
-
-            (void)singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io);
-            first_pending_io = singlylinkedlist_get_head_item(socket_io_instance->pending_io_list);
+            free(socket_io_instance->pending_io[i].bytes);
+        }
+        while (socket_io_instance->overflow_io_head != NULL)
+        {
+            PENDING_SOCKET_IO* pending_socket_io = socket_io_instance->overflow_io_head;
+            socket_io_instance->overflow_io_head = pending_socket_io->next;
+            free(pending_socket_io);
         }
 
-        singlylinkedlist_destroy(socket_io_instance->pending_io_list);
         free(socket_io_instance->hostname);
         free(socket_io);
     }
@@ -281,6 +371,7 @@ int socketio_close(CONCRETE_IO_HANDLE socket_io, ON_IO_CLOSE_COMPLETE on_io_clos
         else
         {
             tcpsocketconnection_close(socket_io_instance->tcp_socket_connection);
+            tcpsocketconnection_destroy(socket_io_instance->tcp_socket_connection);
             socket_io_instance->tcp_socket_connection = NULL;
             socket_io_instance->io_state = IO_STATE_CLOSED;
 
@@ -316,8 +407,7 @@ int socketio_send(CONCRETE_IO_HANDLE socket_io, const void* buffer, size_t size,
         }
         else
         {
-            LIST_ITEM_HANDLE first_pending_io = singlylinkedlist_get_head_item(socket_io_instance->pending_io_list);
-            if (first_pending_io != NULL)
+            if (get_first_pending_io(socket_io_instance) != NULL)
             {
                 if (add_pending_io(socket_io_instance, buffer, size, on_send_complete, callback_context) != 0)
                 {
@@ -372,20 +462,14 @@ void socketio_dowork(CONCRETE_IO_HANDLE socket_io)
         if (socket_io_instance->io_state == IO_STATE_OPEN)
         {
             int received = 1;
+            PENDING_SOCKET_IO* pending_socket_io;
 
-            LIST_ITEM_HANDLE first_pending_io = singlylinkedlist_get_head_item(socket_io_instance->pending_io_list);
-            while (first_pending_io != NULL)
+            while ((pending_socket_io = get_first_pending_io(socket_io_instance)) != NULL)
             {
-                PENDING_SOCKET_IO* pending_socket_io = (PENDING_SOCKET_IO*)singlylinkedlist_item_get_value(first_pending_io);
-                if (pending_socket_io == NULL)
-                {
-                    socket_io_instance->io_state = IO_STATE_ERROR;
-                    indicate_error(socket_io_instance);
-                    break;
-                }
-
-                int send_result = tcpsocketconnection_send(socket_io_instance->tcp_socket_connection, (const char*)pending_socket_io->bytes, pending_socket_io->size);
-                if (send_result != pending_socket_io->size)
+                ON_SEND_COMPLETE on_send_complete;
+                void* callback_context;
+                int send_result = tcpsocketconnection_send(socket_io_instance->tcp_socket_connection, (const char*)pending_socket_io->bytes + pending_socket_io->offset, pending_socket_io->size - pending_socket_io->offset);
+                if (send_result != pending_socket_io->size - pending_socket_io->offset)
                 {
                     if (send_result < 0)
                     {
@@ -400,48 +484,32 @@ void socketio_dowork(CONCRETE_IO_HANDLE socket_io)
                     else
                     {
                         /* send something, wait for the rest */
-                        (void)memmove(pending_socket_io->bytes, pending_socket_io->bytes + send_result, pending_socket_io->size - send_result);
+                        pending_socket_io->offset += send_result;
                     }
                 }
                 else
                 {
-                    if (pending_socket_io->on_send_complete != NULL)
-                    {
-                        pending_socket_io->on_send_complete(pending_socket_io->callback_context, IO_SEND_OK);
-                    }
+                    on_send_complete = pending_socket_io->on_send_complete;
+                    callback_context = pending_socket_io->callback_context;
+                    remove_first_pending_io(socket_io_instance);
 
-                    free(pending_socket_io->bytes);
-                    free(pending_socket_io);
-                    if (singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io) != 0)
+                    if (on_send_complete != NULL)
                     {
-                        socket_io_instance->io_state = IO_STATE_ERROR;
-                        indicate_error(socket_io_instance);
+                        on_send_complete(callback_context, IO_SEND_OK);
                     }
                 }
-
-                first_pending_io = singlylinkedlist_get_head_item(socket_io_instance->pending_io_list);
             }
 
             while (received > 0)
             {
-                unsigned char* recv_bytes = malloc(MBED_RECEIVE_BYTES_VALUE);
-                if (recv_bytes == NULL)
+                received = tcpsocketconnection_receive(socket_io_instance->tcp_socket_connection, (char*)socket_io_instance->recv_bytes, MBED_RECEIVE_BYTES_VALUE);
+                if (received > 0)
                 {
-                    LogError("Socketio_Failure: NULL allocating input buffer.");
-                    indicate_error(socket_io_instance);
-                }
-                else
-                {
-                    received = tcpsocketconnection_receive(socket_io_instance->tcp_socket_connection, (char*)recv_bytes, MBED_RECEIVE_BYTES_VALUE);
-                    if (received > 0)
+                    if (socket_io_instance->on_bytes_received != NULL)
                     {
-                        if (socket_io_instance->on_bytes_received != NULL)
-                        {
-                            /* explictly ignoring here the result of the callback */
-                            (void)socket_io_instance->on_bytes_received(socket_io_instance->on_bytes_received_context, recv_bytes, received);
-                        }
+                        /* explictly ignoring here the result of the callback */
+                        (void)socket_io_instance->on_bytes_received(socket_io_instance->on_bytes_received_context, socket_io_instance->recv_bytes, received);
                     }
-                    free(recv_bytes);
                 }
             }
         }
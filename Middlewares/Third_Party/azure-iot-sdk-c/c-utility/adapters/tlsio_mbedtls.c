@@ -32,6 +32,12 @@ static const char *const OPTION_UNDERLYING_IO_OPTIONS = "underlying_io_options";
 #define HANDSHAKE_TIMEOUT_MS 5000
 #define HANDSHAKE_WAIT_INTERVAL_MS 10
 
+// Initial capacity of the ring buffer holding the bytes received from the
+// underlying IO until mbedTLS reads them. It only grows if a burst does not fit.
+#ifndef TLSIO_MBEDTLS_RECV_BUFFER_SIZE
+#define TLSIO_MBEDTLS_RECV_BUFFER_SIZE 2048
+#endif
+
 typedef enum TLSIO_STATE_ENUM_TAG
 {
     TLSIO_STATE_NOT_OPEN,
@@ -55,6 +61,8 @@ typedef struct TLS_IO_INSTANCE_TAG
     void *on_io_error_context;
     TLSIO_STATE_ENUM tlsio_state;
     unsigned char *socket_io_read_bytes;
+    size_t socket_io_read_buffer_size;
+    size_t socket_io_read_head;
     size_t socket_io_read_byte_count;
     ON_SEND_COMPLETE on_send_complete;
     void *on_send_complete_callback_context;
@@ -167,25 +175,120 @@ static void on_underlying_io_open_complete(void *context, IO_OPEN_RESULT open_re
     }
 }
 
+static int read_bytes_grow(TLS_IO_INSTANCE *tls_io_instance, size_t needed)
+{
+    int result;
+    size_t new_size = tls_io_instance->socket_io_read_buffer_size * 2;
+    unsigned char *new_socket_io_read_bytes;
+
+    if (new_size < needed)
+    {
+        new_size = needed;
+    }
+
+    new_socket_io_read_bytes = (unsigned char *)malloc(new_size);
+    if (new_socket_io_read_bytes == NULL)
+    {
+        LogError("Failure growing the receive buffer to %u bytes", (unsigned int)new_size);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        // Unwrap the pending bytes at the start of the new buffer
+        size_t first = tls_io_instance->socket_io_read_buffer_size - tls_io_instance->socket_io_read_head;
+        if (first > tls_io_instance->socket_io_read_byte_count)
+        {
+            first = tls_io_instance->socket_io_read_byte_count;
+        }
+        (void)memcpy(new_socket_io_read_bytes, tls_io_instance->socket_io_read_bytes + tls_io_instance->socket_io_read_head, first);
+        (void)memcpy(new_socket_io_read_bytes + first, tls_io_instance->socket_io_read_bytes, tls_io_instance->socket_io_read_byte_count - first);
+
+        free(tls_io_instance->socket_io_read_bytes);
+        tls_io_instance->socket_io_read_bytes = new_socket_io_read_bytes;
+        tls_io_instance->socket_io_read_buffer_size = new_size;
+        tls_io_instance->socket_io_read_head = 0;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int read_bytes_put(TLS_IO_INSTANCE *tls_io_instance, const unsigned char *buffer, size_t size)
+{
+    int result;
+
+    if ((tls_io_instance->socket_io_read_buffer_size - tls_io_instance->socket_io_read_byte_count < size) &&
+        (read_bytes_grow(tls_io_instance, tls_io_instance->socket_io_read_byte_count + size) != 0))
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        size_t tail = tls_io_instance->socket_io_read_head + tls_io_instance->socket_io_read_byte_count;
+        size_t first;
+
+        if (tail >= tls_io_instance->socket_io_read_buffer_size)
+        {
+            tail -= tls_io_instance->socket_io_read_buffer_size;
+        }
+        first = tls_io_instance->socket_io_read_buffer_size - tail;
+        if (first > size)
+        {
+            first = size;
+        }
+        (void)memcpy(tls_io_instance->socket_io_read_bytes + tail, buffer, first);
+        (void)memcpy(tls_io_instance->socket_io_read_bytes, buffer + first, size - first);
+        tls_io_instance->socket_io_read_byte_count += size;
+        result = 0;
+    }
+
+    return result;
+}
+
+static size_t read_bytes_get(TLS_IO_INSTANCE *tls_io_instance, unsigned char *buf, size_t sz)
+{
+    size_t first;
+
+    if (sz > tls_io_instance->socket_io_read_byte_count)
+    {
+        sz = tls_io_instance->socket_io_read_byte_count;
+    }
+    first = tls_io_instance->socket_io_read_buffer_size - tls_io_instance->socket_io_read_head;
+    if (first > sz)
+    {
+        first = sz;
+    }
+    (void)memcpy(buf, tls_io_instance->socket_io_read_bytes + tls_io_instance->socket_io_read_head, first);
+    (void)memcpy(buf + first, tls_io_instance->socket_io_read_bytes, sz - first);
+
+    tls_io_instance->socket_io_read_byte_count -= sz;
+    if (tls_io_instance->socket_io_read_byte_count == 0)
+    {
+        tls_io_instance->socket_io_read_head = 0;
+    }
+    else
+    {
+        tls_io_instance->socket_io_read_head += sz;
+        if (tls_io_instance->socket_io_read_head >= tls_io_instance->socket_io_read_buffer_size)
+        {
+            tls_io_instance->socket_io_read_head -= tls_io_instance->socket_io_read_buffer_size;
+        }
+    }
+
+    return sz;
+}
+
 static void on_underlying_io_bytes_received(void *context, const unsigned char *buffer, size_t size)
 {
     if (context != NULL)
     {
         TLS_IO_INSTANCE *tls_io_instance = (TLS_IO_INSTANCE *)context;
 
-        unsigned char *new_socket_io_read_bytes = (unsigned char *)realloc(tls_io_instance->socket_io_read_bytes, tls_io_instance->socket_io_read_byte_count + size);
-
-        if (new_socket_io_read_bytes == NULL)
+        if (read_bytes_put(tls_io_instance, buffer, size) != 0)
         {
             tls_io_instance->tlsio_state = TLSIO_STATE_ERROR;
             indicate_error(tls_io_instance);
         }
-        else
-        {
-            tls_io_instance->socket_io_read_bytes = new_socket_io_read_bytes;
-            (void)memcpy(tls_io_instance->socket_io_read_bytes + tls_io_instance->socket_io_read_byte_count, buffer, size);
-            tls_io_instance->socket_io_read_byte_count += size;
-        }
     }
     else
     {
@@ -256,7 +359,6 @@ static int on_io_recv(void *context, unsigned char *buf, size_t sz)
     else
     {
         TLS_IO_INSTANCE *tls_io_instance = (TLS_IO_INSTANCE *)context;
-        unsigned char *new_socket_io_read_bytes;
         int pending = 0;
 
         while (tls_io_instance->socket_io_read_byte_count == 0)
@@ -291,31 +393,7 @@ static int on_io_recv(void *context, unsigned char *buf, size_t sz)
             }
         }
 
-        result = tls_io_instance->socket_io_read_byte_count;
-        if (result > (int)sz)
-        {
-            result = sz;
-        }
-
-        if (result > 0)
-        {
-            (void)memcpy((void *)buf, tls_io_instance->socket_io_read_bytes, result);
-            (void)memmove(tls_io_instance->socket_io_read_bytes, tls_io_instance->socket_io_read_bytes + result, tls_io_instance->socket_io_read_byte_count - result);
-            tls_io_instance->socket_io_read_byte_count -= result;
-            if (tls_io_instance->socket_io_read_byte_count > 0)
-            {
-                new_socket_io_read_bytes = (unsigned char *)realloc(tls_io_instance->socket_io_read_bytes, tls_io_instance->socket_io_read_byte_count);
-                if (new_socket_io_read_bytes != NULL)
-                {
-                    tls_io_instance->socket_io_read_bytes = new_socket_io_read_bytes;
-                }
-            }
-            else
-            {
-                free(tls_io_instance->socket_io_read_bytes);
-                tls_io_instance->socket_io_read_bytes = NULL;
-            }
-        }
+        result = (int)read_bytes_get(tls_io_instance, buf, sz);
 
         if ((result == 0) && (tls_io_instance->tlsio_state == TLSIO_STATE_OPEN))
         {
@@ -475,15 +553,24 @@ CONCRETE_IO_HANDLE tlsio_mbedtls_create(void *io_create_parameters)
                     result = NULL;
                     LogError("Failure allocating hostname.");
                 }
+                else if ((result->socket_io_read_bytes = (unsigned char *)malloc(TLSIO_MBEDTLS_RECV_BUFFER_SIZE)) == NULL)
+                {
+                    LogError("Failure allocating receive buffer.");
+                    free(result->hostname);
+                    free(result);
+                    result = NULL;
+                }
                 else if ((result->socket_io = xio_create(underlying_io_interface, io_interface_parameters)) == NULL)
                 {
                     LogError("socket xio create failed");
+                    free(result->socket_io_read_bytes);
                     free(result->hostname);
                     free(result);
                     result = NULL;
                 }
                 else
                 {
+                    result->socket_io_read_buffer_size = TLSIO_MBEDTLS_RECV_BUFFER_SIZE;
                     result->tls_status = TLS_STATE_NOT_INITIALIZED;
                     mbedtls_init((void*)result);
 
@@ -574,6 +661,10 @@ int tlsio_mbedtls_open(CONCRETE_IO_HANDLE tls_io, ON_IO_OPEN_COMPLETE on_io_open
 
             mbedtls_ssl_session_reset(&tls_io_instance->ssl);
 
+            // Drop any bytes left over from a previous connection
+            tls_io_instance->socket_io_read_head = 0;
+            tls_io_instance->socket_io_read_byte_count = 0;
+
             if (xio_open(tls_io_instance->socket_io, on_underlying_io_open_complete, tls_io_instance, on_underlying_io_bytes_received, tls_io_instance, on_underlying_io_error, tls_io_instance) != 0)
             {
 
@@ -279,6 +279,19 @@ typedef struct IOTHUB_CLIENT_CORE_LL_HANDLE_DATA_TAG* IOTHUB_CLIENT_LL_HANDLE;
     */
      MOCKABLE_FUNCTION(, IOTHUB_CLIENT_RESULT, IoTHubClient_LL_SetOption, IOTHUB_CLIENT_LL_HANDLE, iotHubClientHandle, const char*, optionName, const void*, value);
 
+    /**
+    * @brief    This API reads the current value of an option of the transport.
+    *
+    * @param    iotHubClientHandle    The handle created by a call to the create function.
+    * @param    optionName            Name of the option.
+    * @param    value                 Where the value of the option is written, its type depends on the option:
+    *              - @b max_inflight_messages - available for MQTT protocol, size_t.
+    *              - @b telemetry_stats - available for MQTT protocol, IOTHUB_CLIENT_TELEMETRY_STATS.
+    *
+    * @return    IOTHUB_CLIENT_OK upon success or an error code upon failure.
+    */
+     MOCKABLE_FUNCTION(, IOTHUB_CLIENT_RESULT, IoTHubClient_LL_GetOption, IOTHUB_CLIENT_LL_HANDLE, iotHubClientHandle, const char*, optionName, void*, value);
+
     /**
     * @brief    This API specifies a call back to be used when the device receives a desired state update.
     *
@@ -18,6 +18,24 @@ extern "C"
         const char* password;
     } IOTHUB_PROXY_OPTIONS;
 
+#define IOTHUB_CLIENT_RTT_HISTOGRAM_SIZE    8
+
+    /*
+    * @brief Telemetry counters returned by OPTION_TELEMETRY_STATS.
+    *        rtt_histogram counts the acknowledged messages by time between their last PUBLISH and the PUBACK:
+    *        below 50, 100, 200, 500 ms, 1, 2, 5 s, and 5 s or more.
+    */
+    typedef struct IOTHUB_CLIENT_TELEMETRY_STATS_TAG
+    {
+        size_t messages_sent;
+        size_t messages_resent;
+        size_t messages_acked;
+        size_t messages_timed_out;
+        size_t acks_outstanding;
+        size_t messages_per_sec;
+        size_t rtt_histogram[IOTHUB_CLIENT_RTT_HISTOGRAM_SIZE];
+    } IOTHUB_CLIENT_TELEMETRY_STATS;
+
     static STATIC_VAR_UNUSED const char* OPTION_LOG_TRACE = "logtrace";
     static STATIC_VAR_UNUSED const char* OPTION_X509_CERT = "x509certificate";
     static STATIC_VAR_UNUSED const char* OPTION_X509_PRIVATE_KEY = "x509privatekey";
@@ -45,6 +63,17 @@ extern "C"
     */
     static STATIC_VAR_UNUSED const char* OPTION_AUTO_URL_ENCODE_DECODE = "auto_url_encode_decode";
 
+    /*
+    * @brief    Maximum number of telemetry messages sent and not acknowledged yet (size_t, 0 for no limit, the default).
+    *           Queued messages are sent in the same DoWork call as long as the window is not full. Only valid for use with MQTT Transport
+    */
+    static STATIC_VAR_UNUSED const char* OPTION_MAX_INFLIGHT_MESSAGES = "max_inflight_messages";
+
+    /*
+    * @brief    Telemetry counters, read only with GetOption into a IOTHUB_CLIENT_TELEMETRY_STATS. Only valid for use with MQTT Transport
+    */
+    static STATIC_VAR_UNUSED const char* OPTION_TELEMETRY_STATS = "telemetry_stats";
+
     /*
     * @brief Informs the service of what is the maximum period the client will wait for a keep-alive message from the service.
     *        The service must send keep-alives before this timeout is reached, otherwise the client will trigger its re-connection logic.
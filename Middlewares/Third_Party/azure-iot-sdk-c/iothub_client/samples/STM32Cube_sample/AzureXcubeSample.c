@@ -27,6 +27,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <float.h>
+#include <math.h>
 
 /* The Azure model declaration defines many symbols which are unused. Mask the compilation warning. */
 #ifdef __ICCARM__             /* IAR */
@@ -124,6 +128,28 @@ MU_DEFINE_ENUM_STRINGS(FIRMWARE_UPDATE_STATUS, FIRMWARE_UPDATE_STATUS_VALUES)
 #define DEVICE_AUTH_DPS        (2U)  /* device registration via DPS procedure first     */
 #define DEVICE_AUTH_UNKNOWN    (3U)  /* method not recognized                           */
 
+/*
+ * Define AZURE_TELEMETRY_BATCH to sample the sensors every TELEMETRY_BATCH_SAMPLE_MS
+ * and publish the samples by batches: one message every TELEMETRY_BATCH_SIZE samples,
+ * or every TelemetryInterval seconds at most.
+ * This saves the per-message MQTT and TLS overhead on metered links.
+ */
+#if defined(AZURE_TELEMETRY_BATCH)
+#ifndef TELEMETRY_BATCH_SIZE
+#define TELEMETRY_BATCH_SIZE              10    /* Samples per message */
+#endif
+#ifndef TELEMETRY_BATCH_SAMPLE_MS
+#define TELEMETRY_BATCH_SAMPLE_MS         1000  /* Sensor sampling period */
+#endif
+#define TELEMETRY_BATCH_HEADER_MAX        64    /* Upper bound of the serialized message header and footer */
+#define TELEMETRY_BATCH_SAMPLE_MAX        256   /* Upper bound of one serialized sample */
+#define TELEMETRY_LOOP_WAIT_MS            (TELEMETRY_BATCH_SAMPLE_MS / 2)
+#else
+#define TELEMETRY_LOOP_WAIT_MS            500
+#define TELEMETRY_MESSAGE_MAX             768   /* Upper bound of one serialized message, with the longest float values */
+#define TELEMETRY_FLOAT_STRING_MAX        (DECIMAL_DIG * 2 + 2) /* Same bound as the serializer: longer floats are rejected */
+#endif /* AZURE_TELEMETRY_BATCH */
+
 
 /* Private typedef -----------------------------------------------------------*/
 typedef struct {
@@ -226,6 +252,57 @@ typedef struct {
   model_strings_t strings;
 } IotSampleDev_t;
 
+#if defined(AZURE_TELEMETRY_BATCH)
+typedef struct {
+  time_t ts;
+#ifdef SENSOR
+  float temperature;
+  float humidity;
+  float pressure;
+  int proximity;
+  float acc[3];
+  float gyr[3];
+  float mag[3];
+#endif /* SENSOR */
+} telemetry_sample_t;
+
+/* Fixed ring of samples: when a publication fails, the oldest samples are overwritten. */
+typedef struct {
+  telemetry_sample_t samples[TELEMETRY_BATCH_SIZE];
+  uint32_t head;                    /* Index of the oldest sample */
+  uint32_t count;
+  uint32_t first_sample_time_ms;    /* Tick of the oldest sample */
+} telemetry_batch_t;
+#else
+/*
+ * Telemetry schema: the model fields published by the telemetry loop, in publication order.
+ * The message is encoded from this table straight into a buffer, without any heap allocation,
+ * and is byte-identical to the SERIALIZE() output for the same fields.
+ */
+typedef enum {
+  TELEMETRY_FIELD_STRING,           /* ascii_char_ptr */
+  TELEMETRY_FIELD_FLOAT,            /* float */
+  TELEMETRY_FIELD_INT,              /* int */
+  TELEMETRY_FIELD_DATE_TIME_OFFSET  /* EDM_DATE_TIME_OFFSET */
+} telemetry_field_type_t;
+
+typedef struct {
+  const char *name;
+  telemetry_field_type_t type;
+  size_t offset;                    /* Offset of the field in SerializableIotSampleDev_t */
+} telemetry_field_t;
+
+/* Bump writer: each value is formatted in place, right after the previous one. */
+typedef struct {
+  char *buf;
+  size_t size;
+  size_t len;                       /* Always lower than size: room is kept for the string terminator */
+} telemetry_writer_t;
+#endif /* AZURE_TELEMETRY_BATCH */
+
+#define TELEMETRY_NAME_(x)  #x
+#define TELEMETRY_NAME(x)   TELEMETRY_NAME_(x)
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static bool g_continueRunning;
@@ -243,6 +320,32 @@ iot_state_t write_ota_state;
  */
 uint8_t g_deviceAuthMethod;
 
+#if !defined(AZURE_TELEMETRY_BATCH)
+#define TELEMETRY_FIELD(type, field)  { TELEMETRY_NAME(field), (type), offsetof(SerializableIotSampleDev_t, field) }
+static const telemetry_field_t telemetry_schema[] = {
+  TELEMETRY_FIELD(TELEMETRY_FIELD_STRING, mac),
+#if defined(AZURE_DPS_PROV)
+  TELEMETRY_FIELD(TELEMETRY_FIELD_STRING, deviceId),
+#endif /* AZURE_DPS_PROV */
+#ifdef SENSOR
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, TEMPERATURE),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, HUMIDITY),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, PRESSURE),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_INT, proximity),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, ACCELEROMETERX),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, ACCELEROMETERY),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, ACCELEROMETERZ),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, GYROSCOPEX),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, GYROSCOPEY),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, GYROSCOPEZ),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, MAGNETOMETERX),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, MAGNETOMETERY),
+  TELEMETRY_FIELD(TELEMETRY_FIELD_FLOAT, MAGNETOMETERZ),
+#endif /* SENSOR */
+  TELEMETRY_FIELD(TELEMETRY_FIELD_DATE_TIME_OFFSET, ts)
+};
+#endif /* AZURE_TELEMETRY_BATCH */
+
 /* Private function prototypes -----------------------------------------------*/
 int device_model_create(IotSampleDev_t **pModel);
 int device_model_destroy(IotSampleDev_t *model);
@@ -253,6 +356,14 @@ static void setDeviceRegistrationMethod(const char * connectionString);
 static void printDeviceRegistrationMethod(void);
 static int directIoTHubRegistration(IotSampleDev_t * pDevice, const char * pConnectionString, const char * pCaCert, const char *pClientCert, const char *pClientPrivateKey);
 static int setAllCallbacks(IotSampleDev_t * pDevice);
+static time_t ReadSensors(SerializableIotSampleDev_t * mdl);
+#if defined(AZURE_TELEMETRY_BATCH)
+static void TelemetryBatch_Push(telemetry_batch_t * batch, const SerializableIotSampleDev_t * mdl, time_t ts);
+static unsigned char * TelemetryBatch_Serialize(const telemetry_batch_t * batch, const SerializableIotSampleDev_t * mdl, size_t * pSize);
+#else
+static bool Telemetry_Serialize(const SerializableIotSampleDev_t * mdl, char * buf, size_t size, size_t * pSize);
+#endif /* AZURE_TELEMETRY_BATCH */
+static bool SendTelemetry(IotSampleDev_t * device, const unsigned char * payload, size_t payloadSize);
 
 /* Exported functions --------------------------------------------------------*/
 int cloud_device_enter_credentials(void)
@@ -1551,10 +1662,15 @@ void cloud_run(void const *arg)
     }
 
     /* Loop sending telemetry data. */
+#if defined(AZURE_TELEMETRY_BATCH)
+    static telemetry_batch_t batch;
+    uint32_t last_sample_time_ms = HAL_GetTick();
+#else
     uint32_t last_telemetry_time_ms = HAL_GetTick();
+#endif /* AZURE_TELEMETRY_BATCH */
     do
     {
-      uint8_t command = Button_WaitForMultiPush(500);
+      uint8_t command = Button_WaitForMultiPush(TELEMETRY_LOOP_WAIT_MS);
       bool b_sample_data = (command == BP_SINGLE_PUSH); /* If short button push, publish once. */
       if (command == BP_MULTIPLE_PUSH)                  /* If long button push, toggle the telemetry publication. */
       {
@@ -1562,90 +1678,69 @@ void cloud_run(void const *arg)
         msg_info("%s the sensor values publication loop.\n", (g_publishData == true) ? "Enter" : "Exit");
       }
 
+#if defined(AZURE_TELEMETRY_BATCH)
+      SerializableIotSampleDev_t * mdl = device->serModel;
+
+      if (((g_publishData == true) && (comp_left_ms(last_sample_time_ms, HAL_GetTick(), TELEMETRY_BATCH_SAMPLE_MS) <= 0))
+          || ((b_sample_data == true) && (batch.count == 0)))
+      {
+        last_sample_time_ms = HAL_GetTick();
+        TelemetryBatch_Push(&batch, mdl, ReadSensors(mdl));
+      }
+
+      /* Publish when the batch is full, when its oldest sample is TelemetryInterval old, or on request. */
+      if ((batch.count > 0)
+          && ((batch.count == TELEMETRY_BATCH_SIZE) || (b_sample_data == true)
+              || (comp_left_ms(batch.first_sample_time_ms, HAL_GetTick(), mdl->TelemetryInterval * 1000) <= 0)))
+      {
+        unsigned char* destination;
+        size_t destinationSize;
+
+        if ((destination = TelemetryBatch_Serialize(&batch, mdl, &destinationSize)) == NULL)
+        {
+          msg_error("Failed to serialize.\n");
+        }
+        else
+        {
+          if (SendTelemetry(device, destination, destinationSize) == true)
+          {
+            /* The message is queued by the IoT Hub client: start a new batch.
+               Otherwise the samples are kept, and sent with the next publication. */
+            batch.count = 0;
+            batch.head = 0;
+          }
+          free(destination);
+        }
+
+        /* Visual notification of the telemetry publication: LED blink. */
+        Led_Blink(80, 40, 5);
+        /* Restore the LED state */
+        Led_SetState(device->serModel->LedStatusOn);
+      }
+#else
       int32_t left_ms = comp_left_ms(last_telemetry_time_ms, HAL_GetTick(), device->serModel->TelemetryInterval * 1000);
 
       if ( ((g_publishData == true) && (left_ms <= 0))
           || (b_sample_data == true) )
       {
         SerializableIotSampleDev_t * mdl = device->serModel;
-        unsigned char* destination;
+        /* The message is copied by IoTHubMessage_CreateFromByteArray(): the buffer can be reused. */
+        static char destination[TELEMETRY_MESSAGE_MAX];
         size_t destinationSize;
 
         last_telemetry_time_ms = HAL_GetTick();
 
         /* Read the Data from the sensors */
-        time_t time = TimingSystemGetSystemTime();
-        memset(&mdl->ts.dateTime, 0, sizeof(EDM_DATE_TIME_OFFSET));
-        mdl->ts.dateTime = *(gmtime(&time));
-        {
-#ifdef SENSOR
-#define INSTANCE_TEMPERATURE_HUMIDITY 0
-#define INSTANCE_TEMPERATURE_PRESSURE 1
-#define INSTANCE_GYROSCOPE_ACCELEROMETER 0
-#define INSTANCE_MAGNETOMETER 1
-          BSP_MOTION_SENSOR_Axes_t acc_value;
-          BSP_MOTION_SENSOR_Axes_t gyr_value;
-          BSP_MOTION_SENSOR_Axes_t mag_value;
-          BSP_ENV_SENSOR_GetValue(INSTANCE_TEMPERATURE_HUMIDITY, ENV_TEMPERATURE, &mdl->TEMPERATURE);
-          BSP_ENV_SENSOR_GetValue(INSTANCE_TEMPERATURE_HUMIDITY, ENV_HUMIDITY, &mdl->HUMIDITY);
-          BSP_ENV_SENSOR_GetValue(INSTANCE_TEMPERATURE_PRESSURE, ENV_PRESSURE, &mdl->PRESSURE);
-          mdl->proximity = VL53L0X_PROXIMITY_GetDistance();
-          BSP_MOTION_SENSOR_GetAxes(INSTANCE_GYROSCOPE_ACCELEROMETER, MOTION_ACCELERO, &acc_value);
-          mdl->ACCELEROMETERX = acc_value.x;
-          mdl->ACCELEROMETERY = acc_value.y;
-          mdl->ACCELEROMETERZ = acc_value.z;
-          BSP_MOTION_SENSOR_GetAxes(INSTANCE_GYROSCOPE_ACCELEROMETER, MOTION_GYRO, &gyr_value);
-          mdl->GYROSCOPEX = gyr_value.x;
-          mdl->GYROSCOPEY = gyr_value.y;
-          mdl->GYROSCOPEZ = gyr_value.z;
-          BSP_MOTION_SENSOR_GetAxes(INSTANCE_MAGNETOMETER, MOTION_MAGNETO, &mag_value);
-          mdl->MAGNETOMETERX = mag_value.x;
-          mdl->MAGNETOMETERY = mag_value.y;
-          mdl->MAGNETOMETERZ = mag_value.z;
-
-          /* Serialize the device data. */
-          if (SERIALIZE(&destination, &destinationSize,
-                mdl->mac,
-#if defined(AZURE_DPS_PROV)
-                mdl->deviceId,
-#endif /* AZURE_DPS_PROV */
-                mdl->TEMPERATURE, mdl->HUMIDITY, mdl->PRESSURE, mdl->proximity,
-                mdl->ACCELEROMETERX , mdl->ACCELEROMETERY, mdl->ACCELEROMETERZ,
-                mdl->GYROSCOPEX , mdl->GYROSCOPEY, mdl->GYROSCOPEZ,
-                mdl->MAGNETOMETERX , mdl->MAGNETOMETERY, mdl->MAGNETOMETERZ,
-                mdl->ts) != CODEFIRST_OK)
-#else /* SENSOR */
-          /* Serialize the device data. */
-          if (SERIALIZE(&destination, &destinationSize,
-                mdl->mac,
-#if defined(AZURE_DPS_PROV)
-                mdl->deviceId,
-#endif /* AZURE_DPS_PROV */
-                mdl->ts) != CODEFIRST_OK)
-#endif /* SENSOR */
-          {
-            msg_error("Failed to serialize.\n");
-          }
-          else
-          {
-            IOTHUB_MESSAGE_HANDLE msgHnd = NULL;
-            /* Create the message. */
-            /* Note: The message is destroyed by the confirmation callback. */
-            if ((msgHnd = IoTHubMessage_CreateFromByteArray(destination, destinationSize)) == NULL)
-            {
-              msg_error("Failed allocating an iotHubMessage.\n");
-            }
-            else
-            {
-              /* Send the message. */
-              if (IoTHubClient_LL_SendEventAsync(device->iotHubClientHandle, msgHnd, SendConfirmationCallback, msgHnd) != IOTHUB_CLIENT_OK)
-              {
-                msg_error("IoTHubClient_LL_SendEventAsync failed.\n");
-              }
+        (void) ReadSensors(mdl);
 
-            }
-            free(destination);
-          }
+        /* Serialize the device data. */
+        if (Telemetry_Serialize(mdl, destination, sizeof(destination), &destinationSize) == false)
+        {
+          msg_error("Failed to serialize.\n");
+        }
+        else
+        {
+          SendTelemetry(device, (const unsigned char *) destination, destinationSize);
         }
 
         /* Visual notification of the telemetry publication: LED blink. */
@@ -1653,6 +1748,7 @@ void cloud_run(void const *arg)
         /* Restore the LED state */
         Led_SetState(device->serModel->LedStatusOn);
       }
+#endif /* AZURE_TELEMETRY_BATCH */
 
       for (size_t index = 0; index < DOWORK_LOOP_NUM; index++)
       {
@@ -1726,7 +1822,7 @@ void cloud_run(void const *arg)
       }
 #endif /* CLD_OTA */
 
-      ThreadAPI_Sleep(500);
+      ThreadAPI_Sleep(TELEMETRY_LOOP_WAIT_MS);
     } while (g_continueRunning && !g_reboot);
 
     msg_info("cloud_run / iothub_client_XCube_sample_run exited, call DoWork %d more time to complete final sending...\n", DOWORK_LOOP_NUM);
@@ -1766,6 +1862,352 @@ void cloud_run(void const *arg)
 }
 
 
+/**
+ * @brief   Read the sensors into the model.
+ * @param   In: mdl   Model instance
+ * @retval  Sampling time
+ */
+static time_t ReadSensors(SerializableIotSampleDev_t * mdl)
+{
+  time_t time = TimingSystemGetSystemTime();
+  memset(&mdl->ts.dateTime, 0, sizeof(EDM_DATE_TIME_OFFSET));
+  mdl->ts.dateTime = *(gmtime(&time));
+#ifdef SENSOR
+#define INSTANCE_TEMPERATURE_HUMIDITY 0
+#define INSTANCE_TEMPERATURE_PRESSURE 1
+#define INSTANCE_GYROSCOPE_ACCELEROMETER 0
+#define INSTANCE_MAGNETOMETER 1
+  BSP_MOTION_SENSOR_Axes_t acc_value;
+  BSP_MOTION_SENSOR_Axes_t gyr_value;
+  BSP_MOTION_SENSOR_Axes_t mag_value;
+  BSP_ENV_SENSOR_GetValue(INSTANCE_TEMPERATURE_HUMIDITY, ENV_TEMPERATURE, &mdl->TEMPERATURE);
+  BSP_ENV_SENSOR_GetValue(INSTANCE_TEMPERATURE_HUMIDITY, ENV_HUMIDITY, &mdl->HUMIDITY);
+  BSP_ENV_SENSOR_GetValue(INSTANCE_TEMPERATURE_PRESSURE, ENV_PRESSURE, &mdl->PRESSURE);
+  mdl->proximity = VL53L0X_PROXIMITY_GetDistance();
+  BSP_MOTION_SENSOR_GetAxes(INSTANCE_GYROSCOPE_ACCELEROMETER, MOTION_ACCELERO, &acc_value);
+  mdl->ACCELEROMETERX = acc_value.x;
+  mdl->ACCELEROMETERY = acc_value.y;
+  mdl->ACCELEROMETERZ = acc_value.z;
+  BSP_MOTION_SENSOR_GetAxes(INSTANCE_GYROSCOPE_ACCELEROMETER, MOTION_GYRO, &gyr_value);
+  mdl->GYROSCOPEX = gyr_value.x;
+  mdl->GYROSCOPEY = gyr_value.y;
+  mdl->GYROSCOPEZ = gyr_value.z;
+  BSP_MOTION_SENSOR_GetAxes(INSTANCE_MAGNETOMETER, MOTION_MAGNETO, &mag_value);
+  mdl->MAGNETOMETERX = mag_value.x;
+  mdl->MAGNETOMETERY = mag_value.y;
+  mdl->MAGNETOMETERZ = mag_value.z;
+#endif /* SENSOR */
+  return time;
+}
+
+/**
+ * @brief   Send a telemetry message to the IoT Hub.
+ * @note    The message is destroyed by the confirmation callback.
+ * @param   In: device        Device instance
+ * @param   In: payload       Serialized telemetry (JSON)
+ * @param   In: payloadSize   Payload size
+ * @retval  true if the message is queued for sending.
+ */
+static bool SendTelemetry(IotSampleDev_t * device, const unsigned char * payload, size_t payloadSize)
+{
+  IOTHUB_MESSAGE_HANDLE msgHnd = NULL;
+  bool ret = false;
+
+  /* Create the message. */
+  if ((msgHnd = IoTHubMessage_CreateFromByteArray(payload, payloadSize)) == NULL)
+  {
+    msg_error("Failed allocating an iotHubMessage.\n");
+  }
+  else
+  {
+#if defined(AZURE_TELEMETRY_BATCH)
+    /* Let the IoT Hub route on the message body. */
+    (void) IoTHubMessage_SetContentTypeSystemProperty(msgHnd, "application/json");
+    (void) IoTHubMessage_SetContentEncodingSystemProperty(msgHnd, "utf-8");
+#endif /* AZURE_TELEMETRY_BATCH */
+    /* Send the message. */
+    if (IoTHubClient_LL_SendEventAsync(device->iotHubClientHandle, msgHnd, SendConfirmationCallback, msgHnd) != IOTHUB_CLIENT_OK)
+    {
+      msg_error("IoTHubClient_LL_SendEventAsync failed.\n");
+      /* The confirmation callback will not be called. */
+      IoTHubMessage_Destroy(msgHnd);
+    }
+    else
+    {
+      ret = true;
+    }
+  }
+  return ret;
+}
+
+#if !defined(AZURE_TELEMETRY_BATCH)
+/**
+ * @brief   Append formatted text to the telemetry message.
+ * @param   In: w        Writer
+ * @param   In: format   printf() format
+ * @retval  false if the text does not fit.
+ */
+static bool TelemetryWriter_Printf(telemetry_writer_t * w, const char * format, ...)
+{
+  va_list args;
+  int n;
+
+  va_start(args, format);
+  n = vsnprintf(w->buf + w->len, w->size - w->len, format, args);
+  va_end(args);
+
+  if ((n < 0) || ((size_t) n >= (w->size - w->len)))
+  {
+    return false;
+  }
+  w->len += n;
+  return true;
+}
+
+/**
+ * @brief   Append a quoted JSON string, escaped as by AgentDataTypes_ToString().
+ * @param   In: w   Writer
+ * @param   In: s   ASCII string
+ * @retval  false if the string is NULL, is not ASCII, or does not fit.
+ */
+static bool TelemetryWriter_String(telemetry_writer_t * w, const char * s)
+{
+  static const char hex[] = "0123456789ABCDEF";
+  bool ret = (s != NULL) && TelemetryWriter_Printf(w, "\"");
+
+  for (; (ret == true) && (*s != '\0'); s++)
+  {
+    if ((unsigned char) *s >= 128)
+    {
+      ret = false;  /* The serializer rejects the non-ASCII strings. */
+    }
+    else if (*s <= 0x1F)
+    {
+      ret = TelemetryWriter_Printf(w, "\\u00%c%c", hex[(*s & 0xF0) >> 4], hex[*s & 0x0F]);
+    }
+    else if ((*s == '"') || (*s == '\\') || (*s == '/'))
+    {
+      ret = TelemetryWriter_Printf(w, "\\%c", *s);
+    }
+    else if ((w->len + 1) < w->size)
+    {
+      w->buf[w->len++] = *s;
+    }
+    else
+    {
+      ret = false;
+    }
+  }
+  return ret && TelemetryWriter_Printf(w, "\"");
+}
+
+/**
+ * @brief   Append an EDM_DATE_TIME_OFFSET value, formatted as by AgentDataTypes_ToString().
+ * @param   In: w    Writer
+ * @param   In: dt   Value
+ * @retval  false if the value does not fit.
+ */
+static bool TelemetryWriter_DateTimeOffset(telemetry_writer_t * w, const EDM_DATE_TIME_OFFSET * dt)
+{
+  bool ret = TelemetryWriter_Printf(w, "\"%.4d-%.2d-%.2dT%.2d:%.2d:%.2d",
+                                    dt->dateTime.tm_year + 1900, dt->dateTime.tm_mon + 1, dt->dateTime.tm_mday,
+                                    dt->dateTime.tm_hour, dt->dateTime.tm_min, dt->dateTime.tm_sec);
+
+  if ((ret == true) && (dt->hasFractionalSecond))
+  {
+    ret = TelemetryWriter_Printf(w, ".%.12llu", (unsigned long long) dt->fractionalSecond);
+  }
+  if (ret == true)
+  {
+    ret = (dt->hasTimeZone) ? TelemetryWriter_Printf(w, "%+.2d:%.2d\"", dt->timeZoneHour, dt->timeZoneMinute)
+                            : TelemetryWriter_Printf(w, "Z\"");
+  }
+  return ret;
+}
+
+/**
+ * @brief   Serialize the telemetry schema fields of the model into a caller buffer.
+ *          The output is the same as SERIALIZE() of these fields, but nothing is allocated:
+ *          {"mac":"...", "temp":24.500000, ..., "ts":"2019-01-01T00:00:00Z"}
+ * @param   In: mdl     Model instance
+ * @param   Out: buf    Message buffer
+ * @param   In: size    Buffer size
+ * @param   Out: pSize  Message size
+ * @retval  false if a value cannot be serialized, or if the message does not fit.
+ */
+static bool Telemetry_Serialize(const SerializableIotSampleDev_t * mdl, char * buf, size_t size, size_t * pSize)
+{
+  telemetry_writer_t w = { buf, size, 0 };
+  bool ret = (size > 0) && TelemetryWriter_Printf(&w, "{");
+
+  for (size_t i = 0; (ret == true) && (i < (sizeof(telemetry_schema) / sizeof(telemetry_schema[0]))); i++)
+  {
+    const telemetry_field_t *field = &telemetry_schema[i];
+    const void *value = (const uint8_t *) mdl + field->offset;
+
+    ret = TelemetryWriter_Printf(&w, "%s\"%s\":", (i == 0) ? "" : ", ", field->name);
+    if (ret == true)
+    {
+      switch (field->type)
+      {
+        case TELEMETRY_FIELD_STRING:
+          ret = TelemetryWriter_String(&w, *(const ascii_char_ptr *) value);
+          break;
+        case TELEMETRY_FIELD_FLOAT:
+        {
+          float f = *(const float *) value;
+          if (ISNAN(f))
+          {
+            ret = TelemetryWriter_Printf(&w, "NaN");
+          }
+          else if (ISNEGATIVEINFINITY(f))
+          {
+            ret = TelemetryWriter_Printf(&w, "-INF");
+          }
+          else if (ISPOSITIVEINFINITY(f))
+          {
+            ret = TelemetryWriter_Printf(&w, "INF");
+          }
+          else
+          {
+            size_t start = w.len;
+            ret = TelemetryWriter_Printf(&w, "%.*f", FLT_DIG, (double) f) && ((w.len - start) < TELEMETRY_FLOAT_STRING_MAX);
+          }
+          break;
+        }
+        case TELEMETRY_FIELD_INT:
+          ret = TelemetryWriter_Printf(&w, "%d", *(const int *) value);
+          break;
+        case TELEMETRY_FIELD_DATE_TIME_OFFSET:
+          ret = TelemetryWriter_DateTimeOffset(&w, (const EDM_DATE_TIME_OFFSET *) value);
+          break;
+        default:
+          ret = false;
+          break;
+      }
+    }
+  }
+  ret = ret && TelemetryWriter_Printf(&w, "}");
+
+  if (ret == false)
+  {
+    msg_error("Telemetry message does not fit in %u bytes, or has an invalid value.\n", size);
+  }
+  *pSize = w.len;
+  return ret;
+}
+#endif /* AZURE_TELEMETRY_BATCH */
+
+#if defined(AZURE_TELEMETRY_BATCH)
+/**
+ * @brief   Append the sensor values of the model to the batch.
+ * @param   In: batch   Sample batch
+ * @param   In: mdl     Model instance, just updated by ReadSensors()
+ * @param   In: ts      Sampling time
+ */
+static void TelemetryBatch_Push(telemetry_batch_t * batch, const SerializableIotSampleDev_t * mdl, time_t ts)
+{
+  telemetry_sample_t *sample;
+
+  if (batch->count == TELEMETRY_BATCH_SIZE)
+  {
+    /* Full: drop the oldest sample */
+    batch->head = (batch->head + 1) % TELEMETRY_BATCH_SIZE;
+    batch->count--;
+  }
+  if (batch->count == 0)
+  {
+    batch->first_sample_time_ms = HAL_GetTick();
+  }
+  sample = &batch->samples[(batch->head + batch->count) % TELEMETRY_BATCH_SIZE];
+  batch->count++;
+
+  sample->ts = ts;
+#ifdef SENSOR
+  sample->temperature = mdl->TEMPERATURE;
+  sample->humidity = mdl->HUMIDITY;
+  sample->pressure = mdl->PRESSURE;
+  sample->proximity = mdl->proximity;
+  sample->acc[0] = mdl->ACCELEROMETERX;
+  sample->acc[1] = mdl->ACCELEROMETERY;
+  sample->acc[2] = mdl->ACCELEROMETERZ;
+  sample->gyr[0] = mdl->GYROSCOPEX;
+  sample->gyr[1] = mdl->GYROSCOPEY;
+  sample->gyr[2] = mdl->GYROSCOPEZ;
+  sample->mag[0] = mdl->MAGNETOMETERX;
+  sample->mag[1] = mdl->MAGNETOMETERY;
+  sample->mag[2] = mdl->MAGNETOMETERZ;
+#else
+  (void) mdl;
+#endif /* SENSOR */
+}
+
+/**
+ * @brief   Serialize the batch as one compact JSON message:
+ *          {"mac":"...","samples":[{"ts":<epoch seconds>,"temp":...},...]}
+ * @note    The batch is left unchanged: it is emptied once the message is sent.
+ * @param   In: batch   Sample batch
+ * @param   In: mdl     Model instance, for the device identification
+ * @param   Out: pSize  Message size
+ * @retval  Allocated message, to be freed by the caller, or NULL on error.
+ */
+static unsigned char * TelemetryBatch_Serialize(const telemetry_batch_t * batch, const SerializableIotSampleDev_t * mdl, size_t * pSize)
+{
+  size_t size = TELEMETRY_BATCH_HEADER_MAX + MODEL_MAC_SIZE + MODEL_DEVICEID_SIZE + (batch->count * TELEMETRY_BATCH_SAMPLE_MAX);
+  char *buf = malloc(size);
+  size_t len = 0;
+
+  if (buf == NULL)
+  {
+    return NULL;
+  }
+
+#if defined(AZURE_DPS_PROV)
+  len += snprintf(buf + len, size - len, "{\"mac\":\"%s\",\"deviceId\":\"%s\",\"samples\":[", mdl->mac, mdl->deviceId);
+#else
+  len += snprintf(buf + len, size - len, "{\"mac\":\"%s\",\"samples\":[", mdl->mac);
+#endif /* AZURE_DPS_PROV */
+  for (uint32_t i = 0; (i < batch->count) && (len < size); i++)
+  {
+    const telemetry_sample_t *sample = &batch->samples[(batch->head + i) % TELEMETRY_BATCH_SIZE];
+    len += snprintf(buf + len, size - len, "%s{\"ts\":%lu", (i == 0) ? "" : ",", (unsigned long) sample->ts);
+#ifdef SENSOR
+    if (len < size)
+    {
+      len += snprintf(buf + len, size - len,
+                      ",\"" TELEMETRY_NAME(TEMPERATURE) "\":%.2f,\"" TELEMETRY_NAME(HUMIDITY) "\":%.2f"
+                      ",\"" TELEMETRY_NAME(PRESSURE) "\":%.2f,\"proximity\":%d"
+                      ",\"" TELEMETRY_NAME(ACCELEROMETERX) "\":%.0f,\"" TELEMETRY_NAME(ACCELEROMETERY) "\":%.0f,\"" TELEMETRY_NAME(ACCELEROMETERZ) "\":%.0f"
+                      ",\"" TELEMETRY_NAME(GYROSCOPEX) "\":%.0f,\"" TELEMETRY_NAME(GYROSCOPEY) "\":%.0f,\"" TELEMETRY_NAME(GYROSCOPEZ) "\":%.0f"
+                      ",\"" TELEMETRY_NAME(MAGNETOMETERX) "\":%.0f,\"" TELEMETRY_NAME(MAGNETOMETERY) "\":%.0f,\"" TELEMETRY_NAME(MAGNETOMETERZ) "\":%.0f",
+                      sample->temperature, sample->humidity, sample->pressure, sample->proximity,
+                      sample->acc[0], sample->acc[1], sample->acc[2],
+                      sample->gyr[0], sample->gyr[1], sample->gyr[2],
+                      sample->mag[0], sample->mag[1], sample->mag[2]);
+    }
+#endif /* SENSOR */
+    if (len < size)
+    {
+      len += snprintf(buf + len, size - len, "}");
+    }
+  }
+  if (len < size)
+  {
+    len += snprintf(buf + len, size - len, "]}");
+  }
+
+  if (len >= size)
+  {
+    msg_error("Telemetry batch does not fit in %u bytes.\n", size);
+    free(buf);
+    return NULL;
+  }
+
+  *pSize = len;
+  return (unsigned char *) buf;
+}
+#endif /* AZURE_TELEMETRY_BATCH */
+
 int device_model_create(IotSampleDev_t ** pDev)
 {
   int ret = -1;
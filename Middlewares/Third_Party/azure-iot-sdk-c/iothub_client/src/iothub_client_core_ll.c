@@ -272,6 +272,7 @@ static void setTransportProtocol(IOTHUB_CLIENT_CORE_LL_HANDLE_DATA* handleData,
     handleData->IoTHubTransport_SendMessageDisposition = protocol->IoTHubTransport_SendMessageDisposition;
     handleData->IoTHubTransport_GetHostname = protocol->IoTHubTransport_GetHostname;
     handleData->IoTHubTransport_SetOption = protocol->IoTHubTransport_SetOption;
+    handleData->IoTHubTransport_GetOption = protocol->IoTHubTransport_GetOption;
     handleData->IoTHubTransport_Create = protocol->IoTHubTransport_Create;
     handleData->IoTHubTransport_Destroy = protocol->IoTHubTransport_Destroy;
     handleData->IoTHubTransport_Register = protocol->IoTHubTransport_Register;
@@ -2324,6 +2325,38 @@ IOTHUB_CLIENT_RESULT IoTHubClientCore_LL_SetOption(IOTHUB_CLIENT_CORE_LL_HANDLE
     return result;
 }
 
+IOTHUB_CLIENT_RESULT IoTHubClientCore_LL_GetOption(IOTHUB_CLIENT_CORE_LL_HANDLE iotHubClientHandle, const char* optionName, void* value)
+{
+    IOTHUB_CLIENT_RESULT result;
+    if (
+        (iotHubClientHandle == NULL) ||
+        (optionName == NULL) ||
+        (value == NULL)
+        )
+    {
+        result = IOTHUB_CLIENT_INVALID_ARG;
+        LogError("invalid argument (NULL)");
+    }
+    else
+    {
+        IOTHUB_CLIENT_CORE_LL_HANDLE_DATA* handleData = (IOTHUB_CLIENT_CORE_LL_HANDLE_DATA*)iotHubClientHandle;
+        if (handleData->IoTHubTransport_GetOption == NULL)
+        {
+            LogError("GetOption is not supported by the transport");
+            result = IOTHUB_CLIENT_ERROR;
+        }
+        else
+        {
+            result = handleData->IoTHubTransport_GetOption(handleData->transportHandle, optionName, value);
+            if (result != IOTHUB_CLIENT_OK)
+            {
+                LogError("unable to IoTHubTransport_GetOption");
+            }
+        }
+    }
+    return result;
+}
+
 IOTHUB_CLIENT_RESULT IoTHubClientCore_LL_SetDeviceTwinCallback(IOTHUB_CLIENT_CORE_LL_HANDLE iotHubClientHandle, IOTHUB_CLIENT_DEVICE_TWIN_CALLBACK deviceTwinCallback, void* userContextCallback)
 {
     IOTHUB_CLIENT_RESULT result;
@@ -129,6 +129,7 @@ TRANSPORT_HANDLE IoTHubTransport_Create(IOTHUB_CLIENT_TRANSPORT_PROVIDER protoco
                         result->workerThreadHandle = NULL; /* create thread when work needs to be done */
                         result->IoTHubTransport_GetHostname = transportProtocol->IoTHubTransport_GetHostname;
                         result->IoTHubTransport_SetOption = transportProtocol->IoTHubTransport_SetOption;
+                        result->IoTHubTransport_GetOption = transportProtocol->IoTHubTransport_GetOption;
                         result->IoTHubTransport_Create = transportProtocol->IoTHubTransport_Create;
                         result->IoTHubTransport_Destroy = transportProtocol->IoTHubTransport_Destroy;
                         result->IoTHubTransport_Register = transportProtocol->IoTHubTransport_Register;
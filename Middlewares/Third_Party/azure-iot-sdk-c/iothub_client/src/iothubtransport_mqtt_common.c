@@ -45,6 +45,8 @@
 #define SAS_TOKEN_DEFAULT_LEN               10
 #define RESEND_TIMEOUT_VALUE_MIN            1*60
 #define MAX_SEND_RECOUNT_LIMIT              2
+#define TELEMETRY_ACK_MAP_INITIAL_SIZE      16 // Power of 2, doubled when half full
+#define TELEMETRY_RATE_WINDOW_MS            1000
 #define DEFAULT_CONNECTION_INTERVAL         30
 #define FAILED_CONN_BACKOFF_VALUE           5
 #define STATUS_CODE_FAILURE_VALUE           500
@@ -217,7 +219,16 @@ typedef struct MQTTTRANSPORT_HANDLE_DATA_TAG
     CONTROL_PACKET_TYPE currPacketState;
 
     // Telemetry specific
+    // Messages waiting for their PUBACK, ordered by msgPublishTime, and indexed by packet_id
+    // in an open addressing table (linear probing, telemetry_ackMapSize is a power of 2)
     DLIST_ENTRY telemetry_waitingForAck;
+    struct MQTT_MESSAGE_DETAILS_LIST_TAG** telemetry_ackMap;
+    size_t telemetry_ackMapSize;
+    size_t telemetry_ackMapCount;
+    size_t max_inflight_messages; // 0: no limit
+    IOTHUB_CLIENT_TELEMETRY_STATS telemetry_stats;
+    tickcounter_ms_t telemetry_rate_start;
+    size_t telemetry_rate_acks;
     bool auto_url_encode_decode;
 
     // Controls frequency of reconnection logic.
@@ -328,6 +339,7 @@ static void free_transport_handle_data(MQTTTRANSPORT_HANDLE_DATA* transport_data
     STRING_delete(transport_data->topic_DeviceMethods);
     STRING_delete(transport_data->topic_InputQueue);
 
+    free(transport_data->telemetry_ackMap);
     free(transport_data);
 }
 
@@ -381,6 +393,128 @@ static uint16_t get_next_packet_id(PMQTTTRANSPORT_HANDLE_DATA transport_data)
     return transport_data->packetId;
 }
 
+// Upper bounds in ms of the IOTHUB_CLIENT_TELEMETRY_STATS rtt_histogram buckets, the last one has none
+static const tickcounter_ms_t TELEMETRY_RTT_BUCKETS_MS[IOTHUB_CLIENT_RTT_HISTOGRAM_SIZE - 1] = { 50, 100, 200, 500, 1000, 2000, 5000 };
+
+static void update_telemetry_rate(PMQTTTRANSPORT_HANDLE_DATA transport_data, tickcounter_ms_t current_ms)
+{
+    tickcounter_ms_t elapsed = current_ms - transport_data->telemetry_rate_start;
+    if (elapsed >= TELEMETRY_RATE_WINDOW_MS)
+    {
+        transport_data->telemetry_stats.messages_per_sec = (size_t)((transport_data->telemetry_rate_acks * 1000) / elapsed);
+        transport_data->telemetry_rate_start = current_ms;
+        transport_data->telemetry_rate_acks = 0;
+    }
+}
+
+static void record_telemetry_ack(PMQTTTRANSPORT_HANDLE_DATA transport_data, tickcounter_ms_t publish_time)
+{
+    tickcounter_ms_t current_ms;
+    if (tickcounter_get_current_ms(transport_data->msgTickCounter, &current_ms) == 0)
+    {
+        tickcounter_ms_t rtt = current_ms - publish_time;
+        size_t bucket = 0;
+        while (bucket < IOTHUB_CLIENT_RTT_HISTOGRAM_SIZE - 1 && rtt >= TELEMETRY_RTT_BUCKETS_MS[bucket])
+        {
+            bucket++;
+        }
+        transport_data->telemetry_stats.rtt_histogram[bucket]++;
+
+        update_telemetry_rate(transport_data, current_ms);
+        transport_data->telemetry_rate_acks++;
+    }
+    transport_data->telemetry_stats.messages_acked++;
+}
+
+static size_t get_ack_map_index(PMQTTTRANSPORT_HANDLE_DATA transport_data, uint16_t packet_id)
+{
+    return (size_t)packet_id & (transport_data->telemetry_ackMapSize - 1);
+}
+
+static int add_telemetry_waiting_ack(PMQTTTRANSPORT_HANDLE_DATA transport_data, MQTT_MESSAGE_DETAILS_LIST* msg_entry)
+{
+    int result = 0;
+    if ((transport_data->telemetry_ackMapCount + 1) * 2 > transport_data->telemetry_ackMapSize)
+    {
+        size_t old_size = transport_data->telemetry_ackMapSize;
+        MQTT_MESSAGE_DETAILS_LIST** old_map = transport_data->telemetry_ackMap;
+        size_t new_size = (old_size == 0) ? TELEMETRY_ACK_MAP_INITIAL_SIZE : old_size * 2;
+        MQTT_MESSAGE_DETAILS_LIST** new_map = (MQTT_MESSAGE_DETAILS_LIST**)calloc(new_size, sizeof(MQTT_MESSAGE_DETAILS_LIST*));
+        if (new_map == NULL)
+        {
+            LogError("Failure allocating the telemetry ack map");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            size_t index;
+            transport_data->telemetry_ackMap = new_map;
+            transport_data->telemetry_ackMapSize = new_size;
+            transport_data->telemetry_ackMapCount = 0;
+            for (index = 0; index < old_size; index++)
+            {
+                if (old_map[index] != NULL)
+                {
+                    (void)add_telemetry_waiting_ack(transport_data, old_map[index]);
+                }
+            }
+            free(old_map);
+        }
+    }
+
+    if (result == 0)
+    {
+        size_t index = get_ack_map_index(transport_data, msg_entry->packet_id);
+        while (transport_data->telemetry_ackMap[index] != NULL)
+        {
+            index = (index + 1) & (transport_data->telemetry_ackMapSize - 1);
+        }
+        transport_data->telemetry_ackMap[index] = msg_entry;
+        transport_data->telemetry_ackMapCount++;
+    }
+    return result;
+}
+
+// Returns the first message waiting for packet_id, or msg_entry itself when it is not NULL
+static MQTT_MESSAGE_DETAILS_LIST* remove_telemetry_waiting_ack(PMQTTTRANSPORT_HANDLE_DATA transport_data, uint16_t packet_id, MQTT_MESSAGE_DETAILS_LIST* msg_entry)
+{
+    MQTT_MESSAGE_DETAILS_LIST* result = NULL;
+    if (transport_data->telemetry_ackMapSize != 0)
+    {
+        size_t mask = transport_data->telemetry_ackMapSize - 1;
+        size_t index = get_ack_map_index(transport_data, packet_id);
+        while (transport_data->telemetry_ackMap[index] != NULL &&
+            (transport_data->telemetry_ackMap[index]->packet_id != packet_id || (msg_entry != NULL && transport_data->telemetry_ackMap[index] != msg_entry)))
+        {
+            index = (index + 1) & mask;
+        }
+
+        if (transport_data->telemetry_ackMap[index] != NULL)
+        {
+            size_t next = (index + 1) & mask;
+            result = transport_data->telemetry_ackMap[index];
+            transport_data->telemetry_ackMap[index] = NULL;
+            transport_data->telemetry_ackMapCount--;
+
+            // Shift back the following entries of the probe sequence which can no longer be reached
+            while (transport_data->telemetry_ackMap[next] != NULL)
+            {
+                size_t home = get_ack_map_index(transport_data, transport_data->telemetry_ackMap[next]->packet_id);
+                if (((next - home) & mask) >= ((next - index) & mask))
+                {
+                    transport_data->telemetry_ackMap[index] = transport_data->telemetry_ackMap[next];
+                    transport_data->telemetry_ackMap[next] = NULL;
+                    index = next;
+                }
+                next = (next + 1) & mask;
+            }
+
+            (void)DList_RemoveEntryList(&result->entry);
+        }
+    }
+    return result;
+}
+
 #ifndef NO_LOGGING
 static const char* retrieve_mqtt_return_codes(CONNECT_RETURN_CODE rtn_code)
 {
@@ -867,6 +1001,14 @@ static int publish_mqtt_telemetry_msg(PMQTTTRANSPORT_HANDLE_DATA transport_data,
                 }
                 else
                 {
+                    if (mqttMsgEntry->retryCount == 0)
+                    {
+                        transport_data->telemetry_stats.messages_sent++;
+                    }
+                    else
+                    {
+                        transport_data->telemetry_stats.messages_resent++;
+                    }
                     mqttMsgEntry->retryCount++;
                     result = 0;
                 }
@@ -1667,20 +1809,12 @@ static void mqtt_operation_complete_callback(MQTT_CLIENT_HANDLE handle, MQTT_CLI
                 const PUBLISH_ACK* puback = (const PUBLISH_ACK*)msgInfo;
                 if (puback != NULL)
                 {
-                    PDLIST_ENTRY currentListEntry = transport_data->telemetry_waitingForAck.Flink;
-                    while (currentListEntry != &transport_data->telemetry_waitingForAck)
+                    MQTT_MESSAGE_DETAILS_LIST* mqttMsgEntry;
+                    while ((mqttMsgEntry = remove_telemetry_waiting_ack(transport_data, puback->packetId, NULL)) != NULL)
                     {
-                        MQTT_MESSAGE_DETAILS_LIST* mqttMsgEntry = containingRecord(currentListEntry, MQTT_MESSAGE_DETAILS_LIST, entry);
-                        DLIST_ENTRY saveListEntry;
-                        saveListEntry.Flink = currentListEntry->Flink;
-
-                        if (puback->packetId == mqttMsgEntry->packet_id)
-                        {
-                            (void)DList_RemoveEntryList(currentListEntry); //First remove the item from Waiting for Ack List.
-                            sendMsgComplete(mqttMsgEntry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_OK);
-                            free(mqttMsgEntry);
-                        }
-                        currentListEntry = saveListEntry.Flink;
+                        record_telemetry_ack(transport_data, mqttMsgEntry->msgPublishTime);
+                        sendMsgComplete(mqttMsgEntry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_OK);
+                        free(mqttMsgEntry);
                     }
                 }
                 else
@@ -2032,45 +2166,56 @@ static void process_queued_ack_messages(PMQTTTRANSPORT_HANDLE_DATA transport_dat
         DLIST_ENTRY nextListEntry;
         nextListEntry.Flink = current_entry->Flink;
 
-        if (((current_ms - msg_detail_entry->msgPublishTime) / 1000) > RESEND_TIMEOUT_VALUE_MIN)
+        // The list is ordered by publish time: the following messages have not timed out either
+        if (((current_ms - msg_detail_entry->msgPublishTime) / 1000) <= RESEND_TIMEOUT_VALUE_MIN)
         {
-            if (msg_detail_entry->retryCount >= MAX_SEND_RECOUNT_LIMIT)
-            {
-                sendMsgComplete(msg_detail_entry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_MESSAGE_TIMEOUT);
-                (void)DList_RemoveEntryList(current_entry);
-                free(msg_detail_entry);
+            break;
+        }
 
-                DisconnectFromClient(transport_data);
-            }
-            else
+        if (msg_detail_entry->retryCount >= MAX_SEND_RECOUNT_LIMIT)
+        {
+            (void)remove_telemetry_waiting_ack(transport_data, msg_detail_entry->packet_id, msg_detail_entry);
+            transport_data->telemetry_stats.messages_timed_out++;
+            sendMsgComplete(msg_detail_entry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_MESSAGE_TIMEOUT);
+            free(msg_detail_entry);
+
+            DisconnectFromClient(transport_data);
+
+            // Acks processed while disconnecting may have removed the next entry: restart from the
+            // head, the entries already processed are now at the end of the list
+            nextListEntry.Flink = transport_data->telemetry_waitingForAck.Flink;
+        }
+        else
+        {
+            bool requeue = true;
+
+            // Ensure that the packet state is PUBLISH_TYPE and then attempt to send the message
+            // again
+            if (transport_data->currPacketState == PUBLISH_TYPE)
             {
-                // Ensure that the packet state is PUBLISH_TYPE and then attempt to send the message
-                // again
-                if (transport_data->currPacketState == PUBLISH_TYPE)
-                {
-                    size_t messageLength;
-                    const unsigned char* messagePayload = NULL;
-                    if (!RetrieveMessagePayload(msg_detail_entry->iotHubMessageEntry->messageHandle, &messagePayload, &messageLength))
-                    {
-                        (void)DList_RemoveEntryList(current_entry);
-                        sendMsgComplete(msg_detail_entry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_ERROR);
-                    }
-                    else
-                    {
-                        if (publish_mqtt_telemetry_msg(transport_data, msg_detail_entry, messagePayload, messageLength) != 0)
-                        {
-                            (void)DList_RemoveEntryList(current_entry);
-                            sendMsgComplete(msg_detail_entry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_ERROR);
-                            free(msg_detail_entry);
-                        }
-                    }
-                }
-                else
+                size_t messageLength;
+                const unsigned char* messagePayload = NULL;
+                if (!RetrieveMessagePayload(msg_detail_entry->iotHubMessageEntry->messageHandle, &messagePayload, &messageLength) ||
+                    publish_mqtt_telemetry_msg(transport_data, msg_detail_entry, messagePayload, messageLength) != 0)
                 {
-                    msg_detail_entry->retryCount++;
-                    msg_detail_entry->msgPublishTime = current_ms;
+                    (void)remove_telemetry_waiting_ack(transport_data, msg_detail_entry->packet_id, msg_detail_entry);
+                    sendMsgComplete(msg_detail_entry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_ERROR);
+                    free(msg_detail_entry);
+                    requeue = false;
                 }
             }
+            else
+            {
+                msg_detail_entry->retryCount++;
+                msg_detail_entry->msgPublishTime = current_ms;
+            }
+
+            if (requeue)
+            {
+                // Its publish time is now the latest one: move it to the end of the list
+                (void)DList_RemoveEntryList(current_entry);
+                DList_InsertTailList(&(transport_data->telemetry_waitingForAck), current_entry);
+            }
         }
         current_entry = nextListEntry.Flink;
     }
@@ -3111,8 +3256,14 @@ void IoTHubTransport_MQTT_Common_DoWork(TRANSPORT_LL_HANDLE handle)
             else if (transport_data->currPacketState == PUBLISH_TYPE)
             {
                 PDLIST_ENTRY currentListEntry = transport_data->waitingToSend->Flink;
+                const uint16_t* failedPacketIds;
+                size_t failedCount;
+                // Send the queued messages together, in as few TLS records as possible
+                bool batching = (mqtt_client_begin_batch(transport_data->mqttClient) == 0);
                 /* Codes_SRS_IOTHUB_MQTT_TRANSPORT_07_027: [IoTHubTransport_MQTT_Common_DoWork shall inspect the "waitingToSend" DLIST passed in config structure.] */
-                while (currentListEntry != transport_data->waitingToSend)
+                // A failed send closes the connection: the next messages wait for the reconnection
+                while (currentListEntry != transport_data->waitingToSend && transport_data->currPacketState == PUBLISH_TYPE &&
+                    (transport_data->max_inflight_messages == 0 || transport_data->telemetry_ackMapCount < transport_data->max_inflight_messages))
                 {
                     IOTHUB_MESSAGE_LIST* iothubMsgList = containingRecord(currentListEntry, IOTHUB_MESSAGE_LIST, entry);
                     DLIST_ENTRY savedFromCurrentListEntry;
@@ -3140,12 +3291,20 @@ void IoTHubTransport_MQTT_Common_DoWork(TRANSPORT_LL_HANDLE handle)
                             mqttMsgEntry->retryCount = 0;
                             mqttMsgEntry->iotHubMessageEntry = iothubMsgList;
                             mqttMsgEntry->packet_id = get_next_packet_id(transport_data);
-                            if (publish_mqtt_telemetry_msg(transport_data, mqttMsgEntry, messagePayload, messageLength) != 0)
+                            DList_InitializeListHead(&(mqttMsgEntry->entry));
+                            if (add_telemetry_waiting_ack(transport_data, mqttMsgEntry) != 0)
                             {
                                 (void)(DList_RemoveEntryList(currentListEntry));
                                 sendMsgComplete(iothubMsgList, transport_data, IOTHUB_CLIENT_CONFIRMATION_ERROR);
                                 free(mqttMsgEntry);
                             }
+                            else if (publish_mqtt_telemetry_msg(transport_data, mqttMsgEntry, messagePayload, messageLength) != 0)
+                            {
+                                (void)remove_telemetry_waiting_ack(transport_data, mqttMsgEntry->packet_id, mqttMsgEntry);
+                                (void)(DList_RemoveEntryList(currentListEntry));
+                                sendMsgComplete(iothubMsgList, transport_data, IOTHUB_CLIENT_CONFIRMATION_ERROR);
+                                free(mqttMsgEntry);
+                            }
                             else
                             {
                                 // Remove the message from the waiting queue ...
@@ -3158,6 +3317,25 @@ void IoTHubTransport_MQTT_Common_DoWork(TRANSPORT_LL_HANDLE handle)
                     currentListEntry = savedFromCurrentListEntry.Flink;
                 }
 
+                if (batching && mqtt_client_end_batch(transport_data->mqttClient, &failedPacketIds, &failedCount) != 0)
+                {
+                    // The messages of the failed send were not sent: they fail as an unbatched publish does
+                    // instead of waiting for an ack until the resend timeout. The ones of the previous sends
+                    // of the batch wait for their ack
+                    size_t index;
+                    LogError("Failure sending %lu batched telemetry messages", (unsigned long)failedCount);
+                    for (index = 0; index < failedCount; index++)
+                    {
+                        MQTT_MESSAGE_DETAILS_LIST* msg_detail_entry = remove_telemetry_waiting_ack(transport_data, failedPacketIds[index], NULL);
+                        if (msg_detail_entry != NULL)
+                        {
+                            transport_data->telemetry_stats.messages_sent--;
+                            sendMsgComplete(msg_detail_entry->iotHubMessageEntry, transport_data, IOTHUB_CLIENT_CONFIRMATION_ERROR);
+                            free(msg_detail_entry);
+                        }
+                    }
+                }
+
                 sendPendingGetTwinRequests(transport_data);
             }
             /* Codes_SRS_IOTHUB_MQTT_TRANSPORT_07_030: [IoTHubTransport_MQTT_Common_DoWork shall call mqtt_client_dowork everytime it is called if it is connected.] */
@@ -3236,6 +3414,11 @@ IOTHUB_CLIENT_RESULT IoTHubTransport_MQTT_Common_SetOption(TRANSPORT_LL_HANDLE h
             transport_data->auto_url_encode_decode = *((bool*)value);
             result = IOTHUB_CLIENT_OK;
         }
+        else if (strcmp(OPTION_MAX_INFLIGHT_MESSAGES, option) == 0)
+        {
+            transport_data->max_inflight_messages = *((size_t*)value);
+            result = IOTHUB_CLIENT_OK;
+        }
         else if (strcmp(OPTION_CONNECTION_TIMEOUT, option) == 0)
         {
             int* connection_time = (int*)value;
@@ -3375,6 +3558,47 @@ IOTHUB_CLIENT_RESULT IoTHubTransport_MQTT_Common_SetOption(TRANSPORT_LL_HANDLE h
     return result;
 }
 
+IOTHUB_CLIENT_RESULT IoTHubTransport_MQTT_Common_GetOption(TRANSPORT_LL_HANDLE handle, const char* option, void* value)
+{
+    IOTHUB_CLIENT_RESULT result;
+    if (
+        (handle == NULL) ||
+        (option == NULL) ||
+        (value == NULL)
+        )
+    {
+        result = IOTHUB_CLIENT_INVALID_ARG;
+        LogError("invalid parameter (NULL) passed to IoTHubTransport_MQTT_Common_GetOption.");
+    }
+    else
+    {
+        MQTTTRANSPORT_HANDLE_DATA* transport_data = (MQTTTRANSPORT_HANDLE_DATA*)handle;
+
+        if (strcmp(OPTION_MAX_INFLIGHT_MESSAGES, option) == 0)
+        {
+            *((size_t*)value) = transport_data->max_inflight_messages;
+            result = IOTHUB_CLIENT_OK;
+        }
+        else if (strcmp(OPTION_TELEMETRY_STATS, option) == 0)
+        {
+            tickcounter_ms_t current_ms;
+            if (tickcounter_get_current_ms(transport_data->msgTickCounter, &current_ms) == 0)
+            {
+                update_telemetry_rate(transport_data, current_ms);
+            }
+            transport_data->telemetry_stats.acks_outstanding = transport_data->telemetry_ackMapCount;
+            *((IOTHUB_CLIENT_TELEMETRY_STATS*)value) = transport_data->telemetry_stats;
+            result = IOTHUB_CLIENT_OK;
+        }
+        else
+        {
+            LogError("option %s is not supported by GetOption", option);
+            result = IOTHUB_CLIENT_INVALID_ARG;
+        }
+    }
+    return result;
+}
+
 static bool check_module_ids_equal(const char* transportModuleId, const char* deviceModuleId)
 {
     if ((transportModuleId != NULL) && (deviceModuleId == NULL))
@@ -183,6 +183,11 @@ static IOTHUB_CLIENT_RESULT IoTHubTransportMqtt_WS_SetOption(TRANSPORT_LL_HANDLE
     return IoTHubTransport_MQTT_Common_SetOption(handle, option, value);
 }
 
+static IOTHUB_CLIENT_RESULT IoTHubTransportMqtt_WS_GetOption(TRANSPORT_LL_HANDLE handle, const char* option, void* value)
+{
+    return IoTHubTransport_MQTT_Common_GetOption(handle, option, value);
+}
+
 /* Codes_SRS_IOTHUB_MQTT_WEBSOCKET_TRANSPORT_07_003: [ IoTHubTransportMqtt_WS_Register shall register the TRANSPORT_LL_HANDLE by calling into the IoTHubMqttAbstract_Register function. ]*/
 static IOTHUB_DEVICE_HANDLE IoTHubTransportMqtt_WS_Register(TRANSPORT_LL_HANDLE handle, const IOTHUB_DEVICE_CONFIG* device, PDLIST_ENTRY waitingToSend)
 {
@@ -266,7 +271,8 @@ static TRANSPORT_PROVIDER thisTransportProvider_WebSocketsOverTls = {
     IoTHubTransportMqtt_WS_Subscribe_InputQueue,
     IoTHubTransportMqtt_WS_Unsubscribe_InputQueue,
     IotHubTransportMqtt_WS_SetCallbackContext,
-    IoTHubTransportMqtt_WS_GetTwinAsync
+    IoTHubTransportMqtt_WS_GetTwinAsync,
+    IoTHubTransportMqtt_WS_GetOption
 };
 
 const TRANSPORT_PROVIDER* MQTT_WebSocket_Protocol(void)
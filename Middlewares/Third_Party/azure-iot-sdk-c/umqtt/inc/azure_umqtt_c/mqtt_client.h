@@ -61,6 +61,14 @@ MOCKABLE_FUNCTION(, int, mqtt_client_publish, MQTT_CLIENT_HANDLE, handle, MQTT_M
 
 MOCKABLE_FUNCTION(, void, mqtt_client_dowork, MQTT_CLIENT_HANDLE, handle);
 
+/* Packets sent between these calls are collected and sent together (MQTT_SEND_BATCH_SIZE bytes at most per send)
+   by mqtt_client_end_batch, so that a burst of publishes goes out in as few TLS records as possible.
+   When a send of the batch fails, batching stops and the connection is closed with MQTT_CLIENT_COMMUNICATION_ERROR.
+   mqtt_client_end_batch then fails and returns the packet ids of the PUBLISH packets of that send, valid until the
+   next mqtt_client_begin_batch: the packets of the previous sends of the batch were sent */
+MOCKABLE_FUNCTION(, int, mqtt_client_begin_batch, MQTT_CLIENT_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, mqtt_client_end_batch, MQTT_CLIENT_HANDLE, handle, const uint16_t**, failedPacketIds, size_t*, failedCount);
+
 MOCKABLE_FUNCTION(, void, mqtt_client_set_trace, MQTT_CLIENT_HANDLE, handle, bool, traceOn, bool, rawBytesOn);
 
 #ifdef __cplusplus
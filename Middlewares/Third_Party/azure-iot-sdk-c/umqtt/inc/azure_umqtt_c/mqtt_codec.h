@@ -23,13 +23,20 @@ extern "C" {
 typedef struct MQTTCODEC_INSTANCE_TAG* MQTTCODEC_HANDLE;
 
 typedef void(*ON_PACKET_COMPLETE_CALLBACK)(void* context, CONTROL_PACKET_TYPE packet, int flags, BUFFER_HANDLE headerData);
+/* Same as ON_PACKET_COMPLETE_CALLBACK without a buffer copy: data points into the received bytes when the packet was received
+   in one mqtt_codec_bytesReceived call, and is only valid until the callback returns. */
+typedef void(*ON_PACKET_COMPLETE_SPAN_CALLBACK)(void* context, CONTROL_PACKET_TYPE packet, int flags, const uint8_t* data, size_t length);
 
 MOCKABLE_FUNCTION(, MQTTCODEC_HANDLE, mqtt_codec_create, ON_PACKET_COMPLETE_CALLBACK, packetComplete, void*, callbackCtx);
+MOCKABLE_FUNCTION(, MQTTCODEC_HANDLE, mqtt_codec_create_span, ON_PACKET_COMPLETE_SPAN_CALLBACK, packetComplete, void*, callbackCtx);
 MOCKABLE_FUNCTION(, void, mqtt_codec_destroy, MQTTCODEC_HANDLE, handle);
 
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, mqtt_codec_connect, const MQTT_CLIENT_OPTIONS*, mqttOptions, STRING_HANDLE, trace_log);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, mqtt_codec_disconnect);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, mqtt_codec_publish, QOS_VALUE, qosValue, bool, duplicateMsg, bool, serverRetain, uint16_t, packetId, const char*, topicName, const uint8_t*, msgBuffer, size_t, buffLen, STRING_HANDLE, trace_log);
+/* Writes only the PUBLISH fixed and variable headers for a payload of buffLen bytes, so that the payload can be sent from the caller's buffer.
+   On return *headerLen is the header size, a non-zero value is returned if headerSize is smaller. */
+MOCKABLE_FUNCTION(, int, mqtt_codec_publishHeader, QOS_VALUE, qosValue, bool, duplicateMsg, bool, serverRetain, uint16_t, packetId, const char*, topicName, size_t, buffLen, uint8_t*, header, size_t, headerSize, size_t*, headerLen, STRING_HANDLE, trace_log);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, mqtt_codec_publishAck, uint16_t, packetId);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, mqtt_codec_publishReceived, uint16_t, packetId);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, mqtt_codec_publishRelease, uint16_t, packetId);
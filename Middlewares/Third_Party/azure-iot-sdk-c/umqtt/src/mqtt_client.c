@@ -29,6 +29,24 @@
 #define DEFAULT_MAX_PING_RESPONSE_TIME  80  // % of time to send pings
 #define MAX_CLOSE_RETRIES               20
 
+/* Payloads of at least this size are sent from the message buffer after a separately encoded
+   PUBLISH header instead of being copied into one packet buffer (one more send, no payload copy) */
+#ifndef MQTT_PUBLISH_SPLIT_THRESHOLD
+#define MQTT_PUBLISH_SPLIT_THRESHOLD    1024
+#endif
+#define PUBLISH_HEADER_BUFFER_SIZE      256
+
+/* Size of the buffer collecting the packets sent between mqtt_client_begin_batch and mqtt_client_end_batch,
+   sent with one xio_send (one TLS record): it should not exceed the TLS maximum fragment length.
+   Packets of at least MQTT_PUBLISH_SPLIT_THRESHOLD bytes are not copied into it: they are sent directly */
+#ifndef MQTT_SEND_BATCH_SIZE
+#define MQTT_SEND_BATCH_SIZE            2048
+#endif
+/* Maximum number of PUBLISH packets in the batch buffer, whose packet ids are reported if their send fails */
+#ifndef MQTT_SEND_BATCH_MAX_PACKETS
+#define MQTT_SEND_BATCH_MAX_PACKETS     32
+#endif
+
 static const char* const TRUE_CONST = "true";
 static const char* const FALSE_CONST = "false";
 
@@ -57,6 +75,13 @@ typedef struct MQTT_CLIENT_TAG
     bool rawBytesTrace;
     tickcounter_ms_t timeSincePing;
     uint16_t maxPingRespTime;
+    bool sendBatching;
+    unsigned char* sendBatch;
+    size_t sendBatchLength;
+    bool sendBatchFailed;
+    // Packet ids of the PUBLISH packets in sendBatch, or of the failed send once sendBatchFailed is set
+    uint16_t sendBatchPacketIds[MQTT_SEND_BATCH_MAX_PACKETS];
+    size_t sendBatchPacketCount;
 } MQTT_CLIENT;
 
 static void on_connection_closed(void* context)
@@ -358,6 +383,36 @@ static void logIncomingRawTrace(MQTT_CLIENT* mqtt_client, CONTROL_PACKET_TYPE pa
 }
 #endif // NO_LOGGING
 
+static int flushSendBatch(MQTT_CLIENT* mqtt_client)
+{
+    int result = 0;
+    if (mqtt_client->sendBatchLength > 0)
+    {
+        result = xio_send(mqtt_client->xioHandle, (const void*)mqtt_client->sendBatch, mqtt_client->sendBatchLength, sendComplete, mqtt_client);
+        mqtt_client->sendBatchLength = 0;
+        if (result != 0)
+        {
+            // The packets of the previous sends went out: only the ones of this send are reported by
+            // mqtt_client_end_batch. Stop batching, part of the data may be on the wire
+            LogError("%d: Failure sending batched packets data, closing the connection", result);
+            mqtt_client->sendBatchFailed = true;
+            mqtt_client->sendBatching = false;
+            set_error_callback(mqtt_client, MQTT_CLIENT_COMMUNICATION_ERROR);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            mqtt_client->sendBatchPacketCount = 0;
+        }
+    }
+    return result;
+}
+
+static bool isBatched(MQTT_CLIENT* mqtt_client, size_t length)
+{
+    return mqtt_client->sendBatching && length < MQTT_PUBLISH_SPLIT_THRESHOLD && length <= MQTT_SEND_BATCH_SIZE;
+}
+
 static int sendPacketItem(MQTT_CLIENT* mqtt_client, const unsigned char* data, size_t length)
 {
     int result;
@@ -367,6 +422,28 @@ static int sendPacketItem(MQTT_CLIENT* mqtt_client, const unsigned char* data, s
         LogError("Failure getting current ms tickcounter");
         result = MU_FAILURE;
     }
+    else if (isBatched(mqtt_client, length))
+    {
+        // Send the batch first if the packet does not fit after it, or if no more packet id can be recorded
+        if ((length > MQTT_SEND_BATCH_SIZE - mqtt_client->sendBatchLength || mqtt_client->sendBatchPacketCount == MQTT_SEND_BATCH_MAX_PACKETS) &&
+            flushSendBatch(mqtt_client) != 0)
+        {
+            result = MU_FAILURE;
+        }
+        else
+        {
+            (void)memcpy(mqtt_client->sendBatch + mqtt_client->sendBatchLength, data, length);
+            mqtt_client->sendBatchLength += length;
+#ifdef ENABLE_RAW_TRACE
+            logOutgoingRawTrace(mqtt_client, (const uint8_t*)data, length);
+#endif
+            result = 0;
+        }
+    }
+    else if (mqtt_client->sendBatching && flushSendBatch(mqtt_client) != 0)
+    {
+        result = MU_FAILURE;
+    }
     else
     {
         result = xio_send(mqtt_client->xioHandle, (const void*)data, length, sendComplete, mqtt_client);
@@ -712,18 +789,14 @@ static void ProcessPublishMessage(MQTT_CLIENT* mqtt_client, uint8_t* initialPos,
     }
 }
 
-static void recvCompleteCallback(void* context, CONTROL_PACKET_TYPE packet, int flags, BUFFER_HANDLE headerData)
+static void recvCompleteCallback(void* context, CONTROL_PACKET_TYPE packet, int flags, const uint8_t* data, size_t length)
 {
     MQTT_CLIENT* mqtt_client = (MQTT_CLIENT*)context;
     if (mqtt_client != NULL)
     {
-        size_t packetLength = 0;
-        uint8_t* iterator = NULL;
-        if (headerData != NULL)
-        {
-            packetLength = BUFFER_length(headerData);
-            iterator = BUFFER_u_char(headerData);
-        }
+        size_t packetLength = length;
+        // The packet data are only read, byteutil readers just advance the iterator
+        uint8_t* iterator = (uint8_t*)data;
 
 #ifdef ENABLE_RAW_TRACE
         logIncomingRawTrace(mqtt_client, packet, (uint8_t)flags, iterator, packetLength);
@@ -947,7 +1020,7 @@ MQTT_CLIENT_HANDLE mqtt_client_init(ON_MQTT_MESSAGE_RECV_CALLBACK msgRecv, ON_MQ
             }
             else
             {
-                result->codec_handle = mqtt_codec_create(recvCompleteCallback, result);
+                result->codec_handle = mqtt_codec_create_span(recvCompleteCallback, result);
                 if (result->codec_handle == NULL)
                 {
                     /*Codes_SRS_MQTT_CLIENT_07_002: [If any failure is encountered then mqttclient_init shall return NULL.]*/
@@ -972,6 +1045,7 @@ void mqtt_client_deinit(MQTT_CLIENT_HANDLE handle)
         tickcounter_destroy(mqtt_client->packetTickCntr);
         mqtt_codec_destroy(mqtt_client->codec_handle);
         clear_mqtt_options(mqtt_client);
+        free(mqtt_client->sendBatch);
         free(mqtt_client);
     }
 }
@@ -1045,8 +1119,38 @@ int mqtt_client_publish(MQTT_CLIENT_HANDLE handle, MQTT_MESSAGE_HANDLE msgHandle
             bool isRetained = mqttmessage_getIsRetained(msgHandle);
             uint16_t packetId = mqttmessage_getPacketId(msgHandle);
             const char* topicName = mqttmessage_getTopicName(msgHandle);
-            BUFFER_HANDLE publishPacket = mqtt_codec_publish(qos, isDuplicate, isRetained, packetId, topicName, payload->message, payload->length, trace_log);
-            if (publishPacket == NULL)
+            uint8_t publishHeader[PUBLISH_HEADER_BUFFER_SIZE];
+            size_t headerLen;
+            BUFFER_HANDLE publishPacket;
+            if (payload->length >= MQTT_PUBLISH_SPLIT_THRESHOLD &&
+                mqtt_codec_publishHeader(qos, isDuplicate, isRetained, packetId, topicName, payload->length, publishHeader, sizeof(publishHeader), &headerLen, trace_log) == 0)
+            {
+                mqtt_client->packetState = PUBLISH_TYPE;
+
+                // The payload is sent from the message buffer, right after its header
+                if (sendPacketItem(mqtt_client, publishHeader, headerLen) != 0)
+                {
+                    LogError("Error: mqtt_client_publish send failed");
+                    result = MU_FAILURE;
+                }
+                else if (sendPacketItem(mqtt_client, payload->message, payload->length) != 0)
+                {
+                    // The header is sent without its payload: the broker would read the next packets as payload.
+                    // A failed send of the batch with the header has already closed the connection
+                    LogError("Error: mqtt_client_publish payload send failed, closing the connection");
+                    if (mqtt_client->xioHandle != NULL)
+                    {
+                        set_error_callback(mqtt_client, MQTT_CLIENT_COMMUNICATION_ERROR);
+                    }
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    log_outgoing_trace(mqtt_client, trace_log);
+                    result = 0;
+                }
+            }
+            else if ((publishPacket = mqtt_codec_publish(qos, isDuplicate, isRetained, packetId, topicName, payload->message, payload->length, trace_log)) == NULL)
             {
                 /*Codes_SRS_MQTT_CLIENT_07_020: [If any failure is encountered then mqtt_client_unsubscribe shall return a non-zero value.]*/
                 LogError("Error: mqtt_codec_publish failed");
@@ -1058,6 +1162,7 @@ int mqtt_client_publish(MQTT_CLIENT_HANDLE handle, MQTT_MESSAGE_HANDLE msgHandle
 
                 /*Codes_SRS_MQTT_CLIENT_07_022: [On success mqtt_client_publish shall send the MQTT SUBCRIBE packet to the endpoint.]*/
                 size_t size = BUFFER_length(publishPacket);
+                bool batched = isBatched(mqtt_client, size);
                 if (sendPacketItem(mqtt_client, BUFFER_u_char(publishPacket), size) != 0)
                 {
                     /*Codes_SRS_MQTT_CLIENT_07_020: [If any failure is encountered then mqtt_client_unsubscribe shall return a non-zero value.]*/
@@ -1066,6 +1171,10 @@ int mqtt_client_publish(MQTT_CLIENT_HANDLE handle, MQTT_MESSAGE_HANDLE msgHandle
                 }
                 else
                 {
+                    if (batched && qos != DELIVER_AT_MOST_ONCE)
+                    {
+                        mqtt_client->sendBatchPacketIds[mqtt_client->sendBatchPacketCount++] = packetId;
+                    }
                     log_outgoing_trace(mqtt_client, trace_log);
                     result = 0;
                 }
@@ -1293,6 +1402,59 @@ void mqtt_client_dowork(MQTT_CLIENT_HANDLE handle)
     }
 }
 
+int mqtt_client_begin_batch(MQTT_CLIENT_HANDLE handle)
+{
+    int result;
+    MQTT_CLIENT* mqtt_client = (MQTT_CLIENT*)handle;
+    if (mqtt_client == NULL)
+    {
+        LogError("Invalid parameter specified mqtt_client: %p", mqtt_client);
+        result = MU_FAILURE;
+    }
+    else if (mqtt_client->sendBatch == NULL && (mqtt_client->sendBatch = (unsigned char*)malloc(MQTT_SEND_BATCH_SIZE)) == NULL)
+    {
+        LogError("Failure allocating the send batch buffer");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        mqtt_client->sendBatching = true;
+        mqtt_client->sendBatchFailed = false;
+        mqtt_client->sendBatchPacketCount = 0;
+        result = 0;
+    }
+    return result;
+}
+
+int mqtt_client_end_batch(MQTT_CLIENT_HANDLE handle, const uint16_t** failedPacketIds, size_t* failedCount)
+{
+    int result;
+    MQTT_CLIENT* mqtt_client = (MQTT_CLIENT*)handle;
+    if (mqtt_client == NULL || failedPacketIds == NULL || failedCount == NULL)
+    {
+        LogError("Invalid parameter specified mqtt_client: %p, failedPacketIds: %p, failedCount: %p", mqtt_client, failedPacketIds, failedCount);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        // Also fails when a batch send failed before, as the batch was full or a large packet was sent
+        if (mqtt_client->sendBatchFailed || flushSendBatch(mqtt_client) != 0)
+        {
+            *failedPacketIds = mqtt_client->sendBatchPacketIds;
+            *failedCount = mqtt_client->sendBatchPacketCount;
+            result = MU_FAILURE;
+        }
+        else
+        {
+            *failedPacketIds = NULL;
+            *failedCount = 0;
+            result = 0;
+        }
+        mqtt_client->sendBatching = false;
+    }
+    return result;
+}
+
 void mqtt_client_set_trace(MQTT_CLIENT_HANDLE handle, bool traceOn, bool rawBytesOn)
 {
     AZURE_UNREFERENCED_PARAMETER(handle);
@@ -38,6 +38,8 @@
 #define UNSUBSCRIBE_FIXED_HEADER_FLAG       0x2
 
 #define MAX_SEND_SIZE                       0xFFFFFF7F
+#define MAX_REMAINING_LENGTH                0x0FFFFFFF
+#define MAX_REMAINING_LENGTH_SIZE           4
 
 #define CODEC_STATE_VALUES      \
     CODEC_STATE_FIXED_HEADER,   \
@@ -57,8 +59,9 @@ typedef struct MQTTCODEC_INSTANCE_TAG
     int headerFlags;
     BUFFER_HANDLE headerData;
     ON_PACKET_COMPLETE_CALLBACK packetComplete;
+    ON_PACKET_COMPLETE_SPAN_CALLBACK packetCompleteSpan;
     void* callContext;
-    uint8_t storeRemainLen[4];
+    size_t remainLen;
     size_t remainLenIndex;
 } MQTTCODEC_INSTANCE;
 
@@ -233,62 +236,6 @@ static int constructConnectVariableHeader(BUFFER_HANDLE ctrlPacket, const MQTT_C
     return result;
 }
 
-static int constructPublishVariableHeader(BUFFER_HANDLE ctrlPacket, const PUBLISH_HEADER_INFO* publishHeader, STRING_HANDLE trace_log)
-{
-    int result = 0;
-    size_t topicLen = 0;
-    size_t spaceLen = 0;
-    size_t idLen = 0;
-
-    size_t currLen = BUFFER_length(ctrlPacket);
-
-    topicLen = strlen(publishHeader->topicName);
-    spaceLen += 2;
-
-    if (publishHeader->qualityOfServiceValue != DELIVER_AT_MOST_ONCE)
-    {
-        // Packet Id is only set if the QOS is not 0
-        idLen = 2;
-    }
-
-    if (topicLen > USHRT_MAX)
-    {
-        result = MU_FAILURE;
-    }
-    else if (BUFFER_enlarge(ctrlPacket, topicLen + idLen + spaceLen) != 0)
-    {
-        result = MU_FAILURE;
-    }
-    else
-    {
-        uint8_t* iterator = BUFFER_u_char(ctrlPacket);
-        if (iterator == NULL)
-        {
-            result = MU_FAILURE;
-        }
-        else
-        {
-            iterator += currLen;
-            /* The Topic Name MUST be present as the first field in the PUBLISH Packet Variable header.It MUST be 792 a UTF-8 encoded string [MQTT-3.3.2-1] as defined in section 1.5.3.*/
-            byteutil_writeUTF(&iterator, publishHeader->topicName, (uint16_t)topicLen);
-            if (trace_log != NULL)
-            {
-                STRING_sprintf(trace_log, " | TOPIC_NAME: %s", publishHeader->topicName);
-            }
-            if (idLen > 0)
-            {
-                if (trace_log != NULL)
-                {
-                    STRING_sprintf(trace_log, " | PACKET_ID: %"PRIu16, publishHeader->packetId);
-                }
-                byteutil_writeInt(&iterator, publishHeader->packetId);
-            }
-            result = 0;
-        }
-    }
-    return result;
-}
-
 static int constructSubscibeTypeVariableHeader(BUFFER_HANDLE ctrlPacket, uint16_t packetId)
 {
     int result = 0;
@@ -343,6 +290,104 @@ static BUFFER_HANDLE constructPublishReply(CONTROL_PACKET_TYPE type, uint8_t fla
     return result;
 }
 
+static size_t encodeRemainingLength(size_t packetLen, uint8_t remainSize[MAX_REMAINING_LENGTH_SIZE])
+{
+    size_t index = 0;
+
+    // Calculate the length of packet
+    do
+    {
+        uint8_t encode = packetLen % 128;
+        packetLen /= 128;
+        // if there are more data to encode, set the top bit of this byte
+        if (packetLen > 0)
+        {
+            encode |= NEXT_128_CHUNK;
+        }
+        remainSize[index++] = encode;
+    } while (packetLen > 0 && index < MAX_REMAINING_LENGTH_SIZE);
+
+    return index;
+}
+
+static uint8_t constructPublishFlags(QOS_VALUE qosValue, bool duplicateMsg, bool serverRetain)
+{
+    uint8_t headerFlags = 0;
+    if (duplicateMsg) headerFlags |= PUBLISH_DUP_FLAG;
+    if (serverRetain) headerFlags |= PUBLISH_QOS_RETAIN;
+    if (qosValue != DELIVER_AT_MOST_ONCE)
+    {
+        if (qosValue == DELIVER_AT_LEAST_ONCE)
+        {
+            headerFlags |= PUBLISH_QOS_AT_LEAST_ONCE;
+        }
+        else
+        {
+            headerFlags |= PUBLISH_QOS_EXACTLY_ONCE;
+        }
+    }
+    return headerFlags;
+}
+
+// Computes the sizes of the PUBLISH fixed header plus variable header and of the whole packet
+static int computePublishSize(QOS_VALUE qosValue, const char* topicName, size_t buffLen, size_t* headerLen, size_t* remainLen)
+{
+    int result;
+    size_t topicLen = strlen(topicName);
+    // Packet Id is only set if the QOS is not 0
+    size_t idLen = (qosValue != DELIVER_AT_MOST_ONCE) ? 2 : 0;
+
+    if (topicLen > USHRT_MAX || buffLen > MAX_REMAINING_LENGTH - (2 + topicLen + idLen))
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        uint8_t remainSize[MAX_REMAINING_LENGTH_SIZE];
+        *remainLen = 2 + topicLen + idLen + buffLen;
+        *headerLen = 1 + encodeRemainingLength(*remainLen, remainSize) + 2 + topicLen + idLen;
+        result = 0;
+    }
+    return result;
+}
+
+// Writes the PUBLISH fixed header and variable header, the payload of buffLen bytes is expected right after them
+static void writePublishHeader(uint8_t** iterator, uint8_t headerFlags, size_t remainLen, const PUBLISH_HEADER_INFO* publishHeader)
+{
+    uint8_t remainSize[MAX_REMAINING_LENGTH_SIZE];
+    size_t index = encodeRemainingLength(remainLen, remainSize);
+
+    byteutil_writeByte(iterator, (uint8_t)PUBLISH_TYPE | headerFlags);
+    (void)memcpy(*iterator, remainSize, index);
+    *iterator += index;
+    /* The Topic Name MUST be present as the first field in the PUBLISH Packet Variable header.It MUST be 792 a UTF-8 encoded string [MQTT-3.3.2-1] as defined in section 1.5.3.*/
+    byteutil_writeUTF(iterator, publishHeader->topicName, (uint16_t)strlen(publishHeader->topicName));
+    if (publishHeader->qualityOfServiceValue != DELIVER_AT_MOST_ONCE)
+    {
+        byteutil_writeInt(iterator, publishHeader->packetId);
+    }
+}
+
+static void tracePublish(STRING_HANDLE trace_log, QOS_VALUE qosValue, bool duplicateMsg, bool serverRetain, uint16_t packetId, const char* topicName, size_t buffLen)
+{
+    if (trace_log != NULL)
+    {
+        (void)STRING_copy(trace_log, "PUBLISH");
+        STRING_sprintf(trace_log, " | IS_DUP: %s | RETAIN: %d | QOS: %s", duplicateMsg ? TRUE_CONST : FALSE_CONST,
+            serverRetain ? 1 : 0,
+            retrieve_qos_value(qosValue));
+        STRING_sprintf(trace_log, " | TOPIC_NAME: %s", topicName);
+        if (qosValue != DELIVER_AT_MOST_ONCE)
+        {
+            STRING_sprintf(trace_log, " | PACKET_ID: %"PRIu16, packetId);
+        }
+        if (buffLen > 0)
+        {
+            STRING_sprintf(trace_log, " | PAYLOAD_LEN: %lu", (unsigned long)buffLen);
+        }
+    }
+}
+
 static int constructFixedHeader(BUFFER_HANDLE ctrlPacket, CONTROL_PACKET_TYPE packetType, uint8_t flags)
 {
     int result;
@@ -353,21 +398,8 @@ static int constructFixedHeader(BUFFER_HANDLE ctrlPacket, CONTROL_PACKET_TYPE pa
     else
     {
         size_t packetLen = BUFFER_length(ctrlPacket);
-        uint8_t remainSize[4] ={ 0 };
-        size_t index = 0;
-
-        // Calculate the length of packet
-        do
-        {
-            uint8_t encode = packetLen % 128;
-            packetLen /= 128;
-            // if there are more data to encode, set the top bit of this byte
-            if (packetLen > 0)
-            {
-                encode |= NEXT_128_CHUNK;
-            }
-            remainSize[index++] = encode;
-        } while (packetLen > 0);
+        uint8_t remainSize[MAX_REMAINING_LENGTH_SIZE] ={ 0 };
+        size_t index = encodeRemainingLength(packetLen, remainSize);
 
         BUFFER_HANDLE fixedHeader = BUFFER_new();
         if (fixedHeader == NULL)
@@ -533,81 +565,70 @@ static int constructConnPayload(BUFFER_HANDLE ctrlPacket, const MQTT_CLIENT_OPTI
 static int prepareheaderDataInfo(MQTTCODEC_INSTANCE* codecData, uint8_t remainLen)
 {
     int result;
-    if (codecData == NULL)
+    if (codecData == NULL || codecData->remainLenIndex >= MAX_REMAINING_LENGTH_SIZE)
     {
         result = MU_FAILURE;
     }
     else
     {
         result = 0;
-        codecData->storeRemainLen[codecData->remainLenIndex++] = remainLen;
-        if (remainLen <= 0x7f)
+        // The remaining length is encoded 7 bits per byte, least significant group first
+        codecData->remainLen += (size_t)(remainLen & 127) << (7 * codecData->remainLenIndex);
+        codecData->remainLenIndex++;
+        if ((remainLen & NEXT_128_CHUNK) == 0)
         {
-            int multiplier = 1;
-            int totalLen = 0;
-            size_t index = 0;
-            uint8_t encodeByte = 0;
-            do
-            {
-                encodeByte = codecData->storeRemainLen[index++];
-                totalLen += (encodeByte & 127) * multiplier;
-                multiplier *= NEXT_128_CHUNK;
-
-                if (multiplier > 128 * 128 * 128)
-                {
-                    result = MU_FAILURE;
-                    break;
-                }
-            } while ((encodeByte & NEXT_128_CHUNK) != 0);
-
             codecData->codecState = CODEC_STATE_VAR_HEADER;
 
             // Reset remainLen Index
             codecData->remainLenIndex = 0;
-            memset(codecData->storeRemainLen, 0, 4 * sizeof(uint8_t));
-
-            if (totalLen > 0)
-            {
-                codecData->bufferOffset = 0;
-                codecData->headerData = BUFFER_new();
-                if (codecData->headerData == NULL)
-                {
-                    /* Codes_SRS_MQTT_CODEC_07_035: [ If any error is encountered then the packet state will be marked as error and mqtt_codec_bytesReceived shall return a non-zero value. ] */
-                    LogError("Failed BUFFER_new");
-                    result = MU_FAILURE;
-                }
-                else
-                {
-                    if (BUFFER_pre_build(codecData->headerData, totalLen) != 0)
-                    {
-                        /* Codes_SRS_MQTT_CODEC_07_035: [ If any error is encountered then the packet state will be marked as error and mqtt_codec_bytesReceived shall return a non-zero value. ] */
-                        LogError("Failed BUFFER_pre_build");
-                        result = MU_FAILURE;
-                    }
-
-                }
-            }
+            codecData->bufferOffset = 0;
+        }
+        else if (codecData->remainLenIndex >= MAX_REMAINING_LENGTH_SIZE)
+        {
+            result = MU_FAILURE;
         }
     }
     return result;
 }
 
-static void completePacketData(MQTTCODEC_INSTANCE* codecData)
+// data is either the received buffer, when the whole packet was in it, or the headerData buffer
+static int completePacketData(MQTTCODEC_INSTANCE* codecData, const uint8_t* data, size_t length)
 {
-    if (codecData)
+    int result = 0;
+    if (codecData->packetCompleteSpan != NULL)
+    {
+        codecData->packetCompleteSpan(codecData->callContext, codecData->currPacket, codecData->headerFlags, data, length);
+    }
+    else if (codecData->packetComplete != NULL)
     {
-        if (codecData->packetComplete != NULL)
+        if (codecData->headerData != NULL || length == 0)
         {
             codecData->packetComplete(codecData->callContext, codecData->currPacket, codecData->headerFlags, codecData->headerData);
         }
-
-        // Clean up data
-        codecData->currPacket = UNKNOWN_TYPE;
-        codecData->codecState = CODEC_STATE_FIXED_HEADER;
-        codecData->headerFlags = 0;
-        BUFFER_delete(codecData->headerData);
-        codecData->headerData = NULL;
+        else
+        {
+            BUFFER_HANDLE packetData = BUFFER_create(data, length);
+            if (packetData == NULL)
+            {
+                LogError("Failed BUFFER_create");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                codecData->packetComplete(codecData->callContext, codecData->currPacket, codecData->headerFlags, packetData);
+                BUFFER_delete(packetData);
+            }
+        }
     }
+
+    // Clean up data
+    codecData->currPacket = UNKNOWN_TYPE;
+    codecData->codecState = CODEC_STATE_FIXED_HEADER;
+    codecData->headerFlags = 0;
+    codecData->remainLen = 0;
+    BUFFER_delete(codecData->headerData);
+    codecData->headerData = NULL;
+    return result;
 }
 
 MQTTCODEC_HANDLE mqtt_codec_create(ON_PACKET_COMPLETE_CALLBACK packetComplete, void* callbackCtx)
@@ -625,12 +646,23 @@ MQTTCODEC_HANDLE mqtt_codec_create(ON_PACKET_COMPLETE_CALLBACK packetComplete, v
         result->packetComplete = packetComplete;
         result->callContext = callbackCtx;
         result->headerData = NULL;
-        memset(result->storeRemainLen, 0, 4 * sizeof(uint8_t));
+        result->packetCompleteSpan = NULL;
+        result->remainLen = 0;
         result->remainLenIndex = 0;
     }
     return result;
 }
 
+MQTTCODEC_HANDLE mqtt_codec_create_span(ON_PACKET_COMPLETE_SPAN_CALLBACK packetComplete, void* callbackCtx)
+{
+    MQTTCODEC_HANDLE result = mqtt_codec_create(NULL, callbackCtx);
+    if (result != NULL)
+    {
+        result->packetCompleteSpan = packetComplete;
+    }
+    return result;
+}
+
 void mqtt_codec_destroy(MQTTCODEC_HANDLE handle)
 {
     /* Codes_SRS_MQTT_CODEC_07_003: [If the handle parameter is NULL then mqtt_codec_destroy shall do nothing.] */
@@ -741,6 +773,8 @@ BUFFER_HANDLE mqtt_codec_disconnect()
 BUFFER_HANDLE mqtt_codec_publish(QOS_VALUE qosValue, bool duplicateMsg, bool serverRetain, uint16_t packetId, const char* topicName, const uint8_t* msgBuffer, size_t buffLen, STRING_HANDLE trace_log)
 {
     BUFFER_HANDLE result;
+    size_t headerLen;
+    size_t remainLen;
     /* Codes_SRS_MQTT_CODEC_07_005: [If the parameters topicName is NULL then mqtt_codec_publish shall return NULL.] */
     if (topicName == NULL)
     {
@@ -752,6 +786,11 @@ BUFFER_HANDLE mqtt_codec_publish(QOS_VALUE qosValue, bool duplicateMsg, bool ser
         /* Codes_SRS_MQTT_CODEC_07_006: [If any error is encountered then mqtt_codec_publish shall return NULL.] */
         result = NULL;
     }
+    else if (computePublishSize(qosValue, topicName, buffLen, &headerLen, &remainLen) != 0)
+    {
+        /* Codes_SRS_MQTT_CODEC_07_006: [If any error is encountered then mqtt_codec_publish shall return NULL.] */
+        result = NULL;
+    }
     else
     {
         PUBLISH_HEADER_INFO publishInfo ={ 0 };
@@ -759,34 +798,15 @@ BUFFER_HANDLE mqtt_codec_publish(QOS_VALUE qosValue, bool duplicateMsg, bool ser
         publishInfo.packetId = packetId;
         publishInfo.qualityOfServiceValue = qosValue;
 
-        uint8_t headerFlags = 0;
-        if (duplicateMsg) headerFlags |= PUBLISH_DUP_FLAG;
-        if (serverRetain) headerFlags |= PUBLISH_QOS_RETAIN;
-        if (qosValue != DELIVER_AT_MOST_ONCE)
-        {
-            if (qosValue == DELIVER_AT_LEAST_ONCE)
-            {
-                headerFlags |= PUBLISH_QOS_AT_LEAST_ONCE;
-            }
-            else
-            {
-                headerFlags |= PUBLISH_QOS_EXACTLY_ONCE;
-            }
-        }
+        uint8_t headerFlags = constructPublishFlags(qosValue, duplicateMsg, serverRetain);
 
         /* Codes_SRS_MQTT_CODEC_07_007: [mqtt_codec_publish shall return a BUFFER_HANDLE that represents a MQTT PUBLISH message.] */
-        result = BUFFER_new();
+        // The exact packet size is known: fixed header, variable header and payload are written in one allocation
+        result = BUFFER_create_with_size(headerLen + buffLen);
         if (result != NULL)
         {
-            STRING_HANDLE varible_header_log = NULL;
-            if (trace_log != NULL)
-            {
-                varible_header_log = STRING_construct_sprintf(" | IS_DUP: %s | RETAIN: %d | QOS: %s", duplicateMsg ? TRUE_CONST : FALSE_CONST,
-                    serverRetain ? 1 : 0,
-                    retrieve_qos_value(publishInfo.qualityOfServiceValue) );
-            }
-
-            if (constructPublishVariableHeader(result, &publishInfo, varible_header_log) != 0)
+            uint8_t* iterator = BUFFER_u_char(result);
+            if (iterator == NULL)
             {
                 /* Codes_SRS_MQTT_CODEC_07_006: [If any error is encountered then mqtt_codec_publish shall return NULL.] */
                 BUFFER_delete(result);
@@ -794,67 +814,51 @@ BUFFER_HANDLE mqtt_codec_publish(QOS_VALUE qosValue, bool duplicateMsg, bool ser
             }
             else
             {
-                size_t payloadOffset = BUFFER_length(result);
+                writePublishHeader(&iterator, headerFlags, remainLen, &publishInfo);
                 if (buffLen > 0)
                 {
-                    if (BUFFER_enlarge(result, buffLen) != 0)
-                    {
-                        /* Codes_SRS_MQTT_CODEC_07_006: [If any error is encountered then mqtt_codec_publish shall return NULL.] */
-                        BUFFER_delete(result);
-                        result = NULL;
-                    }
-                    else
-                    {
-                        uint8_t* iterator = BUFFER_u_char(result);
-                        if (iterator == NULL)
-                        {
-                            /* Codes_SRS_MQTT_CODEC_07_006: [If any error is encountered then mqtt_codec_publish shall return NULL.] */
-                            BUFFER_delete(result);
-                            result = NULL;
-                        }
-                        else
-                        {
-                            iterator += payloadOffset;
-                            // Write Message
-                            (void)memcpy(iterator, msgBuffer, buffLen);
-                            if (trace_log)
-                            {
-                                STRING_sprintf(varible_header_log, " | PAYLOAD_LEN: %lu", (unsigned long)buffLen);
-                            }
-                        }
-                    }
-                }
-
-                if (result != NULL)
-                {
-                    if (trace_log != NULL)
-                    {
-                        (void)STRING_copy(trace_log, "PUBLISH");
-                    }
-                    if (constructFixedHeader(result, PUBLISH_TYPE, headerFlags) != 0)
-                    {
-                        /* Codes_SRS_MQTT_CODEC_07_006: [If any error is encountered then mqtt_codec_publish shall return NULL.] */
-                        BUFFER_delete(result);
-                        result = NULL;
-                    }
-                    else
-                    {
-                        if (trace_log != NULL)
-                        {
-                            (void)STRING_concat_with_STRING(trace_log, varible_header_log);
-                        }
-                    }
+                    // Write Message
+                    (void)memcpy(iterator, msgBuffer, buffLen);
                 }
-            }
-            if (varible_header_log != NULL)
-            {
-                STRING_delete(varible_header_log);
+                tracePublish(trace_log, qosValue, duplicateMsg, serverRetain, packetId, topicName, buffLen);
             }
         }
     }
     return result;
 }
 
+int mqtt_codec_publishHeader(QOS_VALUE qosValue, bool duplicateMsg, bool serverRetain, uint16_t packetId, const char* topicName, size_t buffLen, uint8_t* header, size_t headerSize, size_t* headerLen, STRING_HANDLE trace_log)
+{
+    int result;
+    size_t remainLen;
+    if (topicName == NULL || headerLen == NULL || buffLen > MAX_SEND_SIZE)
+    {
+        result = MU_FAILURE;
+    }
+    else if (computePublishSize(qosValue, topicName, buffLen, headerLen, &remainLen) != 0)
+    {
+        result = MU_FAILURE;
+    }
+    else if (header == NULL || headerSize < *headerLen)
+    {
+        // *headerLen tells the caller the header size needed
+        result = MU_FAILURE;
+    }
+    else
+    {
+        PUBLISH_HEADER_INFO publishInfo ={ 0 };
+        publishInfo.topicName = topicName;
+        publishInfo.packetId = packetId;
+        publishInfo.qualityOfServiceValue = qosValue;
+
+        uint8_t* iterator = header;
+        writePublishHeader(&iterator, constructPublishFlags(qosValue, duplicateMsg, serverRetain), remainLen, &publishInfo);
+        tracePublish(trace_log, qosValue, duplicateMsg, serverRetain, packetId, topicName, buffLen);
+        result = 0;
+    }
+    return result;
+}
+
 BUFFER_HANDLE mqtt_codec_publishAck(uint16_t packetId)
 {
     /* Codes_SRS_MQTT_CODEC_07_013: [On success mqtt_codec_publishAck shall return a BUFFER_HANDLE representation of a MQTT PUBACK packet.] */
@@ -1068,58 +1072,68 @@ int mqtt_codec_bytesReceived(MQTTCODEC_HANDLE handle, const unsigned char* buffe
         /* Codes_SRS_MQTT_CODEC_07_033: [mqtt_codec_bytesReceived constructs a sequence of bytes into the corresponding MQTT packets and on success returns zero.] */
         result = 0;
         size_t index = 0;
-        for (index = 0; index < size && result == 0; index++)
+        while (index < size && result == 0)
         {
-            uint8_t iterator = ((int8_t*)buffer)[index];
             if (codec_Data->codecState == CODEC_STATE_FIXED_HEADER)
             {
+                uint8_t iterator = buffer[index++];
                 if (codec_Data->currPacket == UNKNOWN_TYPE)
                 {
                     codec_Data->currPacket = processControlPacketType(iterator, &codec_Data->headerFlags);
                 }
-                else
+                else if (prepareheaderDataInfo(codec_Data, iterator) != 0)
                 {
-                    if (prepareheaderDataInfo(codec_Data, iterator) != 0)
+                    /* Codes_SRS_MQTT_CODEC_07_035: [If any error is encountered then the packet state will be marked as error and mqtt_codec_bytesReceived shall return a non-zero value.] */
+                    codec_Data->currPacket = PACKET_TYPE_ERROR;
+                    result = MU_FAILURE;
+                }
+                else if (codec_Data->codecState == CODEC_STATE_VAR_HEADER)
+                {
+                    size_t packetLen = codec_Data->remainLen;
+                    if (packetLen == 0 || size - index >= packetLen)
                     {
-                        /* Codes_SRS_MQTT_CODEC_07_035: [If any error is encountered then the packet state will be marked as error and mqtt_codec_bytesReceived shall return a non-zero value.] */
-                        codec_Data->currPacket = PACKET_TYPE_ERROR;
-                        result = MU_FAILURE;
+                        // The whole packet is in the received buffer: dispatch it from there
+                        const uint8_t* packetData = &buffer[index];
+                        index += packetLen;
+                        /* Codes_SRS_MQTT_CODEC_07_034: [Upon a constructing a complete MQTT packet mqtt_codec_bytesReceived shall call the ON_PACKET_COMPLETE_CALLBACK function.] */
+                        if (completePacketData(codec_Data, (packetLen > 0) ? packetData : NULL, packetLen) != 0)
+                        {
+                            /* Codes_SRS_MQTT_CODEC_07_035: [If any error is encountered then the packet state will be marked as error and mqtt_codec_bytesReceived shall return a non-zero value.] */
+                            codec_Data->currPacket = PACKET_TYPE_ERROR;
+                            result = MU_FAILURE;
+                        }
                     }
-                    if (codec_Data->currPacket == PINGRESP_TYPE)
+                    else if ((codec_Data->headerData = BUFFER_create_with_size(packetLen)) == NULL)
                     {
-                        /* Codes_SRS_MQTT_CODEC_07_034: [Upon a constructing a complete MQTT packet mqtt_codec_bytesReceived shall call the ON_PACKET_COMPLETE_CALLBACK function.] */
-                        completePacketData(codec_Data);
+                        /* Codes_SRS_MQTT_CODEC_07_035: [ If any error is encountered then the packet state will be marked as error and mqtt_codec_bytesReceived shall return a non-zero value. ] */
+                        LogError("Failed BUFFER_create_with_size");
+                        codec_Data->currPacket = PACKET_TYPE_ERROR;
+                        result = MU_FAILURE;
                     }
                 }
             }
-            else if (codec_Data->codecState == CODEC_STATE_VAR_HEADER)
+            else if (codec_Data->codecState == CODEC_STATE_VAR_HEADER && codec_Data->headerData != NULL)
             {
-                if (codec_Data->headerData == NULL)
+                // Packet split over several reads: copy as much as available of it at once
+                uint8_t* dataBytes = BUFFER_u_char(codec_Data->headerData);
+                size_t copyLen = codec_Data->remainLen - codec_Data->bufferOffset;
+                if (copyLen > size - index)
                 {
-                    codec_Data->codecState = CODEC_STATE_PAYLOAD;
+                    copyLen = size - index;
                 }
-                else
+                (void)memcpy(dataBytes + codec_Data->bufferOffset, &buffer[index], copyLen);
+                codec_Data->bufferOffset += copyLen;
+                index += copyLen;
+
+                if (codec_Data->bufferOffset >= codec_Data->remainLen)
                 {
-                    uint8_t* dataBytes = BUFFER_u_char(codec_Data->headerData);
-                    if (dataBytes == NULL)
+                    /* Codes_SRS_MQTT_CODEC_07_034: [Upon a constructing a complete MQTT packet mqtt_codec_bytesReceived shall call the ON_PACKET_COMPLETE_CALLBACK function.] */
+                    if (completePacketData(codec_Data, dataBytes, codec_Data->remainLen) != 0)
                     {
                         /* Codes_SRS_MQTT_CODEC_07_035: [If any error is encountered then the packet state will be marked as error and mqtt_codec_bytesReceived shall return a non-zero value.] */
                         codec_Data->currPacket = PACKET_TYPE_ERROR;
                         result = MU_FAILURE;
                     }
-                    else
-                    {
-                        // Increment the data
-                        dataBytes += codec_Data->bufferOffset++;
-                        *dataBytes = iterator;
-
-                        size_t totalLen = BUFFER_length(codec_Data->headerData);
-                        if (codec_Data->bufferOffset >= totalLen)
-                        {
-                            /* Codes_SRS_MQTT_CODEC_07_034: [Upon a constructing a complete MQTT packet mqtt_codec_bytesReceived shall call the ON_PACKET_COMPLETE_CALLBACK function.] */
-                            completePacketData(codec_Data);
-                        }
-                    }
                 }
             }
             else
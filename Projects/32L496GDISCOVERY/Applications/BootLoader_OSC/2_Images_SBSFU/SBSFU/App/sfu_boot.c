@@ -582,6 +582,7 @@ static void SFU_BOOT_SM_CheckStatusOnReset(void)
   SE_StatusTypeDef         e_se_status;
   SE_BootInfoTypeDef       x_boot_info;
   uint32_t                 u_last_exec_status;
+  uint32_t                 u_last_exec_error;
 
   TRACE("\r\n= [SBOOT] STATE: CHECK STATUS ON RESET");
 
@@ -589,6 +590,7 @@ static void SFU_BOOT_SM_CheckStatusOnReset(void)
   if (SE_INFO_ReadBootInfo(&e_se_status, &x_boot_info) == SE_SUCCESS)
   {
     u_last_exec_status = x_boot_info.LastExecStatus;
+    u_last_exec_error = x_boot_info.LastExecError;
 
     /* Try to save here the current Execution Status in order to be retrieved and analyzed in case a reboot will be triggered by an error, bug, power-off, Hw reset, etc. */
 
@@ -616,6 +618,12 @@ static void SFU_BOOT_SM_CheckStatusOnReset(void)
             }
             else
             {
+              if ((x_boot_info.ConsecutiveBootOnErrorCounter != 0U) || (u_last_exec_error != (uint32_t)SFU_EXCPT_NONE))
+              {
+                /* The last execution failed (reset on error, tamper...): do not rely on the record of the last
+                   verified Firmware */
+                SFU_IMG_ForceFullVerification();
+              }
               e_ret_status = SFU_SUCCESS;
             }
           } /* else SE_INFO_ReadBootInfo fails: go forward as we end up with a critical failure anyway */
@@ -896,6 +904,9 @@ static void SFU_BOOT_SM_InstallNewUserFw(void)
   {
     /* Launch the Firmware Installation procedure */
     e_ret_status = SFU_IMG_TriggerImageInstallation();
+
+    /* The active slot has been written: the installed FW signature is computed whatever the record says */
+    SFU_IMG_ForceFullVerification();
   }
   /* else no installation: handle this as a critical failure */
 
@@ -951,6 +962,9 @@ static void SFU_BOOT_SM_RollbackPrevUserFw(void)
    */
   e_ret_status = SFU_IMG_TriggerRecoveryProcedure();
 
+  /* The active slot has been written: the restored FW signature is computed whatever the record says */
+  SFU_IMG_ForceFullVerification();
+
   /*
    * Set the next State Machine state according to the success or the failure of e_ret_status.
    * No specific error cause managed here because the FSM state already provides the information.
@@ -94,6 +94,9 @@ extern "C" {
   * @note In this example, the header size is always a multiple of 32 to match the FLASH constraint on STM32H7.
   *       We keep this alignment for all platforms (even when the FLASH alignment constraint is another value) to have one unique header size per crypto scheme.
   * @note In this example, the header size is always 128 bytes (for all crypto schemes).
+  * @note PatchSize is 0 for a full image. Otherwise the binary following the header is an encrypted payload of PatchSize
+  *       bytes: a patch to apply to the active Firmware (delta image) or the compressed Firmware (compressed image).
+  *       FwSize and FwTag still describe the resulting Firmware.
   */
 #if SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM
 typedef struct
@@ -104,7 +107,8 @@ typedef struct
   uint16_t FwVersion;              /*!< Firmware version*/
   uint32_t FwSize;                 /*!< Firmware size (bytes)*/
   uint8_t  FwTag[SE_TAG_LEN];      /*!< Firmware Tag*/
-  uint8_t  Reserved[72];           /*!< Reserved for future use: 72 extra bytes to have a header size of 128 bytes */
+  uint32_t PatchSize;              /*!< Size of the payload (bytes) for a delta or compressed image, 0 for a full image */
+  uint8_t  Reserved[68];           /*!< Reserved for future use: 68 extra bytes to have a header size of 128 bytes */
   uint8_t  HeaderMAC[SE_TAG_LEN];  /*!< MAC of the full header message */
 } SE_FwRawHeaderTypeDef;
 
@@ -118,7 +122,7 @@ typedef struct
   uint16_t FwVersion;              /*!< Firmware version*/
   uint32_t FwSize;                 /*!< Firmware size (bytes)*/
   uint8_t  FwTag[SE_TAG_LEN];      /*!< Firmware Tag*/
-  uint8_t  Reserved[4];            /*!< Reserved for future use: set to 4 so that the header size is a multiple of 32 (FLASH constraint on H7) */
+  uint32_t PatchSize;              /*!< Size of the payload (bytes) for a delta or compressed image, 0 for a full image: keeps the header size a multiple of 32 (FLASH constraint on H7) */
   uint8_t  HeaderMAC[SE_MAC_LEN];  /*!< MAC of the full header message */
 } SE_FwRawHeaderTypeDef;
 
@@ -132,7 +136,8 @@ typedef struct
   uint16_t FwVersion;              /*!< Firmware version*/
   uint32_t FwSize;                 /*!< Firmware size (bytes)*/
   uint8_t  FwTag[SE_TAG_LEN];      /*!< Firmware Tag*/
-  uint8_t  Reserved[20];            /*!< Reserved for future use: set to 20 so that the header size is a multiple of 32 (FLASH constraint on H7) */
+  uint32_t PatchSize;              /*!< Size of the payload (bytes) for a delta or compressed image, 0 for a full image */
+  uint8_t  Reserved[16];           /*!< Reserved for future use: set to 16 so that the header size is a multiple of 32 (FLASH constraint on H7) */
   uint8_t  HeaderMAC[SE_MAC_LEN];  /*!< MAC of the full header message */
 } SE_FwRawHeaderTypeDef;
 
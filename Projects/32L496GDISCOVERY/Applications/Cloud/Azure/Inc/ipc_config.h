@@ -54,6 +54,13 @@ extern "C" {
 #define IPC_USE_SPI  (0U) /* SPI NOT SUPPORTED YET */
 #define IPC_USE_I2C  (0U) /* I2C NOT SUPPORTED YET */
 
+/* UART reception mode */
+#define IPC_USE_UART_DMA_RX (0U) /* 0: one interrupt per character received
+                                  * 1: circular DMA (DMA1 Channel5) processed on idle line and
+                                  *    half/full transfer events, recommended for high baud rates
+                                  */
+#define IPC_RXBUF_DMA_SIZE  ((uint16_t) 256U) /* circular DMA buffer size (if IPC_USE_UART_DMA_RX == 1) */
+
 /* Debug flags */
 #define DBG_IPC_RX_FIFO  (0U)             /* additional debug infos */
 #define DBG_QUEUE_SIZE ((uint16_t) 1000U) /* debug message history depth */
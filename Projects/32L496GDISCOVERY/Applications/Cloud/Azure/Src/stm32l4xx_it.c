@@ -21,12 +21,16 @@
 #include "stm32l496g_discovery.h"
 #include "stm32l4xx_it.h"
 #include "cmsis_os.h"
+#include "ipc_uart.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 extern UART_HandleTypeDef huart1;
+#if (IPC_USE_UART_DMA_RX == 1U)
+extern DMA_HandleTypeDef hdma_usart1_rx;
+#endif /* IPC_USE_UART_DMA_RX */
 extern TIM_HandleTypeDef htim3;
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
@@ -137,9 +141,23 @@ void EXTI9_5_IRQHandler(void)
 */
 void USART1_IRQHandler(void)
 {
+#if (IPC_USE_UART_DMA_RX == 1U)
+  /* idle line is not handled by HAL_UART_IRQHandler */
+  IPC_UART_IdleLineCallback(&huart1);
+#endif /* IPC_USE_UART_DMA_RX */
   HAL_UART_IRQHandler(&huart1);
 }
 
+#if (IPC_USE_UART_DMA_RX == 1U)
+/**
+* @brief This function handles DMA1 channel5 global interrupt (USART1 RX).
+*/
+void DMA1_Channel5_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart1_rx);
+}
+#endif /* IPC_USE_UART_DMA_RX */
+
 /**
 * @brief This function handles TIM3 global interrupt.
 */
@@ -117,6 +117,18 @@ extern "C" {
   * @{
   */
 #define SECBOOT_USE_LOCAL_LOADER /*!< Set this define to enable the local loader feature ( YMODEM over UART) */
+#define SFU_FWIMG_VERIFY_RECORD  /*!< Set this define to skip the signature computation of the active Firmware when it is
+                                      unchanged since its last successful verification (same metadata and same CRC).
+                                      The record is kept across the resets in the Secure Engine RAM, authenticated with
+                                      an AES-CMAC under the Secure Engine AES key. It is ignored after a power-on, an
+                                      installation, an erroneous execution or on request (SFU_IMG_ForceFullVerification).
+                                      Requires a crypto scheme with an AES key. */
+#define SFU_FWIMG_DELTA_UPDATE   /*!< Set this define to accept delta images: the FW header carries a non-null PatchSize
+                                      and the downloaded binary is a patch applied to the active Firmware before the
+                                      installation (not supported with AES-GCM). */
+#define SFU_FWIMG_COMPRESSED_UPDATE /*!< Set this define to accept compressed images: the FW header carries a non-null
+                                      PatchSize and the downloaded binary is the compressed Firmware, decompressed
+                                      during the installation (not supported with AES-GCM). */
 /**
   * @}
   */
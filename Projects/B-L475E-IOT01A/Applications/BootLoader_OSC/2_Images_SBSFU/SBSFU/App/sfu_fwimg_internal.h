@@ -246,6 +246,9 @@ SFU_ErrorStatus SFU_IMG_GetFWInfoMAC(SE_FwRawHeaderTypeDef *pSE_FwImageHeader, u
  */
 SFU_ErrorStatus SFU_IMG_VerifyFwSignature(SE_StatusTypeDef  *pSeStatus, SE_FwRawHeaderTypeDef *pFwImageHeader,
                                           uint32_t slot);
+/* check the active FW image (slot #0) in a single Secure Engine call */
+SFU_ErrorStatus SFU_IMG_VerifyActiveFwSignature(SE_StatusTypeDef *pSeStatus, SE_FwRawHeaderTypeDef *pFwImageHeader,
+                                                uint32_t Flags);
 /* tag the active FW in slot #0 as VALID */
 SFU_ErrorStatus SFU_IMG_WriteHeaderValidated(uint8_t *pHeader);
 
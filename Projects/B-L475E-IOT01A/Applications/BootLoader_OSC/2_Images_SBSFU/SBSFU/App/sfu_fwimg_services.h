@@ -129,6 +129,7 @@ SFU_ErrorStatus SFU_IMG_TriggerRollbackProcedure(void);
 SFU_ErrorStatus SFU_IMG_InvalidateCurrentFirmware(void);
 SFU_ErrorStatus SFU_IMG_VerifyActiveImgMetadata(void);
 SFU_ErrorStatus SFU_IMG_VerifyActiveImg(void);
+void SFU_IMG_ForceFullVerification(void);
 SFU_ErrorStatus SFU_IMG_LaunchActiveImg(void);
 int32_t SFU_IMG_GetActiveFwVersion(void);
 SFU_ErrorStatus SFU_IMG_HasValidActiveFirmware(void);
@@ -133,6 +133,7 @@ SE_ErrorStatus SE_LL_CRC_Config(void);
 SE_ErrorStatus SE_LL_CRC_Init(void);
 SE_ErrorStatus SE_LL_CRC_DeInit(void);
 uint32_t SE_LL_CRC_Calculate(uint32_t pBuffer[], uint32_t uBufferLength);
+uint32_t SE_LL_CRC_Accumulate(uint32_t pBuffer[], uint32_t uBufferLength);
 
 /**
   * @}
@@ -144,6 +145,8 @@ uint32_t SE_LL_CRC_Calculate(uint32_t pBuffer[], uint32_t uBufferLength);
 SE_ErrorStatus SE_LL_FLASH_Erase(void *pStart, uint32_t Length);
 SE_ErrorStatus SE_LL_FLASH_Write(void *pDestination, const void *pSource, uint32_t Length);
 SE_ErrorStatus SE_LL_FLASH_Read(void *pDestination, const void *pSource, uint32_t Length);
+void SE_LL_FLASH_DirectReadStart(void);
+SE_ErrorStatus SE_LL_FLASH_DirectReadStop(void);
 
 void NMI_Handler(void);
 /**
@@ -24,6 +24,7 @@
 #include "se_crypto_bootloader.h"
 #include "se_low_level.h"         /* required for assert_param */
 #include "se_key.h"               /* required to access the keys when not provided as input parameter (metadata authentication) */
+#include "mbedtls/aes.h"          /* AES block cipher for the AES-CMAC */
 
 /** @addtogroup SE Secure Engine
   * @{
@@ -92,6 +93,26 @@ typedef struct
 static AES_GCM_CTX_t m_AESGCMctx; /*!<Variable used to store the AES GCM context */
 #endif /* SECBOOT_CRYPTO_SCHEME */
 
+#if ( (SECBOOT_CRYPTO_SCHEME == SECBOOT_ECCDSA_WITH_AES128_CBC_SHA256) || (SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM) )
+/** @defgroup SE_CRYPTO_BOOTLOADER_Private_Variables_AES_CMAC AES CMAC variables
+ *  @brief  AES-CMAC (NIST SP 800-38B) used to authenticate the Secure Engine data kept in RAM.
+ *  @note   We do not use local variable(s) because the key material must stay in the protected area.
+ *  @{
+ */
+#define SE_CRYPTO_CMAC_BLOCK_LEN (16U)  /*!< AES block length (bytes) */
+typedef struct
+{
+  mbedtls_aes_context mbedAesCtx;              /*<! mbedTLS AES context                          */
+  uint8_t aKey[SE_CRYPTO_CMAC_BLOCK_LEN];      /*<! MAC key derived from the Firmware key        */
+  uint8_t aSubKey[SE_CRYPTO_CMAC_BLOCK_LEN];   /*<! CMAC subkey K1 or K2                         */
+  uint8_t aBlock[SE_CRYPTO_CMAC_BLOCK_LEN];    /*<! CBC-MAC chaining value                       */
+} AES_CMAC_CTX_t;
+static AES_CMAC_CTX_t m_AESCMACctx; /*!<Variable used to store the AES CMAC context */
+/**
+  * @}
+  */
+#endif /* SECBOOT_CRYPTO_SCHEME */
+
 #if ((SECBOOT_CRYPTO_SCHEME == SECBOOT_ECCDSA_WITH_AES128_CBC_SHA256) || (SECBOOT_CRYPTO_SCHEME == SECBOOT_ECCDSA_WITHOUT_ENCRYPT_SHA256))
 /** @defgroup SE_CRYPTO_BOOTLOADER_Private_Variables_SHA256 SHA256 variables
  *  @brief  Secure Hash Algorithm SHA-256.
@@ -162,11 +183,97 @@ static mbedtls_sha256_context m_SHA256ctx;
 
 /** @defgroup SE_CRYPTO_BOOTLOADER_Private_Functions_AES AES Functions
   *  @brief Helpers for AES: high level wrappers for the Cryptolib.
-  *  @note This group of functions is empty because we do not provide high level wrappers for AES.
+  *  @note Apart from the AES-CMAC, the Cryptolib APIs are called directly from the services
+  *        (@ref SE_CRYPTO_BOOTLOADER_Exported_Functions).
   * @{
   */
 
-/* no high level wrappers provided for AES primitives: the Cryptolib APIs are called directly from  the services (@ref SE_CRYPTO_BOOTLOADER_Exported_Functions) */
+#if ( (SECBOOT_CRYPTO_SCHEME == SECBOOT_ECCDSA_WITH_AES128_CBC_SHA256) || (SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM) )
+
+static void SE_CRYPTO_CMAC_Double(uint8_t *pBlock);
+static int32_t SE_CRYPTO_AES_CMAC_Compute(const uint8_t *InputMessage, const int32_t InputMessageLength,
+                                          uint8_t *pMAC);
+
+/**
+  * @brief  Multiplication by x in GF(2^128), used to derive the CMAC subkeys.
+  * @param  pBlock: block to multiply (in place).
+  * @retval None
+  */
+static void SE_CRYPTO_CMAC_Double(uint8_t *pBlock)
+{
+  uint32_t msb = (uint32_t)pBlock[0] & 0x80U;
+  uint32_t i;
+
+  for (i = 0U; i < (SE_CRYPTO_CMAC_BLOCK_LEN - 1U); i++)
+  {
+    pBlock[i] = (uint8_t)((uint32_t)pBlock[i] << 1) | (uint8_t)((uint32_t)pBlock[i + 1U] >> 7);
+  }
+  pBlock[SE_CRYPTO_CMAC_BLOCK_LEN - 1U] = (uint8_t)((uint32_t)pBlock[SE_CRYPTO_CMAC_BLOCK_LEN - 1U] << 1);
+  if (msb != 0U)
+  {
+    pBlock[SE_CRYPTO_CMAC_BLOCK_LEN - 1U] ^= 0x87U;
+  }
+}
+
+/**
+  * @brief  AES-CMAC of a message with the key set in m_AESCMACctx.mbedAesCtx.
+  * @param  InputMessage: pointer to the message.
+  * @param  InputMessageLength: message length in byte.
+  * @param  pMAC: output buffer for the MAC (SE_CRYPTO_CMAC_BLOCK_LEN bytes).
+  * @retval error status: 0 if success
+  */
+static int32_t SE_CRYPTO_AES_CMAC_Compute(const uint8_t *InputMessage, const int32_t InputMessageLength,
+                                          uint8_t *pMAC)
+{
+  int ret;
+  uint32_t remaining = (uint32_t)InputMessageLength;
+  uint32_t block_len;
+  uint32_t i;
+
+  /* Subkey K1: the encrypted null block multiplied by x, K2 = K1 multiplied by x */
+  (void)memset(m_AESCMACctx.aSubKey, 0x00, SE_CRYPTO_CMAC_BLOCK_LEN);
+  ret = mbedtls_aes_crypt_ecb(&m_AESCMACctx.mbedAesCtx, MBEDTLS_AES_ENCRYPT, m_AESCMACctx.aSubKey,
+                              m_AESCMACctx.aSubKey);
+  SE_CRYPTO_CMAC_Double(m_AESCMACctx.aSubKey);
+  if ((remaining == 0U) || ((remaining % SE_CRYPTO_CMAC_BLOCK_LEN) != 0U))
+  {
+    SE_CRYPTO_CMAC_Double(m_AESCMACctx.aSubKey);
+  }
+
+  (void)memset(m_AESCMACctx.aBlock, 0x00, SE_CRYPTO_CMAC_BLOCK_LEN);
+  do
+  {
+    block_len = (remaining < SE_CRYPTO_CMAC_BLOCK_LEN) ? remaining : SE_CRYPTO_CMAC_BLOCK_LEN;
+    for (i = 0U; i < block_len; i++)
+    {
+      m_AESCMACctx.aBlock[i] ^= InputMessage[i];
+    }
+    InputMessage += block_len;
+    remaining -= block_len;
+    if (remaining == 0U)
+    {
+      /* Last block: padded if incomplete, then masked with the subkey */
+      if (block_len < SE_CRYPTO_CMAC_BLOCK_LEN)
+      {
+        m_AESCMACctx.aBlock[block_len] ^= 0x80U;
+      }
+      for (i = 0U; i < SE_CRYPTO_CMAC_BLOCK_LEN; i++)
+      {
+        m_AESCMACctx.aBlock[i] ^= m_AESCMACctx.aSubKey[i];
+      }
+    }
+    ret += mbedtls_aes_crypt_ecb(&m_AESCMACctx.mbedAesCtx, MBEDTLS_AES_ENCRYPT, m_AESCMACctx.aBlock,
+                                 m_AESCMACctx.aBlock);
+  } while (remaining != 0U);
+
+  (void)memcpy(pMAC, m_AESCMACctx.aBlock, SE_CRYPTO_CMAC_BLOCK_LEN);
+  (void)memset(m_AESCMACctx.aSubKey, 0x00, SE_CRYPTO_CMAC_BLOCK_LEN);
+  (void)memset(m_AESCMACctx.aBlock, 0x00, SE_CRYPTO_CMAC_BLOCK_LEN);
+
+  return (ret == 0) ? 0 : -1;
+}
+
+#endif /* SECBOOT_CRYPTO_SCHEME */
 
 /**
   * @}
@@ -1046,6 +1153,62 @@ SE_ErrorStatus SE_CRYPTO_Authenticate_Metadata(SE_FwRawHeaderTypeDef *pxSE_Metad
   return e_ret_status;
 }
 
+/**
+  * @brief Secure Engine MAC Compute function.
+  *        Authenticates data kept by the Secure Engine outside of the Flash (e.g. a record in the BootInfo RAM).
+  *        The MAC is an AES-CMAC under a key derived from the Firmware AES key (AES encryption of a fixed label),
+  *        so that it can not be computed outside of the Secure Engine.
+  * @note  The crypto schemes without a secret key (@ref SECBOOT_ECCDSA_WITHOUT_ENCRYPT_SHA256) can not provide it.
+  * @param pInputBuffer: pointer to the data to authenticate.
+  * @param InputSize: data length (bytes).
+  * @param pOutputBuffer: output buffer for the MAC (SE_CRYPTO_MAC_LEN bytes).
+  * @param pOutputSize: MAC length (bytes).
+  * @retval SE_ErrorStatus SE_SUCCESS if successful, SE_ERROR otherwise.
+  */
+SE_ErrorStatus SE_CRYPTO_MAC_Compute(const uint8_t *pInputBuffer, int32_t InputSize, uint8_t *pOutputBuffer,
+                                     int32_t *pOutputSize)
+{
+  SE_ErrorStatus e_ret_status = SE_ERROR;
+
+#if ( (SECBOOT_CRYPTO_SCHEME == SECBOOT_ECCDSA_WITH_AES128_CBC_SHA256) || (SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM) )
+  /* Label encrypted with the Firmware key to derive the MAC key */
+  static const uint8_t m_aSE_MacKeyLabel[SE_CRYPTO_CMAC_BLOCK_LEN] = "SBSFU MAC KEY 01";
+  int ret; /* mbedTLS return code */
+
+  if ((NULL == pInputBuffer) || (InputSize < 0) || (NULL == pOutputBuffer) || (NULL == pOutputSize))
+  {
+    return SE_ERROR;
+  }
+
+  /* Derive the MAC key from the Firmware key */
+  mbedtls_aes_init(&m_AESCMACctx.mbedAesCtx);
+  SE_ReadKey(&(m_aSE_FirmwareKey[0]));
+  ret = mbedtls_aes_setkey_enc(&m_AESCMACctx.mbedAesCtx, &(m_aSE_FirmwareKey[0]), SE_SYMKEY_LEN * 8);
+  SE_CLEAN_UP_FW_KEY();
+  ret += mbedtls_aes_crypt_ecb(&m_AESCMACctx.mbedAesCtx, MBEDTLS_AES_ENCRYPT, m_aSE_MacKeyLabel, m_AESCMACctx.aKey);
+  ret += mbedtls_aes_setkey_enc(&m_AESCMACctx.mbedAesCtx, m_AESCMACctx.aKey, SE_CRYPTO_CMAC_BLOCK_LEN * 8U);
+  (void)memset(m_AESCMACctx.aKey, 0x00, SE_CRYPTO_CMAC_BLOCK_LEN);
+
+  if ((0 == ret) && (0 == SE_CRYPTO_AES_CMAC_Compute(pInputBuffer, InputSize, pOutputBuffer)))
+  {
+    *pOutputSize = (int32_t)SE_CRYPTO_CMAC_BLOCK_LEN;
+    e_ret_status = SE_SUCCESS;
+  }
+
+  /* Clean-up */
+  mbedtls_aes_free(&m_AESCMACctx.mbedAesCtx);
+#else
+  /* No secret key to authenticate the data */
+  (void)pInputBuffer;
+  (void)InputSize;
+  (void)pOutputBuffer;
+  (void)pOutputSize;
+#endif /* SECBOOT_CRYPTO_SCHEME */
+
+  /* Return status*/
+  return e_ret_status;
+}
+
 /**
   * @}
   */
@@ -152,6 +152,18 @@ uint32_t SE_LL_CRC_Calculate(uint32_t pBuffer[], uint32_t uBufferLength)
   return HAL_CRC_Calculate(&CrcHandle, pBuffer, uBufferLength);
 }
 
+/**
+  * @brief  Wrapper to HAL CRC Accumulate function.
+  * @note   The computation goes on from the result of the previous SE_LL_CRC_Calculate or SE_LL_CRC_Accumulate call.
+  * @param  pBuffer: pointer to data buffer.
+  * @param  uBufferLength: buffer length in 32-bits word.
+  * @retval uint32_t CRC (returned value LSBs for CRC shorter than 32 bits)
+  */
+uint32_t SE_LL_CRC_Accumulate(uint32_t pBuffer[], uint32_t uBufferLength)
+{
+  return HAL_CRC_Accumulate(&CrcHandle, pBuffer, uBufferLength);
+}
+
 /**
   * @}
   */
@@ -286,6 +298,40 @@ SE_ErrorStatus SE_LL_FLASH_Read(void *pDestination, const void *pSource, uint32_
   return e_ret_status;
 }
 
+/**
+  * @brief  Start reading the FLASH directly (through its memory mapping) from the protected area.
+  * @note   A double ECC error raised while reading the FLASH is reported by @ref SE_LL_FLASH_DirectReadStop.
+  * @param  None.
+  * @retval None.
+  */
+void SE_LL_FLASH_DirectReadStart(void)
+{
+  SE_DoubleECC_Error_Counter = 0U;
+  SE_DoubleECC_Check = 1U;
+}
+
+/**
+  * @brief  Stop reading the FLASH directly (through its memory mapping) from the protected area.
+  * @param  None.
+  * @retval SE_ErrorStatus SE_SUCCESS if the FLASH has been read successfully since
+  *         @ref SE_LL_FLASH_DirectReadStart, SE_ERROR otherwise.
+  */
+SE_ErrorStatus SE_LL_FLASH_DirectReadStop(void)
+{
+  SE_ErrorStatus e_ret_status;
+
+  if (SE_DoubleECC_Error_Counter == 0U)
+  {
+    e_ret_status = SE_SUCCESS;
+  }
+  else
+  {
+    e_ret_status = SE_ERROR;
+  }
+  SE_DoubleECC_Error_Counter = 0U;
+  return e_ret_status;
+}
+
 /**
   * @brief Flash IRQ Handler
   * @param None.
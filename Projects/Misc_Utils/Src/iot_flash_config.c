@@ -433,6 +433,11 @@ int updateTLSCredentials(void)
     msg_error("Failed updating the TLS configuration in Flash.\n");
   }
 
+#ifdef NET_MBEDTLS_HOST_SUPPORT
+  /* The credentials cached by the network library may have been rewritten. */
+  net_mbedtls_flush_cache();
+#endif /* NET_MBEDTLS_HOST_SUPPORT */
+
   return ret;
 }
 
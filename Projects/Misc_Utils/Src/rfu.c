@@ -135,16 +135,169 @@ uint32_t SFU_APP_GetDownloadAreaInfo(SFU_FwImageFlashTypeDef *pArea)
 #endif /* GENERIC_OTA || CLD_OTA */
 
 #if defined(GENERIC_OTA) || defined(CLD_OTA)
-#define ALIGN64bit(a)      (((a + 7) / 8) * 8)
 #define MAX_ERROR_RETRY_NB 3
 #define MAX_DUPLICATE_RANGE_NB 3
 #define FW_PAGE_SIZE    1024
-#define HEADERS_SIZE    1024
 #define OTA_READ_TIMEOUT  30000
+#ifndef RFU_PIPELINE_DEPTH
+#define RFU_PIPELINE_DEPTH    4U    /* Number of range requests kept in flight on the HTTP connection */
+#endif
+#define FLASH_DWORD_SIZE      8U    /* Flash programming unit, and source alignment expected by FLASH_Write() */
+#define FLASH_BOUNCE_SIZE     128U  /* Staging buffer for sources which are not doubleword-aligned */
+
+/**
+  * @brief Streaming Flash writer.
+  *        Programs the data as they arrive, whatever the alignment of the source buffer and the size
+  *        of each piece: the bytes which do not complete a doubleword are carried to the next call.
+  */
+typedef struct
+{
+  uint32_t  Addr;                             /*!< Next Flash address to program, doubleword-aligned */
+  uint32_t  TailLen;                          /*!< Number of bytes waiting in Tail */
+  uint64_t  Tail;                             /*!< Incomplete doubleword carried between calls */
+} FLASH_StreamWriterTypeDef;
+
+/**
+  * @brief  Initialize a streaming Flash writer.
+  * @param  pWriter  writer context
+  * @param  Addr     doubleword-aligned Flash address of the first byte to write
+  */
+static void FLASH_StreamInit(FLASH_StreamWriterTypeDef *pWriter, uint32_t Addr)
+{
+  pWriter->Addr = Addr;
+  pWriter->TailLen = 0;
+  pWriter->Tail = 0;
+}
+
+/**
+  * @brief  Append data to the Flash through a streaming writer.
+  * @note   Doubleword-aligned runs are programmed straight from the source buffer,
+  *         other runs are staged through a small aligned buffer.
+  * @param  pWriter  writer context
+  * @param  pData    data to write, no alignment constraint
+  * @param  Len      number of bytes to write
+  * @retval HAL_OK on success otherwise HAL_ERROR
+  */
+static int FLASH_StreamWrite(FLASH_StreamWriterTypeDef *pWriter, const uint8_t *pData, uint32_t Len)
+{
+  int ret = HAL_OK;
+  uint8_t *pTail = (uint8_t *) &pWriter->Tail;
+
+  /* Complete the doubleword left over by the previous call */
+  if (pWriter->TailLen > 0)
+  {
+    uint32_t fill = FLASH_DWORD_SIZE - pWriter->TailLen;
+    fill = (Len < fill) ? Len : fill;
+    memcpy(pTail + pWriter->TailLen, pData, fill);
+    pWriter->TailLen += fill;
+    pData += fill;
+    Len -= fill;
+    if (pWriter->TailLen == FLASH_DWORD_SIZE)
+    {
+      ret = FLASH_Write(pWriter->Addr, (uint32_t *) &pWriter->Tail, FLASH_DWORD_SIZE);
+      pWriter->Addr += FLASH_DWORD_SIZE;
+      pWriter->TailLen = 0;
+    }
+  }
+
+  while ((ret == HAL_OK) && (Len >= FLASH_DWORD_SIZE))
+  {
+    uint32_t run = Len - (Len % FLASH_DWORD_SIZE);
+
+    if (((uint32_t) pData % FLASH_DWORD_SIZE) == 0)
+    {
+      ret = FLASH_Write(pWriter->Addr, (uint32_t *) pData, run);
+    }
+    else
+    {
+      uint64_t bounce[FLASH_BOUNCE_SIZE / sizeof(uint64_t)];
+      run = (run > FLASH_BOUNCE_SIZE) ? FLASH_BOUNCE_SIZE : run;
+      memcpy(bounce, pData, run);
+      ret = FLASH_Write(pWriter->Addr, (uint32_t *) bounce, run);
+    }
+    if (ret != HAL_OK)
+    {
+      msg_error("FLASH_Write(%lx, %lu) failed\n", pWriter->Addr, run);
+    }
+    pWriter->Addr += run;
+    pData += run;
+    Len -= run;
+  }
+
+  /* Keep the remainder for the next call */
+  if ((ret == HAL_OK) && (Len > 0))
+  {
+    memcpy(pTail, pData, Len);
+    pWriter->TailLen = Len;
+  }
+  return ret;
+}
+
+/**
+  * @brief  Program the last incomplete doubleword, if any, padded with the erased Flash value.
+  * @param  pWriter  writer context
+  * @retval HAL_OK on success otherwise HAL_ERROR
+  */
+static int FLASH_StreamFlush(FLASH_StreamWriterTypeDef *pWriter)
+{
+  int ret = HAL_OK;
+
+  if (pWriter->TailLen > 0)
+  {
+    memset((uint8_t *) &pWriter->Tail + pWriter->TailLen, 0xFF, FLASH_DWORD_SIZE - pWriter->TailLen);
+    ret = FLASH_Write(pWriter->Addr, (uint32_t *) &pWriter->Tail, FLASH_DWORD_SIZE);
+    pWriter->Addr += FLASH_DWORD_SIZE;
+    pWriter->TailLen = 0;
+  }
+  return ret;
+}
+
+/**
+  * @brief Context of the body callback of the download.
+  */
+typedef struct
+{
+  FLASH_StreamWriterTypeDef *pWriter;         /*!< Flash writer of the download area */
+  uint32_t  Offset;                           /*!< Offset in the image of the next byte to program */
+  int       FlashRc;                          /*!< Flash programming error, if any */
+} FW_UPDATE_BodyCtxTypeDef;
+
+/**
+  * @brief  HTTP body callback: program the received piece of firmware, as it is parsed.
+  * @note   Only the expected range is programmed. Anything else is skipped and requested again.
+  * @param  parser  HTTP parser of the response, with the headers
+  * @param  data    piece of body
+  * @param  length  piece size
+  * @retval 0 to continue, otherwise the Flash error code
+  */
+static int FW_UPDATE_WriteBody(http_parser_t *parser, const uint8_t *data, uint32_t length)
+{
+  FW_UPDATE_BodyCtxTypeDef *pCtx = (FW_UPDATE_BodyCtxTypeDef *) parser->body_ctx;
+  int ret = 0;
+
+  if (((parser->status / 100U) == 2U) && (parser->has_content_range == true)
+      && ((parser->range_start + parser->body_length) == pCtx->Offset))
+  {
+    ret = FLASH_StreamWrite(pCtx->pWriter, data, length);
+    if (ret == HAL_OK)
+    {
+      pCtx->Offset += length;
+    }
+    else
+    {
+      pCtx->FlashRc = ret;
+    }
+  }
+  return ret;
+}
 
 /**
  * @brief   Download a firmware image from an HTTP server into Flash memory.
  * @note    The HTTP server must support the "Range:" request header. This is the case with HTTP/1.1.
+ * @note    Up to RFU_PIPELINE_DEPTH range requests are kept in flight on the same connection (HTTP/1.1
+ *          pipelining), so that the next chunks are being received while the current one is programmed.
+ *          After a disconnection, the download resumes at the last programmed offset.
+ * @note    The response bodies are programmed as they are received: no response buffer is needed.
  * @param   In: fw_image_dwl_area  Memory area for the new firmware
  * @param   In: url                Network location of the new firmware (HTTP URL: "http://<hostname>:<port>/<path>")
  * @param   In: ca_certs           Root CA certificates (required for server authentication if a TLS session is needed)
@@ -160,25 +313,25 @@ static int FW_UPDATE_DownloadNewFirmware(SFU_FwImageFlashTypeDef *fw_image_dwl_a
   int  port = 80;
   bool is_tls = false;
   char query[256]; /* to be fine-tuned according to your path */
-  uint32_t *http_response_buffer = (uint32_t*) ALIGN64bit((uint32_t) malloc(FW_PAGE_SIZE + HEADERS_SIZE + 8));
-  uint32_t areaAddr = fw_image_dwl_area->DownloadAddr;
+  FLASH_StreamWriterTypeDef flash_writer;
+  FW_UPDATE_BodyCtxTypeDef body_ctx;
+  http_parser_t parser;
   int  net_rc = 0;
-  int  flash_rc = 0;
   int  rfu_rc = RFU_OK;
   char range_header[256];
   uint32_t full_fw_size = FW_PAGE_SIZE;
-  uint32_t range_start = 0;
-  uint32_t range_end = 0;
   uint32_t cumulated_received_size = 0;
-  uint32_t range_size = FW_PAGE_SIZE;
+  uint32_t requested_size = 0;
+  uint32_t in_flight_nb = 0;
   uint32_t body_size = 0;
-  uint32_t response_size = FW_PAGE_SIZE + HEADERS_SIZE;
-  uint8_t * pBody = NULL;
   uint32_t remaining = 0;
   http_handle_t httpHnd = 0;
   int error_retry_nb = 0;
   unsigned int duplicate_range_retry_nb = 0;
 
+  FLASH_StreamInit(&flash_writer, fw_image_dwl_area->DownloadAddr);
+  body_ctx.pWriter = &flash_writer;
+  body_ctx.FlashRc = HAL_OK;
 
   net_rc = http_url_parse(host, sizeof(host), &port, &is_tls, query, sizeof(query), url);
   if (net_rc != HTTP_OK)
@@ -240,83 +393,88 @@ static int FW_UPDATE_DownloadNewFirmware(SFU_FwImageFlashTypeDef *fw_image_dwl_a
          rfu_rc = RFU_ERR_HTTP;
          goto error;
       }
+      /* The requests in flight on the previous connection are lost: resume at the last programmed offset. */
+      requested_size = cumulated_received_size;
+      in_flight_nb = 0;
     }
 
-    remaining = full_fw_size - cumulated_received_size;
-    remaining = (remaining > range_size)?range_size:remaining;
-    sprintf(range_header, "Range: bytes=%lu-%lu\r\n", cumulated_received_size, cumulated_received_size + remaining - 1);
-    response_size = FW_PAGE_SIZE+HEADERS_SIZE;
-    net_rc = http_get(httpHnd, query,
-                  range_header,
-                  (uint8_t*)http_response_buffer,
-                  &response_size);
-    msg_debug("http_get() ret=%d response_size=%d\n", net_rc, response_size);
-    if (((net_rc == HTTP_OK)||(net_rc == HTTP_EOF)) && (response_size > 0))
+    /* Top up the pipeline. The first request of the download is alone until the response
+       tells the firmware size. */
+    while ((net_rc == HTTP_OK) && (in_flight_nb < RFU_PIPELINE_DEPTH)
+           && (requested_size < full_fw_size) && (requested_size < fw_image_dwl_area->MaxSizeInBytes))
     {
-      range_start = 0;
-      range_end = 0;
-      full_fw_size = 0;
-      body_size = response_size;
-      pBody = http_find_body((uint8_t*)http_response_buffer, &body_size);
-      msg_debug("pBody=%x body_size=%d\n", pBody, body_size);
-      msg_debug("HTTP response:\n%.*s\n", pBody - (uint8_t *)http_response_buffer, (char *)http_response_buffer);
-      http_content_range((uint8_t*)http_response_buffer, response_size, &range_start, &range_end, &full_fw_size);
-      if (range_start != cumulated_received_size)
+      remaining = full_fw_size - requested_size;
+      remaining = (remaining > FW_PAGE_SIZE)?FW_PAGE_SIZE:remaining;
+      sprintf(range_header, "Range: bytes=%lu-%lu\r\n", requested_size, requested_size + remaining - 1);
+      net_rc = http_send_get(httpHnd, query, range_header);
+      msg_debug("http_send_get(%s) ret=%d\n", range_header, net_rc);
+      if (net_rc == HTTP_OK)
       {
-        msg_debug("range_start(%d) != cumulated_received_size(%d) -> ask again\n",
-                  range_start, cumulated_received_size);
-        if (duplicate_range_retry_nb < MAX_DUPLICATE_RANGE_NB)
-        {
-          duplicate_range_retry_nb += 1;
-          /* The received range is different than the one requested.
-             Something is wrong in the connection. So close it.
-             It will be re-opened at beginning of loop.
-          */
-          http_close(httpHnd);
-          continue;
-        }
-        else
-        {
-          msg_error("Reached max number of duplicate range. Exiting.\n");
-          net_rc = HTTP_ERR;
-          break;
-        }
+        requested_size += remaining;
+        in_flight_nb++;
+      }
+    }
+
+    if ((net_rc == HTTP_OK) && (in_flight_nb > 0))
+    {
+      /* The body is programmed in Flash by FW_UPDATE_WriteBody() while the response is parsed. */
+      body_ctx.Offset = cumulated_received_size;
+      http_parser_init(&parser, FW_UPDATE_WriteBody, &body_ctx);
+      net_rc = http_recv_get_response_stream(httpHnd, &parser);
+      in_flight_nb--;
+      body_size = body_ctx.Offset - cumulated_received_size;
+      msg_debug("http_recv_get_response_stream() ret=%d status=%lu body=%lu programmed=%lu\n",
+                net_rc, parser.status, parser.body_length, body_size);
+      if (body_ctx.FlashRc != HAL_OK)
+      {
+        printf("ERROR: Unable to write flash area at %lx - return=%d\n", flash_writer.Addr, body_ctx.FlashRc);
+        rfu_rc = RFU_ERR_FLASH;
+        goto error;
       }
-      else
+      if (body_size > 0)
       {
-        duplicate_range_retry_nb = 0;
+        printf(".");
       }
 
-      if (body_size > 0)
+      if ((net_rc == HTTP_OK) || (net_rc == HTTP_EOF))
       {
-        /* The start of the firmware chunk can be at any address in the HTTP response
-           but we need a word-aligned source buffer to write in Flash memory
-           so we shift the firmware chunk to the beggining of buffer which is
-           a (8 bytes = L4 flash word) word-aligned buffer: http_response_buffer */
-        char *csrc = (char *)pBody;
-        char *cdest = (char *)http_response_buffer;
-        for (int i = 0; i < body_size; i++)
+        full_fw_size = (parser.has_content_range == true) ? parser.resource_size : 0;
+        if ((parser.has_content_range == false) || (parser.range_start != cumulated_received_size))
         {
-          cdest[i] = csrc[i];
+          msg_debug("range_start(%d) != cumulated_received_size(%d) -> ask again\n",
+                    parser.range_start, cumulated_received_size);
+          if (duplicate_range_retry_nb < MAX_DUPLICATE_RANGE_NB)
+          {
+            duplicate_range_retry_nb += 1;
+            /* The received range is different than the one requested.
+               Something is wrong in the connection. So close it.
+               It will be re-opened at beginning of loop.
+            */
+            http_close(httpHnd);
+            httpHnd = 0;
+            net_rc = HTTP_OK;
+            continue;
+          }
+          else
+          {
+            msg_error("Reached max number of duplicate range. Exiting.\n");
+            net_rc = HTTP_ERR;
+            break;
+          }
         }
-
-        flash_rc = FLASH_Write(areaAddr, (uint32_t*)http_response_buffer, ALIGN64bit(body_size));
-        msg_debug("FLASH_Write(%x, %x, %d) returns %d\n", areaAddr, http_response_buffer, ALIGN64bit(body_size), flash_rc);
-        if (flash_rc)
+        else
         {
-          printf("ERROR: Unable to write flash area at [%lx - %lx [ - return=%d\n", areaAddr, ALIGN64bit(body_size), flash_rc);
-          rfu_rc = RFU_ERR_FLASH;
-          goto error;
+          duplicate_range_retry_nb = 0;
         }
-        printf(".");
-        areaAddr += body_size;
-        cumulated_received_size += body_size;
       }
+      /* Even after an error, what was programmed is kept: a new connection resumes after it. */
+      cumulated_received_size = body_ctx.Offset;
     }
     if (net_rc == HTTP_EOF)
     {
       msg_debug("EOF -> Disconnecting.\n");
       http_close(httpHnd);
+      httpHnd = 0;
     }
     else
     {
@@ -332,6 +490,7 @@ static int FW_UPDATE_DownloadNewFirmware(SFU_FwImageFlashTypeDef *fw_image_dwl_a
           error_retry_nb++;
           printf("Retrying %d : close and reconnect.\n", error_retry_nb);
           http_close(httpHnd);
+          httpHnd = 0;
           net_rc = HTTP_OK;
         }
       }
@@ -343,6 +502,12 @@ static int FW_UPDATE_DownloadNewFirmware(SFU_FwImageFlashTypeDef *fw_image_dwl_a
   printf("\n");
   if ((net_rc == HTTP_OK) || (net_rc == HTTP_EOF))
   {
+    if (FLASH_StreamFlush(&flash_writer) != HAL_OK)
+    {
+      printf("ERROR: Unable to write flash area at %lx\n", flash_writer.Addr);
+      rfu_rc = RFU_ERR_FLASH;
+      goto error;
+    }
     printf("Downloaded total size %lu bytes\n", cumulated_received_size);
     rfu_rc = RFU_OK;
   } else {
@@ -350,9 +515,10 @@ static int FW_UPDATE_DownloadNewFirmware(SFU_FwImageFlashTypeDef *fw_image_dwl_a
     rfu_rc = RFU_ERR_HTTP;
   }
 error:
-  free(http_response_buffer);
-
-  http_close(httpHnd);
+  if (httpHnd != 0)
+  {
+    http_close(httpHnd);
+  }
   return rfu_rc;
 }
 
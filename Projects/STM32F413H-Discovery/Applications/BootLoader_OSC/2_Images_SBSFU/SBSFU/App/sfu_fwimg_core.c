@@ -69,6 +69,7 @@
 #define CHUNK_SIZE_SIGN_VERIFICATION (1024)  /*!< Signature verification chunk size*/
 
 #define SFU_IMG_CHUNK_SIZE  (512U)
+#define SFU_IMG_COMPARE_SIZE (64U)  /*!< RAM chunk used to compare FLASH areas (SFU_IMG_IMAGE_OFFSET is a multiple of it) */
 
 /**
   * @brief  FW slot and swap offset
@@ -102,13 +103,69 @@
 
 #define CHUNK_1_ADDR(A,B) ((uint8_t *)((uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN +(SFU_IMG_SWAP_REGION_SIZE*A)+SFU_IMG_CHUNK_SIZE*B))
 #define CHUNK_0_ADDR(A,B) ((uint8_t *)((uint32_t) SFU_IMG_SLOT_0_REGION_BEGIN +(SFU_IMG_SWAP_REGION_SIZE*A)+SFU_IMG_CHUNK_SIZE*B))
-
-#define CHUNK_0_ADDR_MODIFIED(A,B) (((A==0) && (B==0))?\
-      ((uint8_t*)((uint32_t) SFU_IMG_SLOT_0_REGION_BEGIN +SFU_IMG_IMAGE_OFFSET)) : ((uint8_t *)((uint32_t) SFU_IMG_SLOT_0_REGION_BEGIN +(SFU_IMG_SWAP_REGION_SIZE*A)+SFU_IMG_CHUNK_SIZE*B)))
 #define CHUNK_SWAP_ADDR(B) ((uint8_t *)((uint32_t) SFU_IMG_SWAP_REGION_BEGIN+SFU_IMG_CHUNK_SIZE*B))
 
 #define AES_BLOCK_SIZE (16U)  /*!< Size of an AES block to check padding needs for decrypting */
 
+#if defined(SFU_FWIMG_DELTA_UPDATE) || defined(SFU_FWIMG_COMPRESSED_UPDATE)
+#define SFU_FWIMG_STAGED_UPDATE  /*!< The downloaded payload is staged then decoded into the candidate FW */
+#endif /* SFU_FWIMG_DELTA_UPDATE || SFU_FWIMG_COMPRESSED_UPDATE */
+
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+#if (SECBOOT_CRYPTO_SCHEME == SECBOOT_AES128_GCM_AES128_GCM_AES128_GCM)
+#error "Delta and compressed images are not supported with AES-GCM: the FW tag authenticates the encrypted payload, not the resulting FW."
+#endif /* SECBOOT_CRYPTO_SCHEME */
+
+/**
+  * @brief  Staged image (PatchSize != 0 in the FW header)
+  * The FW header describes the candidate FW in clear (FwSize, FwTag) but slot #1 only contains an encrypted payload of
+  * PatchSize bytes: a patch (delta image) or the compressed candidate FW (compressed image).
+  * The clear payload starts with a DELTA_HEADER_LEN bytes header: magic (4 bytes), active FW size (4 bytes), candidate FW
+  * size (4 bytes), reserved or window size (4 bytes), active FW tag (32 bytes). The magic gives the payload type.
+  */
+#define DELTA_HEADER_LEN     (48U)
+#define DELTA_HDR_BASE_SIZE  (4U)            /*!< Offset of the active FW size in the payload header */
+#define DELTA_HDR_TARGET_SIZE (8U)           /*!< Offset of the candidate FW size in the payload header */
+#define DELTA_HDR_WINDOW     (12U)           /*!< Offset of the window size in the payload header (compressed image) */
+#define DELTA_HDR_BASE_TAG   (16U)           /*!< Offset of the active FW tag in the payload header */
+#define DELTA_CHUNK_SIZE     (256U)          /*!< RAM chunk used to decode the payload (multiple of the AES block size) */
+
+#define DELTA_GET_U32(P)     ((uint32_t)(P)[0] | ((uint32_t)(P)[1] << 8U) | ((uint32_t)(P)[2] << 16U) | ((uint32_t)(P)[3] << 24U))
+#endif /* SFU_FWIMG_STAGED_UPDATE */
+
+#if defined(SFU_FWIMG_DELTA_UPDATE)
+/**
+  * @brief  Delta image: the payload is a patch transforming the active FW (slot #0) into the candidate FW.
+  * The patch header is followed by a list of operations (little endian values):
+  *   - DELTA_OP_COPY   : 4 bytes offset in the active FW + 4 bytes length
+  *   - DELTA_OP_INSERT : 4 bytes length + the bytes to insert
+  *   - DELTA_OP_END    : end of the patch, the remaining bytes are padding
+  */
+#define DELTA_MAGIC          (0x44554653U)   /*!< 'SFUD' */
+#define DELTA_OP_END         (0x00U)
+#define DELTA_OP_COPY        (0x01U)
+#define DELTA_OP_INSERT      (0x02U)
+#endif /* SFU_FWIMG_DELTA_UPDATE */
+
+#if defined(SFU_FWIMG_COMPRESSED_UPDATE)
+/**
+  * @brief  Compressed image: the payload is the candidate FW compressed with LZ4 block format sequences.
+  * The active FW size and tag of the payload header are 0, the window size is the maximum match offset.
+  * Each sequence is:
+  *   - a token: literal length (4 high bits) and match length - LZ_MIN_MATCH (4 low bits).
+  *     A value of 15 means that extra length bytes follow, until a byte different from 255 (added to the length).
+  *   - the literal bytes
+  *   - the match offset (2 bytes, from 1 to the window size) then the extra match length bytes
+  * The last sequence has no match: the stream ends when the candidate FW size is reached, the remaining bytes are
+  * padding.
+  * As matches never reach further than the window, the decompressor only keeps the last LZ_WINDOW_SIZE bytes in RAM.
+  */
+#define COMPRESS_MAGIC       (0x43554653U)   /*!< 'SFUC' */
+#define LZ_MIN_MATCH         (4U)
+#define LZ_LEN_MASK          (0x0FU)         /*!< Length in a token nibble, LZ_LEN_MASK: extra length bytes follow */
+#define LZ_WINDOW_SIZE       (1024U)         /*!< Decompressor history in RAM: maximum window size (power of 2) */
+#endif /* SFU_FWIMG_COMPRESSED_UPDATE */
+
 /**
   * @}
   */
@@ -118,6 +175,49 @@
   * @{
   */
 
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+/**
+  * @brief  Payload parser states
+  */
+typedef enum
+{
+  DELTA_STATE_HEADER = 0U,  /*!< Receiving the payload header */
+  DELTA_STATE_OPCODE,       /*!< Waiting for the next operation */
+  DELTA_STATE_ARGS,         /*!< Receiving the arguments of the current operation */
+  DELTA_STATE_LITERAL,      /*!< Receiving the bytes of an INSERT operation */
+  DELTA_STATE_LZ_TOKEN,     /*!< Waiting for the next LZ sequence token */
+  DELTA_STATE_LZ_LITLEN,    /*!< Receiving the extra literal length bytes */
+  DELTA_STATE_LZ_LITERAL,   /*!< Receiving the literal bytes of the LZ sequence */
+  DELTA_STATE_LZ_OFFSET,    /*!< Receiving the match offset */
+  DELTA_STATE_LZ_MATCHLEN,  /*!< Receiving the extra match length bytes */
+  DELTA_STATE_END           /*!< Candidate FW complete */
+} DeltaStateTypeDef;
+
+/**
+  * @brief  Context of one payload decoding pass.
+  *         Only the candidate FW bytes in [WindowBegin, WindowEnd[ are written in FLASH by a pass.
+  */
+typedef struct
+{
+  DeltaStateTypeDef State;        /*!< Parser state */
+  uint8_t  Field[DELTA_HEADER_LEN]; /*!< Payload header, operation arguments or match offset being received */
+  uint32_t FieldLen;              /*!< Bytes received in Field */
+  uint32_t FieldExpected;         /*!< Bytes expected in Field */
+  uint8_t  OpCode;                /*!< Current operation or LZ token */
+  uint32_t OpLen;                 /*!< Bytes left for the current INSERT operation, LZ literal or match length */
+  uint32_t LzWindow;              /*!< Maximum match offset (compressed image) */
+  uint32_t LzOffset;              /*!< Offset of the current match (compressed image) */
+  uint32_t TargetOffset;          /*!< Offset of the next candidate FW byte */
+  uint32_t TargetSize;            /*!< Candidate FW size (from the FW header) */
+  uint32_t WindowBegin;           /*!< First candidate FW byte written by this pass */
+  uint32_t WindowEnd;             /*!< End of the candidate FW bytes written by this pass */
+  uint32_t DestAddress;           /*!< FLASH address of the next output chunk */
+  uint32_t EraseAddress;          /*!< Next FLASH block to erase before writing */
+  uint32_t OutLen;                /*!< Bytes pending in Out */
+  uint8_t  Out[DELTA_CHUNK_SIZE] __attribute__((aligned(8))); /*!< Output chunk */
+} DeltaCtxTypeDef;
+#endif /* SFU_FWIMG_STAGED_UPDATE */
+
 /**
   * @}
   */
@@ -138,6 +238,13 @@ static uint8_t fw_header_to_test[FW_INFO_TOT_LEN] __attribute__((aligned(8)));
  */
 static uint8_t fw_header_validated[FW_INFO_TOT_LEN] __attribute__((aligned(8)));
 
+#if defined(SFU_FWIMG_COMPRESSED_UPDATE)
+/**
+ * Last candidate FW bytes produced by the decompressor (indexed by FW offset modulo LZ_WINDOW_SIZE)
+ */
+static uint8_t lz_history[LZ_WINDOW_SIZE];
+#endif /* SFU_FWIMG_COMPRESSED_UPDATE */
+
 /**
   * @}
   */
@@ -646,71 +753,114 @@ static SFU_ErrorStatus  GetTrailerInfo(SE_Ex_PayloadDescTypeDef  *pSE_Payload)
   return e_ret_status;
 }
 
+/**
+  * @brief  Compare two FLASH areas
+  * @param  dest address of the first area
+  * @param  src  address of the second area
+  * @param  size number of bytes to compare
+  * @retval SFU_SUCCESS if both areas hold the same content, SFU_ERROR otherwise (or if one of them cannot be read).
+  */
+static SFU_ErrorStatus CompareFlash(uint32_t dest, uint32_t src, uint32_t size)
+{
+  SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  uint8_t dest_buffer[SFU_IMG_COMPARE_SIZE] __attribute__((aligned(8)));
+  uint8_t src_buffer[SFU_IMG_COMPARE_SIZE] __attribute__((aligned(8)));
+  uint32_t len;
+
+  while ((e_ret_status == SFU_SUCCESS) && (size > 0U))
+  {
+    len = (size < sizeof(dest_buffer)) ? size : sizeof(dest_buffer);
+    /* A double ECC error (interrupted programming) is reported as a difference */
+    e_ret_status = SFU_LL_FLASH_Read(dest_buffer, (void *)dest, len);
+    if (e_ret_status == SFU_SUCCESS)
+    {
+      e_ret_status = SFU_LL_FLASH_Read(src_buffer, (void *)src, len);
+    }
+    if ((e_ret_status == SFU_SUCCESS) && (memcmp(dest_buffer, src_buffer, len) != 0))
+    {
+      e_ret_status = SFU_ERROR;
+    }
+    dest += len;
+    src += len;
+    size -= len;
+  }
+  return e_ret_status;
+}
+
+/**
+  * @brief  Program a FLASH area with the content of another FLASH area
+  * @note   The destination must be erased (or already hold the source content): the chunks which already hold the
+  *         source content (e.g. blank chunks after an erase) are not programmed.
+  * @param  dest address of flash to program
+  * @param  src  address of flash to copy from
+  * @param  size number of bytes to copy (multiple of sizeof(SFU_LL_FLASH_write_t))
+  * @retval SFU_ SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus ProgramFlash(uint32_t dest, uint32_t src, uint32_t size)
+{
+  SFU_FLASH_StatusTypeDef flash_if_status;
+  SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  uint8_t buffer[SFU_IMG_CHUNK_SIZE] __attribute__((aligned(8)));
+  uint32_t len;
+
+  while ((e_ret_status == SFU_SUCCESS) && (size > 0U))
+  {
+    len = (size < sizeof(buffer)) ? size : sizeof(buffer);
+    if (CompareFlash(dest, src, len) != SFU_SUCCESS)
+    {
+      e_ret_status = SFU_LL_FLASH_Read(buffer, (void *)src, len);
+      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_READ_FAILED);
+      if (e_ret_status == SFU_SUCCESS)
+      {
+        e_ret_status = SFU_LL_FLASH_Write(&flash_if_status, (void *)dest, buffer, len);
+        StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_WRITE_FAILED);
+      }
+    }
+    dest += len;
+    src += len;
+    size -= len;
+  }
+  return e_ret_status;
+}
+
 /**
   * @brief  Recopy a flash block to flash
-  * @param  dest address of flash to recopy (it must be the start of sector
+  * @note   The copy is done per block of the swap area size: a block of the destination which already holds the source
+  *         content is neither erased nor programmed.
+  * @param  dest address of flash to recopy (it must be the start of a block of the swap area size)
   * @param  src  address of flash to copy from
-  * @param  size it must be a multiple of flash sector size (and a multiple of 2)
+  * @param  size number of bytes to copy (multiple of sizeof(SFU_LL_FLASH_write_t))
   * @retval SFU_ SUCCESS if successful, a SFU_ErrorStatus error otherwise.
   */
 static SFU_ErrorStatus RecopyFlash(uint32_t dest, uint32_t src, uint32_t size)
 {
   SFU_FLASH_StatusTypeDef flash_if_status;
   SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  uint32_t len;
 
   if ((dest == 0) || (src == 0))
   {
     return SFU_ERROR;
   }
 
-  if (0 == size)
-  {
-    /* There is nothing to recopy so return now */
-    return (SFU_SUCCESS);
-  }
-
-  SFU_LL_SECU_IWDG_Refresh();
-  /* The FLASH erase is split becasue of the IWDG: this means that the size must also be a multiple of 2 (constraint) */
-  e_ret_status = SFU_LL_FLASH_Erase_Size(&flash_if_status, (void *)dest, size / 2U);
-  StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_ERASE_FAILED);
-  SFU_LL_SECU_IWDG_Refresh();
-  e_ret_status = SFU_LL_FLASH_Erase_Size(&flash_if_status, (void *)(dest + (size / 2U)), size / 2U);
-  StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_ERASE_FAILED);
-  SFU_LL_SECU_IWDG_Refresh();
-  if (e_ret_status == SFU_SUCCESS)
+  while ((e_ret_status == SFU_SUCCESS) && (size > 0U))
   {
-    uint8_t buffer[512];
-    uint32_t number_of_chunk = (size + sizeof(buffer) - 1) / sizeof(buffer);
-    uint32_t i, last_size, read_size = sizeof(buffer);
-    last_size = size - (number_of_chunk - 1) * sizeof(buffer);
-
-    /* number_of_chunk is always positive as we exit earlier when size == 0 */
-    e_ret_status = SFU_ERROR;
-
-    for (i = 0; i < number_of_chunk; i++)
+    len = (size < SFU_IMG_SWAP_REGION_SIZE) ? size : SFU_IMG_SWAP_REGION_SIZE;
+    SFU_LL_SECU_IWDG_Refresh();
+    if (CompareFlash(dest, src, len) != SFU_SUCCESS)
     {
-      SFU_LL_SECU_IWDG_Refresh();
-      if (i  == (number_of_chunk - 1))
-      {
-        read_size = last_size;
-      }
-      e_ret_status = SFU_LL_FLASH_Read(buffer, (void *)src, read_size);
-      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_READ_FAILED);
-      if (e_ret_status == SFU_ERROR)
-      {
-        break;
-      }
-      SFU_LL_SECU_IWDG_Refresh();
-      e_ret_status = SFU_LL_FLASH_Write(&flash_if_status, (void *)dest, buffer, read_size);
-      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_WRITE_FAILED)
-      if (e_ret_status == SFU_ERROR)
+      /* SFU_LL_FLASH_Erase_Size refreshes the IWDG between the erase operations */
+      e_ret_status = SFU_LL_FLASH_Erase_Size(&flash_if_status, (void *)dest, len);
+      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_ERASE_FAILED);
+      if (e_ret_status == SFU_SUCCESS)
       {
-        break;
+        SFU_LL_SECU_IWDG_Refresh();
+        e_ret_status = ProgramFlash(dest, src, len);
       }
-      dest += read_size;
-      src += read_size;
     }
-
+    dest += len;
+    src += len;
+    size -= len;
   }
 
   return e_ret_status;
@@ -871,23 +1021,26 @@ static SFU_ErrorStatus VerifyFwSignatureAfterDecrypt(SE_StatusTypeDef *pSeStatus
  * @brief  Swap Slot 0 with decrypted FW to install
  *         With the 2 images implementation, installing a new Firmware Image means swapping Slot #0 and Slot #1.
  *         To perform this swap, the image to be installed is split in blocks of the swap region size: SFU_IMG_SLOT_1_REGION_SIZE / SFU_IMG_SWAP_REGION_SIZE blocks to be swapped .
- *         Each of these blocks is swapped using smaller chunks of SFU_IMG_CHUNK_SIZE size.
  *         The swap starts from the tail of the image and ends with the beginning of the image ("swap from tail to head").
+ * @note   A block whose destination already holds the expected content is neither erased nor programmed (unchanged
+ *         code, empty end of slot), and only the chunks differing from an erased block are programmed.
+ *         The FLASH content at each step is the same as with a full copy, so the trailer bookkeeping (CPY fields) and
+ *         the recovery procedure are not affected.
  * @param None.
  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
  */
 static SFU_ErrorStatus SwapFirmwareImages(void)
 {
   SFU_ErrorStatus e_ret_status = SFU_ERROR;
-  SFU_FLASH_StatusTypeDef flash_if_status;
   int32_t index = 0;
-  int32_t chunk;
-  uint8_t  buffer[SFU_IMG_CHUNK_SIZE] __attribute__((aligned(8)));
   /* number_of_index is the number of blocks that are swapped (1 move = swap a block of SFU_IMG_SWAP_REGION_SIZE bytes) */
   uint32_t number_of_index = SFU_IMG_SLOT_1_REGION_SIZE / SFU_IMG_SWAP_REGION_SIZE;
-  /* number_of_chunk is the number of chunks used to swap 1 block (moving a block of SFU_IMG_SWAP_REGION_SIZE bytes split in number_of_chunk chunks of SFU_IMG_CHUNK_SIZE bytes) */
-  uint32_t number_of_chunk = SFU_IMG_SWAP_REGION_SIZE / SFU_IMG_CHUNK_SIZE;
-  uint32_t write_len;
+  uint32_t dest;
+  uint32_t src;
+  uint32_t size;
+#if defined(SFU_VERBOSE_DEBUG_MODE)
+  uint32_t skipped = 0U;
+#endif /* SFU_VERBOSE_DEBUG_MODE */
 
 #if defined(SFU_VERBOSE_DEBUG_MODE)
   TRACE("\r\n\t  Swapping the Firmware Images (%d blocks): ", number_of_index);
@@ -900,40 +1053,35 @@ static SFU_ErrorStatus SwapFirmwareImages(void)
 
     TRACE(".");
 
-    if (index != (number_of_index - 1))
-    {
-      /* Erase the destination address in slot #1 */
-      e_ret_status = EraseSlotIndex(1, index); /* erase the size of "swap area" at @: slot #1 + index*swap_area_size*/
-
-      if (e_ret_status ==  SFU_ERROR)
-      {
-        return SFU_ERROR;
-      }
-    }
-
-    /* Copy the block from slot #0 to slot #1 (using "number_of_chunk - 1" chunks) */
-    for (chunk = (number_of_chunk - 1); chunk >= 0 ; chunk--)
+    /* Copy the block from slot #0 to slot #1, up to the trailer */
+    dest = (uint32_t)CHUNK_1_ADDR(index, 0);
+    src = (uint32_t)CHUNK_0_ADDR(index, 0);
+    size = ((dest + SFU_IMG_SWAP_REGION_SIZE) > (uint32_t)TRAILER_BEGIN) ? ((uint32_t)TRAILER_BEGIN - dest) :
+           SFU_IMG_SWAP_REGION_SIZE;
+    if (CompareFlash(dest, src, size) != SFU_SUCCESS)
     {
-      /* ignore return value,  no double ecc error is expected, area already read before */
-      (void)SFU_LL_FLASH_Read(buffer, CHUNK_0_ADDR(index, chunk), sizeof(buffer));
-      if (((uint32_t)CHUNK_1_ADDR(index, chunk)) < (uint32_t)TRAILER_BEGIN)
+      if (index != (number_of_index - 1))
       {
-        /*  write is possible length can be modified  */
-        write_len = sizeof(buffer);
-        if ((uint32_t)(CHUNK_1_ADDR(index, chunk) + write_len) > (uint32_t)TRAILER_BEGIN)
-        {
-          write_len = TRAILER_BEGIN - CHUNK_1_ADDR(index, chunk);
-        }
+        /* Erase the destination address in slot #1 (the last block hosting the trailer is already erased) */
+        e_ret_status = EraseSlotIndex(1, index); /* erase the size of "swap area" at @: slot #1 + index*swap_area_size*/
 
-        e_ret_status = SFU_LL_FLASH_Write(&flash_if_status, CHUNK_1_ADDR(index, chunk), buffer,
-                                          write_len);
-        StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_WRITE_FAILED);
-        if (e_ret_status == SFU_ERROR)
+        if (e_ret_status ==  SFU_ERROR)
         {
           return SFU_ERROR;
         }
       }
+      e_ret_status = ProgramFlash(dest, src, size);
+      if (e_ret_status == SFU_ERROR)
+      {
+        return SFU_ERROR;
+      }
     }
+#if defined(SFU_VERBOSE_DEBUG_MODE)
+    else
+    {
+      skipped++;
+    }
+#endif /* SFU_VERBOSE_DEBUG_MODE */
 
     /*
      * The block of the active firmware has been backed up.
@@ -947,49 +1095,51 @@ static SFU_ErrorStatus SwapFirmwareImages(void)
       return e_ret_status;
     }
 
-    /* The source address in slot #0 is erased */
-    e_ret_status = EraseSlotIndex(0, index); /* erase the size of "swap area" at @: slot #0 + index*swap_area_size*/
-
-    if (e_ret_status ==  SFU_ERROR)
+    /*
+     * The appropriate block of slot #1 (swap area for the 1st block) is copied at the address in slot #0
+     * (installing the block of the new firmware image).
+     * The header is not copied in slot #0 and the end of the last block is not copied.
+     */
+    dest = (uint32_t)CHUNK_0_ADDR(index, 0);
+    src = (index == 0) ? (uint32_t)CHUNK_SWAP_ADDR(0) : (uint32_t)CHUNK_1_ADDR((index - 1), 0);
+    size = SFU_IMG_SWAP_REGION_SIZE;
+    if (index == (number_of_index - 1))
     {
-      return SFU_ERROR;
+      size -= TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t);
     }
-
-    /* The appropriate block of slot #1 is copied at the address in slot #0 (installing the block of the new firmware image) */
-    for (chunk = (number_of_chunk - 1); chunk >= 0 ; chunk--)
+    if (index == 0)
     {
-      if (index == 0)
-      {
-        /* ignore return value,  no double ecc error is expected, area already read before */
-        (void)SFU_LL_FLASH_Read(buffer, CHUNK_SWAP_ADDR(chunk), sizeof(buffer));
-      }
-      else
-      {
-        /* ignore return value,  no double ecc error is expected, area already read before */
-        (void)SFU_LL_FLASH_Read(buffer, CHUNK_1_ADDR((index - 1), chunk), sizeof(buffer));
-      }
-      if (chunk == (number_of_chunk - 1) && (index == number_of_index - 1))
-      {
-        write_len = SFU_IMG_CHUNK_SIZE - TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t);
-      }
-      else
-      {
-        write_len = SFU_IMG_CHUNK_SIZE;
-      }
-      /*  don't copy header on slot 0, fix me chunk minimum size is SFU_IMG_IMAGE_OFFSET  */
-      if ((index == 0) && (chunk == 0))
+      dest += SFU_IMG_IMAGE_OFFSET;
+      src += SFU_IMG_IMAGE_OFFSET;
+      size -= SFU_IMG_IMAGE_OFFSET;
+    }
+    /* The 1st block is always erased: the header of the active firmware must be removed */
+    if ((index == 0) || (CompareFlash(dest, src, size) != SFU_SUCCESS))
+    {
+      /* The source address in slot #0 is erased */
+      e_ret_status = EraseSlotIndex(0, index); /* erase the size of "swap area" at @: slot #0 + index*swap_area_size*/
+
+      if (e_ret_status ==  SFU_ERROR)
       {
-        write_len = write_len - SFU_IMG_IMAGE_OFFSET;
+        return SFU_ERROR;
       }
-      e_ret_status = SFU_LL_FLASH_Write(&flash_if_status, CHUNK_0_ADDR_MODIFIED(index, chunk), buffer,
-                                        write_len);
-      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_WRITE_FAILED);
+      e_ret_status = ProgramFlash(dest, src, size);
       if (e_ret_status == SFU_ERROR)
       {
         return SFU_ERROR;
       }
     }
+#if defined(SFU_VERBOSE_DEBUG_MODE)
+    else
+    {
+      skipped++;
+    }
+#endif /* SFU_VERBOSE_DEBUG_MODE */
   }
+
+#if defined(SFU_VERBOSE_DEBUG_MODE)
+  TRACE("\r\n\t  %d/%d block copies skipped (already in place).", skipped, 2U * number_of_index);
+#endif /* SFU_VERBOSE_DEBUG_MODE */
   return e_ret_status;
 }
 
@@ -1175,101 +1325,771 @@ static SFU_ErrorStatus DecryptImageInSlot1(SE_FwRawHeaderTypeDef *pFwImageHeader
   return e_ret_status;
 }
 
-
+#if defined(SFU_FWIMG_STAGED_UPDATE)
 /**
-  * @}
+  * @brief  Get the staging area of a delta or compressed image.
+  * @note   Before being decoded, the payload is copied (with the header) at the top of slot #1, just below the block
+  *         hosting the trailer, so that the beginning of slot #1 can receive the candidate FW.
+  *         The header is copied last: when it matches the swap header the staged payload is complete.
+  * @param  PatchSize size of the encrypted payload
+  * @retval Address of the staging area, 0 if the payload does not fit in slot #1.
   */
+static uint32_t DeltaStageBegin(uint32_t PatchSize)
+{
+  uint32_t nb_slot_block = SFU_IMG_SLOT_1_REGION_SIZE / SFU_IMG_SWAP_REGION_SIZE;
+  uint32_t nb_stage_block;
 
-/** @defgroup SFU_IMG_CORE_Exported_Functions Exported Functions
-  * @brief Functions used by fwimg_services
-  * @note All these functions are also listed in the Common services (High Level and Low Level Services).
-  * @{
-  */
+  if (PatchSize > SFU_IMG_SLOT_1_REGION_SIZE)
+  {
+    return 0U;
+  }
+  nb_stage_block = (SFU_IMG_IMAGE_OFFSET + PatchSize + SFU_IMG_SWAP_REGION_SIZE - 1U) / SFU_IMG_SWAP_REGION_SIZE;
+  if (nb_stage_block >= nb_slot_block)
+  {
+    return 0U;
+  }
+  return ((uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN + (nb_slot_block - 1U - nb_stage_block) * SFU_IMG_SWAP_REGION_SIZE);
+}
 
 /**
-  * @brief  Initialize the SFU APP.
-  * @param  None
-  * @note   Not used in Alpha version -
+  * @brief  Copy the downloaded image (header + encrypted payload) from slot #1 to its staging area.
+  * @param  StageAddress staging area address
+  * @param  PatchSize size of the encrypted payload
   * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
   */
-SFU_IMG_InitStatusTypeDef SFU_IMG_CoreInit(void)
+static SFU_ErrorStatus DeltaStagePatch(uint32_t StageAddress, uint32_t PatchSize)
 {
-  SFU_IMG_InitStatusTypeDef e_ret_status = SFU_IMG_INIT_OK;
+  SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  SFU_FLASH_StatusTypeDef flash_if_status;
+  uint8_t buffer[DELTA_CHUNK_SIZE] __attribute__((aligned(8)));
+  uint32_t src[2] = {(uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN + SFU_IMG_IMAGE_OFFSET, (uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN};
+  uint32_t dest[2] = {StageAddress + SFU_IMG_IMAGE_OFFSET, StageAddress};
+  uint32_t size[2] = {PatchSize, SFU_IMG_IMAGE_OFFSET};
+  uint32_t erase_address;
+  uint32_t i;
+  uint32_t len;
 
-  /*
-   * When there is no valid FW in slot 0, the fw_header_validated array is filled with 0s.
-   * When installing a first FW (after local download) this means that WRITE_TRAILER_MAGIC will write a SWAP magic starting with 0s.
-   * This causes an issue when calling CLEAN_TRAILER_MAGIC (because of this we added an erase that generated side-effects).
-   * To avoid all these problems we can initialize fw_header_validated with a non-0  value.
-   */
-  memset(fw_header_validated, 0xFE, sizeof(fw_header_validated));
+  for (erase_address = StageAddress; (e_ret_status == SFU_SUCCESS) && (erase_address < (StageAddress + SFU_IMG_IMAGE_OFFSET + PatchSize));
+       erase_address += SFU_IMG_SWAP_REGION_SIZE)
+  {
+    SFU_LL_SECU_IWDG_Refresh();
+    e_ret_status = SFU_LL_FLASH_Erase_Size(&flash_if_status, (void *)erase_address, SFU_IMG_SWAP_REGION_SIZE - 1U);
+    StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_ERASE_FAILED);
+  }
 
-  /*
-   * Sanity check: let's make sure the slot sizes are correct
-   * to avoid discrepancies between linker definitions and constants in sfu_fwimg_regions.h
-   */
-  if (!(SFU_IMG_REGION_IS_SAME_SIZE(SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SLOT_1_REGION_SIZE)))
+  /* The payload first, then the header which marks the staging as complete */
+  for (i = 0U; i < 2U; i++)
   {
-    TRACE("\r\n= [FWIMG] SLOT size issue SLOT0 %d != SLOT1 %d\r\n", SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SLOT_1_REGION_SIZE);
-    e_ret_status = SFU_IMG_INIT_SLOTS_SIZE_ERROR;
+    while ((e_ret_status == SFU_SUCCESS) && (size[i] > 0U))
+    {
+      len = (size[i] < sizeof(buffer)) ? size[i] : sizeof(buffer);
+      SFU_LL_SECU_IWDG_Refresh();
+      e_ret_status = SFU_LL_FLASH_Read(buffer, (void *)src[i], len);
+      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_READ_FAILED);
+      if (e_ret_status == SFU_SUCCESS)
+      {
+        e_ret_status = SFU_LL_FLASH_Write(&flash_if_status, (void *)dest[i], buffer, len);
+        StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_WRITE_FAILED);
+      }
+      src[i] += len;
+      dest[i] += len;
+      size[i] -= len;
+    }
   }
-  else if (!(SFU_IMG_REGION_IS_MULTIPLE(SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SWAP_REGION_SIZE)))
+  return e_ret_status;
+}
+
+/**
+  * @brief  Check that the trailer holds the headers of an installation which has not started yet (no swap magic).
+  * @note   The trailer is written before the decoding erases the swap area, so that the candidate header survives
+  *         until the swap magic is written.
+  * @param  pTestHeader header of the FW to install
+  * @param  pValidHeader header of the active FW, NULL if not checked
+  * @retval SFU_SUCCESS if the trailer matches, SFU_ERROR otherwise.
+  */
+static SFU_ErrorStatus DeltaCheckTrailer(uint8_t *pTestHeader, uint8_t *pValidHeader)
+{
+  SFU_ErrorStatus e_ret_status;
+  uint8_t buffer[FW_INFO_TOT_LEN];
+  uint32_t i;
+
+  e_ret_status = SFU_LL_FLASH_Read(buffer, TRAILER_SWAP_ADDR, MAGIC_LENGTH);
+  for (i = 0U; (e_ret_status == SFU_SUCCESS) && (i < MAGIC_LENGTH); i++)
   {
-    TRACE("\r\n= [FWIMG] The image slot size (%d) must be a multiple of the swap region size (%d)\r\n", SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SWAP_REGION_SIZE);
-    e_ret_status = SFU_IMG_INIT_SLOTS_SIZE_ERROR;
+    if (buffer[i] != 0xFFU)
+    {
+      /* Swap in progress, or installation completed / cancelled (magic cleaned) */
+      e_ret_status = SFU_ERROR;
+    }
   }
-  else
+  if (e_ret_status == SFU_SUCCESS)
   {
-    e_ret_status = SFU_IMG_INIT_OK;
-    TRACE("\r\n= [FWIMG] Slot #0 @: %x / Slot #1 @: %x / Swap @: %x", SFU_IMG_SLOT_0_REGION_BEGIN_VALUE, SFU_IMG_SLOT_1_REGION_BEGIN_VALUE, SFU_IMG_SWAP_REGION_BEGIN_VALUE);
+    e_ret_status = SFU_LL_FLASH_Read(buffer, TRAILER_HDR_TEST, sizeof(buffer));
+    if ((e_ret_status == SFU_SUCCESS) && (memcmp(buffer, pTestHeader, sizeof(buffer)) != 0))
+    {
+      e_ret_status = SFU_ERROR;
+    }
   }
-
-  /*
-   * Sanity check: let's make sure the swap region size and the slot size is correct with regards to the swap procedure constraints.
-   * The swap procedure cannot succeed if the trailer info size is bigger than what a chunk used for swapping can carry.
-   */
-  if (((int32_t)(SFU_IMG_CHUNK_SIZE - (TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t)))) < 0)
+  if ((e_ret_status == SFU_SUCCESS) && (pValidHeader != NULL))
   {
-    e_ret_status = SFU_IMG_INIT_SWAP_SETTINGS_ERROR;
-    TRACE("\r\n= [FWIMG] %d bytes required for the swap metadata is too much, please tune your settings", (TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t)));
-  } /* else the swap settings are fine from a metadata size perspective */
+    e_ret_status = SFU_LL_FLASH_Read(buffer, TRAILER_HDR_VALID, sizeof(buffer));
+    if ((e_ret_status == SFU_SUCCESS) && (memcmp(buffer, pValidHeader, sizeof(buffer)) != 0))
+    {
+      e_ret_status = SFU_ERROR;
+    }
+  }
+  return e_ret_status;
+}
 
-  /*
-   * Sanity check: let's make sure the swap region size and the slot size is correct with regards to the swap procedure constraints.
-   * The swap region size must be a multiple of the chunks size used to do the swap.
-   */
-#if defined(__GNUC__)
-  __IO uint32_t swap_size = SFU_IMG_SWAP_REGION_SIZE, swap_chunk = SFU_IMG_CHUNK_SIZE;
-  if (0 != ((uint32_t)(swap_size % swap_chunk)))
-#else
-  if (0 != ((uint32_t)(SFU_IMG_SWAP_REGION_SIZE % SFU_IMG_CHUNK_SIZE)))
-#endif /* __GNUC__ */
-  {
-    e_ret_status = SFU_IMG_INIT_SWAP_SETTINGS_ERROR;
-    TRACE("\r\n= [FWIMG] The swap procedure uses chunks of %d bytes but the swap region size (%d) is not a multiple of this: please tune your settings", SFU_IMG_CHUNK_SIZE, SFU_IMG_SWAP_REGION_SIZE);
-  } /* else the swap settings are fine from a chunk size perspective */
+/**
+  * @brief  Write the pending output chunk of a decoding pass in FLASH.
+  * @param  pCtx pass context
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus DeltaFlush(DeltaCtxTypeDef *pCtx)
+{
+  SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  SFU_FLASH_StatusTypeDef flash_if_status;
+  uint32_t size = pCtx->OutLen;
 
-  /*
-   * Sanity check: let's make sure the chunks used for the swap procedure are big enough with regards to the offset giving the start @ of the firmware
-   */
-  if (((int32_t)(SFU_IMG_CHUNK_SIZE - SFU_IMG_IMAGE_OFFSET)) < 0)
-  {
-    e_ret_status = SFU_IMG_INIT_SWAP_SETTINGS_ERROR;
-    TRACE("\r\n= [FWIMG] The swap procedure uses chunks of %d bytes but the firmware start offset is %d bytes: please tune your settings", SFU_IMG_CHUNK_SIZE, SFU_IMG_IMAGE_OFFSET);
-  } /* else the swap settings are fine from a firmware start offset perspective */
-  /*
-   * Sanity check: let's make sure all slots are properly aligned with regards to flash constraints
-   */
-  if (!IS_ALIGNED(SFU_IMG_SLOT_0_REGION_BEGIN_VALUE))
+  /* Out is filled with 0xFF beyond OutLen: the size can be adjusted to the FLASH programming granularity */
+  if ((size & ((uint32_t)sizeof(SFU_LL_FLASH_write_t) - 1U)) != 0U)
   {
-    e_ret_status = SFU_IMG_INIT_FLASH_CONSTRAINTS_ERROR;
-    TRACE("\r\n= [FWIMG] slot 0 (%x) is not properly aligned: please tune your settings", SFU_IMG_SLOT_0_REGION_BEGIN_VALUE);
-  } /* else slot 0 is properly aligned */
+    size = size + ((uint32_t)sizeof(SFU_LL_FLASH_write_t) - (size % (uint32_t)sizeof(SFU_LL_FLASH_write_t)));
+  }
 
-  if (!IS_ALIGNED(SFU_IMG_SLOT_1_REGION_BEGIN_VALUE))
+  if (pCtx->DestAddress >= pCtx->EraseAddress)
   {
-    e_ret_status = SFU_IMG_INIT_FLASH_CONSTRAINTS_ERROR;
-    TRACE("\r\n= [FWIMG] slot 1 (%x) is not properly aligned: please tune your settings", SFU_IMG_SLOT_1_REGION_BEGIN_VALUE);
+    SFU_LL_SECU_IWDG_Refresh();
+    e_ret_status = SFU_LL_FLASH_Erase_Size(&flash_if_status, (void *)pCtx->EraseAddress, SFU_IMG_SWAP_REGION_SIZE - 1U);
+    StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_ERASE_FAILED);
+    pCtx->EraseAddress += SFU_IMG_SWAP_REGION_SIZE;
+  }
+  if (e_ret_status == SFU_SUCCESS)
+  {
+    e_ret_status = SFU_LL_FLASH_Write(&flash_if_status, (void *)pCtx->DestAddress, pCtx->Out, size);
+    StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_WRITE_FAILED);
+  }
+  pCtx->DestAddress += size;
+  pCtx->OutLen = 0U;
+  memset(pCtx->Out, 0xff, sizeof(pCtx->Out));
+  return e_ret_status;
+}
+
+/**
+  * @brief  Output candidate FW bytes: only the bytes inside the window of the pass are written in FLASH.
+  * @param  pCtx pass context
+  * @param  pSrc source of the bytes (RAM for an INSERT operation or the decompressor, active FW in slot #0 for a COPY
+  *         operation)
+  * @param  Len number of bytes
+  * @param  FromFlash 1 if pSrc is a FLASH address, 0 otherwise
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus DeltaEmit(DeltaCtxTypeDef *pCtx, const uint8_t *pSrc, uint32_t Len, uint32_t FromFlash)
+{
+  SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  uint32_t len;
+
+  if (Len > (pCtx->TargetSize - pCtx->TargetOffset))
+  {
+    /* The payload produces more bytes than announced in the FW header */
+    return SFU_ERROR;
+  }
+
+  while ((e_ret_status == SFU_SUCCESS) && (Len > 0U))
+  {
+    if (pCtx->TargetOffset < pCtx->WindowBegin)
+    {
+      /* Not written by this pass */
+      len = ((pCtx->WindowBegin - pCtx->TargetOffset) < Len) ? (pCtx->WindowBegin - pCtx->TargetOffset) : Len;
+    }
+    else if (pCtx->TargetOffset >= pCtx->WindowEnd)
+    {
+      /* Not written by this pass */
+      len = Len;
+    }
+    else
+    {
+      len = ((pCtx->WindowEnd - pCtx->TargetOffset) < Len) ? (pCtx->WindowEnd - pCtx->TargetOffset) : Len;
+      len = ((sizeof(pCtx->Out) - pCtx->OutLen) < len) ? (sizeof(pCtx->Out) - pCtx->OutLen) : len;
+      if (FromFlash != 0U)
+      {
+        e_ret_status = SFU_LL_FLASH_Read(&pCtx->Out[pCtx->OutLen], pSrc, len);
+        StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_READ_FAILED);
+      }
+      else
+      {
+        memcpy(&pCtx->Out[pCtx->OutLen], pSrc, len);
+      }
+      pCtx->OutLen += len;
+      if ((e_ret_status == SFU_SUCCESS) && (pCtx->OutLen == sizeof(pCtx->Out)))
+      {
+        e_ret_status = DeltaFlush(pCtx);
+      }
+    }
+    pCtx->TargetOffset += len;
+    pSrc += len;
+    Len -= len;
+  }
+  return e_ret_status;
+}
+
+#if defined(SFU_FWIMG_COMPRESSED_UPDATE)
+/**
+  * @brief  Output candidate FW bytes produced by the decompressor, keeping them in the history.
+  * @param  pCtx pass context
+  * @param  pSrc literal bytes, NULL for a match
+  * @param  Len number of bytes
+  * @param  Offset distance between the match source and the current output (ignored for literals)
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus LzOutput(DeltaCtxTypeDef *pCtx, const uint8_t *pSrc, uint32_t Len, uint32_t Offset)
+{
+  SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  uint32_t pos;
+  uint32_t len;
+  uint32_t i;
+
+  while ((e_ret_status == SFU_SUCCESS) && (Len > 0U))
+  {
+    /* Fill the history up to its end at most: the new bytes are contiguous in RAM and emitted from there */
+    pos = pCtx->TargetOffset & (LZ_WINDOW_SIZE - 1U);
+    len = ((LZ_WINDOW_SIZE - pos) < Len) ? (LZ_WINDOW_SIZE - pos) : Len;
+    if (pSrc != NULL)
+    {
+      memcpy(&lz_history[pos], pSrc, len);
+      pSrc += len;
+    }
+    else
+    {
+      /* Byte per byte: the source can overlap the bytes being produced */
+      for (i = pos; i < (pos + len); i++)
+      {
+        lz_history[i] = lz_history[(i - Offset) & (LZ_WINDOW_SIZE - 1U)];
+      }
+    }
+    e_ret_status = DeltaEmit(pCtx, &lz_history[pos], len, 0U);
+    Len -= len;
+  }
+  return e_ret_status;
+}
+
+/**
+  * @brief  Output the current match, then wait for the next sequence.
+  * @param  pCtx pass context
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus LzMatch(DeltaCtxTypeDef *pCtx)
+{
+  SFU_ErrorStatus e_ret_status;
+
+  e_ret_status = LzOutput(pCtx, NULL, pCtx->OpLen, pCtx->LzOffset);
+  pCtx->State = (pCtx->TargetOffset == pCtx->TargetSize) ? DELTA_STATE_END : DELTA_STATE_LZ_TOKEN;
+  return e_ret_status;
+}
+
+/**
+  * @brief  Literals of the current sequence done: the stream ends with the candidate FW, otherwise a match follows.
+  * @param  pCtx pass context
+  * @retval None
+  */
+static void LzLiteralsDone(DeltaCtxTypeDef *pCtx)
+{
+  pCtx->FieldLen = 0U;
+  pCtx->FieldExpected = 2U;
+  pCtx->State = (pCtx->TargetOffset == pCtx->TargetSize) ? DELTA_STATE_END : DELTA_STATE_LZ_OFFSET;
+}
+#endif /* SFU_FWIMG_COMPRESSED_UPDATE */
+
+/**
+  * @brief  Process a complete payload header, a complete set of operation arguments or a complete match offset.
+  * @param  pCtx pass context
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus DeltaProcessField(DeltaCtxTypeDef *pCtx)
+{
+  SFU_ErrorStatus e_ret_status = SFU_ERROR;
+#if defined(SFU_FWIMG_DELTA_UPDATE)
+  uint32_t offset;
+  uint32_t len;
+#endif /* SFU_FWIMG_DELTA_UPDATE */
+
+  if (pCtx->State == DELTA_STATE_HEADER)
+  {
+#if defined(SFU_FWIMG_DELTA_UPDATE)
+    /* A patch must have been built against the active FW */
+    if ((DELTA_GET_U32(&pCtx->Field[0]) == DELTA_MAGIC)
+        && (DELTA_GET_U32(&pCtx->Field[DELTA_HDR_BASE_SIZE]) == fw_image_header_validated.FwSize)
+        && (DELTA_GET_U32(&pCtx->Field[DELTA_HDR_TARGET_SIZE]) == pCtx->TargetSize)
+        && (memcmp(&pCtx->Field[DELTA_HDR_BASE_TAG], fw_image_header_validated.FwTag, SE_TAG_LEN) == 0))
+    {
+      pCtx->State = DELTA_STATE_OPCODE;
+      e_ret_status = SFU_SUCCESS;
+    }
+#endif /* SFU_FWIMG_DELTA_UPDATE */
+#if defined(SFU_FWIMG_COMPRESSED_UPDATE)
+    /* The window of a compressed FW must fit in the decompressor history */
+    if ((DELTA_GET_U32(&pCtx->Field[0]) == COMPRESS_MAGIC)
+        && (DELTA_GET_U32(&pCtx->Field[DELTA_HDR_TARGET_SIZE]) == pCtx->TargetSize)
+        && (DELTA_GET_U32(&pCtx->Field[DELTA_HDR_WINDOW]) != 0U)
+        && (DELTA_GET_U32(&pCtx->Field[DELTA_HDR_WINDOW]) <= LZ_WINDOW_SIZE))
+    {
+      pCtx->LzWindow = DELTA_GET_U32(&pCtx->Field[DELTA_HDR_WINDOW]);
+      pCtx->State = DELTA_STATE_LZ_TOKEN;
+      e_ret_status = SFU_SUCCESS;
+    }
+#endif /* SFU_FWIMG_COMPRESSED_UPDATE */
+#if defined(SFU_VERBOSE_DEBUG_MODE)
+    if (e_ret_status != SFU_SUCCESS)
+    {
+      TRACE("\r\n\t  The payload does not match the FW header or the active firmware.");
+    }
+#endif /* SFU_VERBOSE_DEBUG_MODE */
+  }
+#if defined(SFU_FWIMG_COMPRESSED_UPDATE)
+  else if (pCtx->State == DELTA_STATE_LZ_OFFSET)
+  {
+    /* A match cannot reach further than the window nor before the beginning of the candidate FW */
+    pCtx->LzOffset = (uint32_t)pCtx->Field[0] | ((uint32_t)pCtx->Field[1] << 8U);
+    if ((pCtx->LzOffset != 0U) && (pCtx->LzOffset <= pCtx->LzWindow) && (pCtx->LzOffset <= pCtx->TargetOffset))
+    {
+      pCtx->OpLen = ((uint32_t)pCtx->OpCode & LZ_LEN_MASK) + LZ_MIN_MATCH;
+      if (((uint32_t)pCtx->OpCode & LZ_LEN_MASK) == LZ_LEN_MASK)
+      {
+        pCtx->State = DELTA_STATE_LZ_MATCHLEN;
+        e_ret_status = SFU_SUCCESS;
+      }
+      else
+      {
+        e_ret_status = LzMatch(pCtx);
+      }
+    }
+  }
+#endif /* SFU_FWIMG_COMPRESSED_UPDATE */
+#if defined(SFU_FWIMG_DELTA_UPDATE)
+  else if (pCtx->OpCode == DELTA_OP_COPY)
+  {
+    offset = DELTA_GET_U32(&pCtx->Field[0]);
+    len = DELTA_GET_U32(&pCtx->Field[4]);
+    if ((len <= fw_image_header_validated.FwSize) && (offset <= (fw_image_header_validated.FwSize - len)))
+    {
+      e_ret_status = DeltaEmit(pCtx, (uint8_t *)((uint32_t)SFU_IMG_SLOT_0_REGION_BEGIN + SFU_IMG_IMAGE_OFFSET + offset),
+                               len, 1U);
+      pCtx->State = DELTA_STATE_OPCODE;
+    }
+  }
+  else
+  {
+    /* DELTA_OP_INSERT */
+    pCtx->OpLen = DELTA_GET_U32(&pCtx->Field[0]);
+    pCtx->State = (pCtx->OpLen != 0U) ? DELTA_STATE_LITERAL : DELTA_STATE_OPCODE;
+    e_ret_status = SFU_SUCCESS;
+  }
+#endif /* SFU_FWIMG_DELTA_UPDATE */
+  return e_ret_status;
+}
+
+/**
+  * @brief  Parse a chunk of clear payload.
+  * @note   Headers, operations, sequences and literals can be split across chunks.
+  * @param  pCtx pass context
+  * @param  pData clear payload bytes
+  * @param  Len number of bytes
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus DeltaParse(DeltaCtxTypeDef *pCtx, const uint8_t *pData, uint32_t Len)
+{
+  SFU_ErrorStatus e_ret_status = SFU_SUCCESS;
+  uint32_t len;
+
+  while ((e_ret_status == SFU_SUCCESS) && (Len > 0U) && (pCtx->State != DELTA_STATE_END))
+  {
+    len = 1U;
+    switch (pCtx->State)
+    {
+      case DELTA_STATE_HEADER:
+      case DELTA_STATE_ARGS:
+      case DELTA_STATE_LZ_OFFSET:
+        len = ((pCtx->FieldExpected - pCtx->FieldLen) < Len) ? (pCtx->FieldExpected - pCtx->FieldLen) : Len;
+        memcpy(&pCtx->Field[pCtx->FieldLen], pData, len);
+        pCtx->FieldLen += len;
+        if (pCtx->FieldLen == pCtx->FieldExpected)
+        {
+          e_ret_status = DeltaProcessField(pCtx);
+        }
+        break;
+#if defined(SFU_FWIMG_DELTA_UPDATE)
+      case DELTA_STATE_OPCODE:
+        pCtx->OpCode = *pData;
+        pCtx->FieldLen = 0U;
+        if (pCtx->OpCode == DELTA_OP_COPY)
+        {
+          pCtx->FieldExpected = 8U;
+          pCtx->State = DELTA_STATE_ARGS;
+        }
+        else if (pCtx->OpCode == DELTA_OP_INSERT)
+        {
+          pCtx->FieldExpected = 4U;
+          pCtx->State = DELTA_STATE_ARGS;
+        }
+        else if ((pCtx->OpCode == DELTA_OP_END) && (pCtx->TargetOffset == pCtx->TargetSize))
+        {
+          pCtx->State = DELTA_STATE_END;
+        }
+        else
+        {
+          /* Unknown operation or candidate FW incomplete */
+          e_ret_status = SFU_ERROR;
+        }
+        break;
+      case DELTA_STATE_LITERAL:
+        len = (pCtx->OpLen < Len) ? pCtx->OpLen : Len;
+        e_ret_status = DeltaEmit(pCtx, pData, len, 0U);
+        pCtx->OpLen -= len;
+        if (pCtx->OpLen == 0U)
+        {
+          pCtx->State = DELTA_STATE_OPCODE;
+        }
+        break;
+#endif /* SFU_FWIMG_DELTA_UPDATE */
+#if defined(SFU_FWIMG_COMPRESSED_UPDATE)
+      case DELTA_STATE_LZ_TOKEN:
+        pCtx->OpCode = *pData;
+        pCtx->OpLen = (uint32_t)(*pData) >> 4U;
+        if (pCtx->OpLen == LZ_LEN_MASK)
+        {
+          pCtx->State = DELTA_STATE_LZ_LITLEN;
+        }
+        else if (pCtx->OpLen != 0U)
+        {
+          pCtx->State = DELTA_STATE_LZ_LITERAL;
+        }
+        else
+        {
+          LzLiteralsDone(pCtx);
+        }
+        break;
+      case DELTA_STATE_LZ_LITLEN:
+        pCtx->OpLen += *pData;
+        if (*pData != 0xFFU)
+        {
+          pCtx->State = DELTA_STATE_LZ_LITERAL;
+        }
+        break;
+      case DELTA_STATE_LZ_LITERAL:
+        len = (pCtx->OpLen < Len) ? pCtx->OpLen : Len;
+        e_ret_status = LzOutput(pCtx, pData, len, 0U);
+        pCtx->OpLen -= len;
+        if (pCtx->OpLen == 0U)
+        {
+          LzLiteralsDone(pCtx);
+        }
+        break;
+      case DELTA_STATE_LZ_MATCHLEN:
+        pCtx->OpLen += *pData;
+        if (*pData != 0xFFU)
+        {
+          e_ret_status = LzMatch(pCtx);
+        }
+        break;
+#endif /* SFU_FWIMG_COMPRESSED_UPDATE */
+      default:
+        e_ret_status = SFU_ERROR;
+        break;
+    }
+    pData += len;
+    Len -= len;
+  }
+  return e_ret_status;
+}
+
+/**
+  * @brief  Decrypt the staged payload and decode it, writing only the candidate FW bytes of the pass window.
+  * @param  pFwImageHeader FW header of the delta or compressed image
+  * @param  StageAddress staging area address
+  * @param  pCtx pass context (window and destination already set)
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus DeltaApplyPass(SE_FwRawHeaderTypeDef *pFwImageHeader, uint32_t StageAddress,
+                                      DeltaCtxTypeDef *pCtx)
+{
+  SFU_ErrorStatus e_ret_status = SFU_ERROR;
+  SE_StatusTypeDef e_se_status;
+  SE_ErrorStatus se_ret_status;
+  uint8_t patch_encrypted_chunk[DELTA_CHUNK_SIZE] __attribute__((aligned(8)));
+  uint8_t patch_decrypted_chunk[DELTA_CHUNK_SIZE] __attribute__((aligned(8)));
+  uint8_t *ppatch_address = (uint8_t *)(StageAddress + SFU_IMG_IMAGE_OFFSET);
+  uint32_t remaining = pFwImageHeader->PatchSize;
+  int32_t size;
+  int32_t decrypted_size;
+  int32_t fw_tag_len;
+  uint8_t fw_tag_output[SE_TAG_LEN];
+
+  pCtx->State = DELTA_STATE_HEADER;
+  pCtx->FieldLen = 0U;
+  pCtx->FieldExpected = DELTA_HEADER_LEN;
+  pCtx->TargetOffset = 0U;
+  pCtx->TargetSize = pFwImageHeader->FwSize;
+  pCtx->OutLen = 0U;
+  memset(pCtx->Out, 0xff, sizeof(pCtx->Out));
+
+  se_ret_status = SE_Decrypt_Init(&e_se_status, pFwImageHeader);
+  if ((se_ret_status == SE_SUCCESS) && (e_se_status == SE_OK))
+  {
+    e_ret_status = SFU_SUCCESS;
+    while ((e_ret_status == SFU_SUCCESS) && (remaining > 0U))
+    {
+      size = (int32_t)((remaining < DELTA_CHUNK_SIZE) ? remaining : DELTA_CHUNK_SIZE);
+      SFU_LL_SECU_IWDG_Refresh();
+      e_ret_status = SFU_LL_FLASH_Read(patch_encrypted_chunk, ppatch_address, (uint32_t)size);
+      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_READ_FAILED);
+      if (e_ret_status == SFU_SUCCESS)
+      {
+        decrypted_size = size;
+        se_ret_status = SE_Decrypt_Append(&e_se_status, patch_encrypted_chunk, size, patch_decrypted_chunk,
+                                          &decrypted_size);
+        if ((se_ret_status != SE_SUCCESS) || (e_se_status != SE_OK) || (decrypted_size != size))
+        {
+          e_ret_status = SFU_ERROR;
+        }
+      }
+      if (e_ret_status == SFU_SUCCESS)
+      {
+        e_ret_status = DeltaParse(pCtx, patch_decrypted_chunk, (uint32_t)size);
+      }
+      ppatch_address += size;
+      remaining -= (uint32_t)size;
+    }
+
+    if ((e_ret_status == SFU_SUCCESS) && (pCtx->OutLen != 0U))
+    {
+      e_ret_status = DeltaFlush(pCtx);
+    }
+    if ((e_ret_status == SFU_SUCCESS) && (pCtx->State != DELTA_STATE_END))
+    {
+      /* Truncated payload */
+      e_ret_status = SFU_ERROR;
+    }
+
+    fw_tag_len = sizeof(fw_tag_output);
+    se_ret_status = SE_Decrypt_Finish(&e_se_status, fw_tag_output, &fw_tag_len);
+    if ((se_ret_status != SE_SUCCESS) || (e_se_status != SE_OK))
+    {
+      e_ret_status = SFU_ERROR;
+    }
+  }
+  return e_ret_status;
+}
+
+/**
+  * @brief Decode the delta or compressed image of slot #1: apply the patch to the active FW or decompress the FW.
+  * @note  The resulting FLASH layout is the one produced by @ref DecryptImageInSlot1, so the signature check and the swap
+  *        procedure are the same as for a full image: the FW tag is verified on the decoded FW.
+  *        The inputs (active FW in slot #0 and staged payload) are not modified, so an interrupted decoding restarts
+  *        from the beginning at next reset:
+  *          - slot #1 pages are written first, the header in the swap area is still there to trigger the installation.
+  *          - the trailer headers are written, the candidate header in the trailer triggers the installation once the
+  *            swap area is erased (see @ref DeltaStageResume). SFU_IMG_InstallNewVersion only adds the swap magic.
+  *          - the swap area is written last, with the beginning of the candidate FW.
+  * @param  pFwImageHeader FW header of the delta or compressed image
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+static SFU_ErrorStatus ApplyPatchInSlot1(SE_FwRawHeaderTypeDef *pFwImageHeader)
+{
+  SFU_ErrorStatus e_ret_status = SFU_ERROR;
+  DeltaCtxTypeDef ctx;
+  uint8_t fw_header_stage[FW_INFO_TOT_LEN] __attribute__((aligned(8)));
+  uint32_t stage_address = DeltaStageBegin(pFwImageHeader->PatchSize);
+
+  if ((stage_address == 0U) || ((pFwImageHeader->PatchSize % AES_BLOCK_SIZE) != 0U))
+  {
+    return e_ret_status;
+  }
+
+  /* Stage the payload unless a previous decoding has already done it */
+  e_ret_status = SFU_LL_FLASH_Read(fw_header_stage, (uint8_t *)stage_address, sizeof(fw_header_stage));
+  if ((e_ret_status != SFU_SUCCESS) || (memcmp(fw_header_stage, fw_header_to_test, sizeof(fw_header_stage)) != 0))
+  {
+    e_ret_status = DeltaStagePatch(stage_address, pFwImageHeader->PatchSize);
+  }
+
+  /* Candidate FW from offset (SWAP_SIZE - IMAGE_OFFSET) to the end: slot #1 from its beginning */
+  if (e_ret_status == SFU_SUCCESS)
+  {
+    ctx.WindowBegin = SFU_IMG_SWAP_REGION_SIZE - SFU_IMG_IMAGE_OFFSET;
+    ctx.WindowEnd = pFwImageHeader->FwSize;
+    ctx.DestAddress = (uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN;
+    ctx.EraseAddress = ctx.DestAddress;
+    e_ret_status = DeltaApplyPass(pFwImageHeader, stage_address, &ctx);
+  }
+
+  /* Keep the candidate header in the trailer before erasing the swap area, unless a previous decoding has done it */
+  if ((e_ret_status == SFU_SUCCESS) && (DeltaCheckTrailer(fw_header_to_test, fw_header_validated) != SFU_SUCCESS))
+  {
+    e_ret_status = EraseSlotIndex(1U, (TRAILER_INDEX - 1U));
+    if (e_ret_status == SFU_SUCCESS)
+    {
+      e_ret_status = WriteTrailerHeader(fw_header_to_test, fw_header_validated);
+      StatusFWIMG(e_ret_status == SFU_ERROR, SFU_IMG_FLASH_WRITE_FAILED);
+    }
+  }
+
+  /* Beginning of the candidate FW: swap area after the header shift */
+  if (e_ret_status == SFU_SUCCESS)
+  {
+    ctx.WindowBegin = 0U;
+    ctx.WindowEnd = SFU_IMG_SWAP_REGION_SIZE - SFU_IMG_IMAGE_OFFSET;
+    ctx.DestAddress = (uint32_t)SFU_IMG_SWAP_REGION_BEGIN + SFU_IMG_IMAGE_OFFSET;
+    ctx.EraseAddress = (uint32_t)SFU_IMG_SWAP_REGION_BEGIN;
+    e_ret_status = DeltaApplyPass(pFwImageHeader, stage_address, &ctx);
+  }
+
+#if defined(SFU_VERBOSE_DEBUG_MODE)
+  TRACE("\r\n\t  %d bytes of payload decoded.", (e_ret_status == SFU_SUCCESS) ? pFwImageHeader->PatchSize : 0U);
+#endif /* SFU_VERBOSE_DEBUG_MODE */
+  return e_ret_status;
+}
+
+/**
+  * @brief  Check if the decoding of a delta or compressed image has been interrupted after erasing the swap area.
+  * @note   The candidate header is then found in the trailer (without swap magic) and in the staging area.
+  *         Populates fw_header_to_test and fw_image_header_to_test.
+  * @retval SFU_SUCCESS if the decoding must be resumed, SFU_ERROR otherwise.
+  */
+static SFU_ErrorStatus DeltaStageResume(void)
+{
+  SFU_ErrorStatus e_ret_status;
+  uint8_t fw_header_stage[FW_INFO_TOT_LEN] __attribute__((aligned(8)));
+  uint32_t stage_address = 0U;
+
+  e_ret_status = SFU_LL_FLASH_Read(fw_header_to_test, TRAILER_HDR_TEST, sizeof(fw_header_to_test));
+  if (e_ret_status == SFU_SUCCESS)
+  {
+    e_ret_status = DeltaCheckTrailer(fw_header_to_test, NULL);
+  }
+  if (e_ret_status == SFU_SUCCESS)
+  {
+    e_ret_status = VerifyFwRawHeaderTag(fw_header_to_test);
+  }
+  if (e_ret_status == SFU_SUCCESS)
+  {
+    e_ret_status = ParseFWInfo(&fw_image_header_to_test, fw_header_to_test);
+  }
+  if ((e_ret_status == SFU_SUCCESS) && (fw_image_header_to_test.PatchSize != 0U))
+  {
+    stage_address = DeltaStageBegin(fw_image_header_to_test.PatchSize);
+  }
+  if ((e_ret_status == SFU_SUCCESS) && (stage_address != 0U))
+  {
+    e_ret_status = SFU_LL_FLASH_Read(fw_header_stage, (uint8_t *)stage_address, sizeof(fw_header_stage));
+    if ((e_ret_status == SFU_SUCCESS) && (memcmp(fw_header_stage, fw_header_to_test, sizeof(fw_header_stage)) != 0))
+    {
+      e_ret_status = SFU_ERROR;
+    }
+  }
+  else
+  {
+    e_ret_status = SFU_ERROR;
+  }
+  return e_ret_status;
+}
+#endif /* SFU_FWIMG_STAGED_UPDATE */
+
+
+/**
+  * @}
+  */
+
+/** @defgroup SFU_IMG_CORE_Exported_Functions Exported Functions
+  * @brief Functions used by fwimg_services
+  * @note All these functions are also listed in the Common services (High Level and Low Level Services).
+  * @{
+  */
+
+/**
+  * @brief  Initialize the SFU APP.
+  * @param  None
+  * @note   Not used in Alpha version -
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+SFU_IMG_InitStatusTypeDef SFU_IMG_CoreInit(void)
+{
+  SFU_IMG_InitStatusTypeDef e_ret_status = SFU_IMG_INIT_OK;
+
+  /*
+   * When there is no valid FW in slot 0, the fw_header_validated array is filled with 0s.
+   * When installing a first FW (after local download) this means that WRITE_TRAILER_MAGIC will write a SWAP magic starting with 0s.
+   * This causes an issue when calling CLEAN_TRAILER_MAGIC (because of this we added an erase that generated side-effects).
+   * To avoid all these problems we can initialize fw_header_validated with a non-0  value.
+   */
+  memset(fw_header_validated, 0xFE, sizeof(fw_header_validated));
+
+  /*
+   * Sanity check: let's make sure the slot sizes are correct
+   * to avoid discrepancies between linker definitions and constants in sfu_fwimg_regions.h
+   */
+  if (!(SFU_IMG_REGION_IS_SAME_SIZE(SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SLOT_1_REGION_SIZE)))
+  {
+    TRACE("\r\n= [FWIMG] SLOT size issue SLOT0 %d != SLOT1 %d\r\n", SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SLOT_1_REGION_SIZE);
+    e_ret_status = SFU_IMG_INIT_SLOTS_SIZE_ERROR;
+  }
+  else if (!(SFU_IMG_REGION_IS_MULTIPLE(SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SWAP_REGION_SIZE)))
+  {
+    TRACE("\r\n= [FWIMG] The image slot size (%d) must be a multiple of the swap region size (%d)\r\n", SFU_IMG_SLOT_0_REGION_SIZE, SFU_IMG_SWAP_REGION_SIZE);
+    e_ret_status = SFU_IMG_INIT_SLOTS_SIZE_ERROR;
+  }
+  else
+  {
+    e_ret_status = SFU_IMG_INIT_OK;
+    TRACE("\r\n= [FWIMG] Slot #0 @: %x / Slot #1 @: %x / Swap @: %x", SFU_IMG_SLOT_0_REGION_BEGIN_VALUE, SFU_IMG_SLOT_1_REGION_BEGIN_VALUE, SFU_IMG_SWAP_REGION_BEGIN_VALUE);
+  }
+
+  /*
+   * Sanity check: let's make sure the swap region size and the slot size is correct with regards to the swap procedure constraints.
+   * The swap procedure cannot succeed if the trailer info size is bigger than what a chunk used for swapping can carry.
+   */
+  if (((int32_t)(SFU_IMG_CHUNK_SIZE - (TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t)))) < 0)
+  {
+    e_ret_status = SFU_IMG_INIT_SWAP_SETTINGS_ERROR;
+    TRACE("\r\n= [FWIMG] %d bytes required for the swap metadata is too much, please tune your settings", (TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t)));
+  } /* else the swap settings are fine from a metadata size perspective */
+
+  /*
+   * Sanity check: let's make sure the swap region size and the slot size is correct with regards to the swap procedure constraints.
+   * The swap region size must be a multiple of the chunks size used to do the swap.
+   */
+#if defined(__GNUC__)
+  __IO uint32_t swap_size = SFU_IMG_SWAP_REGION_SIZE, swap_chunk = SFU_IMG_CHUNK_SIZE;
+  if (0 != ((uint32_t)(swap_size % swap_chunk)))
+#else
+  if (0 != ((uint32_t)(SFU_IMG_SWAP_REGION_SIZE % SFU_IMG_CHUNK_SIZE)))
+#endif /* __GNUC__ */
+  {
+    e_ret_status = SFU_IMG_INIT_SWAP_SETTINGS_ERROR;
+    TRACE("\r\n= [FWIMG] The swap procedure uses chunks of %d bytes but the swap region size (%d) is not a multiple of this: please tune your settings", SFU_IMG_CHUNK_SIZE, SFU_IMG_SWAP_REGION_SIZE);
+  } /* else the swap settings are fine from a chunk size perspective */
+
+  /*
+   * Sanity check: let's make sure the chunks used for the swap procedure are big enough with regards to the offset giving the start @ of the firmware
+   */
+  if (((int32_t)(SFU_IMG_CHUNK_SIZE - SFU_IMG_IMAGE_OFFSET)) < 0)
+  {
+    e_ret_status = SFU_IMG_INIT_SWAP_SETTINGS_ERROR;
+    TRACE("\r\n= [FWIMG] The swap procedure uses chunks of %d bytes but the firmware start offset is %d bytes: please tune your settings", SFU_IMG_CHUNK_SIZE, SFU_IMG_IMAGE_OFFSET);
+  } /* else the swap settings are fine from a firmware start offset perspective */
+  /*
+   * Sanity check: let's make sure all slots are properly aligned with regards to flash constraints
+   */
+  if (!IS_ALIGNED(SFU_IMG_SLOT_0_REGION_BEGIN_VALUE))
+  {
+    e_ret_status = SFU_IMG_INIT_FLASH_CONSTRAINTS_ERROR;
+    TRACE("\r\n= [FWIMG] slot 0 (%x) is not properly aligned: please tune your settings", SFU_IMG_SLOT_0_REGION_BEGIN_VALUE);
+  } /* else slot 0 is properly aligned */
+
+  if (!IS_ALIGNED(SFU_IMG_SLOT_1_REGION_BEGIN_VALUE))
+  {
+    e_ret_status = SFU_IMG_INIT_FLASH_CONSTRAINTS_ERROR;
+    TRACE("\r\n= [FWIMG] slot 1 (%x) is not properly aligned: please tune your settings", SFU_IMG_SLOT_1_REGION_BEGIN_VALUE);
   } /* else slot 1 is properly aligned */
   if (!IS_ALIGNED(SFU_IMG_SWAP_REGION_BEGIN_VALUE))
   {
@@ -1465,6 +2285,47 @@ SFU_ErrorStatus SFU_IMG_VerifyFwSignature(SE_StatusTypeDef  *pSeStatus, SE_FwRaw
 }
 
 
+/**
+  * @brief  Verify image signature of the active Firmware (slot #0)
+  * @note   The whole Firmware image is verified by the Secure Engine in a single call, reading it directly from the FLASH.
+  *         The images in slot #1 are still verified by @ref SFU_IMG_VerifyFwSignature: a double ECC error must be
+  *         caught by the SBSFU when reading an image which may have been partially written.
+  * @param  pSeStatus pointer giving the SE status result
+  * @param  pFwImageHeader pointer to fw header (authenticated)
+  * @param  Flags SE_VERIFY_FW_FULL to compute the Firmware Tag,
+  *         SE_VERIFY_FW_RECORD to skip it if the same Firmware is recorded as verified,
+  *         SE_VERIFY_FW_RECORD | SE_VERIFY_FW_FORCE to compute it and record the Firmware
+  * @retval SFU_SUCCESS if successful, a SFU_ErrorStatus error otherwise.
+  */
+SFU_ErrorStatus SFU_IMG_VerifyActiveFwSignature(SE_StatusTypeDef *pSeStatus, SE_FwRawHeaderTypeDef *pFwImageHeader,
+                                                uint32_t Flags)
+{
+  SE_FwAreaTypeDef fw_area;
+  SFU_ErrorStatus e_ret_status = SFU_ERROR;
+
+  /*  put it OK, to discriminate error in SFU FWIMG parts */
+  *pSeStatus = SE_OK;
+  if ((pFwImageHeader == NULL) || (pFwImageHeader->FwSize > (SFU_IMG_SLOT_0_REGION_SIZE - SFU_IMG_IMAGE_OFFSET)))
+  {
+    return e_ret_status;
+  }
+
+  /* The active Firmware is always written in a contiguous manner */
+  fw_area.pArea[0] = (const uint8_t *)(SlotHeaderAddress[0] + SFU_IMG_IMAGE_OFFSET);
+  fw_area.AreaSize[0] = pFwImageHeader->FwSize;
+  fw_area.pArea[1] = NULL;
+  fw_area.AreaSize[1] = 0U;
+
+  /* Signature Verification */
+  if (SE_VerifyFwTag(pSeStatus, pFwImageHeader, &fw_area, Flags) == SE_SUCCESS)
+  {
+    e_ret_status = SFU_SUCCESS;
+  }
+
+  return e_ret_status;
+}
+
+
 /**
   * @brief  Write a valid header in slot #0
   * @param  Address of the header to be installed in slot #0
@@ -1686,6 +2547,7 @@ SFU_ErrorStatus SFU_IMG_FirmwareToInstall(void)
   uint8_t *pbuffer = (uint8_t *) SFU_IMG_SWAP_REGION_BEGIN;
   uint8_t  buffer[INSTALLED_LENGTH];
   uint8_t fw_header_slot[FW_INFO_TOT_LEN + VALID_SIZE]; /* header + VALID tags */
+  uint32_t resume = 0U;
 
   /*
    * The anti-rollback check is implemented at installation stage (SFU_IMG_InstallNewVersion)
@@ -1698,8 +2560,16 @@ SFU_ErrorStatus SFU_IMG_FirmwareToInstall(void)
   {
     /*  check swap header */
     e_ret_status = SFU_IMG_GetFWInfoMAC(&fw_image_header_to_test, 2);
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+    if ((e_ret_status != SFU_SUCCESS) && (DeltaStageResume() == SFU_SUCCESS))
+    {
+      /* Interrupted decoding of a delta or compressed image: the swap area no longer holds the header */
+      resume = 1U;
+      e_ret_status = SFU_SUCCESS;
+    }
+#endif /* SFU_FWIMG_STAGED_UPDATE */
   }
-  if (e_ret_status == SFU_SUCCESS)
+  if ((e_ret_status == SFU_SUCCESS) && (resume == 0U))
   {
     uint32_t i;
     e_ret_status = SFU_LL_FLASH_Read(buffer, pbuffer, sizeof(buffer));
@@ -1723,17 +2593,42 @@ SFU_ErrorStatus SFU_IMG_FirmwareToInstall(void)
     {
       /* image header in slot 1 not consistent with swap header */
       uint32_t trailer_begin = (uint32_t) TRAILER_BEGIN;
+      uint32_t test_image_limit = trailer_begin;
       uint32_t end_of_test_image = ((uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN + fw_image_header_to_test.FwSize + SFU_IMG_IMAGE_OFFSET);
       uint32_t end_of_valid_image = ((uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN + fw_image_header_validated.FwSize +  SFU_IMG_IMAGE_OFFSET);
       /* the header in swap must be the same as the header in slot #1 */
       int ret = memcmp(fw_header_slot, fw_header_to_test, sizeof(fw_header_to_test)); /* compare only the header length */
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+      if (fw_image_header_to_test.PatchSize != 0U)
+      {
+        /*
+         * Delta or compressed image: the payload, then the decoded FW (shifted by one swap area), must stay below the
+         * staging area. If the decoding has been interrupted, the header in slot #1 is overwritten but its copy in the
+         * staging area still matches the swap header.
+         */
+        test_image_limit = DeltaStageBegin(fw_image_header_to_test.PatchSize);
+        end_of_test_image = (uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN + SFU_IMG_IMAGE_OFFSET + fw_image_header_to_test.PatchSize;
+        if (fw_image_header_to_test.FwSize > (SFU_IMG_SWAP_REGION_SIZE + fw_image_header_to_test.PatchSize))
+        {
+          end_of_test_image = (uint32_t)SFU_IMG_SLOT_1_REGION_BEGIN + SFU_IMG_IMAGE_OFFSET + fw_image_header_to_test.FwSize
+                              - SFU_IMG_SWAP_REGION_SIZE;
+        }
+        if ((ret != 0) && (test_image_limit != 0U))
+        {
+          if (SFU_LL_FLASH_Read(fw_header_slot, (uint8_t *)test_image_limit, sizeof(fw_header_slot)) == SFU_SUCCESS)
+          {
+            ret = memcmp(fw_header_slot, fw_header_to_test, sizeof(fw_header_to_test));
+          }
+        }
+      }
+#endif /* SFU_FWIMG_STAGED_UPDATE */
       /*
        * The image to install must not be already validated otherwise this means we try to install a backed-up FW image.
        * The only case to re-install a backed-up image is the rollback use-case, not the new image installation use-case.
        */
       e_ret_status = CheckHeaderValidated(fw_header_slot);
       /* Check if there is enough room for the trailers */
-      if ((trailer_begin < end_of_test_image) || (trailer_begin < end_of_valid_image) || (ret) || (SFU_SUCCESS == e_ret_status))
+      if ((test_image_limit < end_of_test_image) || (trailer_begin < end_of_valid_image) || (ret) || (SFU_SUCCESS == e_ret_status))
       {
         /*
          * These error causes are not memorized in the BootInfo area because there won't be any error handling procedure
@@ -1745,7 +2640,7 @@ SFU_ErrorStatus SFU_IMG_FirmwareToInstall(void)
         /* Display the debug message(s) only once */
         if (1U == initialDeviceStatusCheck)
         {
-          if ((trailer_begin < end_of_test_image) || (trailer_begin < end_of_valid_image))
+          if ((test_image_limit < end_of_test_image) || (trailer_begin < end_of_valid_image))
           {
             TRACE("\r\n= [FWIMG] The binary image to be installed and/or the image to be backed-up overlap with the trailer area!");
           } /* check next error cause */
@@ -1803,8 +2698,28 @@ SFU_ErrorStatus SFU_IMG_PrepareCandidateImageForInstall(void)
    *
    * <Swap area> : {Candidate Image Header}
    * </Swap area>
+   *
+   * For a delta image, slot #1 contains the encrypted patch instead of the encrypted FW and the patch is applied to
+   * the active FW to produce the same layout as the decryption.
+   * For a compressed image, slot #1 contains the encrypted compressed FW, decompressed to produce the same layout.
    */
-  e_ret_status =  DecryptImageInSlot1(&fw_image_header_to_test);
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+  if (fw_image_header_to_test.PatchSize != 0U)
+  {
+    e_ret_status = ApplyPatchInSlot1(&fw_image_header_to_test);
+    if (e_ret_status != SFU_SUCCESS)
+    {
+      /* We would enter an infinite loop of installation attempts if we do not clean-up the swap sector */
+      SFU_FLASH_StatusTypeDef flash_if_status;
+      (void)SFU_LL_FLASH_Erase_Size(&flash_if_status, (void *)SFU_IMG_SWAP_REGION_BEGIN, SFU_IMG_IMAGE_OFFSET);
+      (void)CLEAN_TRAILER_MAGIC;
+    }
+  }
+  else
+#endif /* SFU_FWIMG_STAGED_UPDATE */
+  {
+    e_ret_status =  DecryptImageInSlot1(&fw_image_header_to_test);
+  }
 
   if (e_ret_status != SFU_SUCCESS)
   {
@@ -1840,6 +2755,13 @@ SFU_ErrorStatus SFU_IMG_PrepareCandidateImageForInstall(void)
 #if defined(SFU_VERBOSE_DEBUG_MODE)
     TRACE("\r\n= [FWIMG] The decrypted image is incorrect!");
 #endif /* SFU_VERBOSE_DEBUG_MODE */
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+    if (fw_image_header_to_test.PatchSize != 0U)
+    {
+      /* The candidate header in the trailer would resume the decoding at each reset */
+      (void)CLEAN_TRAILER_MAGIC;
+    }
+#endif /* SFU_FWIMG_STAGED_UPDATE */
     return e_ret_status;
   }
 
@@ -1875,7 +2797,17 @@ SFU_ErrorStatus SFU_IMG_InstallNewVersion(void)
    */
 
   /*  erase last block */
-  e_ret_status = EraseSlotIndex(1, (TRAILER_INDEX - 1)); /* erase the size of "swap area" at the end of slot #1 */
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+  if (fw_image_header_to_test.PatchSize != 0U)
+  {
+    /* Delta or compressed image: the trailer headers have been written by ApplyPatchInSlot1, keep them */
+    e_ret_status = SFU_SUCCESS;
+  }
+  else
+#endif /* SFU_FWIMG_STAGED_UPDATE */
+  {
+    e_ret_status = EraseSlotIndex(1, (TRAILER_INDEX - 1)); /* erase the size of "swap area" at the end of slot #1 */
+  }
   if (e_ret_status ==  SFU_ERROR)
   {
     (void)SFU_BOOT_SetLastExecError(SFU_EXCPT_FLASH_ERROR);
@@ -1901,7 +2833,12 @@ SFU_ErrorStatus SFU_IMG_InstallNewVersion(void)
 
 
   /*  write trailer  */
-  e_ret_status = WriteTrailerHeader(fw_header_to_test, fw_header_validated);
+#if defined(SFU_FWIMG_STAGED_UPDATE)
+  if (fw_image_header_to_test.PatchSize == 0U)
+#endif /* SFU_FWIMG_STAGED_UPDATE */
+  {
+    e_ret_status = WriteTrailerHeader(fw_header_to_test, fw_header_validated);
+  }
   /*  finish with the magic to validate */
   if (e_ret_status != SFU_SUCCESS)
   {
@@ -53,6 +53,21 @@
   * @{
   */
 
+/** @defgroup SFU_IMG_SERVICES_Private_Variables Private Variables
+  * @{
+  */
+
+#if defined(SFU_FWIMG_VERIFY_RECORD)
+/**
+ * Set by @ref SFU_IMG_ForceFullVerification: the active FW signature must be computed at the next verification.
+ */
+static uint32_t u_ForceFullVerification = 0U;
+#endif /* SFU_FWIMG_VERIFY_RECORD */
+
+/**
+  * @}
+  */
+
 /** @defgroup SFU_IMG_Exported_Functions FW Images Handling Services
   * @brief Services the bootloader can call to handle the FW images.
   * @{
@@ -327,6 +342,8 @@ SFU_ErrorStatus SFU_IMG_CheckCandidateImage(void)
   *        The detailed errors are memorized in bootinfo area to be processed as critical errors if needed.
   *        This function modifies the FLASH content.
   *        If this procedure is interrupted before its completion (e.g.: switch off) it cannot be resumed .
+  *        Except for a delta or compressed image (@ref SFU_FWIMG_DELTA_UPDATE, @ref SFU_FWIMG_COMPRESSED_UPDATE): the
+  *        decoding restarts at next reset until the swap starts.
   * @note  It is up to the caller to make sure the conditions to call this primitive are met (no check performed before running the procedure):
   *        SFU_IMG_CheckPendingInstallation, SFU_IMG_CheckCandidateMetadata, SFU_IMG_CheckCandidateImage should be called first.
   *        fw_image_header_to_test to be populated before calling this function.
@@ -522,12 +539,29 @@ SFU_ErrorStatus SFU_IMG_VerifyActiveImg(void)
 {
   SFU_ErrorStatus e_ret_status = SFU_ERROR;
   SE_StatusTypeDef e_se_status = SE_KO;
+  uint32_t verify_flags = SE_VERIFY_FW_FULL;
+
+#if defined(SFU_FWIMG_VERIFY_RECORD)
+  /* An unchanged active FW, recorded as verified, is not hashed again (unless a full verification is forced) */
+  verify_flags = SE_VERIFY_FW_RECORD;
+  if (u_ForceFullVerification != 0U)
+  {
+    verify_flags |= SE_VERIFY_FW_FORCE;
+  }
+#endif /* SFU_FWIMG_VERIFY_RECORD */
 
   /*
    * fw_image_header_validated MUST have been populated with valid metadata first,
    * slot #0 is the active FW image
    */
-  e_ret_status = SFU_IMG_VerifyFwSignature(&e_se_status, &fw_image_header_validated, 0U);
+  e_ret_status = SFU_IMG_VerifyActiveFwSignature(&e_se_status, &fw_image_header_validated, verify_flags);
+#if defined(SFU_FWIMG_VERIFY_RECORD)
+  if (SFU_SUCCESS == e_ret_status)
+  {
+    /* The verified FW is recorded: the next verifications can rely on it */
+    u_ForceFullVerification = 0U;
+  }
+#endif /* SFU_FWIMG_VERIFY_RECORD */
 #if defined(SFU_VERBOSE_DEBUG_MODE)
   if (SFU_ERROR == e_ret_status)
   {
@@ -539,6 +573,22 @@ SFU_ErrorStatus SFU_IMG_VerifyActiveImg(void)
   return (e_ret_status);
 }
 
+/**
+  * @brief Forces the next verification of the active firmware image to compute its signature
+  *        (the record of the last verified firmware is ignored, then replaced once the verification succeeds).
+  * @note  Called after an installation and after an erroneous execution (e.g. tamper detection), it can also be
+  *        called to request a full verification.
+  * @note  Useless if SFU_FWIMG_VERIFY_RECORD is not defined: the signature is always computed.
+  * @param None.
+  * @retval None.
+  */
+void SFU_IMG_ForceFullVerification(void)
+{
+#if defined(SFU_FWIMG_VERIFY_RECORD)
+  u_ForceFullVerification = 1U;
+#endif /* SFU_FWIMG_VERIFY_RECORD */
+}
+
 /**
   * @brief Launches the user application.
   *        The caller must be prepared to never get the hand back after calling this function.
@@ -152,6 +152,18 @@ uint32_t SE_LL_CRC_Calculate(uint32_t pBuffer[], uint32_t uBufferLength)
   return HAL_CRC_Calculate(&CrcHandle, pBuffer, uBufferLength);
 }
 
+/**
+  * @brief  Wrapper to HAL CRC Accumulate function.
+  * @note   The computation goes on from the result of the previous SE_LL_CRC_Calculate or SE_LL_CRC_Accumulate call.
+  * @param  pBuffer: pointer to data buffer.
+  * @param  uBufferLength: buffer length in 32-bits word.
+  * @retval uint32_t CRC (returned value LSBs for CRC shorter than 32 bits)
+  */
+uint32_t SE_LL_CRC_Accumulate(uint32_t pBuffer[], uint32_t uBufferLength)
+{
+  return HAL_CRC_Accumulate(&CrcHandle, pBuffer, uBufferLength);
+}
+
 /**
   * @}
   */
@@ -273,6 +285,28 @@ SE_ErrorStatus SE_LL_FLASH_Read(void *pDestination, const void *pSource, uint32_
   return SE_SUCCESS;
 }
 
+/**
+  * @brief  Start reading the FLASH directly (through its memory mapping) from the protected area.
+  * @param  None.
+  * @retval None.
+  */
+void SE_LL_FLASH_DirectReadStart(void)
+{
+  /* No ECC error to catch on this product */
+}
+
+/**
+  * @brief  Stop reading the FLASH directly (through its memory mapping) from the protected area.
+  * @param  None.
+  * @retval SE_ErrorStatus SE_SUCCESS if the FLASH has been read successfully since
+  *         @ref SE_LL_FLASH_DirectReadStart, SE_ERROR otherwise.
+  */
+SE_ErrorStatus SE_LL_FLASH_DirectReadStop(void)
+{
+  /* No ECC error to catch on this product */
+  return SE_SUCCESS;
+}
+
 /**
  * @brief Check if an array is inside the RAM of the product
  * @param Addr : address  of array
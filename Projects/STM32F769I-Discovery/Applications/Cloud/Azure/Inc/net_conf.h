@@ -32,6 +32,18 @@ int16_t ethernetif_low_inputsize(void);
 int16_t ethernetif_low_input(uint8_t *payload, uint16_t len);
 int16_t ethernetif_low_output(uint8_t *payload, uint16_t len);
 
+/* Scatter-gather transmit: one frame made of up to ETHERNETIF_LOW_OUTPUT_SG_MAX segments,
+   each one handed to its own DMA descriptor. Leave the define out to always copy chains. */
+#define ETHERNETIF_LOW_OUTPUT_SG_MAX  4
+
+typedef struct
+{
+  uint8_t  *payload;
+  uint16_t len;
+} ethernetif_low_segment_t;
+
+int16_t ethernetif_low_output_sg(const ethernetif_low_segment_t *segments, uint8_t count);
+
 void ethernetif_low_get_mac_addr(uint8_t *MACAddr_in);
 uint8_t ethernetif_low_get_link_status(void);
 
@@ -46,6 +46,8 @@
 
 /* Private function ---------------------------------------------------------*/
 static void ethernetif_low_errhandle(void);
+static void ethernetif_low_release_tx(void);
+static void ethernetif_low_resume_tx(void);
 
 /* Private variables ---------------------------------------------------------*/
 #if defined ( __ICCARM__ )
@@ -340,13 +342,13 @@ void ethernetif_low_deinit()
   memset(MACAddr, 0x00, 6);
 
 
-  /* return pending buffers */
+  /* return pending buffers, once per frame */
   for (int32_t i = 0; i < ETH_TXBUFNB; i++)
   {
     if ((DMATxDscrTab[i].Buffer1Addr != 0))
     {
       DMATxDscrTab[i].Buffer1Addr = 0;
-      if (*buffer_output_callback)
+      if ((DMATxDscrTab[i].Status & ETH_DMATXDESC_LS) && (*buffer_output_callback))
       {
         (*buffer_output_callback)((uint8_t *) DMATxDscrTab[i].Buffer1Addr);
       }
@@ -425,22 +427,42 @@ static void ethernetif_low_errhandle(void)
   }
 }
 
-int16_t ethernetif_low_output(uint8_t *payload, uint16_t len)
+/* Return the buffers of the frames sent by the DMA. A frame may span several
+   descriptors: it is reported once, by its last segment. */
+static void ethernetif_low_release_tx(void)
 {
-  int16_t errval = 0;
-  __IO ETH_DMADescTypeDef *DmaTxDesc = EthHandle.TxDesc;
-  bufferout++;
   for (int32_t i = 0; i < ETH_TXBUFNB; i++)
   {
     if ((DMATxDscrTab[i].Buffer1Addr != 0) && !(DMATxDscrTab[i].Status & ETH_DMATXDESC_OWN))
     {
       DMATxDscrTab[i].Buffer1Addr = 0;
-      if (*buffer_output_callback)
+      if ((DMATxDscrTab[i].Status & ETH_DMATXDESC_LS) && (*buffer_output_callback))
       {
         (*buffer_output_callback)((uint8_t *) DMATxDscrTab[i].Buffer1Addr);
       }
     }
   }
+}
+
+static void ethernetif_low_resume_tx(void)
+{
+  /* When Transmit Underflow flag is set, clear it and issue a Transmit Poll Demand to resume transmission */
+  if ((EthHandle.Instance->DMASR & ETH_DMASR_TUS) != (uint32_t)RESET)
+  {
+    /* Clear TUS ETHERNET DMA flag */
+    EthHandle.Instance->DMASR = ETH_DMASR_TUS;
+
+    /* Resume DMA transmission*/
+    EthHandle.Instance->DMATPDR = 0;
+  }
+}
+
+int16_t ethernetif_low_output(uint8_t *payload, uint16_t len)
+{
+  int16_t errval = 0;
+  __IO ETH_DMADescTypeDef *DmaTxDesc = EthHandle.TxDesc;
+  bufferout++;
+  ethernetif_low_release_tx();
 
   if ((DmaTxDesc->Status & ETH_DMATXDESC_OWN) != (uint32_t)RESET)
   {
@@ -459,15 +481,70 @@ int16_t ethernetif_low_output(uint8_t *payload, uint16_t len)
 
 
 error:
-  /* When Transmit Underflow flag is set, clear it and issue a Transmit Poll Demand to resume transmission */
-  if ((EthHandle.Instance->DMASR & ETH_DMASR_TUS) != (uint32_t)RESET)
+  ethernetif_low_resume_tx();
+  return errval;
+}
+
+int16_t ethernetif_low_output_sg(const ethernetif_low_segment_t *segments, uint8_t count)
+{
+  int16_t errval = 0;
+  __IO ETH_DMADescTypeDef *DmaTxDesc;
+  bufferout++;
+  ethernetif_low_release_tx();
+
+  if ((count == 0U) || (count > ETH_TXBUFNB))
   {
-    /* Clear TUS ETHERNET DMA flag */
-    EthHandle.Instance->DMASR = ETH_DMASR_TUS;
+    errval = -1;
+    goto error;
+  }
 
-    /* Resume DMA transmission*/
+  /* All the descriptors of the frame must be owned by the CPU */
+  DmaTxDesc = EthHandle.TxDesc;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if ((DmaTxDesc->Status & ETH_DMATXDESC_OWN) != (uint32_t)RESET)
+    {
+      errval = -1;
+      goto error;
+    }
+    DmaTxDesc = (ETH_DMADescTypeDef *)(DmaTxDesc->Buffer2NextDescAddr);
+  }
+
+  /* One descriptor per segment, no copy. The first descriptor is given to the DMA last
+     so that the frame is not started before all its segments are ready. */
+  DmaTxDesc = EthHandle.TxDesc;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    DmaTxDesc->Buffer1Addr = (uint32_t) segments[i].payload;
+    SCB_CleanDCache_by_Addr(((uint32_t *)DmaTxDesc->Buffer1Addr), segments[i].len + 32);
+    DmaTxDesc->ControlBufferSize = (segments[i].len & ETH_DMATXDESC_TBS1);
+    DmaTxDesc->Status &= ~(ETH_DMATXDESC_FS | ETH_DMATXDESC_LS);
+    if (i == 0U)
+    {
+      DmaTxDesc->Status |= ETH_DMATXDESC_FS;
+    }
+    if (i == (count - 1U))
+    {
+      DmaTxDesc->Status |= ETH_DMATXDESC_LS;
+    }
+    if (i != 0U)
+    {
+      DmaTxDesc->Status |= ETH_DMATXDESC_OWN;
+    }
+    DmaTxDesc = (ETH_DMADescTypeDef *)(DmaTxDesc->Buffer2NextDescAddr);
+  }
+  EthHandle.TxDesc->Status |= ETH_DMATXDESC_OWN;
+  EthHandle.TxDesc = (ETH_DMADescTypeDef *) DmaTxDesc;
+
+  /* When Tx Buffer unavailable flag is set: clear it and resume transmission */
+  if ((EthHandle.Instance->DMASR & ETH_DMASR_TBUS) != (uint32_t)RESET)
+  {
+    EthHandle.Instance->DMASR = ETH_DMASR_TBUS;
     EthHandle.Instance->DMATPDR = 0;
   }
+
+error:
+  ethernetif_low_resume_tx();
   return errval;
 }
 
@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file    plf_config.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the platform configuration of the cellular AT service: BG96 modem, one
+  *          UART device, no RTOS, no traces.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef PLF_CONFIG_H
+#define PLF_CONFIG_H
+
+#include "stm32l4xx_hal.h"
+
+#define RTOS_USED                      (0)
+#define USE_PRINTF                     (0U)
+#define USER_DEFINED_IPC_MAX_DEVICES   (1)
+#define MODEM_UART_BAUDRATE            (115200U)
+
+#endif /* PLF_CONFIG_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
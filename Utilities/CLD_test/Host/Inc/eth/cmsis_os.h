@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file    cmsis_os.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the CMSIS-RTOS API used by the Ethernet interface: the interface task is
+  *          not started, the test calls the driver directly.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef CMSIS_OS_H
+#define CMSIS_OS_H
+
+#include <stdint.h>
+
+typedef enum
+{
+  osOK = 0,
+  osErrorOS = 0xFF
+} osStatus;
+
+typedef enum
+{
+  osPriorityNormal = 0,
+  osPriorityHigh = 2
+} osPriority;
+
+typedef void *osSemaphoreId;
+typedef void *osThreadId;
+typedef void (*os_pthread)(void const *argument);
+
+typedef struct
+{
+  uint32_t dummy;
+} osSemaphoreDef_t;
+
+typedef struct
+{
+  os_pthread pthread;
+} osThreadDef_t;
+
+#define osSemaphoreDef(name)  const osSemaphoreDef_t os_semaphore_def_##name = { 0 }
+#define osSemaphore(name)     &os_semaphore_def_##name
+#define osThreadDef(name, thread, priority, instances, stacksz) \
+  const osThreadDef_t os_thread_def_##name = { (os_pthread)(thread) }
+#define osThread(name)        &os_thread_def_##name
+
+osSemaphoreId osSemaphoreCreate(const osSemaphoreDef_t *semaphore_def, int32_t count);
+int32_t osSemaphoreWait(osSemaphoreId semaphore_id, uint32_t millisec);
+osStatus osSemaphoreRelease(osSemaphoreId semaphore_id);
+osStatus osSemaphoreDelete(osSemaphoreId semaphore_id);
+osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *argument);
+osStatus osThreadTerminate(osThreadId thread_id);
+
+#endif /* CMSIS_OS_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
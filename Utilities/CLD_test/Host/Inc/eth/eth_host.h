@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    eth_host.h
+  * @author  MCD Application Team
+  * @brief   Host run of the STM32F769I-Discovery Ethernet low level driver (net_conf.c) and of the network
+  *          library Ethernet interface (net_ip_ethernetif.c): fake Ethernet DMA and pbuf pool.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef ETH_HOST_H
+#define ETH_HOST_H
+
+#include "stm32f7xx_hal.h"
+#include "net_connect.h"
+#include "net_ip_ethernet.h"
+
+#define ETH_HOST_PBUF_COUNT   (64U)
+#define ETH_HOST_PBUF_SIZE    (ETH_MAX_PACKET_SIZE)
+
+/**
+  * @brief  Frame read by the fake DMA from the TX descriptors.
+  */
+typedef struct
+{
+  uint8_t  Data[ETH_HOST_PBUF_SIZE];
+  uint32_t Len;
+  uint32_t Segments;
+} eth_host_frame_t;
+
+/**
+  * @brief  Fake driver counters.
+  */
+typedef struct
+{
+  uint32_t PbufsInUse;      /*!< pbufs of the pool allocated and not yet freed */
+  uint32_t FreeErrors;      /*!< pbuf_free() of a NULL or already free pbuf */
+  uint32_t EarlyOwn;        /*!< Segments prepared while the first descriptor of the frame is owned by the DMA */
+} eth_host_t;
+
+/* Driver state of net_conf.c */
+extern ETH_HandleTypeDef EthHandle;
+extern ETH_DMADescTypeDef DMATxDscrTab[ETH_TXBUFNB];
+
+extern eth_host_t eth_host;
+
+int32_t eth_host_dma_transmit(eth_host_frame_t *pFrame);
+
+#endif /* ETH_HOST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
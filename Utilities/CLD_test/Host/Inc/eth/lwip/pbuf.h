@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file    pbuf.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the lwIP packet buffers used by the Ethernet interface: reference counted
+  *          buffers of a static pool (pbuf_alloc, pbuf_ref, pbuf_free).
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef LWIP_HDR_PBUF_H
+#define LWIP_HDR_PBUF_H
+
+#include <stdint.h>
+
+typedef enum
+{
+  PBUF_RAW = 0
+} pbuf_layer;
+
+typedef enum
+{
+  PBUF_RAM = 0,
+  PBUF_REF,
+  PBUF_POOL
+} pbuf_type;
+
+struct pbuf
+{
+  struct pbuf *next;
+  void *payload;
+  uint16_t tot_len;
+  uint16_t len;
+  uint16_t ref;
+};
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, uint16_t length, pbuf_type type);
+void pbuf_ref(struct pbuf *p);
+uint8_t pbuf_free(struct pbuf *p);
+
+#endif /* LWIP_HDR_PBUF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************
+  * @file    net_connect.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the network library API seen by the Ethernet interface: the network
+  *          buffers are lwIP pbufs, the configuration is the one of the STM32F769I-Discovery project.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef NET_CONNECT_H
+#define NET_CONNECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "net_conf.h"
+#include "lwip/pbuf.h"
+/* Before net_ip_ethernet.h: its guard hides the library header, which the Ethernet interface does not need */
+#include "net_internals.h"
+
+typedef struct pbuf net_buf_t;
+
+#endif /* NET_CONNECT_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
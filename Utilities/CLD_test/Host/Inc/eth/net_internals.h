@@ -0,0 +1,26 @@
+/**
+  ******************************************************************************
+  * @file    net_internals.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the network library internals: nothing used by the Ethernet interface.
+  *          Included by the net_connect.h stand-in, so that the library header is never read.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef NET_INTERNALS_H
+#define NET_INTERNALS_H
+
+#endif /* NET_INTERNALS_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
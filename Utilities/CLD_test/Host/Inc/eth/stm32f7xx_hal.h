@@ -0,0 +1,180 @@
+/**
+  ******************************************************************************
+  * @file    stm32f7xx_hal.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the STM32F7 HAL used by the Ethernet low level driver (net_conf.c):
+  *          Ethernet DMA descriptors and registers in RAM, no-op GPIO, NVIC, RCC and cache maintenance.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef STM32F7XX_HAL_H
+#define STM32F7XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO volatile
+#define RESET 0U
+
+typedef enum
+{
+  HAL_OK = 0x00U,
+  HAL_ERROR = 0x01U
+} HAL_StatusTypeDef;
+
+/* Values of stm32f7xx_hal_eth.h, stm32f769xx.h and of the project stm32f7xx_hal_conf.h */
+#define ETH_RXBUFNB                  ((uint32_t)4U)
+#define ETH_TXBUFNB                  ((uint32_t)4U)
+#define ETH_MAX_PACKET_SIZE          ((uint32_t)1524U)
+#define ETH_RX_BUF_SIZE              ETH_MAX_PACKET_SIZE
+#define ETH_TX_BUF_SIZE              ETH_MAX_PACKET_SIZE
+#define LAN8742A_PHY_ADDRESS         0x00U
+#define PHY_BSR                      ((uint16_t)0x01U)
+#define PHY_LINKED_STATUS            ((uint16_t)0x0004U)
+
+#define ETH_DMATXDESC_OWN            ((uint32_t)0x80000000U)
+#define ETH_DMATXDESC_IC             ((uint32_t)0x40000000U)
+#define ETH_DMATXDESC_LS             ((uint32_t)0x20000000U)
+#define ETH_DMATXDESC_FS             ((uint32_t)0x10000000U)
+#define ETH_DMATXDESC_TCH            ((uint32_t)0x00100000U)
+#define ETH_DMATXDESC_TBS1           ((uint32_t)0x00001FFFU)
+#define ETH_DMARXDESC_OWN            ((uint32_t)0x80000000U)
+
+#define ETH_DMA_IT_NIS               ((uint32_t)0x00010000U)
+#define ETH_DMA_IT_AIS               ((uint32_t)0x00008000U)
+#define ETH_DMA_IT_RBU               ((uint32_t)0x00000080U)
+#define ETH_DMA_IT_R                 ((uint32_t)0x00000040U)
+#define ETH_DMA_IT_T                 ((uint32_t)0x00000001U)
+#define ETH_DMASR_RBUS               ((uint32_t)0x00000080U)
+#define ETH_DMASR_TUS                ((uint32_t)0x00000020U)
+#define ETH_DMASR_TBUS               ((uint32_t)0x00000004U)
+
+#define ETH_AUTONEGOTIATION_ENABLE   ((uint32_t)0x00000001U)
+#define ETH_SPEED_100M               ((uint32_t)0x00004000U)
+#define ETH_MODE_FULLDUPLEX          ((uint32_t)0x00000800U)
+#define ETH_RXINTERRUPT_MODE         ((uint32_t)0x00000001U)
+#define ETH_CHECKSUM_BY_HARDWARE     ((uint32_t)0x00000000U)
+#define ETH_MEDIA_INTERFACE_RMII     ((uint32_t)0x00800000U)
+
+/* The descriptors keep buffer and next descriptor addresses in uint32_t: the test is linked without PIE
+   so that the static buffers are below 4 GB */
+typedef struct
+{
+  __IO uint32_t   Status;
+  __IO uint32_t   ControlBufferSize;
+  __IO uint32_t   Buffer1Addr;
+  __IO uint32_t   Buffer2NextDescAddr;
+  __IO uint32_t   ExtendedStatus;
+  __IO uint32_t   Reserved1;
+  __IO uint32_t   TimeStampLow;
+  __IO uint32_t   TimeStampHigh;
+} ETH_DMADescTypeDef;
+
+typedef struct
+{
+  ETH_DMADescTypeDef *FSRxDesc;
+  ETH_DMADescTypeDef *LSRxDesc;
+  uint32_t  SegCount;
+  uint32_t length;
+  uint32_t buffer;
+} ETH_DMARxFrameInfos;
+
+typedef struct
+{
+  __IO uint32_t DMASR;
+  __IO uint32_t DMAIER;
+  __IO uint32_t DMATPDR;
+  __IO uint32_t DMARPDR;
+} ETH_TypeDef;
+
+typedef struct
+{
+  uint32_t AutoNegotiation;
+  uint32_t Speed;
+  uint32_t DuplexMode;
+  uint16_t PhyAddress;
+  uint8_t *MACAddr;
+  uint32_t RxMode;
+  uint32_t ChecksumMode;
+  uint32_t MediaInterface;
+} ETH_InitTypeDef;
+
+typedef struct
+{
+  ETH_TypeDef *Instance;
+  ETH_InitTypeDef Init;
+  ETH_DMADescTypeDef *RxDesc;
+  ETH_DMADescTypeDef *TxDesc;
+  ETH_DMARxFrameInfos RxFrameInfos;
+} ETH_HandleTypeDef;
+
+extern ETH_TypeDef eth_host_regs;
+#define ETH                          (&eth_host_regs)
+#define ETH_IRQn                     61
+
+#define __HAL_ETH_DMA_GET_FLAG(h, f)     (((h)->Instance->DMASR & (f)) == (f))
+#define __HAL_ETH_DMA_CLEAR_FLAG(h, f)   ((h)->Instance->DMASR = (f))
+#define __HAL_ETH_DMA_ENABLE_IT(h, it)   ((h)->Instance->DMAIER |= (it))
+#define __HAL_ETH_DMA_DISABLE_IT(h, it)  ((h)->Instance->DMAIER &= ~(it))
+
+HAL_StatusTypeDef HAL_ETH_Init(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_Start(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_Stop(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_DMATxDescListInit(ETH_HandleTypeDef *heth, ETH_DMADescTypeDef *DMATxDescTab,
+                                            uint8_t *TxBuff, uint32_t TxBuffCount);
+HAL_StatusTypeDef HAL_ETH_DMARxDescListInit(ETH_HandleTypeDef *heth, ETH_DMADescTypeDef *DMARxDescTab,
+                                            uint8_t *RxBuff, uint32_t RxBuffCount);
+HAL_StatusTypeDef HAL_ETH_TransmitFrame(ETH_HandleTypeDef *heth, uint32_t FrameLength);
+HAL_StatusTypeDef HAL_ETH_GetReceivedFrame_IT(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_ReadPHYRegister(ETH_HandleTypeDef *heth, uint16_t PHYReg, uint32_t *RegValue);
+void SCB_CleanDCache_by_Addr(uint32_t *addr, int32_t dsize);
+void SCB_InvalidateDCache_by_Addr(uint32_t *addr, int32_t dsize);
+
+/* Board configuration of HAL_ETH_MspInit(): no effect on the host */
+typedef struct
+{
+  uint32_t Pin;
+  uint32_t Mode;
+  uint32_t Pull;
+  uint32_t Speed;
+  uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+#define GPIOA                        ((void *)0)
+#define GPIOC                        ((void *)0)
+#define GPIOG                        ((void *)0)
+#define GPIO_PIN_1                   0x0002U
+#define GPIO_PIN_2                   0x0004U
+#define GPIO_PIN_4                   0x0010U
+#define GPIO_PIN_5                   0x0020U
+#define GPIO_PIN_7                   0x0080U
+#define GPIO_PIN_11                  0x0800U
+#define GPIO_PIN_13                  0x2000U
+#define GPIO_PIN_14                  0x4000U
+#define GPIO_SPEED_HIGH              0x3U
+#define GPIO_MODE_AF_PP              0x2U
+#define GPIO_NOPULL                  0x0U
+#define GPIO_AF11_ETH                0xBU
+#define HAL_GPIO_Init(port, init)    ((void)(port), (void)(init))
+#define HAL_NVIC_SetPriority(irq, p, s)  ((void)(irq), (void)(p), (void)(s))
+#define HAL_NVIC_EnableIRQ(irq)      ((void)(irq))
+#define __HAL_RCC_GPIOA_CLK_ENABLE() ((void)0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE() ((void)0)
+#define __HAL_RCC_GPIOG_CLK_ENABLE() ((void)0)
+#define __HAL_RCC_ETH_CLK_ENABLE()   ((void)0)
+#define __HAL_RCC_ETH_CLK_DISABLE()  ((void)0)
+
+#endif /* STM32F7XX_HAL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    stm32f7xx_ll_utils.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the STM32F7 LL utilities: fixed unique device ID.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef STM32F7XX_LL_UTILS_H
+#define STM32F7XX_LL_UTILS_H
+
+#include <stdint.h>
+
+static inline uint32_t LL_GetUID_Word0(void)
+{
+  return 0x00360022U;
+}
+
+static inline uint32_t LL_GetUID_Word1(void)
+{
+  return 0x3137510bU;
+}
+
+static inline uint32_t LL_GetUID_Word2(void)
+{
+  return 0x37333832U;
+}
+
+#endif /* STM32F7XX_LL_UTILS_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
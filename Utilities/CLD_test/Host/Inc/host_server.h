@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    host_server.h
+  * @author  MCD Application Team
+  * @brief   Loopback TCP / TLS server of the host benchmarks, run in a child process so that its heap
+  *          and its mbedTLS allocator are not the ones measured on the client (network library) side.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef HOST_SERVER_H
+#define HOST_SERVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Name of the server certificate: the host name the clients connect to. */
+#define HOST_SERVER_NAME  "localhost"
+
+/**
+  * @brief  Connection accepted by the server, given to the connection handler.
+  */
+typedef struct host_server_conn_s host_server_conn_t;
+
+/**
+  * @brief  Connection handler, run in the server process. The connection is closed when it returns.
+  */
+typedef void (*host_server_handler_t)(host_server_conn_t *pConn, void *pArg);
+
+typedef struct
+{
+  pid_t Pid;      /*!< Server process */
+  uint16_t Port;  /*!< Listening port, on 127.0.0.1 */
+} host_server_t;
+
+const char *host_server_ca_cert(void);
+int host_server_start(host_server_t *pServer, uint16_t Port, bool Tls, host_server_handler_t Handler, void *pArg);
+void host_server_stop(host_server_t *pServer);
+int host_server_recv(host_server_conn_t *pConn, uint8_t *pBuf, size_t Len);
+int host_server_send(host_server_conn_t *pConn, const void *pBuf, size_t Len);
+
+#endif /* HOST_SERVER_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
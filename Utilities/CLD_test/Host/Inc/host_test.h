@@ -0,0 +1,71 @@
+/**
+  ******************************************************************************
+  * @file    host_test.h
+  * @author  MCD Application Team
+  * @brief   Check and timing helpers of the host tests and benchmarks.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Each test or benchmark is a single translation unit: the failure count is private to it. */
+static int host_test_failures;
+
+#define HOST_TEST_CHECK(cond) do { \
+    if (!(cond)) \
+    { \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      host_test_failures++; \
+    } \
+  } while (0)
+
+/* Exit code of main(): non-zero as soon as one check failed. */
+#define HOST_TEST_RESULT() ((host_test_failures == 0) ? 0 : 1)
+
+/**
+  * @brief  Iteration count of a benchmark: first command line argument, or the default.
+  *         ctest runs the benchmarks with a small count so that they stay smoke tests.
+  */
+static inline unsigned long host_test_iterations(int argc, char *argv[], unsigned long def)
+{
+  return (argc > 1) ? strtoul(argv[1], NULL, 0) : def;
+}
+
+/**
+  * @brief  Monotonic time in microseconds.
+  */
+static inline uint64_t host_test_time_us(void)
+{
+  struct timespec ts;
+  (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec * 1000000U) + ((uint64_t) ts.tv_nsec / 1000U);
+}
+
+/**
+  * @brief  Throughput in MB/s of size bytes processed in us microseconds.
+  */
+static inline double host_test_mbps(uint64_t size, uint64_t us)
+{
+  return (us == 0U) ? 0.0 : ((double) size / (double) us);
+}
+
+#endif /* HOST_TEST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,44 @@
+/**
+  ******************************************************************************
+  * @file    ipc_config.h
+  * @author  MCD Application Team
+  * @brief   Host IPC configuration: the values of the 32L496GDISCOVERY project, with a smaller queue and DMA
+  *          buffer so that the tests pause the queue and wrap the DMA buffer often. The reception mode
+  *          (IPC_USE_UART_DMA_RX) is given by the build.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef IPC_CONFIG_H
+#define IPC_CONFIG_H
+
+#include "plf_config.h"
+
+#define IPC_RXBUF_MAXSIZE    ((uint16_t) 512U)
+#define IPC_RXBUF_THRESHOLD  ((uint16_t) 20U)
+#define IPC_USE_STREAM_MODE  (0U)
+
+#define IPC_USE_UART (1U)
+#define IPC_USE_SPI  (0U)
+#define IPC_USE_I2C  (0U)
+
+#ifndef IPC_USE_UART_DMA_RX
+#define IPC_USE_UART_DMA_RX (0U)
+#endif /* IPC_USE_UART_DMA_RX */
+#define IPC_RXBUF_DMA_SIZE  ((uint16_t) 64U)
+
+#define DBG_IPC_RX_FIFO  (0U)
+
+#endif /* IPC_CONFIG_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************
+  * @file    ipc_host.h
+  * @author  MCD Application Team
+  * @brief   Fake modem UART of the cellular IPC host tests (Src/ipc_host.c): the modem sends characters
+  *          which are received one by one under interrupt or by the circular RX DMA, depending on
+  *          IPC_USE_UART_DMA_RX.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef IPC_HOST_H
+#define IPC_HOST_H
+
+#include "ipc_uart.h"
+
+/**
+  * @brief  Fake UART counters.
+  */
+typedef struct
+{
+  uint32_t IrqLatency;      /*!< characters received by the DMA before its half / complete interrupt is served */
+  uint32_t Chars;           /*!< characters received */
+  uint32_t Holds;           /*!< characters held by the UART (reception paused, RTS deasserted) */
+  uint32_t DmaWraps;        /*!< ends of the circular DMA buffer reached */
+  uint32_t IdleEvents;      /*!< idle line interrupts */
+  uint32_t WrapSpans;       /*!< DMA interrupts with characters to process on both sides of the buffer end */
+  uint32_t MidSpanPauses;   /*!< DMA paused with received characters left in the DMA buffer */
+} ipc_host_t;
+
+extern UART_HandleTypeDef ipc_host_uart;
+extern ipc_host_t ipc_host;
+
+uint32_t ipc_host_modem_send(const uint8_t *pData, uint32_t Len);
+void ipc_host_line_idle(void);
+
+#endif /* IPC_HOST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    stm32l4xx_hal.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the STM32L4 HAL UART used by the cellular IPC: UART and RX DMA channel
+  *          registers in RAM, driven by the fake UART of Src/ipc_host.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef STM32L4XX_HAL_H
+#define STM32L4XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO volatile
+#define UNUSED(X) (void)X
+
+typedef enum
+{
+  RESET = 0U,
+  SET = !RESET
+} FlagStatus, ITStatus;
+
+typedef enum
+{
+  HAL_OK = 0x00U,
+  HAL_ERROR = 0x01U,
+  HAL_BUSY = 0x02U,
+  HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+/* Values of stm32l4xx_hal_uart.h and stm32l496xx.h: the IDLE interrupt enable bit is used as interrupt
+   identifier */
+typedef uint32_t HAL_UART_StateTypeDef;
+#define HAL_UART_STATE_READY    0x00000020U
+#define HAL_UART_STATE_BUSY_RX  0x00000022U
+#define UART_FLAG_IDLE          0x00000010U
+#define UART_IT_IDLE            0x00000010U
+
+typedef struct
+{
+  __IO uint32_t CR1;
+  __IO uint32_t ISR;
+} USART_TypeDef;
+
+typedef struct
+{
+  __IO uint32_t CNDTR;
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+  DMA_Channel_TypeDef *Instance;
+} DMA_HandleTypeDef;
+
+typedef struct
+{
+  USART_TypeDef               *Instance;
+  uint8_t                     *pRxBuffPtr;
+  uint16_t                    RxXferSize;
+  __IO HAL_UART_StateTypeDef  RxState;
+  DMA_HandleTypeDef           *hdmarx;
+} UART_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)  ((__HANDLE__)->Instance->CNDTR)
+
+#define __HAL_UART_GET_FLAG(__HANDLE__, __FLAG__)  \
+  ((((__HANDLE__)->Instance->ISR & (__FLAG__)) == (__FLAG__)) ? SET : RESET)
+#define __HAL_UART_GET_IT_SOURCE(__HANDLE__, __IT__)  \
+  ((((__HANDLE__)->Instance->CR1 & (__IT__)) != 0U) ? SET : RESET)
+#define __HAL_UART_CLEAR_IDLEFLAG(__HANDLE__)  ((__HANDLE__)->Instance->ISR &= ~UART_FLAG_IDLE)
+#define __HAL_UART_ENABLE_IT(__HANDLE__, __IT__)  ((__HANDLE__)->Instance->CR1 |= (__IT__))
+#define __HAL_UART_DISABLE_IT(__HANDLE__, __IT__)  ((__HANDLE__)->Instance->CR1 &= ~(__IT__))
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_DMAPause(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_DMAResume(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+
+#endif /* STM32L4XX_HAL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
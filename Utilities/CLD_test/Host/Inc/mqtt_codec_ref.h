@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file    mqtt_codec_ref.h
+  * @author  MCD Application Team
+  * @brief   MQTT packet decoder of umqtt as delivered (Src/mqtt_codec_ref.c): reference of the host
+  *          test and benchmark of the current decoder.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MQTT_CODEC_REF_H
+#define MQTT_CODEC_REF_H
+
+#include "azure_umqtt_c/mqtt_codec.h"
+
+MQTTCODEC_HANDLE ref_mqtt_codec_create(ON_PACKET_COMPLETE_CALLBACK packetComplete, void *callbackCtx);
+void ref_mqtt_codec_destroy(MQTTCODEC_HANDLE handle);
+int ref_mqtt_codec_bytesReceived(MQTTCODEC_HANDLE handle, const unsigned char *buffer, size_t size);
+
+#endif /* MQTT_CODEC_REF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
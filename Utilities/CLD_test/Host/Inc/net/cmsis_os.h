@@ -0,0 +1,31 @@
+/**
+  ******************************************************************************
+  * @file    cmsis_os.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the FreeRTOS heap used by the network library (NET_MALLOC, NET_FREE):
+  *          implemented with an allocation count by Src/net_os_posix.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef CMSIS_OS_H
+#define CMSIS_OS_H
+
+#include <stddef.h>
+
+void *pvPortMalloc(size_t xWantedSize);
+void vPortFree(void *pv);
+
+#endif /* CMSIS_OS_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    main.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the board main.h of the network build: the HAL services used by the
+  *          network library, rfu.c and the Azure IoT SDK adapters, implemented by Src/net_os_posix.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HAL_OK      0
+#define HAL_ERROR   1
+
+/* Random number generator of the board: mbedtls_rng_raw() reads the host entropy. */
+typedef struct __RNG_HandleTypeDef
+{
+  uint32_t Instance;
+} RNG_HandleTypeDef;
+
+extern RNG_HandleTypeDef hrng;
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+#endif /* MAIN_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
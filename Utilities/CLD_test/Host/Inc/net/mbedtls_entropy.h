@@ -0,0 +1,30 @@
+/**
+  ******************************************************************************
+  * @file    mbedtls_entropy.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the entropy source of the projects (mbedtls_entropy.c), implemented by
+  *          Src/net_os_posix.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef mbedtls_entropy_H
+#define mbedtls_entropy_H
+
+#include <stddef.h>
+
+int mbedtls_rng_raw(void *data, unsigned char *output, size_t len);
+
+#endif /* mbedtls_entropy_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
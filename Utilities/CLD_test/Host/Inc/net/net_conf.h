@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************
+  * @file    net_conf.h
+  * @author  MCD Application Team
+  * @brief   Network library configuration of the host build: the configuration of the projects, with the
+  *          RTOS port (NET_USE_RTOS) provided by Src/net_os_posix.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef NET_CONF_H
+#define NET_CONF_H
+
+#define NET_USE_RTOS
+
+#include "net_conf_template.h"
+
+/* A failed assertion ends the test, instead of the device loop. */
+#include <stdlib.h>
+#undef NET_ASSERT
+#define NET_ASSERT(test,s)  do { if (!(test)) {\
+                                 (void) printf("Assert Failed %s %d : %s\n",__FILE__,__LINE__,(s)); \
+                                 abort(); }\
+                               } while (false)
+
+#endif /* NET_CONF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
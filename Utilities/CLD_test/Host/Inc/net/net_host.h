@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    net_host.h
+  * @author  MCD Application Team
+  * @brief   Host network interface of the network library: BSD sockets driver (Src/net_posix_driver.c)
+  *          and heap counters of the RTOS port (Src/net_os_posix.c).
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef NET_HOST_H
+#define NET_HOST_H
+
+#include "net_connect.h"
+
+/**
+  * @brief  Heap counters of pvPortMalloc() / vPortFree(): NET_MALLOC, NET_CALLOC, NET_FREE, and the mbedTLS
+  *         allocations of the secure sockets.
+  */
+typedef struct
+{
+  size_t Used;               /*!< Bytes allocated and not yet freed */
+  size_t Peak;               /*!< Highest Used, since the benchmark reset it */
+  uint32_t Allocs;           /*!< Allocation count, since the benchmark reset it */
+} net_host_heap_t;
+
+extern net_host_heap_t net_host_heap;
+
+int32_t net_posix_driver(net_if_handle_t *pnetif);
+int32_t net_host_if_up(net_if_handle_t *pnetif);
+void net_host_heap_reset(void);
+
+#endif /* NET_HOST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,31 @@
+/**
+  ******************************************************************************
+  * @file    flash.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the FLASH driver of the projects (flash.c), used by rfu.c: the simulated
+  *          FLASH of Src/sfu_host.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef flash_H
+#define flash_H
+
+#include <stdint.h>
+
+int FLASH_Write(uint32_t uDestination, uint32_t *pSource, uint32_t uLength);
+int FLASH_Erase_Size(uint32_t uStart, uint32_t uLength);
+
+#endif /* flash_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    mapping_export.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the linker symbols of the SBSFU FLASH mapping (32L496GDISCOVERY
+  *          values). The FLASH is simulated at its STM32 address, see sfu_host.h.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef MAPPING_EXPORT_H
+#define MAPPING_EXPORT_H
+
+#define INTVECT_START                 ((uint32_t)0x08000000U)
+#define SE_CODE_REGION_ROM_START      ((uint32_t)0x08000200U)
+#define SE_CODE_REGION_ROM_END        ((uint32_t)0x08009FFFU)
+#define SE_KEY_REGION_ROM_START       ((uint32_t)0x08000300U)
+#define SE_KEY_REGION_ROM_END         ((uint32_t)0x080003FFU)
+#define SB_REGION_ROM_START           ((uint32_t)0x0800A000U)
+#define SB_REGION_ROM_END             ((uint32_t)0x08013FFFU)
+#define SE_REGION_SRAM1_START         ((uint32_t)0x20000000U)
+#define SE_REGION_SRAM1_END           ((uint32_t)0x20000FFFU)
+#define SB_REGION_SRAM1_START         ((uint32_t)0x20001000U)
+#define SB_REGION_SRAM1_END           ((uint32_t)0x2004FFFFU)
+
+#define REGION_SLOT_0_START           ((uint32_t)0x08080800U)
+#define REGION_SLOT_0_END             ((uint32_t)0x080EC7FFU)
+#define REGION_SLOT_1_START           ((uint32_t)0x08014000U)
+#define REGION_SLOT_1_END             ((uint32_t)0x0807FFFFU)
+#define REGION_SWAP_START             ((uint32_t)0x080EC800U)
+#define REGION_SWAP_END               ((uint32_t)0x080F07FFU)
+
+#endif /* MAPPING_EXPORT_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
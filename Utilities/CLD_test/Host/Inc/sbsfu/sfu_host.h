@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file    sfu_host.h
+  * @author  MCD Application Team
+  * @brief   Host run of the SBSFU FW image handling (sfu_fwimg_core.c): simulated FLASH with power cut
+  *          injection, Secure Engine stand-in and boot sequence of the SBSFU state machine.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SFU_HOST_H
+#define SFU_HOST_H
+
+#include <setjmp.h>
+#include "main.h"
+#include "sfu_low_level_flash.h"
+#include "sfu_fwimg_regions.h"
+#include "se_def.h"
+
+/*
+ * The FLASH is mapped at its STM32 address: the FW image handling keeps FLASH addresses in uint32_t.
+ * It behaves as the STM32L4 FLASH: erase by page, a double-word is programmed once after an erase (or with 0s).
+ */
+#define SFU_HOST_FLASH_SIZE   ((uint32_t)0x100000U)
+#define SFU_HOST_FLASH        ((uint8_t *)FLASH_BASE)
+
+/**
+  * @brief  FLASH operation counters of the last boot. Each page erase and each write call is one operation.
+  */
+typedef struct
+{
+  uint32_t Ops;              /*!< FLASH operations */
+  uint32_t PageErases;       /*!< Pages erased */
+  uint32_t ProgrammedBytes;  /*!< Bytes programmed */
+  uint32_t CutOp;            /*!< Operation interrupted by a power cut, 0 for none */
+  uint32_t WatchAddress;     /*!< FLASH address to watch (kept across boots) */
+  uint32_t WatchOp;          /*!< First write operation programming WatchAddress, 0 if none */
+  uint32_t Violations;       /*!< Writes breaking the FLASH constraints (alignment, programming a non erased area),
+                                  since sfu_host_flash_init() */
+} sfu_host_flash_t;
+
+/**
+  * @brief  Outcome of a boot.
+  */
+typedef enum
+{
+  SFU_HOST_BOOT_NO_FW = 0,   /*!< No valid FW, nothing to install: the bootloader waits for a download */
+  SFU_HOST_BOOT_RUN,         /*!< The active FW is verified and launched */
+  SFU_HOST_BOOT_INSTALLED,   /*!< A candidate FW has been installed, the next boot launches it */
+  SFU_HOST_BOOT_RECOVERED,   /*!< An interrupted installation has been recovered */
+  SFU_HOST_BOOT_FAILED,      /*!< The installation or the recovery failed (critical failure, reboot) */
+  SFU_HOST_BOOT_CUT          /*!< The power was cut during the boot */
+} sfu_host_boot_t;
+
+extern sfu_host_flash_t sfu_host_flash;
+
+void sfu_host_flash_init(void);
+sfu_host_boot_t sfu_host_boot(uint32_t CutOp);
+void sfu_host_sign_header(SE_FwRawHeaderTypeDef *pHeader);
+void sfu_host_fw_tag(const uint8_t *pFw, uint32_t Size, uint8_t *pTag);
+void sfu_host_image(const SE_FwRawHeaderTypeDef *pCandidate, const uint8_t *pPayload, uint8_t *pImage);
+void sfu_host_download(const SE_FwRawHeaderTypeDef *pActive, const uint8_t *pActiveFw,
+                       const SE_FwRawHeaderTypeDef *pCandidate, const uint8_t *pPayload);
+int sfu_host_is_active(const SE_FwRawHeaderTypeDef *pHeader, const uint8_t *pFw);
+
+#endif /* SFU_HOST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file    sfu_low_level.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the SBSFU low level services used by the FW image handling.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SFU_LOW_LEVEL_H
+#define SFU_LOW_LEVEL_H
+
+#include "main.h"
+
+/* SFU_IMG_LaunchActiveImg() is built but never called on the host */
+#define __set_MSP(TopOfMainStack) ((void)(TopOfMainStack))
+
+void SFU_LL_SB_SRAM_Erase(void);
+
+#endif /* SFU_LOW_LEVEL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
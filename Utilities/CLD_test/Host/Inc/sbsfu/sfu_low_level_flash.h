@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file    sfu_low_level_flash.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the SBSFU FLASH low level interface (STM32L4 constraints: 2 KB
+  *          pages, double-word programming), implemented by the simulated FLASH of sfu_host.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SFU_LOW_LEVEL_FLASH_H
+#define SFU_LOW_LEVEL_FLASH_H
+
+#include "main.h"
+#include "sfu_def.h"
+
+#ifndef __IO
+#define __IO volatile
+#endif
+
+#define FLASH_BASE       ((uint32_t)0x08000000U)
+#define FLASH_PAGE_SIZE  ((uint32_t)0x800U)
+
+typedef uint64_t SFU_LL_FLASH_write_t;
+
+#if defined(SFU_FWIMG_CORE_C)
+const int8_t SWAPPED[sizeof(SFU_LL_FLASH_write_t)]  = {0, 0, 0, 0, 0, 0, 0, 0};
+const int8_t NOT_SWAPPED[sizeof(SFU_LL_FLASH_write_t)] = {-1, -1, -1, -1, -1, -1, -1, -1};
+
+#define MAGIC_LENGTH ((uint32_t)32U)
+
+const uint8_t MAGIC_NULL[MAGIC_LENGTH]  = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+#endif /* SFU_FWIMG_CORE_C */
+
+typedef enum
+{
+  SFU_FLASH_ERROR = 0U,
+  SFU_FLASH_ERR_HAL,
+  SFU_FLASH_ERR_ERASE,
+  SFU_FLASH_ERR_WRITING,
+  SFU_FLASH_ERR_WRITINGCTRL,
+  SFU_FLASH_SUCCESS
+} SFU_FLASH_StatusTypeDef;
+
+#define IS_ALIGNED(address) (0U == ((address) % FLASH_PAGE_SIZE))
+
+SFU_ErrorStatus SFU_LL_FLASH_Erase_Size(SFU_FLASH_StatusTypeDef *pxFlashStatus, void *pStart, uint32_t Length);
+SFU_ErrorStatus SFU_LL_FLASH_Write(SFU_FLASH_StatusTypeDef *pxFlashStatus, void *pDestination, const void *pSource,
+                                   uint32_t Length);
+SFU_ErrorStatus SFU_LL_FLASH_Read(void *pDestination, const void *pSource, uint32_t Length);
+
+#endif /* SFU_LOW_LEVEL_FLASH_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
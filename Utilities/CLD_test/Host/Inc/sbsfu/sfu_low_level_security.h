@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file    sfu_low_level_security.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the SBSFU security services used by the FW image handling.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SFU_LOW_LEVEL_SECURITY_H
+#define SFU_LOW_LEVEL_SECURITY_H
+
+#include "main.h"
+#include "sfu_fwimg_regions.h"
+#include "sfu_def.h"
+
+#define SFU_PROTECT_WRP_PAGE_END_1    ((uint32_t)((SB_REGION_ROM_END - FLASH_BASE) / FLASH_PAGE_SIZE))
+
+SFU_ErrorStatus SFU_LL_SECU_IWDG_Refresh(void);
+
+#endif /* SFU_LOW_LEVEL_SECURITY_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
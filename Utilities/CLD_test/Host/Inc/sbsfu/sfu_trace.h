@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file    sfu_trace.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in for the SBSFU trace: the traces are dropped.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef SFU_TRACE_H
+#define SFU_TRACE_H
+
+#include <stdint.h>
+#include "app_sfu.h"
+
+extern uint8_t initialDeviceStatusCheck;
+
+#define TRACE(...)
+#define TRACE_IRQ(pbuffer)
+
+#endif /* SFU_TRACE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
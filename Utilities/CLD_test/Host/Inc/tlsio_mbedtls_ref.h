@@ -0,0 +1,30 @@
+/**
+  ******************************************************************************
+  * @file    tlsio_mbedtls_ref.h
+  * @author  MCD Application Team
+  * @brief   TLS IO adapter of the Azure IoT SDK as delivered (Src/tlsio_mbedtls_ref.c): reference of the
+  *          host benchmark of the current receive path.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+#ifndef TLSIO_MBEDTLS_REF_H
+#define TLSIO_MBEDTLS_REF_H
+
+#include "azure_c_shared_utility/xio.h"
+
+const IO_INTERFACE_DESCRIPTION *ref_tlsio_mbedtls_get_interface_description(void);
+
+#endif /* TLSIO_MBEDTLS_REF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
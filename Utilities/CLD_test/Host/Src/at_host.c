@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file    at_host.c
+  * @author  MCD Application Team
+  * @brief   Host stand-ins of the cellular AT service board interface: the SIM selection of the system
+  *          control, and the AT function pointers of the modem API, which the host tests do not call.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "sysctrl.h"
+#include "at_custom_modem_api_bg96.h"
+
+/* Functions Definition ------------------------------------------------------*/
+sysctrl_status_t SysCtrl_sim_select(sysctrl_device_type_t device_type, sysctrl_sim_slot_t sim_slot)
+{
+  UNUSED(device_type);
+  UNUSED(sim_slot);
+  return (SCSTATUS_OK);
+}
+
+void atcma_init_at_func_ptrs(atcustom_funcPtrs_t *funcPtrs)
+{
+  (void) memset(funcPtrs, 0, sizeof(atcustom_funcPtrs_t));
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
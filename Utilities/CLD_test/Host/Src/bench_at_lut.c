@@ -0,0 +1,270 @@
+/**
+  ******************************************************************************
+  * @file    bench_at_lut.c
+  * @author  MCD Application Team
+  * @brief   Host benchmark of the AT command LUT of the cellular AT service (at_modem_common.c) with the
+  *          BG96 LUT (at_custom_modem_specific_bg96.c): the LUT lookups of a BG96 session (boot,
+  *          network attach, socket open, socket send and receive traffic) are replayed with the LUT
+  *          index built at modem init, and with the linear scan of the LUT, which the AT service uses
+  *          when the index is not available.
+  *          For each command sent, the AT service gets its string, build function and timeout by
+  *          command id. For each line received, it searches the command string of the line, then gets
+  *          the analyze function of the command found. The results of both searches are compared.
+  *          Usage: bench_at_lut [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "at_modem_common.h"
+#include "at_modem_signalling.h"
+#include "at_custom_modem_specific_bg96.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+/* Command sent, by id, and line received, without its <CR><LF> */
+#define TX(id)      { (uint32_t) (id), NULL }
+#define RX(line)    { CMD_AT_INVALID, (line) }
+
+/* Socket traffic of the session: one send, and one reception read in two QIRD */
+#define BENCH_SOCKET_EXCHANGE \
+  TX(CMD_AT_QISEND), RX("> "), TX(CMD_AT_QISEND_WRITE_DATA), RX("SEND OK"), \
+  RX("+QIURC: \"recv\",0"), \
+  TX(CMD_AT_QIRD), RX("+QIRD: 1460"), RX("OK"), \
+  TX(CMD_AT_QIRD), RX("+QIRD: 0"), RX("OK")
+
+#define BENCH_SOCKET_EXCHANGE_4 \
+  BENCH_SOCKET_EXCHANGE, BENCH_SOCKET_EXCHANGE, BENCH_SOCKET_EXCHANGE, BENCH_SOCKET_EXCHANGE
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t cmd_id;
+  const char *line;
+} bench_trace_t;
+
+typedef struct
+{
+  const AT_CHAR_t *cmd_str;
+  CmdBuildFuncTypeDef build;
+  uint32_t timeout;
+  at_status_t status;
+  uint32_t cmd_id_received;
+  CmdAnalyzeFuncTypeDef analyze;
+} bench_result_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* BG96 session, as sequenced by the BG96 AT driver. The data of the socket are not searched in the LUT. */
+static const bench_trace_t bench_trace[] =
+{
+  /* boot and modem init */
+  RX("RDY"),
+  TX(CMD_AT), RX("OK"),
+  TX(CMD_ATE), RX("OK"),
+  TX(CMD_ATV), RX("OK"),
+  TX(CMD_AT_CMEE), RX("OK"),
+  TX(CMD_AT_AND_D), RX("OK"),
+  TX(CMD_AT_IFC), RX("OK"),
+  TX(CMD_AT_CGMI), RX("Quectel"), RX("OK"),
+  TX(CMD_AT_CGMM), RX("BG96"), RX("OK"),
+  TX(CMD_AT_CGMR), RX("BG96MAR02A07M1G"), RX("OK"),
+  TX(CMD_AT_CGSN), RX("866425030000000"), RX("OK"),
+  TX(CMD_AT_QCCID), RX("+QCCID: 89882806660000000000"), RX("OK"),
+  TX(CMD_AT_CPIN), RX("+CPIN: READY"), RX("OK"),
+  TX(CMD_AT_CIMI), RX("901288000000000"), RX("OK"),
+  TX(CMD_AT_QCFG), RX("+QCFG: \"nwscanseq\",020103"), RX("OK"),
+  TX(CMD_AT_QCFG), RX("+QCFG: \"iotopmode\",0"), RX("OK"),
+  TX(CMD_AT_QINDCFG), RX("OK"),
+  TX(CMD_AT_CFUN), RX("OK"),
+  RX("+CPIN: READY"), RX("+QUSIM: 1"), RX("+QIND: SMS DONE"),
+
+  /* network attach */
+  TX(CMD_AT_CGDCONT), RX("OK"),
+  TX(CMD_AT_CEREG), RX("OK"),
+  TX(CMD_AT_CREG), RX("OK"),
+  TX(CMD_AT_CGREG), RX("OK"),
+  TX(CMD_AT_COPS), RX("OK"),
+  RX("+CEREG: 2"),
+  TX(CMD_AT_CEREG), RX("+CEREG: 2,2"), RX("OK"),
+  TX(CMD_AT_CEREG), RX("+CEREG: 2,2"), RX("OK"),
+  RX("+CEREG: 5,\"A8D9\",\"1A2D101\",8"),
+  TX(CMD_AT_CEREG), RX("+CEREG: 2,5,\"A8D9\",\"1A2D101\",8"), RX("OK"),
+  TX(CMD_AT_CGATT), RX("+CGATT: 1"), RX("OK"),
+  TX(CMD_AT_COPS), RX("+COPS: 0,0,\"Operator\",8"), RX("OK"),
+  TX(CMD_AT_CSQ), RX("+CSQ: 19,99"), RX("OK"),
+  TX(CMD_AT_QICSGP), RX("OK"),
+  TX(CMD_AT_QIACT), RX("OK"),
+  TX(CMD_AT_CGPADDR), RX("+CGPADDR: 1,10.170.20.5"), RX("OK"),
+
+  /* socket open */
+  TX(CMD_AT_QIDNSGIP), RX("OK"),
+  RX("+QIURC: \"dnsgip\",0,1,600"), RX("+QIURC: \"dnsgip\",\"20.43.43.33\""),
+  TX(CMD_AT_QIOPEN), RX("OK"), RX("+QIOPEN: 0,0"),
+
+  /* socket traffic */
+  BENCH_SOCKET_EXCHANGE_4,
+  TX(CMD_AT_CSQ), RX("+CSQ: 18,99"), RX("OK"),
+  BENCH_SOCKET_EXCHANGE_4,
+  TX(CMD_AT_QISTATE), RX("+QISTATE: 0,\"TCP\",\"20.43.43.33\",8883,50000,2,1,0,0,\"usbmodem\""), RX("OK"),
+  BENCH_SOCKET_EXCHANGE_4,
+
+  /* socket close */
+  TX(CMD_AT_QICLOSE), RX("OK"),
+};
+
+#define BENCH_TRACE_SIZE  (sizeof(bench_trace) / sizeof(bench_trace[0]))
+
+static atparser_context_t bench_atp_ctxt;
+static atcustom_modem_context_t *bench_modem_ctxt;
+static IPC_RxMessage_t bench_msg[BENCH_TRACE_SIZE];
+static at_element_info_t bench_element[BENCH_TRACE_SIZE];
+static bench_result_t bench_indexed[BENCH_TRACE_SIZE];
+static bench_result_t bench_linear[BENCH_TRACE_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+/* Modem context of the BG96 driver, captured at its init: see the link options of bench_at_lut. */
+void __real_atcm_modem_init(atcustom_modem_context_t *p_modem_ctxt);
+void __wrap_atcm_modem_init(atcustom_modem_context_t *p_modem_ctxt);
+
+void __wrap_atcm_modem_init(atcustom_modem_context_t *p_modem_ctxt)
+{
+  bench_modem_ctxt = p_modem_ctxt;
+  __real_atcm_modem_init(p_modem_ctxt);
+}
+
+/**
+  * @brief  Received lines, with their first element as extracted by the BG96 driver: the command up to
+  *         ':' for a response or an URC, the whole line for a final result code or a text line.
+  */
+static void bench_prepare(void)
+{
+  const char *colon;
+  size_t i;
+  size_t len;
+
+  for (i = 0; i < BENCH_TRACE_SIZE; i++)
+  {
+    if (bench_trace[i].line != NULL)
+    {
+      len = strlen(bench_trace[i].line);
+      (void) memcpy(bench_msg[i].buffer, bench_trace[i].line, len);
+      bench_msg[i].size = (uint16_t) len;
+      colon = strchr(bench_trace[i].line, ':');
+      bench_element[i].str_start_idx = 0U;
+      bench_element[i].str_size = (uint16_t) ((colon != NULL) ? (size_t) (colon - bench_trace[i].line) : len);
+      bench_element[i].str_end_idx = (uint16_t) (bench_element[i].str_size - 1U);
+    }
+  }
+}
+
+/**
+  * @brief  LUT lookups of the session.
+  * @retval Number of lookups.
+  */
+static unsigned long bench_replay(bench_result_t *pResult)
+{
+  unsigned long lookups = 0;
+  size_t i;
+
+  for (i = 0; i < BENCH_TRACE_SIZE; i++)
+  {
+    if (bench_trace[i].line == NULL)
+    {
+      pResult[i].cmd_str = atcm_get_CmdStr(bench_modem_ctxt, bench_trace[i].cmd_id);
+      pResult[i].build = atcm_get_CmdBuildFunc(bench_modem_ctxt, bench_trace[i].cmd_id);
+      pResult[i].timeout = atcm_get_CmdTimeout(bench_modem_ctxt, bench_trace[i].cmd_id);
+      lookups += 3U;
+    }
+    else
+    {
+      pResult[i].status = atcm_searchCmdInLUT(bench_modem_ctxt, &bench_atp_ctxt, &bench_msg[i], &bench_element[i]);
+      pResult[i].cmd_id_received = bench_element[i].cmd_id_received;
+      lookups++;
+      if (pResult[i].status == ATSTATUS_OK)
+      {
+        pResult[i].analyze = atcm_get_CmdAnalyzeFunc(bench_modem_ctxt, bench_element[i].cmd_id_received);
+        lookups++;
+      }
+    }
+  }
+  return lookups;
+}
+
+static void bench_run(const char *name, at_bool_t indexed, bench_result_t *pResult, unsigned long iterations)
+{
+  at_bool_t valid = bench_modem_ctxt->LUT_index.valid;
+  unsigned long lookups = 0;
+  unsigned long i;
+  uint64_t start;
+  uint64_t us;
+
+  bench_modem_ctxt->LUT_index.valid = indexed;
+  start = host_test_time_us();
+  for (i = 0; i < iterations; i++)
+  {
+    lookups += bench_replay(pResult);
+  }
+  us = host_test_time_us() - start;
+  bench_modem_ctxt->LUT_index.valid = valid;
+
+  printf("%-8s %8lu sessions %10lu lookups %10.1f ns/lookup %10.2f us/session\n", name, iterations, lookups,
+         (lookups == 0U) ? 0.0 : ((double) us * 1000.0 / (double) lookups),
+         (iterations == 0U) ? 0.0 : ((double) us / (double) iterations));
+}
+
+/* Functions Definition ------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 20000);
+  unsigned long found = 0;
+  unsigned long missed = 0;
+  size_t i;
+
+  ATCustom_BG96_init(&bench_atp_ctxt);
+  HOST_TEST_CHECK(bench_modem_ctxt != NULL);
+  if (bench_modem_ctxt == NULL)
+  {
+    return HOST_TEST_RESULT();
+  }
+  HOST_TEST_CHECK(bench_modem_ctxt->LUT_index.valid == AT_TRUE);
+  bench_prepare();
+
+  printf("BG96 LUT: %lu commands, session of %lu lines\n", (unsigned long) bench_modem_ctxt->modem_LUT_size,
+         (unsigned long) BENCH_TRACE_SIZE);
+  bench_run("linear", AT_FALSE, bench_linear, iterations);
+  bench_run("indexed", AT_TRUE, bench_indexed, iterations);
+
+  /* Same commands, functions and timeouts found by both */
+  for (i = 0; i < BENCH_TRACE_SIZE; i++)
+  {
+    HOST_TEST_CHECK(memcmp(&bench_indexed[i], &bench_linear[i], sizeof(bench_result_t)) == 0);
+    if (bench_trace[i].line == NULL)
+    {
+      HOST_TEST_CHECK(bench_indexed[i].cmd_str != NULL);
+    }
+    else if (bench_indexed[i].status == ATSTATUS_OK)
+    {
+      found++;
+    }
+    else
+    {
+      missed++;
+    }
+  }
+  printf("received lines: %lu commands found in the LUT, %lu text lines\n", found, missed);
+  HOST_TEST_CHECK(missed == 5U);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,323 @@
+/**
+  ******************************************************************************
+  * @file    bench_http.c
+  * @author  MCD Application Team
+  * @brief   Host benchmark of the firmware download, over the network library on the host interface
+  *          driver. A loopback HTTP/1.1 server serves an SBSFU image (.sfb):
+  *          - http_lib downloads it in "Range:" requests, with and without request pipelining, and the
+  *            received body is checked;
+  *          - rfu_update() downloads it over HTTP and HTTPS into the simulated FLASH, as the firmware
+  *            update of the applications, and the next boots of SBSFU install and launch it.
+  *          Usage: bench_http [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "net_connect.h"
+#include "net_host.h"
+#include "http_lib.h"
+#include "rfu.h"
+#include "sfu_host.h"
+#include "host_server.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_RESOURCE          "/firmware.sfb"
+#define BENCH_FW_SIZE           (128U * 1024U)
+#define BENCH_RESOURCE_SIZE     (SFU_IMG_IMAGE_OFFSET + BENCH_FW_SIZE)
+#define BENCH_REQUEST_MAX       1024U
+#define BENCH_PIPELINE_MAX      4U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const uint8_t *expected;
+  uint32_t offset;
+  bool match;
+} bench_body_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t resource[BENCH_RESOURCE_SIZE];
+static uint8_t active_fw[BENCH_FW_SIZE];
+static uint8_t new_fw[BENCH_FW_SIZE];
+static SE_FwRawHeaderTypeDef active_header;
+static SE_FwRawHeaderTypeDef new_header;
+static net_if_handle_t netif;
+static const uint32_t bench_ranges[] = { 1024, 2048, 16384 };
+static const uint32_t bench_depths[] = { 1, BENCH_PIPELINE_MAX };
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Answers one request header block: 206 with the requested range, 200 without range.
+  */
+static int bench_serve_request(host_server_conn_t *pConn, const char *request)
+{
+  char header[256];
+  const char *range = strstr(request, "Range: bytes=");
+  unsigned long start = 0;
+  unsigned long end = BENCH_RESOURCE_SIZE - 1U;
+  int len;
+
+  if (strncmp(request, "GET " BENCH_RESOURCE " ", sizeof("GET " BENCH_RESOURCE " ") - 1U) != 0)
+  {
+    len = snprintf(header, sizeof(header), "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+    return host_server_send(pConn, header, (size_t) len);
+  }
+  if (range != NULL)
+  {
+    if ((sscanf(range, "Range: bytes=%lu-%lu", &start, &end) != 2) || (start > end)
+        || (start >= BENCH_RESOURCE_SIZE))
+    {
+      return -1;
+    }
+    end = (end < BENCH_RESOURCE_SIZE) ? end : (BENCH_RESOURCE_SIZE - 1U);
+    len = snprintf(header, sizeof(header), "HTTP/1.1 206 Partial Content\r\n"
+                   "Content-Range: bytes %lu-%lu/%lu\r\nContent-Length: %lu\r\n\r\n",
+                   start, end, (unsigned long) BENCH_RESOURCE_SIZE, end - start + 1U);
+  }
+  else
+  {
+    len = snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Length: %lu\r\n\r\n",
+                   (unsigned long) BENCH_RESOURCE_SIZE);
+  }
+  if (host_server_send(pConn, header, (size_t) len) != 0)
+  {
+    return -1;
+  }
+  return host_server_send(pConn, &resource[start], end - start + 1U);
+}
+
+/**
+  * @brief  Server connection: any number of (pipelined) requests.
+  */
+static void bench_server(host_server_conn_t *pConn, void *pArg)
+{
+  char request[BENCH_REQUEST_MAX + 1U];
+  size_t len = 0;
+  char *end;
+  int n;
+
+  (void) pArg;
+  for (;;)
+  {
+    n = host_server_recv(pConn, (uint8_t *) &request[len], BENCH_REQUEST_MAX - len);
+    if (n <= 0)
+    {
+      break;
+    }
+    len += (size_t) n;
+    request[len] = '\0';
+    while ((end = strstr(request, "\r\n\r\n")) != NULL)
+    {
+      end += 4;
+      *(end - 1) = '\0';
+      if (bench_serve_request(pConn, request) != 0)
+      {
+        return;
+      }
+      len -= (size_t) (end - request);
+      memmove(request, end, len + 1U);
+    }
+    if (len >= BENCH_REQUEST_MAX)
+    {
+      break;
+    }
+  }
+}
+
+static int bench_on_body(http_parser_t *parser, const uint8_t *data, uint32_t length)
+{
+  bench_body_t *body = parser->body_ctx;
+
+  if ((body->offset + length > BENCH_RESOURCE_SIZE) || (memcmp(&body->expected[body->offset], data, length) != 0))
+  {
+    body->match = false;
+    return -1;
+  }
+  body->offset += length;
+  return 0;
+}
+
+/**
+  * @brief  Downloads the resource with requests of range bytes, keeping up to depth requests in flight.
+  * @retval Number of downloaded bytes.
+  */
+static uint32_t bench_download(uint16_t port, uint32_t range, uint32_t depth)
+{
+  char range_header[64];
+  http_handle_t hnd = NULL;
+  http_parser_t parser;
+  bench_body_t body = { resource, 0, true };
+  uint32_t requested = 0;
+  uint32_t in_flight = 0;
+  uint32_t remaining;
+  int rc;
+
+  rc = http_create_session(&hnd, HOST_SERVER_NAME, port, HTTP_PROTO_HTTP);
+  if (rc == HTTP_OK)
+  {
+    rc = http_connect(hnd);
+  }
+  while ((rc == HTTP_OK) && (body.offset < BENCH_RESOURCE_SIZE))
+  {
+    while ((rc == HTTP_OK) && (in_flight < depth) && (requested < BENCH_RESOURCE_SIZE))
+    {
+      remaining = BENCH_RESOURCE_SIZE - requested;
+      remaining = (remaining > range) ? range : remaining;
+      (void) snprintf(range_header, sizeof(range_header), "Range: bytes=%lu-%lu\r\n",
+                      (unsigned long) requested, (unsigned long) (requested + remaining - 1U));
+      rc = http_send_get(hnd, BENCH_RESOURCE, range_header);
+      if (rc == HTTP_OK)
+      {
+        requested += remaining;
+        in_flight++;
+      }
+    }
+    if (rc == HTTP_OK)
+    {
+      http_parser_init(&parser, bench_on_body, &body);
+      rc = http_recv_get_response_stream(hnd, &parser);
+      in_flight--;
+      HOST_TEST_CHECK(parser.status == 206);
+      HOST_TEST_CHECK(parser.resource_size == BENCH_RESOURCE_SIZE);
+    }
+  }
+  HOST_TEST_CHECK(rc == HTTP_OK);
+  HOST_TEST_CHECK(body.match);
+  HOST_TEST_CHECK(in_flight == 0U);
+  if (hnd != NULL)
+  {
+    (void) http_close(hnd);
+  }
+  return body.offset;
+}
+
+static void bench_header(SE_FwRawHeaderTypeDef *header, uint16_t version, uint8_t *fw)
+{
+  uint32_t i;
+
+  for (i = 0; i < BENCH_FW_SIZE; i++)
+  {
+    fw[i] = (uint8_t) ((i >> 8) ^ (i * 13U) ^ version);
+  }
+  memset(header, 0, sizeof(*header));
+  header->SFUMagic = 0x4D554653U; /* 'SFUM' */
+  header->ProtocolVersion = 0x1U;
+  for (i = 0; i < sizeof(header->InitVector); i++)
+  {
+    header->InitVector[i] = (uint8_t) (i * version);
+  }
+  header->FwVersion = version;
+  header->FwSize = BENCH_FW_SIZE;
+  sfu_host_fw_tag(fw, BENCH_FW_SIZE, header->FwTag);
+  sfu_host_sign_header(header);
+}
+
+/**
+  * @brief  Firmware update: download by rfu_update() into the FLASH of a device running the active FW,
+  *         then installation and launch of the new FW by SBSFU.
+  * @retval Duration of the download, in us.
+  */
+static uint64_t bench_update(const char *url, const char *ca_cert)
+{
+  uint64_t us;
+
+  sfu_host_download(&active_header, active_fw, NULL, NULL);
+  us = host_test_time_us();
+  HOST_TEST_CHECK(rfu_update(url, ca_cert) == RFU_OK);
+  us = host_test_time_us() - us;
+  HOST_TEST_CHECK(memcmp(SFU_IMG_SLOT_DWL_REGION_BEGIN, resource, BENCH_RESOURCE_SIZE) == 0);
+  HOST_TEST_CHECK(sfu_host_boot(0U) == SFU_HOST_BOOT_INSTALLED);
+  HOST_TEST_CHECK(sfu_host_boot(0U) == SFU_HOST_BOOT_RUN);
+  HOST_TEST_CHECK(sfu_host_is_active(&new_header, new_fw) != 0);
+  return us;
+}
+
+/* Functions Definition ------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 20);
+  host_server_t http_server;
+  host_server_t https_server;
+  const char *ca_cert;
+  char url[64];
+  unsigned long i;
+  uint64_t start;
+  uint64_t total;
+  size_t r;
+  size_t d;
+
+  sfu_host_flash_init();
+  bench_header(&active_header, 1U, active_fw);
+  bench_header(&new_header, 2U, new_fw);
+  sfu_host_image(&new_header, new_fw, resource);
+
+  ca_cert = host_server_ca_cert();
+  if ((ca_cert == NULL) || (host_server_start(&http_server, 0U, false, bench_server, NULL) != 0)
+      || (host_server_start(&https_server, 0U, true, bench_server, NULL) != 0))
+  {
+    printf("cannot start the HTTP servers\n");
+    return 1;
+  }
+  HOST_TEST_CHECK(net_host_if_up(&netif) == NET_OK);
+
+  printf("%8s %8s %10s %10s\n", "range", "depth", "downloads", "MB/s");
+  for (r = 0; r < (sizeof(bench_ranges) / sizeof(bench_ranges[0])); r++)
+  {
+    for (d = 0; d < (sizeof(bench_depths) / sizeof(bench_depths[0])); d++)
+    {
+      total = 0;
+      start = host_test_time_us();
+      for (i = 0; i < iterations; i++)
+      {
+        total += bench_download(http_server.Port, bench_ranges[r], bench_depths[d]);
+      }
+      HOST_TEST_CHECK(total == (uint64_t) BENCH_RESOURCE_SIZE * iterations);
+      printf("%8lu %8lu %10lu %10.1f\n", (unsigned long) bench_ranges[r], (unsigned long) bench_depths[d],
+             iterations, host_test_mbps(total, host_test_time_us() - start));
+    }
+  }
+
+  /* Firmware update of the applications, into the simulated FLASH. */
+  (void) snprintf(url, sizeof(url), "http://%s:%u%s", HOST_SERVER_NAME, (unsigned int) http_server.Port,
+                  BENCH_RESOURCE);
+  total = 0;
+  for (i = 0; i < iterations; i++)
+  {
+    total += bench_update(url, NULL);
+  }
+  printf("rfu_update http  %10lu updates %10.1f MB/s\n", iterations,
+         host_test_mbps((uint64_t) BENCH_RESOURCE_SIZE * iterations, total));
+
+  (void) snprintf(url, sizeof(url), "https://%s:%u%s", HOST_SERVER_NAME, (unsigned int) https_server.Port,
+                  BENCH_RESOURCE);
+  total = 0;
+  for (i = 0; i < iterations; i++)
+  {
+    total += bench_update(url, ca_cert);
+  }
+  printf("rfu_update https %10lu updates %10.1f MB/s\n", iterations,
+         host_test_mbps((uint64_t) BENCH_RESOURCE_SIZE * iterations, total));
+  HOST_TEST_CHECK(sfu_host_flash.Violations == 0U);
+
+  HOST_TEST_CHECK(net_if_disconnect(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_stop(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_deinit(&netif) == NET_OK);
+  host_server_stop(&https_server);
+  host_server_stop(&http_server);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
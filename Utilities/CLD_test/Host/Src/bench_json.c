@@ -0,0 +1,197 @@
+/**
+  ******************************************************************************
+  * @file    bench_json.c
+  * @author  MCD Application Team
+  * @brief   Host benchmark of the telemetry JSON encoding: a message with the fields of the
+  *          sample application is encoded with the serializer (SERIALIZE) and with parson,
+  *          and both outputs are parsed back and checked.
+  *          Usage: bench_json [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "serializer.h"
+#include "parson.h"
+#include "host_test.h"
+
+/* Private typedef -----------------------------------------------------------*/
+BEGIN_NAMESPACE(BenchThing);
+
+DECLARE_MODEL(BenchDev_t,
+  WITH_DATA(ascii_char_ptr, mac),
+  WITH_DATA(float, temperature),
+  WITH_DATA(float, humidity),
+  WITH_DATA(float, pressure),
+  WITH_DATA(int, proximity),
+  WITH_DATA(float, accelerometerX),
+  WITH_DATA(float, accelerometerY),
+  WITH_DATA(float, accelerometerZ),
+  WITH_DATA(float, gyroscopeX),
+  WITH_DATA(float, gyroscopeY),
+  WITH_DATA(float, gyroscopeZ),
+  WITH_DATA(float, magnetometerX),
+  WITH_DATA(float, magnetometerY),
+  WITH_DATA(float, magnetometerZ),
+  WITH_DATA(EDM_DATE_TIME_OFFSET, ts)
+);
+
+END_NAMESPACE(BenchThing);
+
+/* Private functions ---------------------------------------------------------*/
+static void bench_sample(BenchDev_t *mdl, unsigned long i)
+{
+  time_t t = (time_t) (1600000000UL + i);
+
+  mdl->temperature = 20.0f + (float) (i % 100) / 10.0f;
+  mdl->humidity = 40.0f + (float) (i % 50);
+  mdl->pressure = 1013.25f - (float) (i % 30);
+  mdl->proximity = (int) (i % 2000);
+  mdl->accelerometerX = (float) (i % 17) - 8.0f;
+  mdl->accelerometerY = (float) (i % 13) - 6.0f;
+  mdl->accelerometerZ = 1000.0f + (float) (i % 7);
+  mdl->gyroscopeX = (float) (i % 1000) / 3.0f;
+  mdl->gyroscopeY = -(float) (i % 1000) / 7.0f;
+  mdl->gyroscopeZ = 0.5f;
+  mdl->magnetometerX = (float) (i % 300);
+  mdl->magnetometerY = -(float) (i % 200);
+  mdl->magnetometerZ = (float) (i % 100) * 1.5f;
+  (void) memset(&mdl->ts, 0, sizeof(mdl->ts));
+  mdl->ts.dateTime = *gmtime(&t);
+}
+
+static char *bench_parson(const BenchDev_t *mdl)
+{
+  JSON_Value *root = json_value_init_object();
+  JSON_Object *obj = json_value_get_object(root);
+  char ts[32];
+  char *json;
+
+  (void) strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%SZ", &mdl->ts.dateTime);
+  (void) json_object_set_string(obj, "mac", mdl->mac);
+  (void) json_object_set_number(obj, "temperature", mdl->temperature);
+  (void) json_object_set_number(obj, "humidity", mdl->humidity);
+  (void) json_object_set_number(obj, "pressure", mdl->pressure);
+  (void) json_object_set_number(obj, "proximity", mdl->proximity);
+  (void) json_object_set_number(obj, "accelerometerX", mdl->accelerometerX);
+  (void) json_object_set_number(obj, "accelerometerY", mdl->accelerometerY);
+  (void) json_object_set_number(obj, "accelerometerZ", mdl->accelerometerZ);
+  (void) json_object_set_number(obj, "gyroscopeX", mdl->gyroscopeX);
+  (void) json_object_set_number(obj, "gyroscopeY", mdl->gyroscopeY);
+  (void) json_object_set_number(obj, "gyroscopeZ", mdl->gyroscopeZ);
+  (void) json_object_set_number(obj, "magnetometerX", mdl->magnetometerX);
+  (void) json_object_set_number(obj, "magnetometerY", mdl->magnetometerY);
+  (void) json_object_set_number(obj, "magnetometerZ", mdl->magnetometerZ);
+  (void) json_object_set_string(obj, "ts", ts);
+  json = json_serialize_to_string(root);
+  json_value_free(root);
+  return json;
+}
+
+/* Both encoders must give the same message content. */
+static void bench_check(const BenchDev_t *mdl, const char *json, size_t len)
+{
+  char *copy = malloc(len + 1U);
+  JSON_Value *root;
+  JSON_Object *obj;
+
+  if (copy == NULL)
+  {
+    HOST_TEST_CHECK(copy != NULL);
+    return;
+  }
+  memcpy(copy, json, len);
+  copy[len] = '\0';
+  root = json_parse_string(copy);
+  obj = json_value_get_object(root);
+  HOST_TEST_CHECK(obj != NULL);
+  if (obj != NULL)
+  {
+    HOST_TEST_CHECK(json_object_get_count(obj) == 15U);
+    HOST_TEST_CHECK(strcmp(json_object_get_string(obj, "mac"), mdl->mac) == 0);
+    HOST_TEST_CHECK((float) json_object_get_number(obj, "temperature") == mdl->temperature);
+    HOST_TEST_CHECK((int) json_object_get_number(obj, "proximity") == mdl->proximity);
+    HOST_TEST_CHECK((float) json_object_get_number(obj, "gyroscopeY") == mdl->gyroscopeY);
+    HOST_TEST_CHECK((float) json_object_get_number(obj, "magnetometerZ") == mdl->magnetometerZ);
+  }
+  json_value_free(root);
+  free(copy);
+}
+
+/* Functions Definition ------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 100000);
+  BenchDev_t *mdl;
+  unsigned char *data;
+  size_t size;
+  char *json;
+  uint64_t serialize_us = 0;
+  uint64_t parson_us = 0;
+  uint64_t start;
+  unsigned long i;
+
+  HOST_TEST_CHECK(serializer_init(NULL) == SERIALIZER_OK);
+  mdl = CREATE_MODEL_INSTANCE(BenchThing, BenchDev_t);
+  HOST_TEST_CHECK(mdl != NULL);
+  if (mdl == NULL)
+  {
+    return HOST_TEST_RESULT();
+  }
+  mdl->mac = "00:80:e1:01:02:03";
+
+  for (i = 0; i < iterations; i++)
+  {
+    bench_sample(mdl, i);
+
+    start = host_test_time_us();
+    data = NULL;
+    HOST_TEST_CHECK(SERIALIZE(&data, &size, mdl->mac, mdl->temperature, mdl->humidity, mdl->pressure, mdl->proximity,
+                              mdl->accelerometerX, mdl->accelerometerY, mdl->accelerometerZ,
+                              mdl->gyroscopeX, mdl->gyroscopeY, mdl->gyroscopeZ,
+                              mdl->magnetometerX, mdl->magnetometerY, mdl->magnetometerZ, mdl->ts) == CODEFIRST_OK);
+    serialize_us += host_test_time_us() - start;
+
+    start = host_test_time_us();
+    json = bench_parson(mdl);
+    parson_us += host_test_time_us() - start;
+    HOST_TEST_CHECK(json != NULL);
+
+    /* Checking every message would dominate the measure. */
+    if ((i % 1000U) == 0U)
+    {
+      if (data != NULL)
+      {
+        bench_check(mdl, (const char *) data, size);
+      }
+      if (json != NULL)
+      {
+        bench_check(mdl, json, strlen(json));
+      }
+    }
+    free(data);
+    json_free_serialized_string(json);
+  }
+
+  printf("%-10s %8lu messages %8.2f us/message\n", "SERIALIZE", iterations,
+         (iterations == 0U) ? 0.0 : ((double) serialize_us / (double) iterations));
+  printf("%-10s %8lu messages %8.2f us/message\n", "parson", iterations,
+         (iterations == 0U) ? 0.0 : ((double) parson_us / (double) iterations));
+
+  DESTROY_MODEL_INSTANCE(mdl);
+  serializer_deinit();
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,418 @@
+/**
+  ******************************************************************************
+  * @file    bench_mqtt.c
+  * @author  MCD Application Team
+  * @brief   Host benchmark of the MQTT codec: PUBLISH packets of 1 byte to 64 Kbytes are encoded,
+  *          and the stream is decoded back in TCP segment sized reads by the decoder as delivered
+  *          (Src/mqtt_codec_ref.c) and by the current one, with the buffer and with the span packet
+  *          callbacks. Each decoded packet is checked.
+  *          Then the device to cloud throughput of the IoT Hub device client (IoTHubClient_LL, MQTT
+  *          transport, tlsio_mbedtls over the network library) is measured against a loopback mock
+  *          hub, which acknowledges the connection and each QoS 1 PUBLISH. The MQTT transport
+  *          connects to port 8883: the mock hub listens on 127.0.0.1:8883.
+  *          Usage: bench_mqtt [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/platform.h"
+#include "azure_c_shared_utility/shared_util_options.h"
+#include "iothub_client_ll.h"
+#include "iothub_client_options.h"
+#include "iothubtransportmqtt.h"
+#include "net_connect.h"
+#include "net_host.h"
+#include "mqtt_codec_ref.h"
+#include "host_server.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_TOPIC             "devices/bench/messages/events/"
+#define BENCH_PACKET_ID         0x1234
+#define BENCH_SEGMENT_SIZE      1460
+#define BENCH_PAYLOAD_MAX       65536
+
+#define BENCH_HUB_PORT          8883U
+#define BENCH_HUB_PACKET_MAX    16384U
+#define BENCH_HUB_TIMEOUT_US    10000000U
+/* The transport connects to the gateway host, the name of the certificate of the mock hub. */
+#define BENCH_CONNECTION_STRING "HostName=bench.azure-devices.net;DeviceId=bench;" \
+                                "SharedAccessKey=AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=;" \
+                                "GatewayHostName=" HOST_SERVER_NAME
+
+/* Private typedef -----------------------------------------------------------*/
+typedef int (*bench_decoder_t)(MQTTCODEC_HANDLE handle, const unsigned char *buffer, size_t size);
+
+typedef struct
+{
+  size_t payload_size;
+  unsigned long packets;
+} bench_rx_t;
+
+typedef struct
+{
+  unsigned long confirmed;
+  unsigned long failed;
+} bench_d2c_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const size_t bench_sizes[] = { 1, 16, 128, 1024, 2048, 16384, BENCH_PAYLOAD_MAX };
+static const size_t bench_d2c_sizes[] = { 16, 256, 4096 };
+static const size_t bench_d2c_windows[] = { 1, 0 };   /* Messages in flight, 0 for no limit */
+static net_if_handle_t netif;
+static uint8_t payload[BENCH_PAYLOAD_MAX];
+
+/* Private functions ---------------------------------------------------------*/
+/* Variable header and payload of a QoS 1 PUBLISH: topic, packet identifier, payload. */
+static void bench_check_publish(bench_rx_t *rx, CONTROL_PACKET_TYPE packet, int flags, const uint8_t *data, size_t length)
+{
+  const size_t topic_len = sizeof(BENCH_TOPIC) - 1U;
+
+  HOST_TEST_CHECK(packet == PUBLISH_TYPE);
+  HOST_TEST_CHECK((flags & 0x06) == (DELIVER_AT_LEAST_ONCE << 1));
+  HOST_TEST_CHECK(length == 2U + topic_len + 2U + rx->payload_size);
+  if (length == 2U + topic_len + 2U + rx->payload_size)
+  {
+    HOST_TEST_CHECK(((size_t) data[0] << 8 | data[1]) == topic_len);
+    HOST_TEST_CHECK(memcmp(&data[2], BENCH_TOPIC, topic_len) == 0);
+    HOST_TEST_CHECK(((unsigned) data[2 + topic_len] << 8 | data[3 + topic_len]) == BENCH_PACKET_ID);
+    HOST_TEST_CHECK(memcmp(&data[4 + topic_len], payload, rx->payload_size) == 0);
+  }
+  rx->packets++;
+}
+
+static void bench_on_packet(void *context, CONTROL_PACKET_TYPE packet, int flags, BUFFER_HANDLE headerData)
+{
+  bench_check_publish(context, packet, flags, BUFFER_u_char(headerData), BUFFER_length(headerData));
+}
+
+static void bench_on_packet_span(void *context, CONTROL_PACKET_TYPE packet, int flags, const uint8_t *data, size_t length)
+{
+  bench_check_publish(context, packet, flags, data, length);
+}
+
+static uint64_t bench_decode(bench_decoder_t decoder, MQTTCODEC_HANDLE codec, const uint8_t *stream, size_t stream_len)
+{
+  uint64_t start = host_test_time_us();
+  size_t offset;
+  size_t n;
+
+  for (offset = 0; offset < stream_len; offset += n)
+  {
+    n = stream_len - offset;
+    n = (n < BENCH_SEGMENT_SIZE) ? n : BENCH_SEGMENT_SIZE;
+    HOST_TEST_CHECK(decoder(codec, &stream[offset], n) == 0);
+  }
+  return host_test_time_us() - start;
+}
+
+/**
+  * @brief  Mock hub connection: CONNACK, SUBACK and PUBACK (QoS 1) for the client packets, PINGRESP for
+  *         its pings, until it disconnects.
+  */
+static void bench_hub(host_server_conn_t *pConn, void *pArg)
+{
+  static uint8_t packet[BENCH_HUB_PACKET_MAX];
+  uint8_t reply[2U + 2U + 16U];
+  size_t len = 0;
+  size_t header;
+  size_t remaining;
+  size_t reply_len;
+  size_t topic_len;
+  size_t i;
+  uint32_t shift;
+  int n;
+
+  (void) pArg;
+  for (;;)
+  {
+    n = host_server_recv(pConn, &packet[len], sizeof(packet) - len);
+    if (n <= 0)
+    {
+      return;
+    }
+    len += (size_t) n;
+    for (;;)
+    {
+      /* Fixed header: type and flags, remaining length. */
+      remaining = 0;
+      shift = 0;
+      for (header = 1U; (header < len) && (header <= 4U); header++)
+      {
+        remaining |= (size_t) (packet[header] & 0x7FU) << shift;
+        shift += 7U;
+        if ((packet[header] & 0x80U) == 0U)
+        {
+          break;
+        }
+      }
+      if ((header >= len) || ((header + 1U + remaining) > len))
+      {
+        if ((header > 4U) || ((header + 1U + remaining) > sizeof(packet)))
+        {
+          return;
+        }
+        break;
+      }
+      header++;
+      reply_len = 0;
+      switch (packet[0] & 0xF0U)
+      {
+        case 0x10U: /* CONNECT */
+          reply[0] = 0x20U;
+          reply[1] = 2U;
+          reply[2] = 0U;
+          reply[3] = 0U;
+          reply_len = 4U;
+          break;
+        case 0x30U: /* PUBLISH */
+          topic_len = ((size_t) packet[header] << 8) | packet[header + 1U];
+          if ((packet[0] & 0x06U) != 0U)
+          {
+            reply[0] = 0x40U;
+            reply[1] = 2U;
+            reply[2] = packet[header + 2U + topic_len];
+            reply[3] = packet[header + 3U + topic_len];
+            reply_len = 4U;
+          }
+          break;
+        case 0x80U: /* SUBSCRIBE: each topic filter is granted its QoS */
+          reply[0] = 0x90U;
+          reply[2] = packet[header];
+          reply[3] = packet[header + 1U];
+          reply_len = 4U;
+          for (i = 2U; (i < remaining) && (reply_len < sizeof(reply)); i += 2U + topic_len + 1U)
+          {
+            topic_len = ((size_t) packet[header + i] << 8) | packet[header + i + 1U];
+            reply[reply_len++] = packet[header + i + 2U + topic_len];
+          }
+          reply[1] = (uint8_t) (reply_len - 2U);
+          break;
+        case 0xC0U: /* PINGREQ */
+          reply[0] = 0xD0U;
+          reply[1] = 0U;
+          reply_len = 2U;
+          break;
+        case 0xE0U: /* DISCONNECT */
+          return;
+        default:
+          break;
+      }
+      if ((reply_len > 0U) && (host_server_send(pConn, reply, reply_len) != 0))
+      {
+        return;
+      }
+      len -= header + remaining;
+      memmove(packet, &packet[header + remaining], len);
+    }
+  }
+}
+
+static void bench_on_confirm(IOTHUB_CLIENT_CONFIRMATION_RESULT result, void *context)
+{
+  bench_d2c_t *d2c = context;
+
+  if (result == IOTHUB_CLIENT_CONFIRMATION_OK)
+  {
+    d2c->confirmed++;
+  }
+  else
+  {
+    d2c->failed++;
+  }
+}
+
+/**
+  * @brief  Send count messages, and run the client until they are all acknowledged by the hub.
+  * @retval Duration, in us.
+  */
+static uint64_t bench_d2c(IOTHUB_CLIENT_LL_HANDLE client, size_t size, unsigned long count)
+{
+  bench_d2c_t d2c = { 0, 0 };
+  IOTHUB_MESSAGE_HANDLE message;
+  uint64_t start = host_test_time_us();
+  uint64_t us = 0;
+  unsigned long i;
+
+  for (i = 0; i < count; i++)
+  {
+    message = IoTHubMessage_CreateFromByteArray(payload, size);
+    HOST_TEST_CHECK(message != NULL);
+    HOST_TEST_CHECK(IoTHubClient_LL_SendEventAsync(client, message, bench_on_confirm, &d2c) == IOTHUB_CLIENT_OK);
+    IoTHubMessage_Destroy(message);
+  }
+  while (((d2c.confirmed + d2c.failed) < count) && (us < BENCH_HUB_TIMEOUT_US))
+  {
+    IoTHubClient_LL_DoWork(client);
+    us = host_test_time_us() - start;
+  }
+  HOST_TEST_CHECK(d2c.confirmed == count);
+  return us;
+}
+
+/**
+  * @brief  Device to cloud throughput, for each message size and in-flight window.
+  */
+static void bench_iothub(unsigned long iterations)
+{
+  IOTHUB_CLIENT_LL_HANDLE client;
+  host_server_t hub;
+  const char *ca_cert;
+  uint64_t us;
+  size_t s;
+  size_t w;
+
+  ca_cert = host_server_ca_cert();
+  if ((ca_cert == NULL) || (host_server_start(&hub, BENCH_HUB_PORT, true, bench_hub, NULL) != 0))
+  {
+    printf("cannot start the mock hub\n");
+    HOST_TEST_CHECK(0);
+    return;
+  }
+  HOST_TEST_CHECK(net_host_if_up(&netif) == NET_OK);
+  client = IoTHubClient_LL_CreateFromConnectionString(BENCH_CONNECTION_STRING, MQTT_Protocol);
+  HOST_TEST_CHECK(client != NULL);
+  if (client != NULL)
+  {
+    HOST_TEST_CHECK(IoTHubClient_LL_SetOption(client, OPTION_TRUSTED_CERT, ca_cert) == IOTHUB_CLIENT_OK);
+    /* The connection is set up by the first message. */
+    (void) bench_d2c(client, bench_d2c_sizes[0], 1U);
+
+    printf("\n%8s %8s %8s %12s %12s\n", "message", "window", "messages", "messages/s", "MB/s");
+    for (s = 0; s < (sizeof(bench_d2c_sizes) / sizeof(bench_d2c_sizes[0])); s++)
+    {
+      for (w = 0; w < (sizeof(bench_d2c_windows) / sizeof(bench_d2c_windows[0])); w++)
+      {
+        HOST_TEST_CHECK(IoTHubClient_LL_SetOption(client, OPTION_MAX_INFLIGHT_MESSAGES, &bench_d2c_windows[w])
+                        == IOTHUB_CLIENT_OK);
+        us = bench_d2c(client, bench_d2c_sizes[s], iterations);
+        printf("%8lu %8lu %8lu %12.0f %12.2f\n", (unsigned long) bench_d2c_sizes[s],
+               (unsigned long) bench_d2c_windows[w], iterations,
+               (us == 0U) ? 0.0 : ((double) iterations * 1000000.0 / (double) us),
+               host_test_mbps((uint64_t) bench_d2c_sizes[s] * iterations, us));
+      }
+    }
+    IoTHubClient_LL_Destroy(client);
+  }
+  HOST_TEST_CHECK(net_if_disconnect(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_stop(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_deinit(&netif) == NET_OK);
+  host_server_stop(&hub);
+}
+
+/* Functions Definition ------------------------------------------------------*/
+/* Platform of the IoT Hub client: initialized by the application (cloud.c) on the device. */
+int platform_init(void)
+{
+  return 0;
+}
+
+void platform_deinit(void)
+{
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 1000);
+  unsigned long count;
+  unsigned long i;
+  size_t s;
+  size_t j;
+
+  for (j = 0; j < sizeof(payload); j++)
+  {
+    payload[j] = (uint8_t) (j * 7U + 3U);
+  }
+
+  printf("%8s %8s %12s %12s %12s %12s\n", "payload", "packets", "encode MB/s", "ref MB/s", "buffer MB/s",
+         "span MB/s");
+  for (s = 0; s < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); s++)
+  {
+    bench_rx_t rx = { bench_sizes[s], 0 };
+    MQTTCODEC_HANDLE codec;
+    BUFFER_HANDLE packet;
+    uint8_t *stream = NULL;
+    size_t stream_len = 0;
+    size_t packet_len;
+    uint64_t encode_us = 0;
+    uint64_t ref_us;
+    uint64_t buffer_us;
+    uint64_t span_us;
+    uint64_t start;
+
+    /* Large payloads take fewer iterations, for a similar amount of data. */
+    count = iterations / (1U + (unsigned long) (bench_sizes[s] / 1024U));
+    count = (count == 0U) ? 1U : count;
+
+    for (i = 0; i < count; i++)
+    {
+      start = host_test_time_us();
+      packet = mqtt_codec_publish(DELIVER_AT_LEAST_ONCE, false, false, BENCH_PACKET_ID, BENCH_TOPIC, payload, bench_sizes[s], NULL);
+      encode_us += host_test_time_us() - start;
+      HOST_TEST_CHECK(packet != NULL);
+      if (packet == NULL)
+      {
+        break;
+      }
+      packet_len = BUFFER_length(packet);
+      if (stream == NULL)
+      {
+        stream = malloc(packet_len * count);
+        HOST_TEST_CHECK(stream != NULL);
+      }
+      if (stream != NULL)
+      {
+        memcpy(&stream[stream_len], BUFFER_u_char(packet), packet_len);
+        stream_len += packet_len;
+      }
+      BUFFER_delete(packet);
+    }
+    if (stream_len == 0U)
+    {
+      free(stream);
+      break;
+    }
+
+    codec = ref_mqtt_codec_create(bench_on_packet, &rx);
+    ref_us = bench_decode(ref_mqtt_codec_bytesReceived, codec, stream, stream_len);
+    ref_mqtt_codec_destroy(codec);
+    HOST_TEST_CHECK(rx.packets == count);
+
+    rx.packets = 0;
+    codec = mqtt_codec_create(bench_on_packet, &rx);
+    buffer_us = bench_decode(mqtt_codec_bytesReceived, codec, stream, stream_len);
+    mqtt_codec_destroy(codec);
+    HOST_TEST_CHECK(rx.packets == count);
+
+    rx.packets = 0;
+    codec = mqtt_codec_create_span(bench_on_packet_span, &rx);
+    span_us = bench_decode(mqtt_codec_bytesReceived, codec, stream, stream_len);
+    mqtt_codec_destroy(codec);
+    HOST_TEST_CHECK(rx.packets == count);
+
+    printf("%8lu %8lu %12.1f %12.1f %12.1f %12.1f\n", (unsigned long) bench_sizes[s], count,
+           host_test_mbps(stream_len, encode_us),
+           host_test_mbps(stream_len, ref_us),
+           host_test_mbps(stream_len, buffer_us),
+           host_test_mbps(stream_len, span_us));
+    free(stream);
+  }
+
+  bench_iothub(iterations);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
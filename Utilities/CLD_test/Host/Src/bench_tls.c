@@ -0,0 +1,172 @@
+/**
+  ******************************************************************************
+  * @file    bench_tls.c
+  * @author  MCD Application Team
+  * @brief   Host benchmark of the TLS connection of the network library: secure sockets
+  *          (NET_SO_SECURE, net_mbedtls.c) on the host interface driver connect to a loopback
+  *          TLS server, exchange one record each way, and close. The connection is timed
+  *          without the TLS caches of the library (first connection) and with them (reconnection,
+  *          session resumed). The peak heap of the library is reported, as it sizes the device heap.
+  *          Built as bench_tls (credential and session caches), bench_tls_nosession (credential cache
+  *          only) and bench_tls_nocache (NET_MBEDTLS_CRED_CACHE_SIZE and NET_MBEDTLS_SESSION_CACHE_SIZE
+  *          0): without the caches, a reconnection is a first connection.
+  *          Usage: bench_tls [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "net_connect.h"
+#include "net_internals.h"
+#include "net_host.h"
+#include "host_server.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_TIMEOUT   5000
+#define BENCH_RECORD    "ping"
+
+/* Private variables ---------------------------------------------------------*/
+static net_if_handle_t netif;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Echo server connection.
+  */
+static void bench_echo(host_server_conn_t *pConn, void *pArg)
+{
+  uint8_t buf[256];
+  int n;
+
+  (void) pArg;
+  while ((n = host_server_recv(pConn, buf, sizeof(buf))) > 0)
+  {
+    if (host_server_send(pConn, buf, (size_t) n) != 0)
+    {
+      break;
+    }
+  }
+}
+
+/**
+  * @brief  One connection, as the applications open them: server verified against the CA certificate,
+  *         one record each way, and close.
+  * @retval 0 on success.
+  */
+static int bench_connect(uint16_t port, const char *ca_cert)
+{
+  static const bool verify = true;
+  const int32_t timeout = BENCH_TIMEOUT;
+  sockaddr_in_t addr;
+  uint8_t buf[sizeof(BENCH_RECORD)];
+  int32_t sock;
+  int32_t ret;
+
+  (void) memset(&addr, 0, sizeof(addr));
+  ret = net_if_gethostbyname(NULL, (sockaddr_t *) &addr, (char_t *) HOST_SERVER_NAME);
+  addr.sin_port = NET_HTONS(port);
+
+  sock = net_socket(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP);
+  if ((ret != NET_OK) || (sock < 0))
+  {
+    return -1;
+  }
+  ret  = net_setsockopt(sock, NET_SOL_SOCKET, NET_SO_RCVTIMEO, &timeout, sizeof(timeout));
+  ret |= net_setsockopt(sock, NET_SOL_SOCKET, NET_SO_SECURE, NULL, 0);
+  ret |= net_setsockopt(sock, NET_SOL_SOCKET, NET_SO_TLS_CA_CERT, ca_cert, strlen(ca_cert) + 1U);
+  ret |= net_setsockopt(sock, NET_SOL_SOCKET, NET_SO_TLS_SERVER_NAME, HOST_SERVER_NAME, sizeof(HOST_SERVER_NAME));
+  ret |= net_setsockopt(sock, NET_SOL_SOCKET, NET_SO_TLS_SERVER_VERIFICATION, &verify, sizeof(verify));
+  if (ret == NET_OK)
+  {
+    ret = net_connect(sock, (sockaddr_t *) &addr, (int32_t) sizeof(addr));
+  }
+  if ((ret == NET_OK) && (net_send(sock, (uint8_t *) BENCH_RECORD, sizeof(BENCH_RECORD) - 1U, 0)
+                          != ((int32_t) sizeof(BENCH_RECORD) - 1)))
+  {
+    ret = -1;
+  }
+  if ((ret == NET_OK) && ((net_recv(sock, buf, sizeof(buf) - 1U, 0) != ((int32_t) sizeof(BENCH_RECORD) - 1))
+                          || (memcmp(buf, BENCH_RECORD, sizeof(BENCH_RECORD) - 1U) != 0)))
+  {
+    ret = -1;
+  }
+  if (net_closesocket(sock) != NET_OK)
+  {
+    ret = -1;
+  }
+  return (ret == NET_OK) ? 0 : -1;
+}
+
+static void bench_report(const char *name, unsigned long count, uint64_t us)
+{
+  printf("%-12s %6lu connections %10.3f ms/connection   heap peak %6lu bytes, %4lu allocations/connection\n",
+         name, count, (count == 0U) ? 0.0 : ((double) us / 1000.0 / (double) count),
+         (unsigned long) net_host_heap.Peak,
+         (count == 0U) ? 0UL : (unsigned long) (net_host_heap.Allocs / count));
+}
+
+/* Functions Definition ------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 20);
+  host_server_t server;
+  const char *ca_cert;
+  size_t idle;
+  unsigned long i;
+  uint64_t start;
+  uint64_t us;
+
+  ca_cert = host_server_ca_cert();
+  if ((ca_cert == NULL) || (host_server_start(&server, 0U, true, bench_echo, NULL) != 0))
+  {
+    printf("cannot start the TLS server\n");
+    return 1;
+  }
+  HOST_TEST_CHECK(net_host_if_up(&netif) == NET_OK);
+  idle = net_host_heap.Used;
+  printf("TLS caches: %d credentials, %d sessions\n", NET_MBEDTLS_CRED_CACHE_SIZE, NET_MBEDTLS_SESSION_CACHE_SIZE);
+
+  /* First connections: the library parses the CA certificate, and negotiates a full handshake. */
+  us = 0U;
+  net_host_heap_reset();
+  for (i = 0; (i < iterations) && (host_test_failures == 0); i++)
+  {
+    net_mbedtls_flush_cache();
+    start = host_test_time_us();
+    HOST_TEST_CHECK(bench_connect(server.Port, ca_cert) == 0);
+    us += host_test_time_us() - start;
+  }
+  bench_report("first", iterations, us);
+
+  /* Reconnections: parsed credentials and session kept by the library, when it has the caches. */
+  net_host_heap_reset();
+  start = host_test_time_us();
+  for (i = 0; (i < iterations) && (host_test_failures == 0); i++)
+  {
+    HOST_TEST_CHECK(bench_connect(server.Port, ca_cert) == 0);
+  }
+  bench_report("reconnect", iterations, host_test_time_us() - start);
+
+  /* Only the caches are left, and they are released by a flush. */
+  net_mbedtls_flush_cache();
+  HOST_TEST_CHECK(net_host_heap.Used == idle);
+
+  HOST_TEST_CHECK(net_if_disconnect(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_stop(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_deinit(&netif) == NET_OK);
+  host_server_stop(&server);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,278 @@
+/**
+  ******************************************************************************
+  * @file    bench_tlsio.c
+  * @author  MCD Application Team
+  * @brief   Host benchmark of the receive path of the TLS IO adapter of the Azure IoT SDK
+  *          (tlsio_mbedtls.c, socketio over the network library): a loopback TLS server streams
+  *          64 Kbytes per request in records of 256 bytes to 16 Kbytes, and the adapter delivers them.
+  *          The current adapter (receive ring buffer) is compared with the one as delivered
+  *          (Src/tlsio_mbedtls_ref.c, realloc and memmove of the received bytes): throughput, CPU
+  *          time of the client per byte, and heap allocations per Kbyte while receiving.
+  *          The allocations are counted by wrapping malloc, calloc and realloc at link time.
+  *          Usage: bench_tlsio [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include "azure_c_shared_utility/shared_util_options.h"
+#include "azure_c_shared_utility/tlsio.h"
+#include "azure_c_shared_utility/tlsio_mbedtls.h"
+#include "net_connect.h"
+#include "net_host.h"
+#include "tlsio_mbedtls_ref.h"
+#include "host_server.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_REQUEST_SIZE  65536U
+#define BENCH_RECORD_MAX    16384U
+#define BENCH_TIMEOUT_US    10000000U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *name;
+  const IO_INTERFACE_DESCRIPTION *(*interface)(void);
+} bench_adapter_t;
+
+typedef struct
+{
+  size_t received;
+  bool open;
+  bool error;
+} bench_io_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const bench_adapter_t bench_adapters[] =
+{
+  { "ref",  ref_tlsio_mbedtls_get_interface_description },
+  { "ring", tlsio_mbedtls_get_interface_description },
+};
+static const size_t bench_records[] = { 256, 4096, BENCH_RECORD_MAX };
+static net_if_handle_t netif;
+static uint8_t pattern[BENCH_RECORD_MAX + 256U];
+static unsigned long bench_allocs;
+
+/* Private functions ---------------------------------------------------------*/
+/* Heap allocations of the process, see the link options of bench_tlsio. */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t nmemb, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+  bench_allocs++;
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+  bench_allocs++;
+  return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+  bench_allocs++;
+  return __real_realloc(ptr, size);
+}
+
+static uint64_t bench_cpu_ns(void)
+{
+  struct timespec ts;
+
+  (void) clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ((uint64_t) ts.tv_sec * 1000000000U) + (uint64_t) ts.tv_nsec;
+}
+
+/**
+  * @brief  Server connection: for each request (record size and length, 32-bit big endian), the pattern
+  *         bytes in records of the requested size.
+  */
+static void bench_server(host_server_conn_t *pConn, void *pArg)
+{
+  uint8_t request[8];
+  size_t len = 0;
+  size_t record;
+  size_t total;
+  size_t sent;
+  size_t n;
+  int ret;
+
+  (void) pArg;
+  for (;;)
+  {
+    ret = host_server_recv(pConn, &request[len], sizeof(request) - len);
+    if (ret <= 0)
+    {
+      return;
+    }
+    len += (size_t) ret;
+    if (len == sizeof(request))
+    {
+      len = 0;
+      record = ((size_t) request[0] << 24) | ((size_t) request[1] << 16) | ((size_t) request[2] << 8) | request[3];
+      total = ((size_t) request[4] << 24) | ((size_t) request[5] << 16) | ((size_t) request[6] << 8) | request[7];
+      record = (record < BENCH_RECORD_MAX) ? record : BENCH_RECORD_MAX;
+      for (sent = 0; sent < total; sent += n)
+      {
+        n = ((total - sent) < record) ? (total - sent) : record;
+        /* The records start on a multiple of 256 bytes: the pattern is the offset in the request. */
+        if (host_server_send(pConn, &pattern[sent & 0xFFU], n) != 0)
+        {
+          return;
+        }
+      }
+    }
+  }
+}
+
+static void bench_on_open(void *context, IO_OPEN_RESULT open_result)
+{
+  bench_io_t *io = context;
+
+  io->open = (open_result == IO_OPEN_OK);
+  io->error = (open_result != IO_OPEN_OK);
+}
+
+static void bench_on_bytes(void *context, const unsigned char *buffer, size_t size)
+{
+  bench_io_t *io = context;
+
+  HOST_TEST_CHECK(((io->received & 0xFFU) + size) <= sizeof(pattern));
+  HOST_TEST_CHECK(memcmp(buffer, &pattern[io->received & 0xFFU], size) == 0);
+  io->received += size;
+}
+
+static void bench_on_error(void *context)
+{
+  bench_io_t *io = context;
+
+  io->error = true;
+}
+
+/**
+  * @brief  Request length bytes in records of record bytes, and run the adapter until they are received.
+  * @retval 0 on success.
+  */
+static int bench_request(XIO_HANDLE tlsio, bench_io_t *io, size_t record, size_t length)
+{
+  const uint8_t request[8] =
+  {
+    (uint8_t)(record >> 24), (uint8_t)(record >> 16), (uint8_t)(record >> 8), (uint8_t) record,
+    (uint8_t)(length >> 24), (uint8_t)(length >> 16), (uint8_t)(length >> 8), (uint8_t) length
+  };
+  uint64_t start = host_test_time_us();
+
+  io->received = 0;
+  if (xio_send(tlsio, request, sizeof(request), NULL, NULL) != 0)
+  {
+    return -1;
+  }
+  while ((io->received < length) && (io->error == false) && ((host_test_time_us() - start) < BENCH_TIMEOUT_US))
+  {
+    xio_dowork(tlsio);
+  }
+  return (io->received == length) ? 0 : -1;
+}
+
+static void bench_adapter(const bench_adapter_t *adapter, uint16_t port, const char *ca_cert, unsigned long iterations)
+{
+  TLSIO_CONFIG config = { HOST_SERVER_NAME, (int) port, NULL, NULL };
+  bench_io_t io = { 0, false, false };
+  XIO_HANDLE tlsio;
+  unsigned long allocs;
+  unsigned long i;
+  uint64_t cpu;
+  uint64_t us;
+  size_t r;
+
+  tlsio = xio_create(adapter->interface(), &config);
+  HOST_TEST_CHECK(tlsio != NULL);
+  if (tlsio == NULL)
+  {
+    return;
+  }
+  HOST_TEST_CHECK(xio_setoption(tlsio, OPTION_TRUSTED_CERT, ca_cert) == 0);
+  HOST_TEST_CHECK(xio_open(tlsio, bench_on_open, &io, bench_on_bytes, &io, bench_on_error, &io) == 0);
+  for (i = 0; (i < 1000U) && (io.open == false) && (io.error == false); i++)
+  {
+    xio_dowork(tlsio);
+  }
+  HOST_TEST_CHECK(io.open);
+
+  for (r = 0; (r < (sizeof(bench_records) / sizeof(bench_records[0]))) && io.open && (host_test_failures == 0); r++)
+  {
+    /* One request first, so that the buffers of the adapter have their steady state size. */
+    HOST_TEST_CHECK(bench_request(tlsio, &io, bench_records[r], BENCH_REQUEST_SIZE) == 0);
+
+    allocs = bench_allocs;
+    cpu = bench_cpu_ns();
+    us = host_test_time_us();
+    for (i = 0; (i < iterations) && (host_test_failures == 0); i++)
+    {
+      HOST_TEST_CHECK(bench_request(tlsio, &io, bench_records[r], BENCH_REQUEST_SIZE) == 0);
+    }
+    us = host_test_time_us() - us;
+    cpu = bench_cpu_ns() - cpu;
+    allocs = bench_allocs - allocs;
+    printf("%-6s %8lu %10.2f %14.2f %16.2f\n", adapter->name, (unsigned long) bench_records[r],
+           host_test_mbps((uint64_t) BENCH_REQUEST_SIZE * iterations, us),
+           (double) cpu / ((double) BENCH_REQUEST_SIZE * (double) iterations),
+           (double) allocs * 1024.0 / ((double) BENCH_REQUEST_SIZE * (double) iterations));
+  }
+
+  (void) xio_close(tlsio, NULL, NULL);
+  xio_destroy(tlsio);
+}
+
+/* Functions Definition ------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 20);
+  host_server_t server;
+  const char *ca_cert;
+  size_t i;
+
+  for (i = 0; i < sizeof(pattern); i++)
+  {
+    pattern[i] = (uint8_t) i;
+  }
+  ca_cert = host_server_ca_cert();
+  if ((ca_cert == NULL) || (host_server_start(&server, 0U, true, bench_server, NULL) != 0))
+  {
+    printf("cannot start the TLS server\n");
+    return 1;
+  }
+  HOST_TEST_CHECK(net_host_if_up(&netif) == NET_OK);
+
+  printf("%-6s %8s %10s %14s %16s\n", "tlsio", "record", "MB/s", "CPU ns/byte", "allocations/KB");
+  for (i = 0; i < (sizeof(bench_adapters) / sizeof(bench_adapters[0])); i++)
+  {
+    bench_adapter(&bench_adapters[i], server.Port, ca_cert, iterations);
+  }
+
+  HOST_TEST_CHECK(net_if_disconnect(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_stop(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_deinit(&netif) == NET_OK);
+  host_server_stop(&server);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,288 @@
+/**
+  ******************************************************************************
+  * @file    eth_host.c
+  * @author  MCD Application Team
+  * @brief   Host run of the STM32F769I-Discovery Ethernet low level driver: fake HAL Ethernet (TX
+  *          descriptor ring walked by a fake DMA), CMSIS-RTOS and lwIP pbuf stand-ins.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "cmsis_os.h"
+#include "lwip/pbuf.h"
+#include "eth_host.h"
+
+/* Private variables ---------------------------------------------------------*/
+ETH_TypeDef eth_host_regs;
+eth_host_t eth_host;
+
+static struct pbuf eth_host_pbufs[ETH_HOST_PBUF_COUNT];
+static uint8_t eth_host_payloads[ETH_HOST_PBUF_COUNT][ETH_HOST_PBUF_SIZE];
+static ETH_DMADescTypeDef *eth_host_dma_desc;   /* Next TX descriptor read by the DMA */
+static uint32_t eth_host_semaphore;
+
+/* Private functions ---------------------------------------------------------*/
+static ETH_DMADescTypeDef *eth_host_next(const ETH_DMADescTypeDef *pDesc)
+{
+  return (ETH_DMADescTypeDef *)(uintptr_t) pDesc->Buffer2NextDescAddr;
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Fake DMA: send the next frame of the TX ring, and give its descriptors back to the CPU.
+  *         A frame starts with a FS descriptor and ends with a LS descriptor, all owned by the DMA.
+  * @retval 1 if a frame is sent, 0 if the next descriptor is not owned by the DMA, -1 for a malformed frame
+  */
+int32_t eth_host_dma_transmit(eth_host_frame_t *pFrame)
+{
+  ETH_DMADescTypeDef *desc = eth_host_dma_desc;
+  uint32_t len;
+
+  pFrame->Len = 0U;
+  pFrame->Segments = 0U;
+  if ((desc->Status & ETH_DMATXDESC_OWN) == 0U)
+  {
+    return 0;
+  }
+  if ((desc->Status & ETH_DMATXDESC_FS) == 0U)
+  {
+    return -1;
+  }
+  for (;;)
+  {
+    if (((desc->Status & ETH_DMATXDESC_OWN) == 0U) || (pFrame->Segments == ETH_TXBUFNB))
+    {
+      return -1;
+    }
+    len = desc->ControlBufferSize & ETH_DMATXDESC_TBS1;
+    if ((pFrame->Len + len) > sizeof(pFrame->Data))
+    {
+      return -1;
+    }
+    (void) memcpy(&pFrame->Data[pFrame->Len], (const void *)(uintptr_t) desc->Buffer1Addr, len);
+    pFrame->Len += len;
+    pFrame->Segments++;
+    desc->Status &= ~ETH_DMATXDESC_OWN;
+    if ((desc->Status & ETH_DMATXDESC_LS) != 0U)
+    {
+      break;
+    }
+    desc = eth_host_next(desc);
+  }
+  eth_host_dma_desc = eth_host_next(desc);
+  return 1;
+}
+
+HAL_StatusTypeDef HAL_ETH_Init(ETH_HandleTypeDef *heth)
+{
+  (void) memset(&eth_host_regs, 0, sizeof(eth_host_regs));
+  (void) heth;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_Start(ETH_HandleTypeDef *heth)
+{
+  (void) heth;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_Stop(ETH_HandleTypeDef *heth)
+{
+  (void) heth;
+  return HAL_OK;
+}
+
+/**
+  * @brief  Chained TX descriptor ring, as HAL_ETH_DMATxDescListInit() of the STM32F7 HAL.
+  */
+HAL_StatusTypeDef HAL_ETH_DMATxDescListInit(ETH_HandleTypeDef *heth, ETH_DMADescTypeDef *DMATxDescTab,
+                                            uint8_t *TxBuff, uint32_t TxBuffCount)
+{
+  uint32_t i;
+
+  for (i = 0U; i < TxBuffCount; i++)
+  {
+    DMATxDescTab[i].Status = ETH_DMATXDESC_TCH;
+    DMATxDescTab[i].Buffer1Addr = (uint32_t)(uintptr_t)(&TxBuff[i * ETH_TX_BUF_SIZE]);
+    DMATxDescTab[i].Buffer2NextDescAddr = (uint32_t)(uintptr_t)(&DMATxDescTab[(i + 1U) % TxBuffCount]);
+  }
+  heth->TxDesc = DMATxDescTab;
+  eth_host_dma_desc = DMATxDescTab;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_DMARxDescListInit(ETH_HandleTypeDef *heth, ETH_DMADescTypeDef *DMARxDescTab,
+                                            uint8_t *RxBuff, uint32_t RxBuffCount)
+{
+  (void) RxBuff;
+  (void) RxBuffCount;
+  heth->RxDesc = DMARxDescTab;
+  return HAL_OK;
+}
+
+/**
+  * @brief  One frame in one descriptor, as HAL_ETH_TransmitFrame() of the STM32F7 HAL for a frame of one buffer.
+  */
+HAL_StatusTypeDef HAL_ETH_TransmitFrame(ETH_HandleTypeDef *heth, uint32_t FrameLength)
+{
+  if (((heth->TxDesc->Status & ETH_DMATXDESC_OWN) != 0U) || (FrameLength > ETH_TX_BUF_SIZE))
+  {
+    return HAL_ERROR;
+  }
+  heth->TxDesc->Status |= ETH_DMATXDESC_FS | ETH_DMATXDESC_LS;
+  heth->TxDesc->ControlBufferSize = (FrameLength & ETH_DMATXDESC_TBS1);
+  heth->TxDesc->Status |= ETH_DMATXDESC_OWN;
+  heth->TxDesc = eth_host_next(heth->TxDesc);
+  if ((heth->Instance->DMASR & ETH_DMASR_TBUS) != 0U)
+  {
+    heth->Instance->DMASR = ETH_DMASR_TBUS;
+    heth->Instance->DMATPDR = 0U;
+  }
+  return HAL_OK;
+}
+
+/* No RX traffic */
+HAL_StatusTypeDef HAL_ETH_GetReceivedFrame_IT(ETH_HandleTypeDef *heth)
+{
+  (void) heth;
+  return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_ETH_ReadPHYRegister(ETH_HandleTypeDef *heth, uint16_t PHYReg, uint32_t *RegValue)
+{
+  (void) heth;
+  *RegValue = (PHYReg == PHY_BSR) ? PHY_LINKED_STATUS : 0U;
+  return HAL_OK;
+}
+
+/**
+  * @brief  Called for each TX buffer before its descriptor is given to the DMA: the first descriptor of the frame
+  *         (EthHandle.TxDesc until the frame is complete) must still be owned by the CPU.
+  */
+void SCB_CleanDCache_by_Addr(uint32_t *addr, int32_t dsize)
+{
+  (void) addr;
+  (void) dsize;
+  if ((EthHandle.TxDesc->Status & ETH_DMATXDESC_OWN) != 0U)
+  {
+    eth_host.EarlyOwn++;
+  }
+}
+
+void SCB_InvalidateDCache_by_Addr(uint32_t *addr, int32_t dsize)
+{
+  (void) addr;
+  (void) dsize;
+}
+
+osSemaphoreId osSemaphoreCreate(const osSemaphoreDef_t *semaphore_def, int32_t count)
+{
+  (void) semaphore_def;
+  (void) count;
+  return &eth_host_semaphore;
+}
+
+int32_t osSemaphoreWait(osSemaphoreId semaphore_id, uint32_t millisec)
+{
+  (void) semaphore_id;
+  (void) millisec;
+  return (int32_t) osOK;
+}
+
+osStatus osSemaphoreRelease(osSemaphoreId semaphore_id)
+{
+  (void) semaphore_id;
+  return osOK;
+}
+
+osStatus osSemaphoreDelete(osSemaphoreId semaphore_id)
+{
+  (void) semaphore_id;
+  return osOK;
+}
+
+/* The interface task is not run: the test drives the transmit path */
+osThreadId osThreadCreate(const osThreadDef_t *thread_def, void *argument)
+{
+  (void) argument;
+  return (osThreadId)(uintptr_t) thread_def;
+}
+
+osStatus osThreadTerminate(osThreadId thread_id)
+{
+  (void) thread_id;
+  return osOK;
+}
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, uint16_t length, pbuf_type type)
+{
+  uint32_t i;
+
+  (void) layer;
+  (void) type;
+  if (length > ETH_HOST_PBUF_SIZE)
+  {
+    return NULL;
+  }
+  for (i = 0U; i < ETH_HOST_PBUF_COUNT; i++)
+  {
+    if (eth_host_pbufs[i].ref == 0U)
+    {
+      eth_host_pbufs[i].next = NULL;
+      eth_host_pbufs[i].payload = eth_host_payloads[i];
+      eth_host_pbufs[i].tot_len = length;
+      eth_host_pbufs[i].len = length;
+      eth_host_pbufs[i].ref = 1U;
+      eth_host.PbufsInUse++;
+      return &eth_host_pbufs[i];
+    }
+  }
+  return NULL;
+}
+
+void pbuf_ref(struct pbuf *p)
+{
+  p->ref++;
+}
+
+/**
+  * @brief  As lwIP: the chain is freed up to the first pbuf still referenced.
+  */
+uint8_t pbuf_free(struct pbuf *p)
+{
+  uint8_t count = 0U;
+  struct pbuf *next;
+
+  if ((p == NULL) || (p->ref == 0U))
+  {
+    eth_host.FreeErrors++;
+    return 0U;
+  }
+  while (p != NULL)
+  {
+    p->ref--;
+    if (p->ref != 0U)
+    {
+      break;
+    }
+    next = p->next;
+    eth_host.PbufsInUse--;
+    count++;
+    p = next;
+  }
+  return count;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,383 @@
+/**
+  ******************************************************************************
+  * @file    host_server.c
+  * @author  MCD Application Team
+  * @brief   Loopback TCP / TLS server of the host benchmarks. The server is a child process which
+  *          accepts one connection at a time and gives it to the handler of the benchmark (HTTP range
+  *          server, MQTT hub, ...). In TLS mode, the server certificate is a self-signed ECDSA certificate
+  *          for "localhost", made at run time (the test certificates delivered with mbedTLS are out of
+  *          their validity period); the clients take its PEM as CA certificate. The server keeps a session
+  *          cache, so that the clients can resume their sessions.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "mbedtls/platform.h"
+#include "mbedtls/certs.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/x509_crt.h"
+#include "host_server.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define HOST_SERVER_CERT_SIZE   2048U
+
+/* Private typedef -----------------------------------------------------------*/
+struct host_server_conn_s
+{
+  int Fd;
+  mbedtls_ssl_context *pSsl;  /* NULL for a plain TCP connection */
+};
+
+/* Private variables ---------------------------------------------------------*/
+static char host_server_cert[HOST_SERVER_CERT_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+static int host_server_bio_send(void *ctx, const unsigned char *buf, size_t len)
+{
+  ssize_t n = send(*(int *) ctx, buf, len, MSG_NOSIGNAL);
+
+  return (n < 0) ? MBEDTLS_ERR_NET_SEND_FAILED : (int) n;
+}
+
+static int host_server_bio_recv(void *ctx, unsigned char *buf, size_t len)
+{
+  ssize_t n = recv(*(int *) ctx, buf, len, 0);
+
+  return (n < 0) ? MBEDTLS_ERR_NET_RECV_FAILED : (int) n;
+}
+
+/**
+  * @brief  Make the self-signed server certificate, once.
+  * @retval 0 on success.
+  */
+static int host_server_make_cert(void)
+{
+  mbedtls_entropy_context entropy;
+  mbedtls_ctr_drbg_context drbg;
+  mbedtls_x509write_cert crt;
+  mbedtls_pk_context key;
+  mbedtls_mpi serial;
+  int ret;
+
+  if (host_server_cert[0] != '\0')
+  {
+    return 0;
+  }
+  mbedtls_entropy_init(&entropy);
+  mbedtls_ctr_drbg_init(&drbg);
+  mbedtls_x509write_crt_init(&crt);
+  mbedtls_pk_init(&key);
+  mbedtls_mpi_init(&serial);
+
+  ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, (const unsigned char *) "host_server", 11);
+  if (ret == 0)
+  {
+    ret = mbedtls_pk_parse_key(&key, (const unsigned char *) mbedtls_test_srv_key_ec, mbedtls_test_srv_key_ec_len,
+                               NULL, 0);
+  }
+  if (ret == 0)
+  {
+    ret = mbedtls_mpi_lset(&serial, 1);
+  }
+  if (ret == 0)
+  {
+    mbedtls_x509write_crt_set_version(&crt, MBEDTLS_X509_CRT_VERSION_3);
+    mbedtls_x509write_crt_set_md_alg(&crt, MBEDTLS_MD_SHA256);
+    mbedtls_x509write_crt_set_subject_key(&crt, &key);
+    mbedtls_x509write_crt_set_issuer_key(&crt, &key);
+    ret = mbedtls_x509write_crt_set_subject_name(&crt, "CN=" HOST_SERVER_NAME);
+  }
+  if (ret == 0)
+  {
+    ret = mbedtls_x509write_crt_set_issuer_name(&crt, "CN=" HOST_SERVER_NAME);
+  }
+  if (ret == 0)
+  {
+    ret = mbedtls_x509write_crt_set_serial(&crt, &serial);
+  }
+  if (ret == 0)
+  {
+    ret = mbedtls_x509write_crt_set_validity(&crt, "20200101000000", "20991231235959");
+  }
+  if (ret == 0)
+  {
+    ret = mbedtls_x509write_crt_set_basic_constraints(&crt, 1, -1);
+  }
+  if (ret == 0)
+  {
+    ret = mbedtls_x509write_crt_pem(&crt, (unsigned char *) host_server_cert, sizeof(host_server_cert),
+                                    mbedtls_ctr_drbg_random, &drbg);
+  }
+  if (ret != 0)
+  {
+    host_server_cert[0] = '\0';
+    printf("cannot make the server certificate: -0x%04x\n", (unsigned int) -ret);
+  }
+
+  mbedtls_mpi_free(&serial);
+  mbedtls_pk_free(&key);
+  mbedtls_x509write_crt_free(&crt);
+  mbedtls_ctr_drbg_free(&drbg);
+  mbedtls_entropy_free(&entropy);
+  return ret;
+}
+
+/**
+  * @brief  Server process: serves the connections until it is stopped.
+  */
+static void host_server_run(int ListenFd, bool Tls, host_server_handler_t Handler, void *pArg)
+{
+  mbedtls_entropy_context entropy;
+  mbedtls_ctr_drbg_context drbg;
+  mbedtls_ssl_config conf;
+  mbedtls_ssl_cache_context cache;
+  mbedtls_x509_crt crt;
+  mbedtls_pk_context key;
+  mbedtls_ssl_context ssl;
+  host_server_conn_t conn;
+  int one = 1;
+  int ret = 0;
+
+  /* The client may have set the allocator of mbedTLS to its own heap: the server uses the C library one. */
+  (void) mbedtls_platform_set_calloc_free(calloc, free);
+  mbedtls_entropy_init(&entropy);
+  mbedtls_ctr_drbg_init(&drbg);
+  mbedtls_ssl_config_init(&conf);
+  mbedtls_ssl_cache_init(&cache);
+  mbedtls_x509_crt_init(&crt);
+  mbedtls_pk_init(&key);
+  if (Tls == true)
+  {
+    ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, (const unsigned char *) "host_server", 11);
+    if (ret == 0)
+    {
+      ret = mbedtls_x509_crt_parse(&crt, (const unsigned char *) host_server_cert, strlen(host_server_cert) + 1U);
+    }
+    if (ret == 0)
+    {
+      ret = mbedtls_pk_parse_key(&key, (const unsigned char *) mbedtls_test_srv_key_ec, mbedtls_test_srv_key_ec_len,
+                                 NULL, 0);
+    }
+    if (ret == 0)
+    {
+      ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                        MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0)
+    {
+      ret = mbedtls_ssl_conf_own_cert(&conf, &crt, &key);
+    }
+    if (ret != 0)
+    {
+      printf("cannot set up the TLS server: -0x%04x\n", (unsigned int) -ret);
+      _exit(2);
+    }
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+    mbedtls_ssl_conf_session_cache(&conf, &cache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
+  }
+
+  for (;;)
+  {
+    conn.Fd = accept(ListenFd, NULL, NULL);
+    if (conn.Fd < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      break;
+    }
+    /* The headers and the bodies are sent separately: do not let them wait for an acknowledge. */
+    (void) setsockopt(conn.Fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    conn.pSsl = NULL;
+    if (Tls == true)
+    {
+      mbedtls_ssl_init(&ssl);
+      ret = mbedtls_ssl_setup(&ssl, &conf);
+      mbedtls_ssl_set_bio(&ssl, &conn.Fd, host_server_bio_send, host_server_bio_recv, NULL);
+      while (ret == 0)
+      {
+        ret = mbedtls_ssl_handshake(&ssl);
+        if ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE))
+        {
+          ret = 0;
+        }
+        else
+        {
+          break;
+        }
+      }
+      if (ret == 0)
+      {
+        conn.pSsl = &ssl;
+        Handler(&conn, pArg);
+        (void) mbedtls_ssl_close_notify(&ssl);
+      }
+      mbedtls_ssl_free(&ssl);
+    }
+    else
+    {
+      Handler(&conn, pArg);
+    }
+    (void) close(conn.Fd);
+  }
+  _exit(0);
+}
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  PEM of the server certificate, to be given as CA certificate to the clients.
+  * @retval NULL if the certificate cannot be made.
+  */
+const char *host_server_ca_cert(void)
+{
+  return (host_server_make_cert() == 0) ? host_server_cert : NULL;
+}
+
+/**
+  * @brief  Start a server on 127.0.0.1.
+  * @param  pServer  out: the server process and its port
+  * @param  Port     listening port, 0 for an ephemeral one
+  * @param  Tls      the connections are TLS ones
+  * @param  Handler  connection handler
+  * @param  pArg     handler argument
+  * @retval 0 on success.
+  */
+int host_server_start(host_server_t *pServer, uint16_t Port, bool Tls, host_server_handler_t Handler, void *pArg)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int one = 1;
+  int fd;
+
+  if ((Tls == true) && (host_server_make_cert() != 0))
+  {
+    return -1;
+  }
+  (void) memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(Port);
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  (void) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if ((bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) || (listen(fd, 4) != 0)
+      || (getsockname(fd, (struct sockaddr *) &addr, &addr_len) != 0))
+  {
+    printf("cannot listen on port %u\n", (unsigned int) Port);
+    (void) close(fd);
+    return -1;
+  }
+  pServer->Port = ntohs(addr.sin_port);
+
+  (void) fflush(stdout);
+  pServer->Pid = fork();
+  if (pServer->Pid == 0)
+  {
+    /* The server does not outlive the benchmark, even if it crashes. */
+    (void) prctl(PR_SET_PDEATHSIG, SIGKILL);
+    host_server_run(fd, Tls, Handler, pArg);
+  }
+  (void) close(fd);
+  return (pServer->Pid > 0) ? 0 : -1;
+}
+
+void host_server_stop(host_server_t *pServer)
+{
+  if (pServer->Pid > 0)
+  {
+    (void) kill(pServer->Pid, SIGTERM);
+    (void) waitpid(pServer->Pid, NULL, 0);
+    pServer->Pid = 0;
+  }
+}
+
+/**
+  * @brief  Receive data of the connection.
+  * @retval Received bytes, 0 when the client closed the connection, < 0 on error.
+  */
+int host_server_recv(host_server_conn_t *pConn, uint8_t *pBuf, size_t Len)
+{
+  ssize_t n;
+  int ret;
+
+  if (pConn->pSsl != NULL)
+  {
+    do
+    {
+      ret = mbedtls_ssl_read(pConn->pSsl, pBuf, Len);
+    } while ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE));
+    return (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) ? 0 : ret;
+  }
+  do
+  {
+    n = recv(pConn->Fd, pBuf, Len, 0);
+  } while ((n < 0) && (errno == EINTR));
+  return (int) n;
+}
+
+/**
+  * @brief  Send all the data.
+  * @retval 0 on success, < 0 on error.
+  */
+int host_server_send(host_server_conn_t *pConn, const void *pBuf, size_t Len)
+{
+  const uint8_t *p = pBuf;
+  int n;
+
+  while (Len > 0U)
+  {
+    if (pConn->pSsl != NULL)
+    {
+      n = mbedtls_ssl_write(pConn->pSsl, p, Len);
+      if ((n == MBEDTLS_ERR_SSL_WANT_READ) || (n == MBEDTLS_ERR_SSL_WANT_WRITE))
+      {
+        continue;
+      }
+    }
+    else
+    {
+      n = (int) send(pConn->Fd, p, Len, MSG_NOSIGNAL);
+    }
+    if (n <= 0)
+    {
+      return -1;
+    }
+    p += n;
+    Len -= (size_t) n;
+  }
+  return 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
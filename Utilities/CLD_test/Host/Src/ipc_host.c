@@ -0,0 +1,241 @@
+/**
+  ******************************************************************************
+  * @file    ipc_host.c
+  * @author  MCD Application Team
+  * @brief   Host run of the cellular IPC: fake HAL UART receiving the characters of a fake modem, one by one
+  *          under interrupt or in a circular RX DMA buffer (half transfer, transfer complete and idle line
+  *          events), with the hardware flow control of the paused reception.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ipc_host.h"
+
+/* Private variables ---------------------------------------------------------*/
+static USART_TypeDef ipc_host_usart;
+static DMA_Channel_TypeDef ipc_host_dma_channel;
+static DMA_HandleTypeDef ipc_host_hdma = { &ipc_host_dma_channel };
+static uint8_t ipc_host_dma_paused;
+static uint8_t ipc_host_rx_since_idle;
+#if (IPC_USE_UART_DMA_RX == 1U)
+static uint8_t ipc_host_irq_half;         /* DMA interrupts pending */
+static uint8_t ipc_host_irq_cplt;
+static uint32_t ipc_host_irq_delay;
+#endif /* IPC_USE_UART_DMA_RX */
+
+UART_HandleTypeDef ipc_host_uart = { &ipc_host_usart, NULL, 0U, HAL_UART_STATE_READY, &ipc_host_hdma };
+ipc_host_t ipc_host;
+
+/* Private functions ---------------------------------------------------------*/
+#if (IPC_USE_UART_DMA_RX == 1U)
+/* Position where the DMA writes the next character */
+static uint16_t ipc_host_dma_pos(void)
+{
+  return (uint16_t)((ipc_host_uart.RxXferSize - ipc_host_dma_channel.CNDTR) % ipc_host_uart.RxXferSize);
+}
+
+static void ipc_host_count_wrap(void)
+{
+  uint16_t write_pos = ipc_host_dma_pos();
+
+  if ((g_IPC_Devices_List[0].RxDmaReadPos > write_pos) && (write_pos != 0U))
+  {
+    ipc_host.WrapSpans++;
+  }
+}
+
+/* DMA half transfer and transfer complete interrupts */
+static void ipc_host_dma_irq(void)
+{
+  if (ipc_host_irq_half != 0U)
+  {
+    ipc_host_irq_half = 0U;
+    ipc_host_count_wrap();
+    IPC_UART_RxHalfCpltCallback(&ipc_host_uart);
+  }
+  if (ipc_host_irq_cplt != 0U)
+  {
+    ipc_host_irq_cplt = 0U;
+    ipc_host_count_wrap();
+    IPC_UART_RxCpltCallback(&ipc_host_uart);
+  }
+  ipc_host_irq_delay = 0U;
+}
+#endif /* IPC_USE_UART_DMA_RX */
+
+/**
+  * @brief  Receive one character, as the UART interrupt handler does.
+  * @retval 1 if received, 0 if held by the UART (no reception armed, or RX DMA paused)
+  */
+static uint32_t ipc_host_receive(uint8_t c)
+{
+  if ((ipc_host_uart.RxState != HAL_UART_STATE_BUSY_RX) || (ipc_host_dma_paused != 0U))
+  {
+    ipc_host.Holds++;
+    return 0U;
+  }
+  ipc_host.Chars++;
+  ipc_host_rx_since_idle = 1U;
+#if (IPC_USE_UART_DMA_RX == 1U)
+  ipc_host_uart.pRxBuffPtr[ipc_host_dma_pos()] = c;
+  ipc_host_dma_channel.CNDTR--;
+  if (ipc_host_dma_channel.CNDTR == (ipc_host_uart.RxXferSize / 2U))
+  {
+    ipc_host_irq_half = 1U;
+  }
+  else if (ipc_host_dma_channel.CNDTR == 0U)
+  {
+    /* circular mode: the counter is reloaded before the transfer complete interrupt */
+    ipc_host_dma_channel.CNDTR = ipc_host_uart.RxXferSize;
+    ipc_host.DmaWraps++;
+    ipc_host_irq_cplt = 1U;
+  }
+  else
+  {
+    /* no DMA event */
+  }
+  /* the DMA goes on receiving until the interrupt is served */
+  if ((ipc_host_irq_half != 0U) || (ipc_host_irq_cplt != 0U))
+  {
+    ipc_host_irq_delay++;
+    if (ipc_host_irq_delay > ipc_host.IrqLatency)
+    {
+      ipc_host_dma_irq();
+    }
+  }
+#else
+  *ipc_host_uart.pRxBuffPtr = c;
+  ipc_host_uart.RxState = HAL_UART_STATE_READY;
+  IPC_UART_RxCpltCallback(&ipc_host_uart);
+#endif /* IPC_USE_UART_DMA_RX */
+  return 1U;
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  The modem sends characters until the UART holds one.
+  * @retval Number of characters received
+  */
+uint32_t ipc_host_modem_send(const uint8_t *pData, uint32_t Len)
+{
+  uint32_t i;
+
+  for (i = 0U; i < Len; i++)
+  {
+    if (ipc_host_receive(pData[i]) == 0U)
+    {
+      break;
+    }
+  }
+  return i;
+}
+
+/**
+  * @brief  The modem stops sending: idle line flag, and interrupt if enabled.
+  */
+void ipc_host_line_idle(void)
+{
+#if (IPC_USE_UART_DMA_RX == 1U)
+  ipc_host_dma_irq();
+#endif /* IPC_USE_UART_DMA_RX */
+  if (ipc_host_rx_since_idle != 0U)
+  {
+    ipc_host_rx_since_idle = 0U;
+    ipc_host_usart.ISR |= UART_FLAG_IDLE;
+  }
+  if (((ipc_host_usart.ISR & UART_FLAG_IDLE) != 0U) && ((ipc_host_usart.CR1 & UART_IT_IDLE) != 0U))
+  {
+    ipc_host.IdleEvents++;
+#if (IPC_USE_UART_DMA_RX == 1U)
+    ipc_host_count_wrap();
+    IPC_UART_IdleLineCallback(&ipc_host_uart);
+#endif /* IPC_USE_UART_DMA_RX */
+  }
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  UNUSED(huart);
+  UNUSED(pData);
+  UNUSED(Size);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart)
+{
+  UNUSED(huart);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  if (huart->RxState != HAL_UART_STATE_READY)
+  {
+    return HAL_BUSY;
+  }
+  huart->pRxBuffPtr = pData;
+  huart->RxXferSize = Size;
+  huart->RxState = HAL_UART_STATE_BUSY_RX;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  if (huart->RxState != HAL_UART_STATE_READY)
+  {
+    return HAL_BUSY;
+  }
+  huart->pRxBuffPtr = pData;
+  huart->RxXferSize = Size;
+  huart->RxState = HAL_UART_STATE_BUSY_RX;
+  huart->hdmarx->Instance->CNDTR = Size;
+  ipc_host_dma_paused = 0U;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DMAPause(UART_HandleTypeDef *huart)
+{
+#if (IPC_USE_UART_DMA_RX == 1U)
+  if ((ipc_host_dma_paused == 0U) && (g_IPC_Devices_List[0].RxDmaReadPos != ipc_host_dma_pos()))
+  {
+    ipc_host.MidSpanPauses++;
+  }
+#endif /* IPC_USE_UART_DMA_RX */
+  if (huart->RxState == HAL_UART_STATE_BUSY_RX)
+  {
+    ipc_host_dma_paused = 1U;
+  }
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DMAResume(UART_HandleTypeDef *huart)
+{
+  UNUSED(huart);
+  ipc_host_dma_paused = 0U;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+  huart->Instance->CR1 &= ~UART_IT_IDLE;
+  huart->RxState = HAL_UART_STATE_READY;
+  ipc_host_dma_paused = 0U;
+#if (IPC_USE_UART_DMA_RX == 1U)
+  ipc_host_irq_half = 0U;
+  ipc_host_irq_cplt = 0U;
+#endif /* IPC_USE_UART_DMA_RX */
+  return HAL_OK;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,285 @@
+/**
+  ******************************************************************************
+  * @file    net_os_posix.c
+  * @author  MCD Application Team
+  * @brief   Host port of the network library OS functions (core/net_os.c) on POSIX threads, and the
+  *          board services used by the network build: FreeRTOS heap with counters, HAL tick and delay,
+  *          random number generator.
+  *          The locks are binary semaphores, as osSemaphoreCreate(..., 1) on the device.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/random.h>
+#include "main.h"
+#include "mbedtls_entropy.h"
+#include "net_connect.h"
+#include "net_internals.h"
+#include "net_host.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  bool available;
+} net_os_sem_t;
+
+/* Allocation header: keeps the size of each block, and the alignment of the block. */
+typedef union
+{
+  size_t size;
+  long double align;
+} net_os_block_t;
+
+/* Private variables ---------------------------------------------------------*/
+static net_os_sem_t net_sem[NET_LOCK_NUMBER];
+static pthread_mutex_t net_heap_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+net_host_heap_t net_host_heap;
+RNG_HandleTypeDef hrng;
+void *pxCurrentTCB;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Take a binary semaphore.
+  * @retval 0 on success, -1 on timeout.
+  */
+static int32_t net_os_sem_wait(net_os_sem_t *sem, uint32_t timeout)
+{
+  struct timespec deadline;
+  int32_t ret = 0;
+  int rc = 0;
+
+  (void) clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += (time_t)(timeout / 1000U);
+  deadline.tv_nsec += (long)(timeout % 1000U) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  (void) pthread_mutex_lock(&sem->mutex);
+  while ((sem->available == false) && (rc != ETIMEDOUT))
+  {
+    if (timeout == NET_OS_WAIT_FOREVER)
+    {
+      (void) pthread_cond_wait(&sem->cond, &sem->mutex);
+    }
+    else
+    {
+      rc = pthread_cond_timedwait(&sem->cond, &sem->mutex, &deadline);
+    }
+  }
+  if (sem->available == true)
+  {
+    sem->available = false;
+  }
+  else
+  {
+    ret = -1;
+  }
+  (void) pthread_mutex_unlock(&sem->mutex);
+  return ret;
+}
+
+/**
+  * @brief  Give a binary semaphore.
+  * @retval 0 on success, -1 if it was not taken.
+  */
+static int32_t net_os_sem_release(net_os_sem_t *sem)
+{
+  int32_t ret = 0;
+
+  (void) pthread_mutex_lock(&sem->mutex);
+  if (sem->available == true)
+  {
+    ret = -1;
+  }
+  sem->available = true;
+  (void) pthread_cond_signal(&sem->cond);
+  (void) pthread_mutex_unlock(&sem->mutex);
+  return ret;
+}
+
+/* Functions Definition ------------------------------------------------------*/
+void net_init_locks(void)
+{
+  pthread_condattr_t attr;
+
+#ifdef NET_MBEDTLS_HOST_SUPPORT
+  net_tls_init();
+#endif /* NET_MBEDTLS_HOST_SUPPORT */
+  (void) pthread_condattr_init(&attr);
+  (void) pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  for (int32_t i = 0; i < NET_LOCK_NUMBER; i++)
+  {
+    NET_ASSERT(pthread_mutex_init(&net_sem[i].mutex, NULL) == 0, "Failed on mutex creation");
+    NET_ASSERT(pthread_cond_init(&net_sem[i].cond, &attr) == 0, "Failed on mutex creation");
+    net_sem[i].available = true;
+  }
+  (void) pthread_condattr_destroy(&attr);
+}
+
+void net_destroy_locks(void)
+{
+#ifdef NET_MBEDTLS_HOST_SUPPORT
+  net_tls_destroy();
+#endif /* NET_MBEDTLS_HOST_SUPPORT */
+  for (int32_t i = 0; i < NET_LOCK_NUMBER; i++)
+  {
+    (void) pthread_cond_destroy(&net_sem[i].cond);
+    (void) pthread_mutex_destroy(&net_sem[i].mutex);
+  }
+}
+
+void net_lock(int32_t sock, uint32_t timeout)
+{
+  int32_t ret;
+
+  ret = net_os_sem_wait(&net_sem[sock], timeout);
+  NET_ASSERT(ret == 0, "Failed locking mutex");
+}
+
+void net_unlock(int32_t sock)
+{
+  int32_t ret;
+
+  ret = net_os_sem_release(&net_sem[sock]);
+  NET_ASSERT(ret == 0, "Failed unlocking mutex");
+}
+
+void net_lock_nochk(int32_t sock, uint32_t timeout)
+{
+  (void) net_os_sem_wait(&net_sem[sock], timeout);
+}
+
+void net_unlock_nochk(int32_t sock)
+{
+  (void) net_os_sem_release(&net_sem[sock]);
+}
+
+void *net_calloc(size_t n, size_t m)
+{
+  void *p = NULL;
+
+  if ((m == 0U) || (n <= (SIZE_MAX / m)))
+  {
+    p = pvPortMalloc(n * m);
+  }
+  if (p != NULL)
+  {
+    (void) memset(p, 0, n * m);
+  }
+  return p;
+}
+
+/* FreeRTOS heap -------------------------------------------------------------*/
+void *pvPortMalloc(size_t xWantedSize)
+{
+  net_os_block_t *block = NULL;
+
+  if (xWantedSize <= (SIZE_MAX - sizeof(net_os_block_t)))
+  {
+    block = malloc(sizeof(net_os_block_t) + xWantedSize);
+  }
+  if (block == NULL)
+  {
+    return NULL;
+  }
+  block->size = xWantedSize;
+  (void) pthread_mutex_lock(&net_heap_mutex);
+  net_host_heap.Used += xWantedSize;
+  net_host_heap.Allocs++;
+  if (net_host_heap.Used > net_host_heap.Peak)
+  {
+    net_host_heap.Peak = net_host_heap.Used;
+  }
+  (void) pthread_mutex_unlock(&net_heap_mutex);
+  return block + 1;
+}
+
+void vPortFree(void *pv)
+{
+  net_os_block_t *block;
+
+  if (pv != NULL)
+  {
+    block = (net_os_block_t *) pv - 1;
+    (void) pthread_mutex_lock(&net_heap_mutex);
+    net_host_heap.Used -= block->size;
+    (void) pthread_mutex_unlock(&net_heap_mutex);
+    free(block);
+  }
+}
+
+/**
+  * @brief  Start a measure: the peak is the current heap use, no allocation counted.
+  */
+void net_host_heap_reset(void)
+{
+  (void) pthread_mutex_lock(&net_heap_mutex);
+  net_host_heap.Peak = net_host_heap.Used;
+  net_host_heap.Allocs = 0U;
+  (void) pthread_mutex_unlock(&net_heap_mutex);
+}
+
+/* Board services ------------------------------------------------------------*/
+uint32_t HAL_GetTick(void)
+{
+  struct timespec ts;
+
+  (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(((uint64_t) ts.tv_sec * 1000U) + ((uint64_t) ts.tv_nsec / 1000000U));
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+  struct timespec ts;
+
+  ts.tv_sec = (time_t)(Delay / 1000U);
+  ts.tv_nsec = (long)(Delay % 1000U) * 1000000L;
+  while (nanosleep(&ts, &ts) != 0)
+  {
+  }
+}
+
+int mbedtls_rng_raw(void *data, unsigned char *output, size_t len)
+{
+  ssize_t n;
+
+  (void) data;
+  while (len > 0U)
+  {
+    n = getrandom(output, len, 0);
+    if (n < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return -1;
+    }
+    output += n;
+    len -= (size_t) n;
+  }
+  return 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
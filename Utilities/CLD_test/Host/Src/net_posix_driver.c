@@ -0,0 +1,530 @@
+/**
+  ******************************************************************************
+  * @file    net_posix_driver.c
+  * @author  MCD Application Team
+  * @brief   Network interface driver of the host build: the socket calls of the network library are
+  *          done on BSD sockets, so that the library (net_socket.c, net_mbedtls.c) and its clients run
+  *          on the host as on the device. The return values are the ones of the LwIP driver
+  *          (net_ip_lwip.c): 0 when no data can be exchanged before the timeout, NET_ERROR_DISCONNECTED
+  *          when the connection is closed.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include "net_connect.h"
+#include "net_internals.h"
+#include "net_host.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define NET_POSIX_STATE_TIMEOUT   1000U
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t net_posix_if_init(net_if_handle_t *pnetif);
+static int32_t net_posix_if_deinit(net_if_handle_t *pnetif);
+static int32_t net_posix_if_start(net_if_handle_t *pnetif);
+static int32_t net_posix_if_stop(net_if_handle_t *pnetif);
+static int32_t net_posix_if_connect(net_if_handle_t *pnetif);
+static int32_t net_posix_if_disconnect(net_if_handle_t *pnetif);
+
+static int32_t net_posix_socket(int32_t domain, int32_t type, int32_t protocol);
+static int32_t net_posix_bind(int32_t sock, const sockaddr_t *addr, int32_t addrlen);
+static int32_t net_posix_listen(int32_t sock, int32_t backlog);
+static int32_t net_posix_accept(int32_t sock, sockaddr_t *addr, int32_t *addrlen);
+static int32_t net_posix_connect(int32_t sock, const sockaddr_t *addr, int32_t addrlen);
+static int32_t net_posix_send(int32_t sock, uint8_t *buf, int32_t len, int32_t flags);
+static int32_t net_posix_recv(int32_t sock, uint8_t *buf, int32_t len, int32_t flags);
+static int32_t net_posix_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *to, int32_t tolen);
+static int32_t net_posix_recvfrom(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *from,
+                                  int32_t *fromlen);
+static int32_t net_posix_setsockopt(int32_t sock, int32_t level, int32_t optname, const void *optvalue,
+                                    int32_t optlen);
+static int32_t net_posix_getsockopt(int32_t sock, int32_t level, int32_t optname, void *optvalue, int32_t *optlen);
+static int32_t net_posix_getsockname(int32_t sock, sockaddr_t *name, int32_t *namelen);
+static int32_t net_posix_getpeername(int32_t sock, sockaddr_t *name, int32_t *namelen);
+static int32_t net_posix_close(int32_t sock, bool clone);
+static int32_t net_posix_shutdown(int32_t sock, int32_t mode);
+static int32_t net_posix_poll(int32_t sock, int32_t events);
+static int32_t net_posix_gethostbyname(net_if_handle_t *pnetif, sockaddr_t *addr, char_t *name);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Return value of a failed call: 0 for a timeout or a non blocking call without data, as LwIP.
+  */
+static int32_t net_posix_error(void)
+{
+  int32_t ret;
+
+  switch (errno)
+  {
+    case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif /* EWOULDBLOCK */
+      ret = 0;
+      break;
+    case ECONNRESET:
+    case ECONNREFUSED:
+    case EPIPE:
+    case ENOTCONN:
+      ret = NET_ERROR_DISCONNECTED;
+      break;
+    case EBADF:
+      ret = NET_ERROR_INVALID_SOCKET;
+      break;
+    default:
+      ret = NET_ERROR_SOCKET_FAILURE;
+      break;
+  }
+  return ret;
+}
+
+/**
+  * @brief  Return value of a data call: 0 (peer closed the connection) becomes NET_ERROR_DISCONNECTED.
+  */
+static int32_t net_posix_data_ret(ssize_t n)
+{
+  int32_t ret;
+
+  if (n < 0)
+  {
+    ret = net_posix_error();
+  }
+  else if (n == 0)
+  {
+    ret = NET_ERROR_DISCONNECTED;
+  }
+  else
+  {
+    ret = (int32_t) n;
+  }
+  return ret;
+}
+
+static int net_posix_flags(int32_t flags)
+{
+  return MSG_NOSIGNAL | ((((uint32_t) flags & NET_MSG_DONTWAIT) != 0U) ? MSG_DONTWAIT : 0);
+}
+
+static int32_t net_posix_to_sockaddr(const sockaddr_t *addr, int32_t addrlen, struct sockaddr_in *sa)
+{
+  const sockaddr_in_t *in = (const sockaddr_in_t *) addr;
+
+  if ((addr == NULL) || (addrlen < (int32_t) sizeof(sockaddr_in_t)) || (in->sin_family != NET_AF_INET))
+  {
+    return NET_ERROR_PARAMETER;
+  }
+  (void) memset(sa, 0, sizeof(*sa));
+  sa->sin_family = AF_INET;
+  sa->sin_port = in->sin_port;          /* Both are in network order. */
+  sa->sin_addr.s_addr = in->sin_addr;
+  return NET_OK;
+}
+
+static void net_posix_from_sockaddr(const struct sockaddr_in *sa, sockaddr_t *addr, int32_t *addrlen)
+{
+  sockaddr_in_t *in = (sockaddr_in_t *) addr;
+
+  if ((addr != NULL) && ((addrlen == NULL) || (*addrlen >= (int32_t) sizeof(sockaddr_in_t))))
+  {
+    (void) memset(in, 0, sizeof(*in));
+    in->sin_len = sizeof(sockaddr_in_t);
+    in->sin_family = NET_AF_INET;
+    in->sin_port = sa->sin_port;
+    in->sin_addr = sa->sin_addr.s_addr;
+    if (addrlen != NULL)
+    {
+      *addrlen = (int32_t) sizeof(sockaddr_in_t);
+    }
+  }
+}
+
+/* Functions Definition ------------------------------------------------------*/
+int32_t net_posix_driver(net_if_handle_t *pnetif)
+{
+  return net_posix_if_init(pnetif);
+}
+
+/**
+  * @brief  Bring the interface up, as the applications do (cloud.c): init, start, connect.
+  * @param  pnetif network interface, kept by the caller until net_if_deinit()
+  * @retval NET_OK once connected, an error code otherwise
+  */
+int32_t net_host_if_up(net_if_handle_t *pnetif)
+{
+  int32_t ret;
+
+  (void) memset(pnetif, 0, sizeof(*pnetif));
+  ret = net_if_init(pnetif, net_posix_driver, NULL);
+  if (ret == NET_OK)
+  {
+    ret = net_if_wait_state(pnetif, NET_STATE_INITIALIZED, NET_POSIX_STATE_TIMEOUT);
+  }
+  if (ret == NET_OK)
+  {
+    ret = net_if_start(pnetif);
+  }
+  if (ret == NET_OK)
+  {
+    ret = net_if_connect(pnetif);
+  }
+  if (ret == NET_OK)
+  {
+    ret = net_if_wait_state(pnetif, NET_STATE_CONNECTED, NET_POSIX_STATE_TIMEOUT);
+  }
+  return ret;
+}
+
+/* Interface -----------------------------------------------------------------*/
+static int32_t net_posix_if_init(net_if_handle_t *pnetif)
+{
+  int32_t ret;
+  net_if_drv_t *p = NET_MALLOC(sizeof(net_if_drv_t));
+
+  if (p != NULL)
+  {
+    (void) memset(p, 0, sizeof(*p));
+    p->if_class = NET_INTERFACE_CLASS_ETHERNET;
+
+    p->if_init = net_posix_if_init;
+    p->if_deinit = net_posix_if_deinit;
+
+    p->if_start = net_posix_if_start;
+    p->if_stop = net_posix_if_stop;
+
+    p->if_connect = net_posix_if_connect;
+    p->if_disconnect = net_posix_if_disconnect;
+
+    p->socket = net_posix_socket;
+    p->bind = net_posix_bind;
+    p->listen = net_posix_listen;
+    p->accept = net_posix_accept;
+    p->connect = net_posix_connect;
+    p->send = net_posix_send;
+    p->recv = net_posix_recv;
+    p->sendto = net_posix_sendto;
+    p->recvfrom = net_posix_recvfrom;
+    p->setsockopt = net_posix_setsockopt;
+    p->getsockopt = net_posix_getsockopt;
+    p->getsockname = net_posix_getsockname;
+    p->getpeername = net_posix_getpeername;
+    p->close = net_posix_close;
+    p->shutdown = net_posix_shutdown;
+    p->poll = net_posix_poll;
+
+    p->gethostbyname = net_posix_gethostbyname;
+    pnetif->pdrv = p;
+    ret = NET_OK;
+    net_if_notify(pnetif, NET_EVENT_STATE_CHANGE, (uint32_t) NET_STATE_INITIALIZED, NULL);
+  }
+  else
+  {
+    NET_DBG_ERROR("can't allocate memory for net_posix_driver class\n");
+    ret = NET_ERROR_NO_MEMORY;
+  }
+  return ret;
+}
+
+static int32_t net_posix_if_deinit(net_if_handle_t *pnetif)
+{
+  NET_FREE(pnetif->pdrv);
+  pnetif->pdrv = NULL;
+  return NET_OK;
+}
+
+static int32_t net_posix_if_start(net_if_handle_t *pnetif)
+{
+  (void) strncpy(pnetif->DeviceName, "host", NET_DEVICE_NAME_LEN);
+  net_if_notify(pnetif, NET_EVENT_STATE_CHANGE, (uint32_t) NET_STATE_STARTED, NULL);
+  return NET_OK;
+}
+
+static int32_t net_posix_if_stop(net_if_handle_t *pnetif)
+{
+  net_if_notify(pnetif, NET_EVENT_STATE_CHANGE, (uint32_t) NET_STATE_STOPPED, NULL);
+  return NET_OK;
+}
+
+/**
+  * @brief  The host is connected: the interface address is the loopback one, the routes are the host ones.
+  */
+static int32_t net_posix_if_connect(net_if_handle_t *pnetif)
+{
+  pnetif->ipaddr = htonl(INADDR_LOOPBACK);
+  net_if_notify(pnetif, NET_EVENT_STATE_CHANGE, (uint32_t) NET_STATE_CONNECTED, NULL);
+  return NET_OK;
+}
+
+static int32_t net_posix_if_disconnect(net_if_handle_t *pnetif)
+{
+  net_if_notify(pnetif, NET_EVENT_STATE_CHANGE, (uint32_t) NET_STATE_DISCONNECTED, NULL);
+  return NET_OK;
+}
+
+/* Sockets -------------------------------------------------------------------*/
+static int32_t net_posix_socket(int32_t domain, int32_t type, int32_t protocol)
+{
+  int posix_type;
+  int posix_protocol;
+  int fd;
+
+  if (domain != NET_AF_INET)
+  {
+    return NET_ERROR_UNSUPPORTED;
+  }
+  switch (type)
+  {
+    case NET_SOCK_STREAM:
+      posix_type = SOCK_STREAM;
+      break;
+    case NET_SOCK_DGRAM:
+      posix_type = SOCK_DGRAM;
+      break;
+    default:
+      return NET_ERROR_UNSUPPORTED;
+  }
+  switch (protocol)
+  {
+    case NET_IPPROTO_TCP:
+      posix_protocol = IPPROTO_TCP;
+      break;
+    case NET_IPPROTO_UDP:
+      posix_protocol = IPPROTO_UDP;
+      break;
+    default:
+      posix_protocol = 0;
+      break;
+  }
+  fd = socket(AF_INET, posix_type, posix_protocol);
+  return (fd < 0) ? NET_ERROR_OUT_OF_SOCKET : (int32_t) fd;
+}
+
+static int32_t net_posix_bind(int32_t sock, const sockaddr_t *addr, int32_t addrlen)
+{
+  struct sockaddr_in sa;
+  int one = 1;
+
+  if (net_posix_to_sockaddr(addr, addrlen, &sa) != NET_OK)
+  {
+    return NET_ERROR_PARAMETER;
+  }
+  (void) setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  return (bind(sock, (struct sockaddr *) &sa, sizeof(sa)) == 0) ? NET_OK : net_posix_error();
+}
+
+static int32_t net_posix_listen(int32_t sock, int32_t backlog)
+{
+  return (listen(sock, backlog) == 0) ? NET_OK : net_posix_error();
+}
+
+static int32_t net_posix_accept(int32_t sock, sockaddr_t *addr, int32_t *addrlen)
+{
+  struct sockaddr_in sa;
+  socklen_t len = sizeof(sa);
+  int fd;
+
+  fd = accept(sock, (struct sockaddr *) &sa, &len);
+  if (fd < 0)
+  {
+    return net_posix_error();
+  }
+  net_posix_from_sockaddr(&sa, addr, addrlen);
+  return (int32_t) fd;
+}
+
+/**
+  * @brief  Connect. The records of the protocols are small and answered: they are sent at once (TCP_NODELAY),
+  *         the host stack would otherwise hold them for the acknowledge of the previous one.
+  */
+static int32_t net_posix_connect(int32_t sock, const sockaddr_t *addr, int32_t addrlen)
+{
+  struct sockaddr_in sa;
+  int one = 1;
+
+  if (net_posix_to_sockaddr(addr, addrlen, &sa) != NET_OK)
+  {
+    return NET_ERROR_PARAMETER;
+  }
+  if (connect(sock, (struct sockaddr *) &sa, sizeof(sa)) != 0)
+  {
+    return (errno == ECONNREFUSED) ? NET_ERROR_SOCKET_FAILURE : net_posix_error();
+  }
+  (void) setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  return NET_OK;
+}
+
+static int32_t net_posix_send(int32_t sock, uint8_t *buf, int32_t len, int32_t flags)
+{
+  return net_posix_data_ret(send(sock, buf, (size_t) len, net_posix_flags(flags)));
+}
+
+static int32_t net_posix_recv(int32_t sock, uint8_t *buf, int32_t len, int32_t flags)
+{
+  return net_posix_data_ret(recv(sock, buf, (size_t) len, net_posix_flags(flags)));
+}
+
+static int32_t net_posix_sendto(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *to, int32_t tolen)
+{
+  struct sockaddr_in sa;
+
+  if (net_posix_to_sockaddr(to, tolen, &sa) != NET_OK)
+  {
+    return NET_ERROR_PARAMETER;
+  }
+  return net_posix_data_ret(sendto(sock, buf, (size_t) len, net_posix_flags(flags), (struct sockaddr *) &sa,
+                                   sizeof(sa)));
+}
+
+static int32_t net_posix_recvfrom(int32_t sock, uint8_t *buf, int32_t len, int32_t flags, sockaddr_t *from,
+                                  int32_t *fromlen)
+{
+  struct sockaddr_in sa;
+  socklen_t sa_len = sizeof(sa);
+  int32_t ret;
+
+  ret = net_posix_data_ret(recvfrom(sock, buf, (size_t) len, net_posix_flags(flags), (struct sockaddr *) &sa,
+                                    &sa_len));
+  if (ret > 0)
+  {
+    net_posix_from_sockaddr(&sa, from, fromlen);
+  }
+  return ret;
+}
+
+/**
+  * @brief  Socket options: the timeouts, in ms (0 waits forever, as with LwIP). The other options of the
+  *         network library are not BSD socket options.
+  */
+static int32_t net_posix_setsockopt(int32_t sock, int32_t level, int32_t optname, const void *optvalue,
+                                    int32_t optlen)
+{
+  struct timeval tv;
+  uint32_t timeout;
+
+  if ((level != NET_SOL_SOCKET) || ((optname != (int32_t) NET_SO_RCVTIMEO) && (optname != (int32_t) NET_SO_SNDTIMEO)))
+  {
+    return NET_ERROR_UNSUPPORTED;
+  }
+  if ((optvalue == NULL) || (optlen != (int32_t) sizeof(uint32_t)))
+  {
+    return NET_ERROR_PARAMETER;
+  }
+  (void) memcpy(&timeout, optvalue, sizeof(timeout));
+  tv.tv_sec = (time_t)(timeout / 1000U);
+  tv.tv_usec = (suseconds_t)(timeout % 1000U) * 1000;
+  return (setsockopt(sock, SOL_SOCKET, (optname == (int32_t) NET_SO_RCVTIMEO) ? SO_RCVTIMEO : SO_SNDTIMEO,
+                     &tv, sizeof(tv)) == 0) ? NET_OK : net_posix_error();
+}
+
+static int32_t net_posix_getsockopt(int32_t sock, int32_t level, int32_t optname, void *optvalue, int32_t *optlen)
+{
+  (void) sock;
+  (void) level;
+  (void) optname;
+  (void) optvalue;
+  (void) optlen;
+  return NET_ERROR_UNSUPPORTED;
+}
+
+static int32_t net_posix_getsockname(int32_t sock, sockaddr_t *name, int32_t *namelen)
+{
+  struct sockaddr_in sa;
+  socklen_t len = sizeof(sa);
+
+  if (getsockname(sock, (struct sockaddr *) &sa, &len) != 0)
+  {
+    return net_posix_error();
+  }
+  net_posix_from_sockaddr(&sa, name, namelen);
+  return NET_OK;
+}
+
+static int32_t net_posix_getpeername(int32_t sock, sockaddr_t *name, int32_t *namelen)
+{
+  struct sockaddr_in sa;
+  socklen_t len = sizeof(sa);
+
+  if (getpeername(sock, (struct sockaddr *) &sa, &len) != 0)
+  {
+    return net_posix_error();
+  }
+  net_posix_from_sockaddr(&sa, name, namelen);
+  return NET_OK;
+}
+
+static int32_t net_posix_close(int32_t sock, bool clone)
+{
+  (void) clone;
+  return (close(sock) == 0) ? NET_OK : NET_ERROR_CLOSE_SOCKET;
+}
+
+static int32_t net_posix_shutdown(int32_t sock, int32_t mode)
+{
+  int how = (mode == NET_SHUTDOWN_R) ? SHUT_RD : ((mode == NET_SHUTDOWN_W) ? SHUT_WR : SHUT_RDWR);
+
+  return (shutdown(sock, how) == 0) ? NET_OK : net_posix_error();
+}
+
+static int32_t net_posix_poll(int32_t sock, int32_t events)
+{
+  struct pollfd pfd;
+  int32_t ret = 0;
+
+  pfd.fd = sock;
+  pfd.events = (short)(((events & NET_POLLIN) != 0) ? POLLIN : 0) | (short)(((events & NET_POLLOUT) != 0) ? POLLOUT : 0);
+  pfd.revents = 0;
+  if (poll(&pfd, 1, 0) < 0)
+  {
+    return NET_ERROR_SOCKET_FAILURE;
+  }
+  ret |= ((pfd.revents & POLLIN) != 0) ? NET_POLLIN : 0;
+  ret |= ((pfd.revents & POLLOUT) != 0) ? NET_POLLOUT : 0;
+  ret |= ((pfd.revents & POLLERR) != 0) ? NET_POLLERR : 0;
+  ret |= ((pfd.revents & POLLHUP) != 0) ? NET_POLLHUP : 0;
+  ret |= ((pfd.revents & POLLNVAL) != 0) ? NET_POLLNVAL : 0;
+  return ret;
+}
+
+/* Services ------------------------------------------------------------------*/
+static int32_t net_posix_gethostbyname(net_if_handle_t *pnetif, sockaddr_t *addr, char_t *name)
+{
+  struct addrinfo hints;
+  struct addrinfo *res = NULL;
+  int32_t ret = NET_ERROR_DNS_FAILURE;
+
+  (void) pnetif;
+  (void) memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if ((getaddrinfo((const char *) name, NULL, &hints, &res) == 0) && (res != NULL))
+  {
+    net_posix_from_sockaddr((const struct sockaddr_in *) res->ai_addr, addr, NULL);
+    ret = NET_OK;
+  }
+  if (res != NULL)
+  {
+    freeaddrinfo(res);
+  }
+  return ret;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
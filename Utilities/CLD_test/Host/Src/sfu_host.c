@@ -0,0 +1,429 @@
+/**
+  ******************************************************************************
+  * @file    sfu_host.c
+  * @author  MCD Application Team
+  * @brief   Host run of the SBSFU FW image handling: simulated FLASH with power cut injection, Secure Engine
+  *          stand-in (AES-128-CBC decryption, SHA-256 FW tag and header MAC) and boot sequence of the SBSFU state
+  *          machine (sfu_boot.c / sfu_fwimg_services.c).
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include "mbedtls/aes.h"
+#include "mbedtls/sha256.h"
+#include "sfu_host.h"
+#include "flash.h"
+#include "sfu_fsm_states.h"
+#include "sfu_error.h"
+#include "sfu_low_level_security.h"
+#include "se_interface_bootloader.h"
+#include "sfu_low_level.h"
+#include "sfu_fwimg_services.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define SFU_HOST_HEADER_SIGNED_LEN  ((uint32_t)offsetof(SE_FwRawHeaderTypeDef, HeaderMAC))
+
+/* Private variables ---------------------------------------------------------*/
+sfu_host_flash_t sfu_host_flash;
+static jmp_buf sfu_host_power_cut;  /* longjmp() target of the FLASH operation interrupted by the power cut */
+uint8_t initialDeviceStatusCheck = 1U;
+
+static const uint8_t sfu_host_key[16] = {0x4f, 0x45, 0x4d, 0x5f, 0x4b, 0x45, 0x59, 0x5f,
+                                         0x43, 0x4f, 0x4d, 0x50, 0x41, 0x4e, 0x59, 0x31
+                                        };
+static mbedtls_aes_context sfu_host_aes;
+static uint8_t sfu_host_iv[16];
+static mbedtls_sha256_context sfu_host_sha;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Count a FLASH operation.
+  * @retval 1 if the power is cut during this operation, 0 otherwise.
+  */
+static int sfu_host_flash_op(void)
+{
+  sfu_host_flash.Ops++;
+  return (sfu_host_flash.Ops == sfu_host_flash.CutOp) ? 1 : 0;
+}
+
+static int sfu_host_flash_range(uint32_t Address, uint32_t Length)
+{
+  return ((Address >= FLASH_BASE) && (Length <= SFU_HOST_FLASH_SIZE)
+          && ((Address - FLASH_BASE) <= (SFU_HOST_FLASH_SIZE - Length))) ? 1 : 0;
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Map the simulated FLASH (fully erased) at its STM32 address.
+  */
+void sfu_host_flash_init(void)
+{
+  void *flash = mmap(SFU_HOST_FLASH, SFU_HOST_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+  if (flash != (void *)SFU_HOST_FLASH)
+  {
+    printf("cannot map the simulated FLASH at 0x%08x\n", (unsigned int)FLASH_BASE);
+    exit(2);
+  }
+  memset(flash, 0xFF, SFU_HOST_FLASH_SIZE);
+  memset(&sfu_host_flash, 0, sizeof(sfu_host_flash));
+}
+
+/**
+  * @brief  FLASH erase: the pages containing [pStart, pStart + Length - 1] (same convention as the board driver).
+  *         A power cut leaves the interrupted page half erased.
+  */
+SFU_ErrorStatus SFU_LL_FLASH_Erase_Size(SFU_FLASH_StatusTypeDef *pxFlashStatus, void *pStart, uint32_t Length)
+{
+  uint32_t start = (uint32_t)(uintptr_t)pStart;
+  uint32_t page;
+  uint32_t last;
+
+  *pxFlashStatus = SFU_FLASH_ERR_ERASE;
+  if ((Length == 0U) || (sfu_host_flash_range(start, Length) == 0))
+  {
+    sfu_host_flash.Violations++;
+    return SFU_ERROR;
+  }
+  last = (start + Length - 1U - FLASH_BASE) / FLASH_PAGE_SIZE;
+  for (page = (start - FLASH_BASE) / FLASH_PAGE_SIZE; page <= last; page++)
+  {
+    if (sfu_host_flash_op() != 0)
+    {
+      memset(SFU_HOST_FLASH + (page * FLASH_PAGE_SIZE), 0xFF, FLASH_PAGE_SIZE / 2U);
+      longjmp(sfu_host_power_cut, 1);
+    }
+    memset(SFU_HOST_FLASH + (page * FLASH_PAGE_SIZE), 0xFF, FLASH_PAGE_SIZE);
+    sfu_host_flash.PageErases++;
+  }
+  *pxFlashStatus = SFU_FLASH_SUCCESS;
+  return SFU_SUCCESS;
+}
+
+/**
+  * @brief  FLASH programming by double-words. A double-word can only be programmed after an erase, except with 0s.
+  *         A power cut leaves the first half of the double-words programmed.
+  */
+SFU_ErrorStatus SFU_LL_FLASH_Write(SFU_FLASH_StatusTypeDef *pxFlashStatus, void *pDestination, const void *pSource,
+                                   uint32_t Length)
+{
+  static const uint8_t erased[sizeof(SFU_LL_FLASH_write_t)] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  static const uint8_t zero[sizeof(SFU_LL_FLASH_write_t)] = {0};
+  uint8_t *dest = (uint8_t *)pDestination;
+  const uint8_t *src = (const uint8_t *)pSource;
+  uint32_t count = Length / sizeof(SFU_LL_FLASH_write_t);
+  uint32_t i;
+  int cut;
+
+  *pxFlashStatus = SFU_FLASH_ERR_WRITING;
+  if (((Length % sizeof(SFU_LL_FLASH_write_t)) != 0U) || ((((uintptr_t)dest) % sizeof(SFU_LL_FLASH_write_t)) != 0U)
+      || (sfu_host_flash_range((uint32_t)(uintptr_t)dest, Length) == 0))
+  {
+    sfu_host_flash.Violations++;
+    return SFU_ERROR;
+  }
+  cut = sfu_host_flash_op();
+  if ((sfu_host_flash.WatchOp == 0U) && (sfu_host_flash.WatchAddress >= (uint32_t)(uintptr_t)dest)
+      && (sfu_host_flash.WatchAddress < ((uint32_t)(uintptr_t)dest + Length)))
+  {
+    sfu_host_flash.WatchOp = sfu_host_flash.Ops;
+  }
+  if (cut != 0)
+  {
+    count /= 2U;
+  }
+  for (i = 0U; i < count; i++)
+  {
+    if ((memcmp(dest, erased, sizeof(erased)) != 0) && (memcmp(src, zero, sizeof(zero)) != 0))
+    {
+      sfu_host_flash.Violations++;
+      return SFU_ERROR;
+    }
+    memcpy(dest, src, sizeof(SFU_LL_FLASH_write_t));
+    dest += sizeof(SFU_LL_FLASH_write_t);
+    src += sizeof(SFU_LL_FLASH_write_t);
+    sfu_host_flash.ProgrammedBytes += sizeof(SFU_LL_FLASH_write_t);
+  }
+  if (cut != 0)
+  {
+    longjmp(sfu_host_power_cut, 1);
+  }
+  *pxFlashStatus = SFU_FLASH_SUCCESS;
+  return SFU_SUCCESS;
+}
+
+/**
+  * @brief  FLASH driver of the applications (flash.h), used by the firmware download (rfu.c).
+  * @retval 0 (HAL_OK) on success, 1 (HAL_ERROR) otherwise.
+  */
+int FLASH_Erase_Size(uint32_t uStart, uint32_t uLength)
+{
+  SFU_FLASH_StatusTypeDef status;
+
+  return (SFU_LL_FLASH_Erase_Size(&status, (void *)(uintptr_t)uStart, uLength) == SFU_SUCCESS) ? 0 : 1;
+}
+
+int FLASH_Write(uint32_t uDestination, uint32_t *pSource, uint32_t uLength)
+{
+  SFU_FLASH_StatusTypeDef status;
+
+  return (SFU_LL_FLASH_Write(&status, (void *)(uintptr_t)uDestination, pSource, uLength) == SFU_SUCCESS) ? 0 : 1;
+}
+
+SFU_ErrorStatus SFU_LL_FLASH_Read(void *pDestination, const void *pSource, uint32_t Length)
+{
+  memcpy(pDestination, pSource, Length);
+  return SFU_SUCCESS;
+}
+
+SFU_ErrorStatus SFU_LL_SECU_IWDG_Refresh(void)
+{
+  return SFU_SUCCESS;
+}
+
+void SFU_LL_SB_SRAM_Erase(void)
+{
+}
+
+SFU_ErrorStatus SFU_BOOT_SetLastExecError(uint32_t uLastExecError)
+{
+  (void)uLastExecError;
+  return SFU_SUCCESS;
+}
+
+/**
+  * @brief  Header MAC of the stand-in: SHA-256 of the header fields, twice (the VALID tags and the swap magic are
+  *         made of parts of the MAC, they must not be constant).
+  */
+void sfu_host_sign_header(SE_FwRawHeaderTypeDef *pHeader)
+{
+  (void)mbedtls_sha256_ret((const uint8_t *)pHeader, SFU_HOST_HEADER_SIGNED_LEN, pHeader->HeaderMAC, 0);
+  (void)mbedtls_sha256_ret(pHeader->HeaderMAC, 32U, &pHeader->HeaderMAC[32], 0);
+}
+
+void sfu_host_fw_tag(const uint8_t *pFw, uint32_t Size, uint8_t *pTag)
+{
+  (void)mbedtls_sha256_ret(pFw, Size, pTag, 0);
+}
+
+/**
+  * @brief  Downloadable image (.sfb) of a candidate FW, as programmed in slot #1: header, erased bytes up to
+  *         SFU_IMG_IMAGE_OFFSET, and encrypted FW or payload.
+  * @param  pCandidate header of the candidate FW
+  * @param  pPayload clear FW, or clear payload of a delta / compressed image (PatchSize bytes)
+  * @param  pImage image, of SFU_IMG_IMAGE_OFFSET + FW (or payload) size bytes
+  */
+void sfu_host_image(const SE_FwRawHeaderTypeDef *pCandidate, const uint8_t *pPayload, uint8_t *pImage)
+{
+  mbedtls_aes_context aes;
+  uint8_t iv[16];
+  uint32_t size = (pCandidate->PatchSize != 0U) ? pCandidate->PatchSize : pCandidate->FwSize;
+
+  memset(pImage, 0xFF, SFU_IMG_IMAGE_OFFSET);
+  memcpy(pImage, pCandidate, sizeof(*pCandidate));
+  memcpy(iv, pCandidate->InitVector, sizeof(iv));
+  mbedtls_aes_init(&aes);
+  (void)mbedtls_aes_setkey_enc(&aes, sfu_host_key, 128U);
+  (void)mbedtls_aes_crypt_cbc(&aes, MBEDTLS_AES_ENCRYPT, size, iv, pPayload, pImage + SFU_IMG_IMAGE_OFFSET);
+  mbedtls_aes_free(&aes);
+}
+
+/**
+  * @brief  FLASH content once a candidate FW has been downloaded (the rest of the FLASH is erased):
+  *         active FW tagged VALID in slot #0, header and encrypted FW or payload in slot #1, header followed by 0s in
+  *         the swap area (installation request).
+  * @param  pActive header of the active FW, NULL for none
+  * @param  pActiveFw active FW
+  * @param  pCandidate header of the candidate FW, NULL for none (slot #1 and swap area erased)
+  * @param  pPayload clear FW, or clear payload of a delta / compressed image (PatchSize bytes)
+  */
+void sfu_host_download(const SE_FwRawHeaderTypeDef *pActive, const uint8_t *pActiveFw,
+                       const SE_FwRawHeaderTypeDef *pCandidate, const uint8_t *pPayload)
+{
+  uint32_t i;
+
+  memset(SFU_HOST_FLASH, 0xFF, SFU_HOST_FLASH_SIZE);
+  if (pActive != NULL)
+  {
+    memcpy(SFU_IMG_SLOT_0_REGION_BEGIN, pActive, sizeof(*pActive));
+    for (i = 0U; i < 3U; i++)
+    {
+      memcpy(SFU_IMG_SLOT_0_REGION_BEGIN + sizeof(*pActive) + (i * 32U), pActive->HeaderMAC, 32U);
+    }
+    memcpy(SFU_IMG_SLOT_0_REGION_BEGIN + SFU_IMG_IMAGE_OFFSET, pActiveFw, pActive->FwSize);
+  }
+  if (pCandidate != NULL)
+  {
+    sfu_host_image(pCandidate, pPayload, SFU_IMG_SLOT_1_REGION_BEGIN);
+    memset(SFU_IMG_SWAP_REGION_BEGIN, 0, SFU_IMG_IMAGE_OFFSET);
+    memcpy(SFU_IMG_SWAP_REGION_BEGIN, pCandidate, sizeof(*pCandidate));
+  }
+}
+
+int sfu_host_is_active(const SE_FwRawHeaderTypeDef *pHeader, const uint8_t *pFw)
+{
+  return ((memcmp(SFU_IMG_SLOT_0_REGION_BEGIN, pHeader, sizeof(*pHeader)) == 0)
+          && (memcmp(SFU_IMG_SLOT_0_REGION_BEGIN + SFU_IMG_IMAGE_OFFSET, pFw, pHeader->FwSize) == 0)) ? 1 : 0;
+}
+
+/* Secure Engine stand-in ----------------------------------------------------*/
+SE_ErrorStatus SE_VerifyFwRawHeaderTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxFwRawHeader)
+{
+  SE_FwRawHeaderTypeDef header;
+
+  memcpy(&header, pxFwRawHeader, sizeof(header));
+  sfu_host_sign_header(&header);
+  *peSE_Status = (memcmp(header.HeaderMAC, pxFwRawHeader->HeaderMAC, sizeof(header.HeaderMAC)) == 0) ? SE_OK : SE_KO;
+  return (*peSE_Status == SE_OK) ? SE_SUCCESS : SE_ERROR;
+}
+
+SE_ErrorStatus SE_VerifyFwTag(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata,
+                              SE_FwAreaTypeDef *pxFwArea, uint32_t Flags)
+{
+  uint8_t tag[SE_TAG_LEN];
+  uint32_t i;
+
+  (void)Flags;
+  mbedtls_sha256_init(&sfu_host_sha);
+  (void)mbedtls_sha256_starts_ret(&sfu_host_sha, 0);
+  for (i = 0U; i < 2U; i++)
+  {
+    (void)mbedtls_sha256_update_ret(&sfu_host_sha, pxFwArea->pArea[i], pxFwArea->AreaSize[i]);
+  }
+  (void)mbedtls_sha256_finish_ret(&sfu_host_sha, tag);
+  *peSE_Status = (memcmp(tag, pxSE_Metadata->FwTag, sizeof(tag)) == 0) ? SE_OK : SE_KO;
+  return (*peSE_Status == SE_OK) ? SE_SUCCESS : SE_ERROR;
+}
+
+SE_ErrorStatus SE_Decrypt_Init(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata)
+{
+  memcpy(sfu_host_iv, pxSE_Metadata->InitVector, sizeof(sfu_host_iv));
+  mbedtls_aes_init(&sfu_host_aes);
+  (void)mbedtls_aes_setkey_dec(&sfu_host_aes, sfu_host_key, 128U);
+  *peSE_Status = SE_OK;
+  return SE_SUCCESS;
+}
+
+SE_ErrorStatus SE_Decrypt_Append(SE_StatusTypeDef *peSE_Status, const uint8_t *pInputBuffer, int32_t InputSize,
+                                 uint8_t *pOutputBuffer, int32_t *pOutputSize)
+{
+  if ((InputSize <= 0) || ((InputSize % 16) != 0)
+      || (mbedtls_aes_crypt_cbc(&sfu_host_aes, MBEDTLS_AES_DECRYPT, (size_t)InputSize, sfu_host_iv, pInputBuffer,
+                                pOutputBuffer) != 0))
+  {
+    *peSE_Status = SE_KO;
+    return SE_ERROR;
+  }
+  *pOutputSize = InputSize;
+  *peSE_Status = SE_OK;
+  return SE_SUCCESS;
+}
+
+SE_ErrorStatus SE_Decrypt_Finish(SE_StatusTypeDef *peSE_Status, uint8_t *pOutputBuffer, int32_t *pOutputSize)
+{
+  (void)pOutputBuffer;
+  mbedtls_aes_free(&sfu_host_aes);
+  *pOutputSize = 0;
+  *peSE_Status = SE_OK;
+  return SE_SUCCESS;
+}
+
+SE_ErrorStatus SE_AuthenticateFW_Init(SE_StatusTypeDef *peSE_Status, SE_FwRawHeaderTypeDef *pxSE_Metadata)
+{
+  (void)pxSE_Metadata;
+  mbedtls_sha256_init(&sfu_host_sha);
+  (void)mbedtls_sha256_starts_ret(&sfu_host_sha, 0);
+  *peSE_Status = SE_OK;
+  return SE_SUCCESS;
+}
+
+SE_ErrorStatus SE_AuthenticateFW_Append(SE_StatusTypeDef *peSE_Status, const uint8_t *pInputBuffer,
+                                        int32_t InputSize, uint8_t *pOutputBuffer, int32_t *pOutputSize)
+{
+  (void)pOutputBuffer;
+  (void)mbedtls_sha256_update_ret(&sfu_host_sha, pInputBuffer, (size_t)InputSize);
+  *pOutputSize = InputSize;
+  *peSE_Status = SE_OK;
+  return SE_SUCCESS;
+}
+
+SE_ErrorStatus SE_AuthenticateFW_Finish(SE_StatusTypeDef *peSE_Status, uint8_t *pOutputBuffer, int32_t *pOutputSize)
+{
+  (void)mbedtls_sha256_finish_ret(&sfu_host_sha, pOutputBuffer);
+  *pOutputSize = SE_TAG_LEN;
+  *peSE_Status = SE_OK;
+  return SE_SUCCESS;
+}
+
+/* Boot sequence -------------------------------------------------------------*/
+/**
+  * @brief  FW image handling steps of the SBSFU state machine (sfu_boot.c), from the FW status check to the FW launch.
+  */
+static sfu_host_boot_t sfu_host_boot_sequence(void)
+{
+  sfu_host_boot_t boot = SFU_HOST_BOOT_FAILED;
+
+  if (SFU_IMG_InitImageHandling() != SFU_IMG_INIT_OK)
+  {
+    return boot;
+  }
+  switch (SFU_IMG_CheckPendingInstallation())
+  {
+    case SFU_IMG_FWUPDATE_STOPPED:
+      /* SFU_BOOT_SM_RollbackPrevUserFw() */
+      if (SFU_IMG_TriggerRecoveryProcedure() == SFU_SUCCESS)
+      {
+        boot = SFU_HOST_BOOT_RECOVERED;
+      }
+      break;
+    case SFU_IMG_FWIMAGE_TO_INSTALL:
+      /* SFU_BOOT_SM_InstallNewUserFw() */
+      if ((SFU_IMG_CheckCandidateMetadata() == SFU_SUCCESS) && (SFU_IMG_CheckCandidateImage() == SFU_SUCCESS)
+          && (SFU_IMG_TriggerImageInstallation() == SFU_SUCCESS))
+      {
+        boot = SFU_HOST_BOOT_INSTALLED;
+      }
+      break;
+    default:
+      /* SFU_BOOT_SM_VerifyUserFwSignature() */
+      boot = (SFU_IMG_HasValidActiveFirmware() == SFU_SUCCESS) ? SFU_HOST_BOOT_RUN : SFU_HOST_BOOT_NO_FW;
+      break;
+  }
+  (void)SFU_IMG_ShutdownImageHandling();
+  return boot;
+}
+
+/**
+  * @brief  One boot.
+  * @param  CutOp FLASH operation interrupted by a power cut (1 for the first one), 0 for none
+  */
+sfu_host_boot_t sfu_host_boot(uint32_t CutOp)
+{
+  sfu_host_flash.Ops = 0U;
+  sfu_host_flash.PageErases = 0U;
+  sfu_host_flash.ProgrammedBytes = 0U;
+  sfu_host_flash.CutOp = CutOp;
+  sfu_host_flash.WatchOp = 0U;
+  if (setjmp(sfu_host_power_cut) != 0)
+  {
+    return SFU_HOST_BOOT_CUT;
+  }
+  return sfu_host_boot_sequence();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,436 @@
+/**
+  ******************************************************************************
+  * @file    test_fwimg_delta.c
+  * @author  MCD Application Team
+  * @brief   Host test of the delta and compressed image installation of the SBSFU (sfu_fwimg_core.c of the
+  *          32L496GDISCOVERY project) on a simulated FLASH.
+  *          The installation is run once without interruption, then restarted from the same FLASH content with a
+  *          power cut at each FLASH operation in turn: the device must then boot on the new FW, or on the previous
+  *          one if the cut happened once the swap had started. The iteration count gives the number of installations
+  *          interrupted twice, at random operations.
+  *          Usage: test_fwimg_delta [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "sfu_host.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_FW_MAX           (64U * 1024U)
+#define TEST_PAYLOAD_MAX      (TEST_FW_MAX + (TEST_FW_MAX / 8U) + 1024U)
+#define TEST_BOOTS_MAX        (8U)           /*!< Boots allowed to get back to a running FW after a power cut */
+
+#define TEST_FW_NONE          (0)
+#define TEST_FW_OLD           (1)
+#define TEST_FW_NEW           (2)
+
+/* Payload format (see sfu_fwimg_core.c) */
+#define TEST_DELTA_MAGIC      (0x44554653U)  /* 'SFUD' */
+#define TEST_COMPRESS_MAGIC   (0x43554653U)  /* 'SFUC' */
+#define TEST_DELTA_HEADER_LEN (48U)
+#define TEST_OP_END           (0x00U)
+#define TEST_OP_COPY          (0x01U)
+#define TEST_OP_INSERT        (0x02U)
+#define TEST_LZ_WINDOW        (1024U)
+#define TEST_LZ_MIN_MATCH     (4U)
+#define TEST_LZ_LAST_LITERALS (5U)
+
+/* Swap magic of the trailer, at the end of slot #1: its first write starts the swap */
+#define TEST_TRAILER_INDEX    (SFU_IMG_SLOT_0_REGION_SIZE / SFU_IMG_SWAP_REGION_SIZE)
+#define TEST_TRAILER_MAGIC    (SFU_IMG_SLOT_1_REGION_BEGIN_VALUE + SFU_IMG_SLOT_1_REGION_SIZE \
+                               - (TEST_TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t)) - 32U)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  TEST_DELTA = 0,
+  TEST_COMPRESSED
+} test_payload_t;
+
+typedef struct
+{
+  const char *name;
+  test_payload_t type;
+  uint32_t old_size;
+  uint32_t new_size;
+} test_case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const test_case_t test_cases[] =
+{
+  { "delta",            TEST_DELTA,      24000U, 26123U },
+  { "delta small",      TEST_DELTA,      20000U,  3001U },
+  { "compressed",       TEST_COMPRESSED, 24000U, 30017U },
+  { "compressed small", TEST_COMPRESSED, 24000U,  5000U },
+};
+
+static uint8_t old_fw[TEST_FW_MAX];
+static uint8_t new_fw[TEST_FW_MAX];
+static uint8_t payload[TEST_PAYLOAD_MAX];
+static uint8_t snapshot[SFU_HOST_FLASH_SIZE];
+static SE_FwRawHeaderTypeDef old_header;
+static SE_FwRawHeaderTypeDef new_header;
+static uint32_t test_seed = 1U;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t test_rand(void)
+{
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 17;
+  test_seed ^= test_seed << 5;
+  return test_seed;
+}
+
+static void test_random_bytes(uint8_t *p, uint32_t len)
+{
+  uint32_t i;
+
+  for (i = 0U; i < len; i++)
+  {
+    p[i] = (uint8_t)test_rand();
+  }
+}
+
+static uint32_t test_put_u32(uint8_t *p, uint32_t n, uint32_t value)
+{
+  p[n] = (uint8_t)value;
+  p[n + 1U] = (uint8_t)(value >> 8);
+  p[n + 2U] = (uint8_t)(value >> 16);
+  p[n + 3U] = (uint8_t)(value >> 24);
+  return n + 4U;
+}
+
+/**
+  * @brief  Payload header: magic, active FW size, candidate FW size, window, active FW tag.
+  */
+static uint32_t test_payload_header(uint8_t *p, uint32_t magic, uint32_t base_size, uint32_t target_size,
+                                    uint32_t window, const uint8_t *base_tag)
+{
+  uint32_t n = test_put_u32(p, 0U, magic);
+
+  n = test_put_u32(p, n, base_size);
+  n = test_put_u32(p, n, target_size);
+  n = test_put_u32(p, n, window);
+  memset(&p[n], 0, SE_TAG_LEN);
+  if (base_tag != NULL)
+  {
+    memcpy(&p[n], base_tag, SE_TAG_LEN);
+  }
+  return TEST_DELTA_HEADER_LEN;
+}
+
+/**
+  * @brief  Candidate FW made of pieces of the active FW and of new bytes, and the patch producing it.
+  */
+static uint32_t test_build_delta(uint32_t old_size, uint32_t new_size)
+{
+  uint32_t n = test_payload_header(payload, TEST_DELTA_MAGIC, old_size, new_size, 0U, old_header.FwTag);
+  uint32_t pos = 0U;
+  uint32_t len;
+  uint32_t offset;
+
+  while (pos < new_size)
+  {
+    if ((test_rand() % 16U) == 0U)
+    {
+      /* Empty insertion */
+      payload[n++] = TEST_OP_INSERT;
+      n = test_put_u32(payload, n, 0U);
+      continue;
+    }
+    len = 1U + (test_rand() % 2000U);
+    len = (len < (new_size - pos)) ? len : (new_size - pos);
+    if (((test_rand() % 4U) != 0U) && (len <= old_size))
+    {
+      offset = test_rand() % (old_size - len + 1U);
+      memcpy(&new_fw[pos], &old_fw[offset], len);
+      payload[n++] = TEST_OP_COPY;
+      n = test_put_u32(payload, n, offset);
+      n = test_put_u32(payload, n, len);
+    }
+    else
+    {
+      test_random_bytes(&new_fw[pos], len);
+      payload[n++] = TEST_OP_INSERT;
+      n = test_put_u32(payload, n, len);
+      memcpy(&payload[n], &new_fw[pos], len);
+      n += len;
+    }
+    pos += len;
+  }
+  payload[n++] = TEST_OP_END;
+  return n;
+}
+
+static uint32_t test_lz_length(uint32_t n, uint32_t extra)
+{
+  while (extra >= 255U)
+  {
+    payload[n++] = 255U;
+    extra -= 255U;
+  }
+  payload[n++] = (uint8_t)extra;
+  return n;
+}
+
+/**
+  * @brief  LZ4 block sequence: literals then a match (match_len 0 for the last sequence).
+  */
+static uint32_t test_lz_sequence(uint32_t n, const uint8_t *literals, uint32_t lit_len, uint32_t offset,
+                                 uint32_t match_len)
+{
+  uint32_t lit_nibble = (lit_len < 15U) ? lit_len : 15U;
+  uint32_t match_nibble = 0U;
+
+  if (match_len != 0U)
+  {
+    match_nibble = ((match_len - TEST_LZ_MIN_MATCH) < 15U) ? (match_len - TEST_LZ_MIN_MATCH) : 15U;
+  }
+  payload[n++] = (uint8_t)((lit_nibble << 4) | match_nibble);
+  if (lit_nibble == 15U)
+  {
+    n = test_lz_length(n, lit_len - 15U);
+  }
+  memcpy(&payload[n], literals, lit_len);
+  n += lit_len;
+  if (match_len != 0U)
+  {
+    payload[n++] = (uint8_t)offset;
+    payload[n++] = (uint8_t)(offset >> 8);
+    if (match_nibble == 15U)
+    {
+      n = test_lz_length(n, match_len - TEST_LZ_MIN_MATCH - 15U);
+    }
+  }
+  return n;
+}
+
+/**
+  * @brief  Compressible candidate FW (random bytes and repeats of recent bytes), compressed with a greedy LZ4 search.
+  */
+static uint32_t test_build_compressed(uint32_t new_size)
+{
+  uint32_t window = TEST_LZ_WINDOW / ((test_rand() % 2U) + 1U);
+  uint32_t n = test_payload_header(payload, TEST_COMPRESS_MAGIC, 0U, new_size, window, NULL);
+  uint32_t pos = 0U;
+  uint32_t anchor = 0U;
+  uint32_t len;
+  uint32_t offset;
+  uint32_t best_len;
+  uint32_t best_offset;
+  uint32_t i;
+
+  while (pos < new_size)
+  {
+    len = 1U + (test_rand() % 300U);
+    len = (len < (new_size - pos)) ? len : (new_size - pos);
+    offset = 1U + (test_rand() % window);
+    if (((test_rand() % 3U) != 0U) && (offset <= pos))
+    {
+      /* Byte per byte: the repeat may overlap itself */
+      for (i = 0U; i < len; i++)
+      {
+        new_fw[pos + i] = new_fw[pos + i - offset];
+      }
+    }
+    else
+    {
+      test_random_bytes(&new_fw[pos], len);
+    }
+    pos += len;
+  }
+
+  pos = 0U;
+  while ((pos + TEST_LZ_MIN_MATCH + TEST_LZ_LAST_LITERALS) <= new_size)
+  {
+    best_len = 0U;
+    best_offset = 0U;
+    for (offset = 1U; (offset <= window) && (offset <= pos); offset++)
+    {
+      for (len = 0U; ((pos + len + TEST_LZ_LAST_LITERALS) < new_size) && (new_fw[pos + len] == new_fw[pos + len - offset]); len++)
+      {
+      }
+      if (len > best_len)
+      {
+        best_len = len;
+        best_offset = offset;
+      }
+    }
+    if (best_len >= TEST_LZ_MIN_MATCH)
+    {
+      n = test_lz_sequence(n, &new_fw[anchor], pos - anchor, best_offset, best_len);
+      pos += best_len;
+      anchor = pos;
+    }
+    else
+    {
+      pos++;
+    }
+  }
+  return test_lz_sequence(n, &new_fw[anchor], new_size - anchor, 0U, 0U);
+}
+
+static void test_header(SE_FwRawHeaderTypeDef *header, uint16_t version, const uint8_t *fw, uint32_t size)
+{
+  memset(header, 0, sizeof(*header));
+  header->SFUMagic = 0x4D554653U; /* 'SFUM' */
+  header->ProtocolVersion = 0x1U;
+  test_random_bytes(header->InitVector, sizeof(header->InitVector));
+  header->FwVersion = version;
+  header->FwSize = size;
+  sfu_host_fw_tag(fw, size, header->FwTag);
+}
+
+/**
+  * @brief  Images of a test case, downloaded in the FLASH (snapshot kept to restart the installation).
+  * @param  corrupt 1 to alter the candidate FW tag
+  * @retval Payload size
+  */
+static uint32_t test_setup(const test_case_t *tc, int corrupt)
+{
+  uint32_t size;
+
+  test_random_bytes(old_fw, tc->old_size);
+  test_header(&old_header, 1U, old_fw, tc->old_size);
+  sfu_host_sign_header(&old_header);
+
+  size = (tc->type == TEST_DELTA) ? test_build_delta(tc->old_size, tc->new_size) : test_build_compressed(tc->new_size);
+  test_header(&new_header, 2U, new_fw, tc->new_size);
+  if (corrupt != 0)
+  {
+    new_header.FwTag[0] ^= 0x01U;
+  }
+  /* Padding to the AES block size */
+  while ((size % 16U) != 0U)
+  {
+    payload[size++] = 0U;
+  }
+  new_header.PatchSize = size;
+  sfu_host_sign_header(&new_header);
+  sfu_host_download(&old_header, old_fw, &new_header, payload);
+  memcpy(snapshot, SFU_HOST_FLASH, SFU_HOST_FLASH_SIZE);
+  return size;
+}
+
+/**
+  * @brief  FW in slot #0.
+  */
+static int test_active_fw(void)
+{
+  if (sfu_host_is_active(&new_header, new_fw) != 0)
+  {
+    return TEST_FW_NEW;
+  }
+  return (sfu_host_is_active(&old_header, old_fw) != 0) ? TEST_FW_OLD : TEST_FW_NONE;
+}
+
+/**
+  * @brief  Boot without power cut until a FW is launched.
+  * @retval FW launched
+  */
+static int test_boot_to_fw(void)
+{
+  uint32_t i;
+  sfu_host_boot_t boot;
+
+  for (i = 0U; i < TEST_BOOTS_MAX; i++)
+  {
+    boot = sfu_host_boot(0U);
+    if (boot == SFU_HOST_BOOT_RUN)
+    {
+      return test_active_fw();
+    }
+    if ((boot != SFU_HOST_BOOT_INSTALLED) && (boot != SFU_HOST_BOOT_RECOVERED))
+    {
+      printf("  boot %u: %d\n", (unsigned int)i, (int)boot);
+      break;
+    }
+  }
+  return TEST_FW_NONE;
+}
+
+static void test_case(const test_case_t *tc, unsigned long iterations)
+{
+  uint32_t size = test_setup(tc, 0);
+  uint32_t ops;
+  uint32_t magic_op;
+  uint32_t cut;
+  uint32_t fw_count[3] = {0U, 0U, 0U};
+  unsigned long i;
+  int fw;
+
+  HOST_TEST_CHECK(sfu_host_boot(0U) == SFU_HOST_BOOT_INSTALLED);
+  ops = sfu_host_flash.Ops;
+  magic_op = sfu_host_flash.WatchOp;
+  printf("%-16s FW %5u bytes, payload %5u bytes: %4u FLASH operations, %3u pages erased, %6u bytes programmed\n",
+         tc->name, (unsigned int)tc->new_size, (unsigned int)size, (unsigned int)ops,
+         (unsigned int)sfu_host_flash.PageErases, (unsigned int)sfu_host_flash.ProgrammedBytes);
+  HOST_TEST_CHECK(magic_op != 0U);
+  HOST_TEST_CHECK(test_boot_to_fw() == TEST_FW_NEW);
+
+  /* One power cut at each FLASH operation: the new FW until the swap starts, then the new or the old one */
+  for (cut = 1U; cut <= ops; cut++)
+  {
+    memcpy(SFU_HOST_FLASH, snapshot, SFU_HOST_FLASH_SIZE);
+    HOST_TEST_CHECK(sfu_host_boot(cut) == SFU_HOST_BOOT_CUT);
+    fw = test_boot_to_fw();
+    fw_count[fw]++;
+    if ((fw == TEST_FW_NONE) || ((cut < magic_op) && (fw != TEST_FW_NEW)))
+    {
+      printf("  power cut at operation %u/%u (swap magic %u): FW %d\n", (unsigned int)cut, (unsigned int)ops,
+             (unsigned int)magic_op, fw);
+      HOST_TEST_CHECK(0);
+    }
+  }
+
+  /* Two power cuts */
+  for (i = 0U; i < iterations; i++)
+  {
+    memcpy(SFU_HOST_FLASH, snapshot, SFU_HOST_FLASH_SIZE);
+    HOST_TEST_CHECK(sfu_host_boot(1U + (test_rand() % ops)) == SFU_HOST_BOOT_CUT);
+    (void)sfu_host_boot(1U + (test_rand() % ops));
+    fw = test_boot_to_fw();
+    fw_count[fw]++;
+    HOST_TEST_CHECK(fw != TEST_FW_NONE);
+  }
+  printf("%-16s %lu interrupted installations: new FW %u, previous FW %u, no FW %u\n", tc->name,
+         (unsigned long)ops + iterations, (unsigned int)fw_count[TEST_FW_NEW], (unsigned int)fw_count[TEST_FW_OLD],
+         (unsigned int)fw_count[TEST_FW_NONE]);
+
+  /* A candidate FW which does not match its tag is rejected once: the previous FW keeps running */
+  (void)test_setup(tc, 1);
+  HOST_TEST_CHECK(sfu_host_boot(0U) == SFU_HOST_BOOT_FAILED);
+  HOST_TEST_CHECK(sfu_host_boot(0U) == SFU_HOST_BOOT_RUN);
+  HOST_TEST_CHECK(test_active_fw() == TEST_FW_OLD);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 1000U);
+  size_t i;
+
+  sfu_host_flash_init();
+  sfu_host_flash.WatchAddress = TEST_TRAILER_MAGIC;
+  for (i = 0U; i < (sizeof(test_cases) / sizeof(test_cases[0])); i++)
+  {
+    test_case(&test_cases[i], iterations);
+  }
+  HOST_TEST_CHECK(sfu_host_flash.Violations == 0U);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
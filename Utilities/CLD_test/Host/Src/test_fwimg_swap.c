@@ -0,0 +1,249 @@
+/**
+  ******************************************************************************
+  * @file    test_fwimg_swap.c
+  * @author  MCD Application Team
+  * @brief   Host test of the SBSFU FW swap and recovery (SwapFirmwareImages, RecopyFlash, CompareFlash, ProgramFlash
+  *          of sfu_fwimg_core.c, 32L496GDISCOVERY project) on a simulated FLASH.
+  *          A full image is installed once without interruption, giving the FLASH erases and programmed bytes, then
+  *          again from the same FLASH content with a power cut at each FLASH operation in turn: the following boots
+  *          must resume the swap or recover the previous FW, and launch a valid FW. The iteration count gives the
+  *          number of installations interrupted twice, at random operations.
+  *          Usage: test_fwimg_swap [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "sfu_host.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_FW_MAX           (96U * 1024U)
+#define TEST_BOOTS_MAX        (8U)           /*!< Boots allowed to get back to a running FW after a power cut */
+
+#define TEST_FW_NONE          (0)
+#define TEST_FW_OLD           (1)
+#define TEST_FW_NEW           (2)
+
+/* Swap magic of the trailer, at the end of slot #1: its first write starts the swap */
+#define TEST_TRAILER_INDEX    (SFU_IMG_SLOT_0_REGION_SIZE / SFU_IMG_SWAP_REGION_SIZE)
+#define TEST_TRAILER_MAGIC    (SFU_IMG_SLOT_1_REGION_BEGIN_VALUE + SFU_IMG_SLOT_1_REGION_SIZE \
+                               - (TEST_TRAILER_INDEX * sizeof(SFU_LL_FLASH_write_t)) - 32U)
+
+/* Pages erased by a swap copying every block of both slots */
+#define TEST_FULL_SWAP_ERASES (2U * SFU_IMG_SLOT_0_REGION_SIZE / FLASH_PAGE_SIZE)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *name;
+  uint32_t old_size;
+  uint32_t new_size;
+  uint32_t changed;   /*!< 0: new FW unrelated to the active one, otherwise bytes changed in the active FW */
+} test_case_t;
+
+typedef struct
+{
+  uint32_t ops;
+  uint32_t erases;
+  uint32_t bytes;
+} test_cost_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* FW sizes are multiples of the AES block size, as produced by the image preparation tool */
+static const test_case_t test_cases[] =
+{
+  { "full",    60000U, 60000U,   0U },
+  { "partial", 60000U, 60000U,  64U },
+  { "resize",  40000U, 45008U,   0U },
+  { "small",    3008U,  3008U,   0U },
+};
+
+static uint8_t old_fw[TEST_FW_MAX];
+static uint8_t new_fw[TEST_FW_MAX];
+static uint8_t snapshot[SFU_HOST_FLASH_SIZE];
+static SE_FwRawHeaderTypeDef old_header;
+static SE_FwRawHeaderTypeDef new_header;
+static uint32_t test_seed = 1U;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t test_rand(void)
+{
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 17;
+  test_seed ^= test_seed << 5;
+  return test_seed;
+}
+
+static void test_random_bytes(uint8_t *p, uint32_t len)
+{
+  uint32_t i;
+
+  for (i = 0U; i < len; i++)
+  {
+    p[i] = (uint8_t)test_rand();
+  }
+}
+
+static void test_header(SE_FwRawHeaderTypeDef *header, uint16_t version, const uint8_t *fw, uint32_t size)
+{
+  memset(header, 0, sizeof(*header));
+  header->SFUMagic = 0x4D554653U; /* 'SFUM' */
+  header->ProtocolVersion = 0x1U;
+  test_random_bytes(header->InitVector, sizeof(header->InitVector));
+  header->FwVersion = version;
+  header->FwSize = size;
+  sfu_host_fw_tag(fw, size, header->FwTag);
+  sfu_host_sign_header(header);
+}
+
+/**
+  * @brief  Images of a test case, downloaded in the FLASH (snapshot kept to restart the installation).
+  *         A partial update changes a few bytes in the middle of the active FW: the other blocks stay in place.
+  */
+static void test_setup(const test_case_t *tc)
+{
+  uint32_t offset;
+
+  test_random_bytes(old_fw, tc->old_size);
+  test_header(&old_header, 1U, old_fw, tc->old_size);
+  if (tc->changed != 0U)
+  {
+    memcpy(new_fw, old_fw, tc->new_size);
+    offset = (tc->new_size / 2U) - (tc->changed / 2U);
+    test_random_bytes(&new_fw[offset], tc->changed);
+  }
+  else
+  {
+    test_random_bytes(new_fw, tc->new_size);
+  }
+  test_header(&new_header, 2U, new_fw, tc->new_size);
+  sfu_host_download(&old_header, old_fw, &new_header, new_fw);
+  memcpy(snapshot, SFU_HOST_FLASH, SFU_HOST_FLASH_SIZE);
+}
+
+static int test_active_fw(void)
+{
+  if (sfu_host_is_active(&new_header, new_fw) != 0)
+  {
+    return TEST_FW_NEW;
+  }
+  return (sfu_host_is_active(&old_header, old_fw) != 0) ? TEST_FW_OLD : TEST_FW_NONE;
+}
+
+/**
+  * @brief  Boot without power cut until a FW is launched.
+  * @param  recovered incremented when a boot recovers an interrupted swap
+  * @retval FW launched
+  */
+static int test_boot_to_fw(uint32_t *recovered)
+{
+  uint32_t i;
+  sfu_host_boot_t boot;
+
+  for (i = 0U; i < TEST_BOOTS_MAX; i++)
+  {
+    boot = sfu_host_boot(0U);
+    if (boot == SFU_HOST_BOOT_RUN)
+    {
+      return test_active_fw();
+    }
+    if (boot == SFU_HOST_BOOT_RECOVERED)
+    {
+      (*recovered)++;
+    }
+    /* A failed installation is a critical failure: the device reboots */
+    else if ((boot != SFU_HOST_BOOT_INSTALLED) && (boot != SFU_HOST_BOOT_FAILED))
+    {
+      printf("  boot %u: %d\n", (unsigned int)i, (int)boot);
+      break;
+    }
+  }
+  return TEST_FW_NONE;
+}
+
+static void test_case(const test_case_t *tc, unsigned long iterations, test_cost_t *cost)
+{
+  uint32_t magic_op;
+  uint32_t cut;
+  uint32_t fw_count[3] = {0U, 0U, 0U};
+  uint32_t recovered = 0U;
+  unsigned long i;
+  int fw;
+
+  test_setup(tc);
+  HOST_TEST_CHECK(sfu_host_boot(0U) == SFU_HOST_BOOT_INSTALLED);
+  cost->ops = sfu_host_flash.Ops;
+  cost->erases = sfu_host_flash.PageErases;
+  cost->bytes = sfu_host_flash.ProgrammedBytes;
+  magic_op = sfu_host_flash.WatchOp;
+  printf("%-8s FW %5u bytes: %4u FLASH operations, %3u pages erased, %6u bytes programmed\n", tc->name,
+         (unsigned int)tc->new_size, (unsigned int)cost->ops, (unsigned int)cost->erases, (unsigned int)cost->bytes);
+  HOST_TEST_CHECK(magic_op != 0U);
+  HOST_TEST_CHECK(cost->erases < TEST_FULL_SWAP_ERASES);
+  HOST_TEST_CHECK(test_boot_to_fw(&recovered) == TEST_FW_NEW);
+
+  /* One power cut at each FLASH operation: a swap which has started is recovered, unless it is complete (the last
+     operation cleans the swap magic) */
+  for (cut = 1U; cut <= cost->ops; cut++)
+  {
+    memcpy(SFU_HOST_FLASH, snapshot, SFU_HOST_FLASH_SIZE);
+    HOST_TEST_CHECK(sfu_host_boot(cut) == SFU_HOST_BOOT_CUT);
+    i = recovered;
+    fw = test_boot_to_fw(&recovered);
+    fw_count[fw]++;
+    if ((fw == TEST_FW_NONE) || ((cut > magic_op) && (cut < cost->ops) && (recovered == i)))
+    {
+      printf("  power cut at operation %u/%u (swap magic %u): FW %d, %u recoveries\n", (unsigned int)cut,
+             (unsigned int)cost->ops, (unsigned int)magic_op, fw, (unsigned int)(recovered - i));
+      HOST_TEST_CHECK(0);
+    }
+  }
+
+  /* Two power cuts: the second one may interrupt the recovery */
+  for (i = 0U; i < iterations; i++)
+  {
+    memcpy(SFU_HOST_FLASH, snapshot, SFU_HOST_FLASH_SIZE);
+    HOST_TEST_CHECK(sfu_host_boot(1U + (test_rand() % cost->ops)) == SFU_HOST_BOOT_CUT);
+    (void)sfu_host_boot(1U + (test_rand() % cost->ops));
+    fw = test_boot_to_fw(&recovered);
+    fw_count[fw]++;
+    HOST_TEST_CHECK(fw != TEST_FW_NONE);
+  }
+  printf("%-8s %lu interrupted installations: new FW %u, previous FW %u, no FW %u, %u recoveries\n", tc->name,
+         (unsigned long)cost->ops + iterations, (unsigned int)fw_count[TEST_FW_NEW],
+         (unsigned int)fw_count[TEST_FW_OLD], (unsigned int)fw_count[TEST_FW_NONE], (unsigned int)recovered);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 1000U);
+  test_cost_t cost[sizeof(test_cases) / sizeof(test_cases[0])];
+  size_t i;
+
+  sfu_host_flash_init();
+  sfu_host_flash.WatchAddress = TEST_TRAILER_MAGIC;
+  for (i = 0U; i < (sizeof(test_cases) / sizeof(test_cases[0])); i++)
+  {
+    test_case(&test_cases[i], iterations, &cost[i]);
+  }
+  /* The blocks of a partial update which are already in place are neither erased nor programmed */
+  HOST_TEST_CHECK(cost[1].erases < cost[0].erases);
+  HOST_TEST_CHECK(cost[1].bytes < cost[0].bytes);
+  HOST_TEST_CHECK(sfu_host_flash.Violations == 0U);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
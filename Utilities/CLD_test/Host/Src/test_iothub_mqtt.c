@@ -0,0 +1,481 @@
+/**
+  ******************************************************************************
+  * @file    test_iothub_mqtt.c
+  * @author  MCD Application Team
+  * @brief   Host test of the telemetry of the IoT Hub device client (IoTHubClient_LL, MQTT transport,
+  *          tlsio_mbedtls over the network library) against a loopback mock hub on 127.0.0.1:8883:
+  *          - the in-flight window (OPTION_MAX_INFLIGHT_MESSAGES), checked after each DoWork,
+  *          - a failed send of the telemetry batch: only the messages of that send fail, the
+  *            connection is closed and the next messages are sent after the reconnection,
+  *          - the counters of OPTION_TELEMETRY_STATS.
+  *          The failed send is injected by wrapping xio_send at link time. The mock hub does not
+  *          acknowledge the messages whose payload starts with 'h'.
+  *          Usage: test_iothub_mqtt [messages]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "azure_c_shared_utility/platform.h"
+#include "azure_c_shared_utility/shared_util_options.h"
+#include "azure_c_shared_utility/xio.h"
+#include "iothub_client_ll.h"
+#include "iothub_client_options.h"
+#include "iothubtransportmqtt.h"
+#include "net_connect.h"
+#include "net_host.h"
+#include "host_server.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_HUB_PORT           8883U
+#define TEST_HUB_PACKET_MAX     4096U
+#define TEST_TIMEOUT_US         10000000U
+#define TEST_HOLD_US            200000U
+/* Window of the messages_per_sec counter, updated by the first ack after it. */
+#define TEST_RATE_WINDOW_US     1100000U
+#define TEST_WINDOW             4U
+/* Several sends of the batch buffer (2048 bytes) in one DoWork. */
+#define TEST_BATCH_MESSAGES     40U
+#define TEST_PAYLOAD_SIZE       100U
+#define TEST_HOLD               'h'
+/* The transport connects to the gateway host, the name of the certificate of the mock hub. */
+#define TEST_CONNECTION_STRING  "HostName=test.azure-devices.net;DeviceId=test;" \
+                                "SharedAccessKey=AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA=;" \
+                                "GatewayHostName=" HOST_SERVER_NAME
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  unsigned long confirmed;
+  unsigned long failed;
+} test_d2c_t;
+
+typedef struct
+{
+  unsigned long sends;        /* Sends of PUBLISH packets */
+  unsigned long fail_send;    /* Send to fail, counted from 1, 0 for none */
+  unsigned long publishes;    /* PUBLISH packets sent */
+  unsigned long failed;       /* PUBLISH packets of the failed send */
+} test_xio_t;
+
+/* Private variables ---------------------------------------------------------*/
+static net_if_handle_t netif;
+static test_d2c_t d2c;
+static test_xio_t test_xio;
+static unsigned long communication_errors;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Number of packets of buffer if it only holds complete PUBLISH packets, else 0.
+  */
+static unsigned long test_publishes(const uint8_t *buffer, size_t size)
+{
+  unsigned long count = 0;
+  size_t offset = 0;
+  size_t remaining;
+  size_t header;
+  uint32_t shift;
+
+  while (offset < size)
+  {
+    if ((buffer[offset] & 0xF0U) != 0x30U)
+    {
+      return 0;
+    }
+    remaining = 0;
+    shift = 0;
+    for (header = 1U; ((offset + header) < size) && (header <= 4U); header++)
+    {
+      remaining |= (size_t) (buffer[offset + header] & 0x7FU) << shift;
+      shift += 7U;
+      if ((buffer[offset + header] & 0x80U) == 0U)
+      {
+        break;
+      }
+    }
+    if (((offset + header) >= size) || (header > 4U))
+    {
+      return 0;
+    }
+    offset += header + 1U + remaining;
+    count++;
+  }
+  return (offset == size) ? count : 0;
+}
+
+/* Sends of the IO layers: see the link options of test_iothub_mqtt. */
+int __real_xio_send(XIO_HANDLE xio, const void *buffer, size_t size, ON_SEND_COMPLETE on_send_complete,
+                    void *callback_context);
+int __wrap_xio_send(XIO_HANDLE xio, const void *buffer, size_t size, ON_SEND_COMPLETE on_send_complete,
+                    void *callback_context);
+
+int __wrap_xio_send(XIO_HANDLE xio, const void *buffer, size_t size, ON_SEND_COMPLETE on_send_complete,
+                    void *callback_context)
+{
+  unsigned long publishes = (buffer != NULL) ? test_publishes(buffer, size) : 0U;
+
+  if (publishes > 0U)
+  {
+    test_xio.sends++;
+    if (test_xio.sends == test_xio.fail_send)
+    {
+      test_xio.failed = publishes;
+      return -1;
+    }
+    test_xio.publishes += publishes;
+  }
+  return __real_xio_send(xio, buffer, size, on_send_complete, callback_context);
+}
+
+/**
+  * @brief  Mock hub connection: CONNACK, SUBACK and PUBACK (QoS 1) for the client packets, except for the
+  *         held messages, PINGRESP for its pings, until it disconnects.
+  */
+static void test_hub(host_server_conn_t *pConn, void *pArg)
+{
+  static uint8_t packet[TEST_HUB_PACKET_MAX];
+  uint8_t reply[2U + 2U + 16U];
+  size_t len = 0;
+  size_t header;
+  size_t remaining;
+  size_t reply_len;
+  size_t topic_len;
+  size_t i;
+  uint32_t shift;
+  int n;
+
+  (void) pArg;
+  for (;;)
+  {
+    n = host_server_recv(pConn, &packet[len], sizeof(packet) - len);
+    if (n <= 0)
+    {
+      return;
+    }
+    len += (size_t) n;
+    for (;;)
+    {
+      /* Fixed header: type and flags, remaining length. */
+      remaining = 0;
+      shift = 0;
+      for (header = 1U; (header < len) && (header <= 4U); header++)
+      {
+        remaining |= (size_t) (packet[header] & 0x7FU) << shift;
+        shift += 7U;
+        if ((packet[header] & 0x80U) == 0U)
+        {
+          break;
+        }
+      }
+      if ((header >= len) || ((header + 1U + remaining) > len))
+      {
+        if ((header > 4U) || ((header + 1U + remaining) > sizeof(packet)))
+        {
+          return;
+        }
+        break;
+      }
+      header++;
+      reply_len = 0;
+      switch (packet[0] & 0xF0U)
+      {
+        case 0x10U: /* CONNECT */
+          reply[0] = 0x20U;
+          reply[1] = 2U;
+          reply[2] = 0U;
+          reply[3] = 0U;
+          reply_len = 4U;
+          break;
+        case 0x30U: /* PUBLISH */
+          topic_len = ((size_t) packet[header] << 8) | packet[header + 1U];
+          if (((packet[0] & 0x06U) != 0U) &&
+              (((4U + topic_len) >= remaining) || (packet[header + 4U + topic_len] != (uint8_t) TEST_HOLD)))
+          {
+            reply[0] = 0x40U;
+            reply[1] = 2U;
+            reply[2] = packet[header + 2U + topic_len];
+            reply[3] = packet[header + 3U + topic_len];
+            reply_len = 4U;
+          }
+          break;
+        case 0x80U: /* SUBSCRIBE: each topic filter is granted its QoS */
+          reply[0] = 0x90U;
+          reply[2] = packet[header];
+          reply[3] = packet[header + 1U];
+          reply_len = 4U;
+          for (i = 2U; (i < remaining) && (reply_len < sizeof(reply)); i += 2U + topic_len + 1U)
+          {
+            topic_len = ((size_t) packet[header + i] << 8) | packet[header + i + 1U];
+            reply[reply_len++] = packet[header + i + 2U + topic_len];
+          }
+          reply[1] = (uint8_t) (reply_len - 2U);
+          break;
+        case 0xC0U: /* PINGREQ */
+          reply[0] = 0xD0U;
+          reply[1] = 0U;
+          reply_len = 2U;
+          break;
+        case 0xE0U: /* DISCONNECT */
+          return;
+        default:
+          break;
+      }
+      if ((reply_len > 0U) && (host_server_send(pConn, reply, reply_len) != 0))
+      {
+        return;
+      }
+      len -= header + remaining;
+      memmove(packet, &packet[header + remaining], len);
+    }
+  }
+}
+
+static void test_on_confirm(IOTHUB_CLIENT_CONFIRMATION_RESULT result, void *context)
+{
+  (void) context;
+  if (result == IOTHUB_CLIENT_CONFIRMATION_OK)
+  {
+    d2c.confirmed++;
+  }
+  else
+  {
+    d2c.failed++;
+  }
+}
+
+static void test_on_connection_status(IOTHUB_CLIENT_CONNECTION_STATUS result,
+                                      IOTHUB_CLIENT_CONNECTION_STATUS_REASON reason, void *context)
+{
+  (void) result;
+  (void) context;
+  if (reason == IOTHUB_CLIENT_CONNECTION_COMMUNICATION_ERROR)
+  {
+    communication_errors++;
+  }
+}
+
+static void test_queue(IOTHUB_CLIENT_LL_HANDLE client, uint8_t first, size_t count)
+{
+  uint8_t payload[TEST_PAYLOAD_SIZE];
+  IOTHUB_MESSAGE_HANDLE message;
+  size_t i;
+
+  memset(payload, 'x', sizeof(payload));
+  payload[0] = first;
+  for (i = 0; i < count; i++)
+  {
+    message = IoTHubMessage_CreateFromByteArray(payload, sizeof(payload));
+    HOST_TEST_CHECK(message != NULL);
+    HOST_TEST_CHECK(IoTHubClient_LL_SendEventAsync(client, message, test_on_confirm, NULL) == IOTHUB_CLIENT_OK);
+    IoTHubMessage_Destroy(message);
+  }
+}
+
+static IOTHUB_CLIENT_TELEMETRY_STATS test_stats(IOTHUB_CLIENT_LL_HANDLE client)
+{
+  IOTHUB_CLIENT_TELEMETRY_STATS stats;
+
+  memset(&stats, 0, sizeof(stats));
+  HOST_TEST_CHECK(IoTHubClient_LL_GetOption(client, OPTION_TELEMETRY_STATS, &stats) == IOTHUB_CLIENT_OK);
+  return stats;
+}
+
+static size_t test_rtt_count(const IOTHUB_CLIENT_TELEMETRY_STATS *stats)
+{
+  size_t count = 0;
+  size_t i;
+
+  for (i = 0; i < IOTHUB_CLIENT_RTT_HISTOGRAM_SIZE; i++)
+  {
+    count += stats->rtt_histogram[i];
+  }
+  return count;
+}
+
+/**
+  * @brief  Run the client until count messages are completed, checking the window after each DoWork.
+  */
+static void test_run(IOTHUB_CLIENT_LL_HANDLE client, unsigned long count, size_t window)
+{
+  IOTHUB_CLIENT_TELEMETRY_STATS stats;
+  uint64_t start = host_test_time_us();
+
+  while (((d2c.confirmed + d2c.failed) < count) && ((host_test_time_us() - start) < TEST_TIMEOUT_US))
+  {
+    IoTHubClient_LL_DoWork(client);
+    if (window != 0U)
+    {
+      stats = test_stats(client);
+      HOST_TEST_CHECK(stats.acks_outstanding <= window);
+    }
+  }
+  HOST_TEST_CHECK((d2c.confirmed + d2c.failed) == count);
+}
+
+/**
+  * @brief  Messages acknowledged through a window of TEST_WINDOW messages, then one more after the window
+  *         of the rate counter.
+  */
+static void test_window(IOTHUB_CLIENT_LL_HANDLE client, unsigned long count)
+{
+  IOTHUB_CLIENT_TELEMETRY_STATS before = test_stats(client);
+  IOTHUB_CLIENT_TELEMETRY_STATS after;
+  size_t window = TEST_WINDOW;
+  uint64_t start;
+
+  HOST_TEST_CHECK(IoTHubClient_LL_SetOption(client, OPTION_MAX_INFLIGHT_MESSAGES, &window) == IOTHUB_CLIENT_OK);
+  memset(&d2c, 0, sizeof(d2c));
+  test_queue(client, 'a', count);
+  test_run(client, count, window);
+  start = host_test_time_us();
+  while ((host_test_time_us() - start) < TEST_RATE_WINDOW_US)
+  {
+    IoTHubClient_LL_DoWork(client);
+  }
+  test_queue(client, 'a', 1U);
+  count++;
+  test_run(client, count, window);
+  HOST_TEST_CHECK(d2c.confirmed == count);
+
+  after = test_stats(client);
+  HOST_TEST_CHECK((after.messages_sent - before.messages_sent) == count);
+  HOST_TEST_CHECK((after.messages_acked - before.messages_acked) == count);
+  HOST_TEST_CHECK(after.messages_resent == before.messages_resent);
+  HOST_TEST_CHECK(after.messages_timed_out == before.messages_timed_out);
+  HOST_TEST_CHECK(after.acks_outstanding == 0U);
+  HOST_TEST_CHECK((test_rtt_count(&after) - test_rtt_count(&before)) == count);
+  HOST_TEST_CHECK(after.messages_per_sec > 0U);
+}
+
+/**
+  * @brief  The second send of a batch fails: its messages and the one being published fail, the messages
+  *         of the first send wait for their ack, and the next ones are sent after the reconnection.
+  */
+static void test_batch_failure(IOTHUB_CLIENT_LL_HANDLE client)
+{
+  IOTHUB_CLIENT_TELEMETRY_STATS before = test_stats(client);
+  IOTHUB_CLIENT_TELEMETRY_STATS after;
+  unsigned long first_send;
+  unsigned long acked;
+  size_t window = 0;
+
+  HOST_TEST_CHECK(IoTHubClient_LL_SetOption(client, OPTION_MAX_INFLIGHT_MESSAGES, &window) == IOTHUB_CLIENT_OK);
+  memset(&d2c, 0, sizeof(d2c));
+  memset(&test_xio, 0, sizeof(test_xio));
+  test_xio.fail_send = 2U;
+  communication_errors = 0;
+  test_queue(client, 'b', TEST_BATCH_MESSAGES);
+
+  IoTHubClient_LL_DoWork(client);
+  first_send = test_xio.publishes;
+  after = test_stats(client);
+  HOST_TEST_CHECK(test_xio.sends == 2U);
+  HOST_TEST_CHECK((first_send > 0U) && (test_xio.failed > 0U));
+  HOST_TEST_CHECK(d2c.failed == (test_xio.failed + 1U));
+  HOST_TEST_CHECK((after.messages_sent - before.messages_sent) == first_send);
+  HOST_TEST_CHECK(communication_errors == 1U);
+  /* The acks of the first send may have been received while the connection was closed. */
+  HOST_TEST_CHECK((d2c.confirmed + after.acks_outstanding) == first_send);
+  acked = d2c.confirmed;
+
+  /* The queued messages go out on the new connection. */
+  test_run(client, TEST_BATCH_MESSAGES - (first_send - acked), 0U);
+  after = test_stats(client);
+  HOST_TEST_CHECK(d2c.failed == (test_xio.failed + 1U));
+  HOST_TEST_CHECK(d2c.confirmed == (TEST_BATCH_MESSAGES - first_send - d2c.failed + acked));
+  HOST_TEST_CHECK((after.messages_sent - before.messages_sent) == (TEST_BATCH_MESSAGES - d2c.failed));
+  HOST_TEST_CHECK(after.acks_outstanding == (first_send - acked));
+  HOST_TEST_CHECK(after.messages_timed_out == before.messages_timed_out);
+}
+
+/**
+  * @brief  Messages which are not acknowledged fill the window: the next one is not sent.
+  */
+static void test_window_full(IOTHUB_CLIENT_LL_HANDLE client)
+{
+  IOTHUB_CLIENT_TELEMETRY_STATS before = test_stats(client);
+  IOTHUB_CLIENT_TELEMETRY_STATS after;
+  size_t window = before.acks_outstanding + 2U;
+  uint64_t start = host_test_time_us();
+
+  HOST_TEST_CHECK(IoTHubClient_LL_SetOption(client, OPTION_MAX_INFLIGHT_MESSAGES, &window) == IOTHUB_CLIENT_OK);
+  HOST_TEST_CHECK(IoTHubClient_LL_GetOption(client, OPTION_MAX_INFLIGHT_MESSAGES, &window) == IOTHUB_CLIENT_OK);
+  HOST_TEST_CHECK(window == (before.acks_outstanding + 2U));
+  memset(&d2c, 0, sizeof(d2c));
+  test_queue(client, TEST_HOLD, 3U);
+  while ((host_test_time_us() - start) < TEST_HOLD_US)
+  {
+    IoTHubClient_LL_DoWork(client);
+  }
+  after = test_stats(client);
+  HOST_TEST_CHECK((after.messages_sent - before.messages_sent) == 2U);
+  HOST_TEST_CHECK(after.acks_outstanding == window);
+  HOST_TEST_CHECK(after.messages_acked == before.messages_acked);
+  HOST_TEST_CHECK((d2c.confirmed + d2c.failed) == 0U);
+}
+
+/* Functions Definition ------------------------------------------------------*/
+/* Platform of the IoT Hub client: initialized by the application (cloud.c) on the device. */
+int platform_init(void)
+{
+  return 0;
+}
+
+void platform_deinit(void)
+{
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned long count = host_test_iterations(argc, argv, 100);
+  IOTHUB_CLIENT_LL_HANDLE client;
+  host_server_t hub;
+  const char *ca_cert;
+
+  ca_cert = host_server_ca_cert();
+  if ((ca_cert == NULL) || (host_server_start(&hub, TEST_HUB_PORT, true, test_hub, NULL) != 0))
+  {
+    printf("cannot start the mock hub\n");
+    return 1;
+  }
+  HOST_TEST_CHECK(net_host_if_up(&netif) == NET_OK);
+  client = IoTHubClient_LL_CreateFromConnectionString(TEST_CONNECTION_STRING, MQTT_Protocol);
+  HOST_TEST_CHECK(client != NULL);
+  if (client != NULL)
+  {
+    HOST_TEST_CHECK(IoTHubClient_LL_SetOption(client, OPTION_TRUSTED_CERT, ca_cert) == IOTHUB_CLIENT_OK);
+    HOST_TEST_CHECK(IoTHubClient_LL_SetRetryPolicy(client, IOTHUB_CLIENT_RETRY_IMMEDIATE, 0) == IOTHUB_CLIENT_OK);
+    HOST_TEST_CHECK(IoTHubClient_LL_SetConnectionStatusCallback(client, test_on_connection_status, NULL)
+                    == IOTHUB_CLIENT_OK);
+
+    /* The connection is set up by the first message. */
+    memset(&d2c, 0, sizeof(d2c));
+    test_queue(client, 'a', 1U);
+    test_run(client, 1U, 0U);
+    HOST_TEST_CHECK(d2c.confirmed == 1U);
+
+    test_window(client, count);
+    test_batch_failure(client);
+    test_window_full(client);
+    IoTHubClient_LL_Destroy(client);
+  }
+  HOST_TEST_CHECK(net_if_disconnect(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_stop(&netif) == NET_OK);
+  HOST_TEST_CHECK(net_if_deinit(&netif) == NET_OK);
+  host_server_stop(&hub);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
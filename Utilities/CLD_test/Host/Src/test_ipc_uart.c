@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file    test_ipc_uart.c
+  * @author  MCD Application Team
+  * @brief   Host replay test of the cellular IPC reception (ipc_uart.c, ipc_rxfifo.c) on a fake modem UART.
+  *          Built twice: characters received one by one under interrupt (test_ipc_uart), and in the circular
+  *          RX DMA buffer (test_ipc_uart_dma, process_RX_DMA, resume_RX_DMA and RXFIFO_writeBuffer). Both
+  *          replay the same modem streams, in bursts followed by an idle line and by reads of the client:
+  *          every message read must be the next message sent by the modem, so that both receptions give
+  *          the same framing, including when the queue pauses the reception and when the DMA buffer wraps.
+  *          The iteration count gives the number of random streams of 500 messages.
+  *          Usage: test_ipc_uart [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "ipc_host.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_MSG_MAX          (200U)    /* A paused queue keeps complete messages to read */
+#define TEST_STREAM_MSGS      (2000U)
+#define TEST_END_OF_MSG       ((uint8_t)'\n')
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *name;
+  uint32_t msg_max;       /*!< message size, end of message included: 1 to msg_max */
+  uint32_t burst_max;     /*!< characters sent by the modem before an idle line: 1 to burst_max */
+  uint32_t reads_max;     /*!< messages read by the client after a burst: 0 to reads_max, all if 0 */
+  uint32_t messages;
+  uint32_t irq_latency;   /*!< characters received by the DMA before its interrupt is served */
+} test_case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const test_case_t test_cases[] =
+{
+  /* Client reading all messages after each burst: the queue never pauses. The DMA interrupts are served late:
+     the characters to process are on both sides of the DMA buffer end */
+  { "wrap",   30U,            100U, 0U, TEST_STREAM_MSGS, 7U },
+  /* Slow client: the queue pauses in the middle of the bursts, and of DMA buffer spans longer than the queue
+     threshold */
+  { "pause",  TEST_MSG_MAX,   600U, 1U, TEST_STREAM_MSGS, 24U },
+  { "random", TEST_MSG_MAX,   300U, 3U, 500U,             3U },
+};
+
+static uint8_t test_stream[TEST_STREAM_MSGS * TEST_MSG_MAX];
+static uint32_t test_msg_end[TEST_STREAM_MSGS];
+static IPC_Handle_t test_hipc;
+static IPC_RxMessage_t test_msg;
+static uint32_t test_signaled;
+static uint32_t test_seed = 1U;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t test_rand(void)
+{
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 17;
+  test_seed ^= test_seed << 5;
+  return test_seed;
+}
+
+static void test_rx_callback(IPC_Handle_t *hipc)
+{
+  UNUSED(hipc);
+  test_signaled++;
+}
+
+static void test_tx_callback(IPC_Handle_t *hipc)
+{
+  UNUSED(hipc);
+}
+
+static uint8_t test_check_end_of_msg(uint8_t rxChar)
+{
+  return (rxChar == TEST_END_OF_MSG) ? 1U : 0U;
+}
+
+/**
+  * @brief  Modem stream: messages of random characters, each one ended by the end of message character.
+  * @retval Stream length
+  */
+static uint32_t test_stream_build(const test_case_t *tc)
+{
+  uint32_t len = 0U;
+  uint32_t size;
+  uint32_t i;
+  uint32_t j;
+
+  for (i = 0U; i < tc->messages; i++)
+  {
+    size = 1U + (test_rand() % tc->msg_max);
+    for (j = 0U; j < (size - 1U); j++)
+    {
+      do
+      {
+        test_stream[len] = (uint8_t)test_rand();
+      } while (test_stream[len] == TEST_END_OF_MSG);
+      len++;
+    }
+    test_stream[len] = TEST_END_OF_MSG;
+    len++;
+    test_msg_end[i] = len;
+  }
+  return len;
+}
+
+/**
+  * @brief  Client read of the next message, which must be the next message of the modem stream.
+  * @param  msg index of the message in the stream
+  */
+static void test_read(uint32_t msg)
+{
+  uint32_t start = (msg == 0U) ? 0U : test_msg_end[msg - 1U];
+  IPC_Status_t status = IPC_receive(&test_hipc, &test_msg);
+
+  HOST_TEST_CHECK(status == ((test_signaled == (msg + 1U)) ? IPC_RXQUEUE_EMPTY : IPC_RXQUEUE_MSG_AVAIL));
+  HOST_TEST_CHECK(test_msg.size == (test_msg_end[msg] - start));
+  HOST_TEST_CHECK(memcmp(test_msg.buffer, &test_stream[start], test_msg.size) == 0);
+}
+
+/**
+  * @brief  Replay of a modem stream: bursts of characters, each one followed by an idle line and reads.
+  */
+static void test_replay(const test_case_t *tc)
+{
+  uint32_t len = test_stream_build(tc);
+  uint32_t pos = 0U;
+  uint32_t read = 0U;
+  uint32_t sent;
+  uint32_t burst;
+  uint32_t reads;
+
+  test_signaled = 0U;
+  while (read < tc->messages)
+  {
+    burst = 1U + (test_rand() % tc->burst_max);
+    burst = ((len - pos) < burst) ? (len - pos) : burst;
+    sent = ipc_host_modem_send(&test_stream[pos], burst);
+    pos += sent;
+    ipc_host_line_idle();
+
+    /* The client reads at least one message when the modem is held, or the stream is over */
+    reads = (tc->reads_max == 0U) ? tc->messages : (test_rand() % (tc->reads_max + 1U));
+    reads = ((sent == 0U) && (reads == 0U)) ? 1U : reads;
+    reads = ((test_signaled - read) < reads) ? (test_signaled - read) : reads;
+    if ((sent == 0U) && (reads == 0U))
+    {
+      printf("  %s: reception stopped at %u/%u\n", tc->name, (unsigned int)pos, (unsigned int)len);
+      HOST_TEST_CHECK(0);
+      break;
+    }
+    while (reads > 0U)
+    {
+      test_read(read);
+      read++;
+      reads--;
+    }
+  }
+  HOST_TEST_CHECK(pos == len);
+  HOST_TEST_CHECK(test_signaled == tc->messages);
+  /* Empty queue, reception restarted */
+  HOST_TEST_CHECK(IPC_reset(&test_hipc) == IPC_OK);
+}
+
+static void test_case(const test_case_t *tc, unsigned long iterations)
+{
+  unsigned long i;
+
+  memset(&ipc_host, 0, sizeof(ipc_host));
+  ipc_host.IrqLatency = tc->irq_latency;
+  for (i = 0U; i < iterations; i++)
+  {
+    test_replay(tc);
+  }
+  printf("%-6s %lu x %u messages: %u chars, %u held, %u DMA wraps, %u idle, %u DMA interrupts across the buffer "
+         "end, %u DMA pauses mid-span\n", tc->name, iterations, (unsigned int)tc->messages, (unsigned int)ipc_host.Chars,
+         (unsigned int)ipc_host.Holds, (unsigned int)ipc_host.DmaWraps, (unsigned int)ipc_host.IdleEvents,
+         (unsigned int)ipc_host.WrapSpans, (unsigned int)ipc_host.MidSpanPauses);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 100U);
+
+  printf("IPC reception %s\n", (IPC_USE_UART_DMA_RX == 1U) ? "by circular DMA" : "by character");
+  HOST_TEST_CHECK(IPC_init(IPC_DEVICE_0, IPC_INTERFACE_UART, &ipc_host_uart) == IPC_OK);
+  HOST_TEST_CHECK(IPC_open(&test_hipc, IPC_DEVICE_0, IPC_MODE_UART_CHARACTER, test_rx_callback, test_tx_callback,
+                           test_check_end_of_msg) == IPC_OK);
+
+  test_case(&test_cases[0], 1U);
+  HOST_TEST_CHECK(ipc_host.Holds == 0U);
+#if (IPC_USE_UART_DMA_RX == 1U)
+  HOST_TEST_CHECK(ipc_host.WrapSpans != 0U);
+#endif /* IPC_USE_UART_DMA_RX */
+
+  test_case(&test_cases[1], 1U);
+  HOST_TEST_CHECK(ipc_host.Holds != 0U);
+#if (IPC_USE_UART_DMA_RX == 1U)
+  HOST_TEST_CHECK(ipc_host.MidSpanPauses != 0U);
+#endif /* IPC_USE_UART_DMA_RX */
+
+  test_case(&test_cases[2], iterations);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
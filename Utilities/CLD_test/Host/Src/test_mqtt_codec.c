@@ -0,0 +1,203 @@
+/**
+  ******************************************************************************
+  * @file    test_mqtt_codec.c
+  * @author  MCD Application Team
+  * @brief   Host differential test of the MQTT packet decoder (mqtt_codec_bytesReceived) against the
+  *          decoder as delivered (Src/mqtt_codec_ref.c). Random streams of packets are fed to both in
+  *          1 byte, small and large chunks: the packets given to the buffer and to the span callbacks
+  *          of the current decoder must be the packets given to the callback of the reference one.
+  *          The streams keep to the packets both decoders accept: remaining lengths of 1 to 3 bytes,
+  *          and no zero-length packet other than PINGRESP (the reference decoder waits for a body).
+  *          Usage: test_mqtt_codec [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "azure_c_shared_utility/buffer_.h"
+#include "mqtt_codec_ref.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_STREAM_SIZE      (400000U)
+#define TEST_PACKETS_MAX      (20U)
+#define TEST_RECORD_HEADER    (2U + sizeof(size_t))   /* packet type, flags, length */
+#define TEST_LOG_SIZE         (TEST_STREAM_SIZE + (TEST_PACKETS_MAX * TEST_RECORD_HEADER))
+
+/* Private typedef -----------------------------------------------------------*/
+/* Packets given to a decoder callback, one after the other */
+typedef struct
+{
+  uint8_t data[TEST_LOG_SIZE];
+  size_t len;
+  unsigned long packets;
+} test_log_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *const test_chunks[] = { "1 byte", "1-64 bytes", "1-50000 bytes" };
+static uint8_t test_stream[TEST_STREAM_SIZE];
+static test_log_t test_logs[3];
+static uint32_t test_seed = 1U;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t test_rand(void)
+{
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 17;
+  test_seed ^= test_seed << 5;
+  return test_seed;
+}
+
+static void test_record(test_log_t *log, CONTROL_PACKET_TYPE packet, int flags, const uint8_t *data, size_t length)
+{
+  HOST_TEST_CHECK((log->len + TEST_RECORD_HEADER + length) <= sizeof(log->data));
+  if ((log->len + TEST_RECORD_HEADER + length) <= sizeof(log->data))
+  {
+    log->data[log->len] = (uint8_t)packet;
+    log->data[log->len + 1U] = (uint8_t)flags;
+    memcpy(&log->data[log->len + 2U], &length, sizeof(length));
+    log->len += TEST_RECORD_HEADER;
+    if (length != 0U)
+    {
+      memcpy(&log->data[log->len], data, length);
+      log->len += length;
+    }
+  }
+  log->packets++;
+}
+
+static void test_on_packet(void *context, CONTROL_PACKET_TYPE packet, int flags, BUFFER_HANDLE headerData)
+{
+  test_record(context, packet, flags, (headerData != NULL) ? BUFFER_u_char(headerData) : NULL,
+              (headerData != NULL) ? BUFFER_length(headerData) : 0U);
+}
+
+static void test_on_packet_span(void *context, CONTROL_PACKET_TYPE packet, int flags, const uint8_t *data, size_t length)
+{
+  test_record(context, packet, flags, data, length);
+}
+
+/**
+  * @brief  Random stream of PINGRESP, PUBLISH, SUBACK and CONNACK packets with random bodies
+  *         (mostly small, some of up to 116 Kbytes).
+  * @retval Stream length
+  */
+static size_t test_stream_build(unsigned long *packets)
+{
+  uint32_t count = 1U + (test_rand() % TEST_PACKETS_MAX);
+  size_t len = 0U;
+  size_t body;
+  size_t x;
+  uint32_t kind;
+  uint32_t r;
+  uint32_t i;
+
+  *packets = 0U;
+  for (i = 0U; i < count; i++)
+  {
+    kind = test_rand() % 4U;
+    r = test_rand() % 10U;
+    body = (r < 6U) ? (1U + (test_rand() % 120U)) :
+           (r < 8U) ? (128U + (test_rand() % 16000U)) : (16384U + (test_rand() % 100000U));
+    body = (kind == 0U) ? 0U : body;
+    if ((len + 4U + body) > sizeof(test_stream))
+    {
+      break;
+    }
+    test_stream[len] = (kind == 0U) ? (uint8_t)PINGRESP_TYPE :
+                       (kind == 1U) ? (uint8_t)((uint8_t)PUBLISH_TYPE | (test_rand() % 16U)) :
+                       (kind == 2U) ? (uint8_t)SUBACK_TYPE : (uint8_t)CONNACK_TYPE;
+    len++;
+    x = body;
+    do
+    {
+      test_stream[len] = (uint8_t)((x % 128U) | ((x >= 128U) ? 0x80U : 0U));
+      len++;
+      x /= 128U;
+    } while (x != 0U);
+    for (x = 0U; x < body; x++)
+    {
+      test_stream[len] = (uint8_t)test_rand();
+      len++;
+    }
+    (*packets)++;
+  }
+  return len;
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 2000U);
+  unsigned long mismatches[3] = { 0U, 0U, 0U };
+  unsigned long streams[3] = { 0U, 0U, 0U };
+  unsigned long packets;
+  unsigned long total = 0U;
+  unsigned long i;
+  MQTTCODEC_HANDLE ref;
+  MQTTCODEC_HANDLE codec;
+  MQTTCODEC_HANDLE codec_span;
+  size_t len;
+  size_t offset;
+  size_t n;
+  uint32_t mode;
+  int status[3];
+
+  for (i = 0U; i < iterations; i++)
+  {
+    len = test_stream_build(&packets);
+    memset(test_logs, 0, sizeof(test_logs));
+    ref = ref_mqtt_codec_create(test_on_packet, &test_logs[0]);
+    codec = mqtt_codec_create(test_on_packet, &test_logs[1]);
+    codec_span = mqtt_codec_create_span(test_on_packet_span, &test_logs[2]);
+    HOST_TEST_CHECK((ref != NULL) && (codec != NULL) && (codec_span != NULL));
+
+    mode = (uint32_t)(i % 3U);
+    streams[mode]++;
+    for (offset = 0U; offset < len; offset += n)
+    {
+      n = (mode == 0U) ? 1U : (mode == 1U) ? (1U + (test_rand() % 64U)) : (1U + (test_rand() % 50000U));
+      n = ((len - offset) < n) ? (len - offset) : n;
+      status[0] = ref_mqtt_codec_bytesReceived(ref, &test_stream[offset], n);
+      status[1] = mqtt_codec_bytesReceived(codec, &test_stream[offset], n);
+      status[2] = mqtt_codec_bytesReceived(codec_span, &test_stream[offset], n);
+      HOST_TEST_CHECK((status[0] == 0) && (status[1] == 0) && (status[2] == 0));
+    }
+
+    HOST_TEST_CHECK(test_logs[0].packets == packets);
+    if ((test_logs[1].len != test_logs[0].len) || (test_logs[2].len != test_logs[0].len) ||
+        (memcmp(test_logs[1].data, test_logs[0].data, test_logs[0].len) != 0) ||
+        (memcmp(test_logs[2].data, test_logs[0].data, test_logs[0].len) != 0))
+    {
+      printf("  stream %lu (%lu packets, %lu bytes, chunks of %s): packets differ\n", i, packets,
+             (unsigned long)len, test_chunks[mode]);
+      mismatches[mode]++;
+    }
+    total += packets;
+    ref_mqtt_codec_destroy(ref);
+    mqtt_codec_destroy(codec);
+    mqtt_codec_destroy(codec_span);
+  }
+
+  for (mode = 0U; mode < 3U; mode++)
+  {
+    printf("chunks of %-13s: %5lu streams, %lu with different packets\n", test_chunks[mode], streams[mode],
+           mismatches[mode]);
+    HOST_TEST_CHECK(mismatches[mode] == 0U);
+  }
+  printf("%lu packets\n", total);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,346 @@
+/**
+  ******************************************************************************
+  * @file    test_net_ethernetif.c
+  * @author  MCD Application Team
+  * @brief   Host test of the scatter-gather transmit of the STM32F769I-Discovery Ethernet driver
+  *          (ethernetif_low_output_sg of net_conf.c, net_ethernetif_output of net_ip_ethernetif.c) on a fake
+  *          Ethernet DMA: descriptor flags (FS, LS, OWN) of frames of 1 to ETHERNETIF_LOW_OUTPUT_SG_MAX segments,
+  *          refused frames, copy of longer chains, then random chains checked byte for byte at the DMA.
+  *          The iteration count gives the number of random chains.
+  *          Usage: test_net_ethernetif [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "eth_host.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_FLAGS            (ETH_DMATXDESC_OWN | ETH_DMATXDESC_FS | ETH_DMATXDESC_LS)
+#define TEST_FRAME_MAX        (1514U)
+#define TEST_CHAIN_MAX        (ETHERNETIF_LOW_OUTPUT_SG_MAX + 2)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t test_segments[ETH_TXBUFNB + 1U][256];
+static eth_host_frame_t test_frame;
+static eth_host_frame_t test_expected[ETH_TXBUFNB + 1U];   /* Frames given to the DMA, and the next one */
+static uint32_t test_seed = 1U;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t test_rand(void)
+{
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 17;
+  test_seed ^= test_seed << 5;
+  return test_seed;
+}
+
+static void test_random_bytes(uint8_t *p, uint32_t len)
+{
+  uint32_t i;
+
+  for (i = 0U; i < len; i++)
+  {
+    p[i] = (uint8_t)test_rand();
+  }
+}
+
+static uint32_t test_desc_index(const ETH_DMADescTypeDef *pDesc)
+{
+  return (uint32_t)(pDesc - DMATxDscrTab);
+}
+
+static int32_t test_link_input(void *context, net_buf_t *p)
+{
+  (void) context;
+  (void) p;
+  return 0;
+}
+
+static void test_link_status(void *context, uint8_t status)
+{
+  (void) context;
+  (void) status;
+}
+
+/**
+  * @brief  Frame of count segments (lengths len[]) given to ethernetif_low_output_sg: one descriptor per segment,
+  *         pointing at the segment, FS on the first one, LS on the last one, all given to the DMA.
+  */
+static void test_sg_output(uint8_t count, const uint16_t *len)
+{
+  ethernetif_low_segment_t segments[ETH_TXBUFNB];
+  ETH_DMADescTypeDef *desc = EthHandle.TxDesc;
+  uint32_t first = test_desc_index(desc);
+  uint32_t flags;
+  uint8_t i;
+
+  test_expected[0].Len = 0U;
+  for (i = 0U; i < count; i++)
+  {
+    test_random_bytes(test_segments[i], len[i]);
+    segments[i].payload = test_segments[i];
+    segments[i].len = len[i];
+    (void) memcpy(&test_expected[0].Data[test_expected[0].Len], test_segments[i], len[i]);
+    test_expected[0].Len += len[i];
+  }
+  test_expected[0].Segments = count;
+  HOST_TEST_CHECK(ethernetif_low_output_sg(segments, count) == 0);
+  for (i = 0U; i < count; i++)
+  {
+    desc = &DMATxDscrTab[(first + i) % ETH_TXBUFNB];
+    flags = ETH_DMATXDESC_OWN | ((i == 0U) ? ETH_DMATXDESC_FS : 0U) | ((i == (count - 1U)) ? ETH_DMATXDESC_LS : 0U);
+    HOST_TEST_CHECK((desc->Status & TEST_FLAGS) == flags);
+    HOST_TEST_CHECK((desc->ControlBufferSize & ETH_DMATXDESC_TBS1) == len[i]);
+    HOST_TEST_CHECK(desc->Buffer1Addr == (uint32_t)(uintptr_t) test_segments[i]);
+  }
+  HOST_TEST_CHECK(test_desc_index(EthHandle.TxDesc) == ((first + count) % ETH_TXBUFNB));
+}
+
+/**
+  * @brief  The DMA sends the frame of test_sg_output, in one piece.
+  */
+static void test_sg_transmit(void)
+{
+  HOST_TEST_CHECK(eth_host_dma_transmit(&test_frame) == 1);
+  HOST_TEST_CHECK(test_frame.Segments == test_expected[0].Segments);
+  HOST_TEST_CHECK((test_frame.Len == test_expected[0].Len) &&
+                  (memcmp(test_frame.Data, test_expected[0].Data, test_frame.Len) == 0));
+}
+
+/**
+  * @brief  Descriptors as given to the DMA (the driver clears the buffer address of the sent ones at each call).
+  */
+static void test_ring_state(uint32_t *pState)
+{
+  uint32_t i;
+
+  for (i = 0U; i < ETH_TXBUFNB; i++)
+  {
+    pState[2U * i] = DMATxDscrTab[i].Status;
+    pState[(2U * i) + 1U] = DMATxDscrTab[i].ControlBufferSize;
+  }
+}
+
+/**
+  * @brief  Frames refused by ethernetif_low_output_sg leave the descriptors untouched.
+  */
+static void test_sg_refused(void)
+{
+  static const uint16_t len[3] = { 14U, 20U, 40U };
+  ethernetif_low_segment_t segments[ETH_TXBUFNB + 1U];
+  uint32_t ring[2U * ETH_TXBUFNB];
+  uint32_t state[2U * ETH_TXBUFNB];
+  ETH_DMADescTypeDef *tx_desc = EthHandle.TxDesc;
+  uint32_t i;
+
+  for (i = 0U; i <= ETH_TXBUFNB; i++)
+  {
+    segments[i].payload = test_segments[i];
+    segments[i].len = 60U;
+  }
+
+  /* More segments than descriptors, or none */
+  test_ring_state(ring);
+  HOST_TEST_CHECK(ethernetif_low_output_sg(segments, (uint8_t)(ETH_TXBUFNB + 1U)) == -1);
+  HOST_TEST_CHECK(ethernetif_low_output_sg(segments, 0U) == -1);
+  test_ring_state(state);
+  HOST_TEST_CHECK(memcmp(ring, state, sizeof(ring)) == 0);
+  HOST_TEST_CHECK(EthHandle.TxDesc == tx_desc);
+
+  /* Not enough free descriptors: 3 are still owned by the DMA */
+  test_sg_output(3U, len);
+  tx_desc = EthHandle.TxDesc;
+  test_ring_state(ring);
+  HOST_TEST_CHECK(ethernetif_low_output_sg(segments, 2U) == -1);
+  test_ring_state(state);
+  HOST_TEST_CHECK(memcmp(ring, state, sizeof(ring)) == 0);
+  HOST_TEST_CHECK(EthHandle.TxDesc == tx_desc);
+  test_sg_transmit();
+  HOST_TEST_CHECK(eth_host_dma_transmit(&test_frame) == 0);
+}
+
+/**
+  * @brief  Chain of count pbufs of random lengths (total at most TEST_FRAME_MAX), its bytes copied to pExpected.
+  */
+static net_buf_t *test_chain(uint32_t count, eth_host_frame_t *pExpected)
+{
+  net_buf_t *head = NULL;
+  net_buf_t *tail = NULL;
+  net_buf_t *p;
+  uint16_t len;
+  uint32_t i;
+
+  pExpected->Len = 0U;
+  pExpected->Segments = count;
+  for (i = 0U; i < count; i++)
+  {
+    len = (uint16_t)(1U + (test_rand() % (TEST_FRAME_MAX / TEST_CHAIN_MAX)));
+    p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
+    test_random_bytes(p->payload, len);
+    (void) memcpy(&pExpected->Data[pExpected->Len], p->payload, len);
+    pExpected->Len += len;
+    if (head == NULL)
+    {
+      head = p;
+    }
+    else
+    {
+      tail->next = p;
+    }
+    tail = p;
+  }
+  head->tot_len = (uint16_t) pExpected->Len;
+  return head;
+}
+
+/**
+  * @brief  Chains of ETHERNETIF_LOW_OUTPUT_SG_MAX pbufs are sent from the pbufs and kept until the frame is sent,
+  *         longer chains are copied into one buffer.
+  */
+static void test_output_chains(void)
+{
+  net_buf_t *chain;
+  net_buf_t *q;
+  ETH_DMADescTypeDef *desc;
+  uint32_t in_use;
+  uint32_t i;
+
+  desc = EthHandle.TxDesc;
+  chain = test_chain(ETHERNETIF_LOW_OUTPUT_SG_MAX, &test_expected[0]);
+  in_use = eth_host.PbufsInUse;
+  HOST_TEST_CHECK(net_ethernetif_output(chain) == 0);
+  for (q = chain, i = 0U; q != NULL; q = q->next, i++)
+  {
+    HOST_TEST_CHECK(DMATxDscrTab[(test_desc_index(desc) + i) % ETH_TXBUFNB].Buffer1Addr ==
+                    (uint32_t)(uintptr_t) q->payload);
+  }
+  (void) pbuf_free(chain);
+  HOST_TEST_CHECK(chain->ref == 1U);
+  HOST_TEST_CHECK(eth_host.PbufsInUse == in_use);
+  HOST_TEST_CHECK(eth_host_dma_transmit(&test_frame) == 1);
+  HOST_TEST_CHECK(test_frame.Segments == ETHERNETIF_LOW_OUTPUT_SG_MAX);
+  HOST_TEST_CHECK((test_frame.Len == test_expected[0].Len) &&
+                  (memcmp(test_frame.Data, test_expected[0].Data, test_frame.Len) == 0));
+
+  desc = EthHandle.TxDesc;
+  chain = test_chain(ETHERNETIF_LOW_OUTPUT_SG_MAX + 1U, &test_expected[0]);
+  HOST_TEST_CHECK(net_ethernetif_output(chain) == 0);
+  HOST_TEST_CHECK((desc->Status & TEST_FLAGS) == TEST_FLAGS);
+  for (q = chain; q != NULL; q = q->next)
+  {
+    HOST_TEST_CHECK(desc->Buffer1Addr != (uint32_t)(uintptr_t) q->payload);
+  }
+  /* The chain is not referenced by the driver: the copy is */
+  in_use = eth_host.PbufsInUse;
+  (void) pbuf_free(chain);
+  HOST_TEST_CHECK(eth_host.PbufsInUse == (in_use - (ETHERNETIF_LOW_OUTPUT_SG_MAX + 1U)));
+  HOST_TEST_CHECK(eth_host_dma_transmit(&test_frame) == 1);
+  HOST_TEST_CHECK(test_frame.Segments == 1U);
+  HOST_TEST_CHECK((test_frame.Len == test_expected[0].Len) &&
+                  (memcmp(test_frame.Data, test_expected[0].Data, test_frame.Len) == 0));
+}
+
+/**
+  * @brief  Random chains of 1 to TEST_CHAIN_MAX pbufs, the DMA sending 0 to 2 frames after each one: each accepted
+  *         frame reaches the DMA once, in order and intact.
+  */
+static void test_output_random(unsigned long iterations, uint32_t *pSent, uint32_t *pRefused)
+{
+  net_buf_t *chain;
+  uint32_t head = 0U;
+  uint32_t pending = 0U;
+  uint32_t dma;
+  unsigned long i;
+
+  for (i = 0U; i < (iterations + 3U); i++)
+  {
+    /* The last 3 frames have one segment, and drain the ring */
+    chain = test_chain((i < iterations) ? (1U + (test_rand() % TEST_CHAIN_MAX)) : 1U,
+                       &test_expected[(head + pending) % (ETH_TXBUFNB + 1U)]);
+    if (net_ethernetif_output(chain) == 0)
+    {
+      HOST_TEST_CHECK(pending < ETH_TXBUFNB);
+      pending++;
+      (*pSent)++;
+    }
+    else
+    {
+      (*pRefused)++;
+    }
+    (void) pbuf_free(chain);
+
+    dma = (i < iterations) ? (test_rand() % 3U) : ETH_TXBUFNB;
+    while ((dma > 0U) && (pending > 0U))
+    {
+      HOST_TEST_CHECK(eth_host_dma_transmit(&test_frame) == 1);
+      HOST_TEST_CHECK((test_frame.Len == test_expected[head].Len) &&
+                      (memcmp(test_frame.Data, test_expected[head].Data, test_frame.Len) == 0));
+      head = (head + 1U) % (ETH_TXBUFNB + 1U);
+      pending--;
+      dma--;
+    }
+  }
+  HOST_TEST_CHECK(eth_host_dma_transmit(&test_frame) == 0);
+  /* The buffers of a frame are freed by the second output call after it is sent: only the last 2 frames remain */
+  HOST_TEST_CHECK(eth_host.PbufsInUse == 2U);
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  static const uint16_t one[1] = { 60U };
+  static const uint16_t max[ETHERNETIF_LOW_OUTPUT_SG_MAX] = { 14U, 20U, 32U, 200U };
+  unsigned long iterations = host_test_iterations(argc, argv, 100000U);
+  uint32_t sent = 0U;
+  uint32_t refused = 0U;
+  uint32_t i;
+
+  net_ethernetif_init(NULL, test_link_input, test_link_status);
+  for (i = 0U; i < ETH_TXBUFNB; i++)
+  {
+    HOST_TEST_CHECK((DMATxDscrTab[i].Status & ETH_DMATXDESC_OWN) == 0U);
+  }
+
+  /* 1 segment, then ETHERNETIF_LOW_OUTPUT_SG_MAX segments wrapping around the descriptor ring */
+  test_sg_output(1U, one);
+  test_sg_transmit();
+  test_sg_output(ETHERNETIF_LOW_OUTPUT_SG_MAX, max);
+  test_sg_transmit();
+
+  /* A frame given while the DMA waits for descriptors (TBUS) resumes the transmission */
+  eth_host_regs.DMASR = ETH_DMASR_TBUS;
+  eth_host_regs.DMATPDR = 1U;
+  test_sg_output(2U, max);
+  HOST_TEST_CHECK(eth_host_regs.DMATPDR == 0U);
+  eth_host_regs.DMASR = 0U;
+  test_sg_transmit();
+
+  test_sg_refused();
+
+  /* The frames above were given to the driver directly: restart the interface before using net_ethernetif_output */
+  net_ethernetif_deinit();
+  net_ethernetif_init(NULL, test_link_input, test_link_status);
+  test_output_chains();
+  test_output_random(iterations, &sent, &refused);
+  printf("%lu random chains of 1 to %d pbufs: %u frames sent, %u refused (TX ring full)\n", iterations,
+         TEST_CHAIN_MAX, (unsigned int)sent, (unsigned int)refused);
+
+  HOST_TEST_CHECK(eth_host.EarlyOwn == 0U);
+  HOST_TEST_CHECK(eth_host.FreeErrors == 0U);
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
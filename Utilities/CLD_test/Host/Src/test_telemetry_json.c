@@ -0,0 +1,273 @@
+/**
+  ******************************************************************************
+  * @file    test_telemetry_json.c
+  * @author  MCD Application Team
+  * @brief   Host test of the telemetry encoder of the STM32Cube sample (Telemetry_Serialize, taken out of
+  *          AzureXcubeSample.c into telemetry_serialize.inc) against SERIALIZE() of the same model fields.
+  *          Random messages, with control, escaped and non-ASCII characters, NaN / INF, huge floats,
+  *          fractional seconds and time zones, must give the same bytes, and be rejected by both or by
+  *          none. A message which does not fit the buffer must fail without writing past its end.
+  *          Built for the SENSOR, AZURE_DPS_PROV and AZURE_USE_STM_DASHBOARD configurations of the sample.
+  *          Usage: test_telemetry_json [iterations]
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2026 STMicroelectronics International N.V.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under Ultimate Liberty license
+  * SLA0044, the "License"; You may not use this file except in compliance with
+  * the License. You may obtain a copy of the License at:
+  *                             www.st.com/SLA0044
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include "azure_c_shared_utility/xlogging.h"
+#include "serializer.h"
+#include "host_test.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_BUFFER_SIZE      (4096U)
+#define TEST_TRUNCATED_MAX    (200U)    /* Buffer sizes of 0 to 199 bytes */
+#define TEST_TRUNCATED_CASES  (100U)    /* Random messages checked with every truncated buffer size */
+#define TEST_CANARY           ((char)0xA5)
+
+#define msg_error(...)        ((void)0)
+
+/* Sensor field names of the sample */
+#include "telemetry_names.inc"
+
+/* Private typedef -----------------------------------------------------------*/
+/* The telemetry fields of the sample model */
+BEGIN_NAMESPACE(IotThing);
+
+DECLARE_MODEL(SerializableIotSampleDev_t,
+  WITH_DATA(ascii_char_ptr, deviceId),
+  WITH_DATA(ascii_char_ptr, mac),
+  WITH_DATA(float, TEMPERATURE),
+  WITH_DATA(float, HUMIDITY),
+  WITH_DATA(float, PRESSURE),
+  WITH_DATA(int, proximity),
+  WITH_DATA(float, ACCELEROMETERX),
+  WITH_DATA(float, ACCELEROMETERY),
+  WITH_DATA(float, ACCELEROMETERZ),
+  WITH_DATA(float, GYROSCOPEX),
+  WITH_DATA(float, GYROSCOPEY),
+  WITH_DATA(float, GYROSCOPEZ),
+  WITH_DATA(float, MAGNETOMETERX),
+  WITH_DATA(float, MAGNETOMETERY),
+  WITH_DATA(float, MAGNETOMETERZ),
+  WITH_DATA(EDM_DATE_TIME_OFFSET, ts)
+);
+
+END_NAMESPACE(IotThing);
+
+/* Telemetry schema and encoder of the sample (Telemetry_Serialize) */
+#include "telemetry_serialize.inc"
+
+/* Private variables ---------------------------------------------------------*/
+static char test_mac[32];
+static char test_device_id[32];
+static char test_buf[TEST_BUFFER_SIZE];
+static uint32_t test_seed = 1U;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t test_rand(void)
+{
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 17;
+  test_seed ^= test_seed << 5;
+  return test_seed;
+}
+
+/**
+  * @brief  Random string: printable, escaped, control and non-ASCII characters.
+  */
+static void test_string(char *s, uint32_t max)
+{
+  static const char escaped[] = "\"\\/\t\n\x01";
+  uint32_t len = test_rand() % max;
+  uint32_t c;
+  uint32_t i;
+
+  for (i = 0U; i < len; i++)
+  {
+    c = test_rand() % 140U;
+    s[i] = (c < 100U) ? (char)(32U + (c % 95U)) :
+           (c < 130U) ? escaped[c % (sizeof(escaped) - 1U)] : (char)(0x80U + c - 130U);
+  }
+  s[len] = '\0';
+}
+
+/**
+  * @brief  Random float: NaN, infinities, huge values (longer than the serializer accepts) or usual values.
+  */
+static float test_float(void)
+{
+  switch (test_rand() % 12U)
+  {
+    case 0:
+      return NAN;
+    case 1:
+      return INFINITY;
+    case 2:
+      return -INFINITY;
+    case 3:
+      return (float)((int32_t)test_rand()) * 1e30f;
+    default:
+      return (float)((int32_t)(test_rand() % 200000U) - 100000) / (float)(1U + (test_rand() % 1000U));
+  }
+}
+
+static void test_sample(SerializableIotSampleDev_t *mdl)
+{
+  time_t t = (time_t)(test_rand() % 2000000000U);
+
+  test_string(test_mac, 12U);
+  test_string(test_device_id, 12U);
+  (void)memset(&mdl->ts, 0, sizeof(mdl->ts));
+  mdl->ts.dateTime = *gmtime(&t);
+  if ((test_rand() % 3U) == 0U)
+  {
+    mdl->ts.hasFractionalSecond = 1U;
+    mdl->ts.fractionalSecond = test_rand() % 1000000U;
+  }
+  if ((test_rand() % 3U) == 0U)
+  {
+    mdl->ts.hasTimeZone = 1U;
+    mdl->ts.timeZoneHour = (int8_t)((int32_t)(test_rand() % 47U) - 23);
+    mdl->ts.timeZoneMinute = (uint8_t)(test_rand() % 60U);
+  }
+  mdl->TEMPERATURE = test_float();
+  mdl->HUMIDITY = test_float();
+  mdl->PRESSURE = test_float();
+  mdl->proximity = ((test_rand() % 50U) == 0U) ? (-2147483647 - 1) : (int)test_rand();
+  mdl->ACCELEROMETERX = test_float();
+  mdl->ACCELEROMETERY = test_float();
+  mdl->ACCELEROMETERZ = test_float();
+  mdl->GYROSCOPEX = test_float();
+  mdl->GYROSCOPEY = test_float();
+  mdl->GYROSCOPEZ = test_float();
+  mdl->MAGNETOMETERX = test_float();
+  mdl->MAGNETOMETERY = test_float();
+  mdl->MAGNETOMETERZ = test_float();
+}
+
+/**
+  * @brief  Encoding in a buffer of the given size, which must fail unless the message and its terminator fit.
+  */
+static void test_truncated(const SerializableIotSampleDev_t *mdl, const char *expected, size_t len, size_t size)
+{
+  size_t out;
+  size_t i;
+  bool ok;
+
+  (void)memset(test_buf, TEST_CANARY, sizeof(test_buf));
+  ok = Telemetry_Serialize(mdl, test_buf, size, &out);
+  HOST_TEST_CHECK(ok == (size > len));
+  HOST_TEST_CHECK((ok == false) || ((out == len) && (memcmp(test_buf, expected, len) == 0)));
+  for (i = size; i < sizeof(test_buf); i++)
+  {
+    if (test_buf[i] != TEST_CANARY)
+    {
+      printf("  buffer of %u bytes: written at %u\n", (unsigned int)size, (unsigned int)i);
+      HOST_TEST_CHECK(0);
+      break;
+    }
+  }
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = host_test_iterations(argc, argv, 20000U);
+  unsigned long mismatches = 0U;
+  unsigned long rejected = 0U;
+  unsigned long i;
+  static char expected[TEST_BUFFER_SIZE];
+  SerializableIotSampleDev_t *mdl;
+  unsigned char *data;
+  size_t data_size;
+  size_t len;
+  size_t size;
+  int status;
+  bool ok;
+
+  /* The serializer logs each message it rejects */
+  xlogging_set_log_function(NULL);
+  HOST_TEST_CHECK(serializer_init(NULL) == SERIALIZER_OK);
+  mdl = CREATE_MODEL_INSTANCE(IotThing, SerializableIotSampleDev_t);
+  HOST_TEST_CHECK(mdl != NULL);
+  if (mdl == NULL)
+  {
+    return HOST_TEST_RESULT();
+  }
+  mdl->mac = test_mac;
+  mdl->deviceId = test_device_id;
+
+  for (i = 0U; i < iterations; i++)
+  {
+    test_sample(mdl);
+    data = NULL;
+    data_size = 0U;
+    /* The fields published by the telemetry loop of the sample */
+    status = SERIALIZE(&data, &data_size, mdl->mac,
+#if defined(AZURE_DPS_PROV)
+                       mdl->deviceId,
+#endif /* AZURE_DPS_PROV */
+#ifdef SENSOR
+                       mdl->TEMPERATURE, mdl->HUMIDITY, mdl->PRESSURE, mdl->proximity,
+                       mdl->ACCELEROMETERX, mdl->ACCELEROMETERY, mdl->ACCELEROMETERZ,
+                       mdl->GYROSCOPEX, mdl->GYROSCOPEY, mdl->GYROSCOPEZ,
+                       mdl->MAGNETOMETERX, mdl->MAGNETOMETERY, mdl->MAGNETOMETERZ,
+#endif /* SENSOR */
+                       mdl->ts);
+    ok = Telemetry_Serialize(mdl, test_buf, sizeof(test_buf), &len);
+    if ((ok != (status == CODEFIRST_OK)) ||
+        ((ok == true) && ((len != data_size) || (memcmp(test_buf, data, len) != 0))))
+    {
+      if (mismatches < 3U)
+      {
+        printf("  message %lu: SERIALIZE %d, Telemetry_Serialize %d\n  %.*s\n  %.*s\n", i, status, (int)ok,
+               (int)data_size, (data != NULL) ? (const char *)data : "", (int)len, test_buf);
+      }
+      mismatches++;
+    }
+    free(data);
+
+    if (ok == false)
+    {
+      rejected++;
+    }
+    else
+    {
+      (void)memcpy(expected, test_buf, len);
+      /* Every truncated buffer size for the first messages, the sizes around the message length for the others */
+      for (size = 0U; (i < TEST_TRUNCATED_CASES) && (size < TEST_TRUNCATED_MAX); size++)
+      {
+        test_truncated(mdl, expected, len, size);
+      }
+      test_truncated(mdl, expected, len, len);
+      test_truncated(mdl, expected, len, len + 1U);
+    }
+  }
+
+  printf("%lu messages: %lu rejected by both encoders, %lu mismatches\n", iterations, rejected, mismatches);
+  HOST_TEST_CHECK(mismatches == 0U);
+  /* Some messages are valid, some are rejected */
+  HOST_TEST_CHECK((rejected != 0U) && (rejected != iterations));
+
+  DESTROY_MODEL_INSTANCE(mdl);
+  serializer_deinit();
+  return HOST_TEST_RESULT();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -19,6 +19,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <string.h>
+#include <stdlib.h>
 #include "main.h"
 #include "http_lib.h"
 #include "msg.h"
@@ -28,6 +29,9 @@
 #define HTTP_MAX_HOST_SIZE        80      /**< Max length of the http server hostname. */
 #define HTTP_MAX_QUERY_SIZE       50      /**< Max length of the http query string. */
 #define HTTP_BUFFER_SIZE          1050    /**< Size of the HTTP work buffer. */
+#define HTTP_HEADER_READ_SIZE     256     /**< Max read size until the response headers are complete.
+                                               Also bounds the bytes of a pipelined response which may be
+                                               received together with the end of the previous one. */
 #define HTTP_VERSION              "1.1"
 #define HTTP_HEADER               "HTTP/"
 
@@ -50,11 +54,16 @@ typedef struct {
   char query[HTTP_MAX_QUERY_SIZE];    /**< HTTP query parsed from the URL. */
   bool connection_is_open;            /**< connection status. */
   uint8_t buffer[HTTP_BUFFER_SIZE];   /**< work buffer  */
+  uint8_t pending[HTTP_HEADER_READ_SIZE]; /**< Received bytes which belong to the next response. */
+  uint32_t pending_length;            /**< Number of bytes in pending. */
 } http_context_t;
 
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 uint8_t * http_find_headers(uint8_t * http_message, unsigned int len);
+static uint32_t http_parser_wanted(const http_parser_t *parser);
+static int http_recv_parse(http_context_t * pCtx, http_parser_t *parser, uint8_t * buffer, uint32_t *buffer_length);
+static int http_check_get_response(const http_parser_t *parser);
 
 /* Functions Definition ------------------------------------------------------*/
 
@@ -363,78 +372,122 @@ int http_recv(http_handle_t hnd, uint8_t * buffer, uint32_t length)
   return rc;
 }
 
-int http_recv_response(http_handle_t hnd, uint8_t * buffer, uint32_t *buffer_length)
+/**
+  * @brief  Receive one response and feed it to a parser.
+  * @note   Reads are limited to what the parser still expects (or HTTP_HEADER_READ_SIZE while it
+  *         cannot tell) so that at most HTTP_HEADER_READ_SIZE bytes of a following pipelined response
+  *         are received; they are kept in pCtx->pending for the next call.
+  * @arg    pCtx: session context
+  * @arg    parser: initialized parser
+  * @arg    buffer: if not NULL, the response is stored there (buffer mode); otherwise the session
+  *         work buffer is reused for each received piece and the body is only delivered to the parser
+  *         callback (stream mode).
+  * @arg    buffer_length: buffer mode only. In: buffer size. Out: received size.
+  * @retval HTTP_OK on success, or a negative net_recv() error code.
+  */
+static int http_recv_parse(http_context_t * pCtx, http_parser_t *parser, uint8_t * buffer, uint32_t *buffer_length)
 {
-  http_context_t * pCtx = (http_context_t *) hnd;
+  int rc = HTTP_OK;
   int received = 0;
-  uint8_t *pBody = NULL;
   uint32_t read_offset = 0;
-  uint32_t body_length = 0;
-  uint32_t content_length = 0;
-  uint32_t response_length = 0;
-
-  response_length = *buffer_length;
+  uint32_t consumed = 0;
+  uint32_t room = 0;
+  uint8_t *dst = NULL;
+  bool from_pending = false;
 
-  do
+  while ((rc == HTTP_OK) && (parser->complete == false))
   {
-    received = net_recv(pCtx->sock, buffer + read_offset, *buffer_length - read_offset, 0);
-
-    if(received == NET_TIMEOUT)
+    if (buffer != NULL)
     {
-      received = 0;
+      dst = buffer + read_offset;
+      room = *buffer_length - read_offset;
+    }
+    else
+    {
+      dst = pCtx->buffer;
+      room = sizeof(pCtx->buffer);
+    }
+    if (room == 0)
+    {
+      break;
     }
 
-    msg_debug("net_recv() received = %d\n", received);
-
-    if (received >= 0)
+    /* Start with what was received past the end of the previous response (pipelined requests). */
+    from_pending = (pCtx->pending_length > 0);
+    if (from_pending)
     {
-      read_offset += received;
-      if (pBody == NULL)
+      received = MIN(pCtx->pending_length, room);
+      memcpy(dst, pCtx->pending, received);
+    }
+    else
+    {
+      received = net_recv(pCtx->sock, dst, MIN(room, http_parser_wanted(parser)), 0);
+      if(received == NET_TIMEOUT)
+      {
+        received = 0;
+      }
+      msg_debug("net_recv() received = %d\n", received);
+
+      if (received <= 0)
       {
-        body_length = read_offset;
-        pBody = http_find_body(buffer, &body_length);
-        if (pBody != NULL)
+        if ((received < 0) && (parser->state == HTTP_PARSER_BODY_UNTIL_CLOSE))
         {
-          content_length = http_content_length(buffer, read_offset);
-          response_length = pBody - buffer + content_length;
-          msg_debug("buffer=%p pBody=%p content-length=%lu response_length=%lu\n",
-                    buffer, pBody, content_length, response_length);
-          if (response_length > *buffer_length)
-          {
-            response_length = *buffer_length;
-          }
+          /* The end of the connection delimits the body. */
+          parser->complete = true;
+          parser->connection_close = true;
         }
+        else
+        {
+          rc = received;
+        }
+        break;
       }
-    } else {
-      break;
     }
-  } while ((received > 0) && (read_offset < response_length));
-  if (received < 0)
-  {
-    return received;
+
+    rc = http_parser_execute(parser, dst, received, &consumed);
+    if (from_pending)
+    {
+      pCtx->pending_length -= consumed;
+      memmove(pCtx->pending, pCtx->pending + consumed, pCtx->pending_length);
+    }
+    else if (consumed < (uint32_t) received)
+    {
+      /* Keep the beginning of the next response for the next call. */
+      pCtx->pending_length = MIN(received - consumed, sizeof(pCtx->pending));
+      memcpy(pCtx->pending, dst + consumed, pCtx->pending_length);
+    }
+    else
+    {
+      /* Everything belongs to this response. */
+    }
+    read_offset += consumed;
   }
-  else
+
+  if (buffer != NULL)
   {
     *buffer_length = read_offset;
-    return HTTP_OK;
   }
+  return rc;
 }
 
+int http_recv_response(http_handle_t hnd, uint8_t * buffer, uint32_t *buffer_length)
+{
+  http_parser_t parser;
 
-int http_get(const http_handle_t hnd,
-             const char * query,
-             const char * additional_headers,
-             uint8_t * readbuffer,
-             uint32_t *readbuffer_size)
+  http_parser_init(&parser, NULL, NULL);
+  return http_recv_parse((http_context_t *) hnd, &parser, buffer, buffer_length);
+}
+
+
+int http_send_get(const http_handle_t hnd,
+                  const char * query,
+                  const char * additional_headers)
 {
   int rc = HTTP_OK;
   int header_size = 0;
-  int response_size = 0;
-  uint32_t status = 0;
   int additional_headers_length = 0;
   int need_final_crlf = 0;
   http_context_t * pCtx = (http_context_t *) hnd;
-  char *connection_header = NULL;
 
   if (!pCtx)
   {
@@ -473,42 +526,37 @@ int http_get(const http_handle_t hnd,
   rc = net_send(pCtx->sock, (uint8_t *) pCtx->buffer, header_size, 0);
   msg_debug("net_send() rc = %d\n", rc);
 
-  if (rc <= 0)
-  {
-    return rc;
-  }
-  /* receive response */
-  rc = http_recv_response(hnd, readbuffer, readbuffer_size);
-  msg_debug("http_recv_response() rc = %d\n", rc);
   if (rc < 0)
   {
     return rc;
   }
+  return (rc == 0) ? HTTP_TIMEOUT : HTTP_OK;
+}
 
-  response_size = *readbuffer_size;
-#ifdef DEBUG_HTTP_CONTENT
-  msg_debug("response (%d)\n%.*s\n", response_size, response_size, readbuffer);
-#else
-  msg_debug("response: size=%d\n", response_size);
-#endif
-  if (http_response_validate(readbuffer, response_size) != HTTP_OK)
+
+/**
+  * @brief  Check the response to a GET request.
+  * @arg    parser: parser which received the response
+  * @retval HTTP_OK, HTTP_EOF if the server closes the connection, HTTP_ERR on an unexpected status.
+  */
+static int http_check_get_response(const http_parser_t *parser)
+{
+  if (parser->status == 0)
   {
     msg_debug("incorrect header\n");
     return HTTP_ERR;
   }
-  connection_header = http_find_header("connection", readbuffer, response_size);
-  if ((connection_header != NULL) && (strncasecmp((char *)connection_header, "close", sizeof("close")-1) == 0))
+  if (parser->connection_close == true)
   {
     msg_debug("found connection: close\n");
     return HTTP_EOF;
   }
-  status = http_response_status(readbuffer, response_size);
-  if (status < 200 || (status>=300))
+  if (parser->status < 200 || (parser->status>=300))
   {
-    msg_debug("incorrect status code %lu\n", status);
+    msg_debug("incorrect status code %lu\n", parser->status);
     return HTTP_ERR;
   }
-  if (status == 204 /* No Content */)
+  if (parser->status == 204 /* No Content */)
   {
     msg_debug("status code 204 - No Content\n");
     return HTTP_OK;
@@ -518,6 +566,79 @@ int http_get(const http_handle_t hnd,
 }
 
 
+int http_recv_get_response(const http_handle_t hnd,
+                           uint8_t * readbuffer,
+                           uint32_t *readbuffer_size)
+{
+  int rc = HTTP_OK;
+  http_parser_t parser;
+
+  if (!hnd)
+  {
+    msg_error("NULL handle");
+    return HTTP_ERR;
+  }
+
+  /* receive response */
+  http_parser_init(&parser, NULL, NULL);
+  rc = http_recv_parse((http_context_t *) hnd, &parser, readbuffer, readbuffer_size);
+  msg_debug("http_recv_parse() rc = %d\n", rc);
+  if (rc < 0)
+  {
+    return rc;
+  }
+
+#ifdef DEBUG_HTTP_CONTENT
+  msg_debug("response (%lu)\n%.*s\n", *readbuffer_size, (int)*readbuffer_size, readbuffer);
+#else
+  msg_debug("response: size=%lu\n", *readbuffer_size);
+#endif
+  return http_check_get_response(&parser);
+}
+
+
+int http_recv_get_response_stream(const http_handle_t hnd, http_parser_t *parser)
+{
+  int rc = HTTP_OK;
+
+  if (!hnd)
+  {
+    msg_error("NULL handle");
+    return HTTP_ERR;
+  }
+
+  rc = http_recv_parse((http_context_t *) hnd, parser, NULL, NULL);
+  msg_debug("http_recv_parse() rc = %d body=%lu\n", rc, parser->body_length);
+  if (rc < 0)
+  {
+    return rc;
+  }
+  if (parser->complete == false)
+  {
+    /* The rest of the response may still come: the connection cannot be used for another request. */
+    return HTTP_TIMEOUT;
+  }
+  return http_check_get_response(parser);
+}
+
+
+int http_get(const http_handle_t hnd,
+             const char * query,
+             const char * additional_headers,
+             uint8_t * readbuffer,
+             uint32_t *readbuffer_size)
+{
+  int rc = HTTP_OK;
+
+  rc = http_send_get(hnd, query, additional_headers);
+  if (rc != HTTP_OK)
+  {
+    return rc;
+  }
+  return http_recv_get_response(hnd, readbuffer, readbuffer_size);
+}
+
+
 int http_post(const http_handle_t hnd,
               const char * query,
               const char * additional_headers,
@@ -707,6 +828,256 @@ int http_delete(const http_handle_t hnd, const char * resource, const char * add
   }
 }
 
+void http_parser_init(http_parser_t *parser, http_body_cb_t body_cb, void *body_ctx)
+{
+  memset(parser, 0, sizeof(http_parser_t));
+  parser->state = HTTP_PARSER_STATUS_LINE;
+  parser->body_cb = body_cb;
+  parser->body_ctx = body_ctx;
+}
+
+/**
+  * @brief  Number of bytes the parser can consume without reaching beyond the response.
+  */
+static uint32_t http_parser_wanted(const http_parser_t *parser)
+{
+  uint32_t wanted = HTTP_HEADER_READ_SIZE;
+
+  if ((parser->state == HTTP_PARSER_BODY) || (parser->state == HTTP_PARSER_CHUNK_DATA))
+  {
+    wanted = parser->remaining;
+  }
+  else if (parser->state == HTTP_PARSER_BODY_UNTIL_CLOSE)
+  {
+    wanted = UINT32_MAX;
+  }
+  else
+  {
+    /* line-oriented state: the length is unknown */
+  }
+  return wanted;
+}
+
+/**
+  * @brief  Record the value of a response header, if it is one of interest.
+  * @arg    line: "name: value" line, without the final CRLF. It is modified.
+  */
+static void http_parser_header(http_parser_t *parser, char *line)
+{
+  char *value = strchr(line, ':');
+
+  if (value == NULL)
+  {
+    return;
+  }
+  *value = '\0';
+  value++;
+  while ((*value == ' ') || (*value == '\t'))
+  {
+    value++;
+  }
+
+  if (strcasecmp(line, "Content-Length") == 0)
+  {
+    parser->has_content_length = true;
+    parser->content_length = strtoul(value, NULL, 10);
+  }
+  else if (strcasecmp(line, "Content-Range") == 0)
+  {
+    unsigned long start, end, size;  /* %lu needs unsigned long, which is wider than uint32_t on some hosts */
+
+    if (3 == sscanf(value, "bytes %lu-%lu/%lu", &start, &end, &size))
+    {
+      parser->range_start = start;
+      parser->range_end = end;
+      parser->resource_size = size;
+      parser->has_content_range = true;
+    }
+    else
+    {
+      msg_error("Could not parse the HTTP Content-range header: %s\n", value);
+    }
+  }
+  else if (strcasecmp(line, "Connection") == 0)
+  {
+    parser->connection_close = (strncasecmp(value, "close", sizeof("close")-1) == 0);
+  }
+  else if (strcasecmp(line, "Transfer-Encoding") == 0)
+  {
+    /* chunked is always the last transfer coding */
+    size_t len = strlen(value);
+    while ((len > 0) && ((value[len-1] == ' ') || (value[len-1] == '\t')))
+    {
+      len--;
+    }
+    parser->chunked = (len >= (sizeof("chunked")-1))
+                      && (strncasecmp(value + len - (sizeof("chunked")-1), "chunked", sizeof("chunked")-1) == 0);
+  }
+  else
+  {
+    /* not used */
+  }
+}
+
+/**
+  * @brief  Select how the body is delimited, once the headers are complete.
+  */
+static void http_parser_headers_done(http_parser_t *parser)
+{
+  parser->headers_complete = true;
+  if (((parser->status / 100) == 1) || (parser->status == 204) || (parser->status == 304))
+  {
+    parser->state = HTTP_PARSER_DONE;
+  }
+  else if (parser->chunked == true)
+  {
+    parser->state = HTTP_PARSER_CHUNK_SIZE;
+  }
+  else if (parser->has_content_length == true)
+  {
+    parser->remaining = parser->content_length;
+    parser->state = (parser->remaining > 0) ? HTTP_PARSER_BODY : HTTP_PARSER_DONE;
+  }
+  else
+  {
+    parser->state = HTTP_PARSER_BODY_UNTIL_CLOSE;
+  }
+}
+
+/**
+  * @brief  Process a complete line (status, header, chunk size or trailer), stored in parser->line.
+  */
+static int http_parser_line(http_parser_t *parser)
+{
+  int rc = HTTP_OK;
+  char *line = parser->line;
+  char *end = NULL;
+
+  switch (parser->state)
+  {
+    case HTTP_PARSER_STATUS_LINE:
+      end = strchr(line, ' ');
+      if ((strncmp(line, HTTP_HEADER, sizeof(HTTP_HEADER)-1) != 0) || (end == NULL))
+      {
+        rc = HTTP_ERR; /* incorrect header */
+      }
+      else
+      {
+        parser->status = strtoul(end + 1, NULL, 10);
+        parser->state = HTTP_PARSER_HEADER_LINE;
+      }
+      break;
+
+    case HTTP_PARSER_HEADER_LINE:
+      if (parser->line_length == 0)
+      {
+        http_parser_headers_done(parser);
+      }
+      else
+      {
+        http_parser_header(parser, line);
+      }
+      break;
+
+    case HTTP_PARSER_CHUNK_SIZE:
+      parser->remaining = strtoul(line, &end, 16);
+      if (end == line)
+      {
+        rc = HTTP_ERR;
+      }
+      else
+      {
+        parser->state = (parser->remaining > 0) ? HTTP_PARSER_CHUNK_DATA : HTTP_PARSER_TRAILER;
+      }
+      break;
+
+    case HTTP_PARSER_CHUNK_DATA_END:
+      if (parser->line_length != 0)
+      {
+        rc = HTTP_ERR;
+      }
+      else
+      {
+        parser->state = HTTP_PARSER_CHUNK_SIZE;
+      }
+      break;
+
+    case HTTP_PARSER_TRAILER:
+      if (parser->line_length == 0)
+      {
+        parser->state = HTTP_PARSER_DONE;
+      }
+      break;
+
+    default:
+      rc = HTTP_ERR;
+      break;
+  }
+  return rc;
+}
+
+int http_parser_execute(http_parser_t *parser, const uint8_t *data, uint32_t length, uint32_t *consumed)
+{
+  int rc = HTTP_OK;
+  uint32_t i = 0;
+
+  while ((rc == HTTP_OK) && (i < length) && (parser->state != HTTP_PARSER_DONE))
+  {
+    if ((parser->state == HTTP_PARSER_BODY) || (parser->state == HTTP_PARSER_CHUNK_DATA)
+        || (parser->state == HTTP_PARSER_BODY_UNTIL_CLOSE))
+    {
+      uint32_t n = length - i;
+
+      if (parser->state != HTTP_PARSER_BODY_UNTIL_CLOSE)
+      {
+        n = MIN(n, parser->remaining);
+        parser->remaining -= n;
+      }
+      if ((parser->body_cb != NULL) && (parser->body_cb(parser, data + i, n) != 0))
+      {
+        rc = HTTP_ERR;
+      }
+      parser->body_length += n;
+      i += n;
+      if ((parser->state != HTTP_PARSER_BODY_UNTIL_CLOSE) && (parser->remaining == 0))
+      {
+        parser->state = (parser->state == HTTP_PARSER_BODY) ? HTTP_PARSER_DONE : HTTP_PARSER_CHUNK_DATA_END;
+      }
+    }
+    else
+    {
+      char c = (char) data[i];
+      i++;
+      if (c == '\n')
+      {
+        if ((parser->line_length > 0) && (parser->line[parser->line_length - 1] == '\r'))
+        {
+          parser->line_length--;
+        }
+        parser->line[parser->line_length] = '\0';
+        rc = http_parser_line(parser);
+        parser->line_length = 0;
+      }
+      else if (parser->line_length < (sizeof(parser->line) - 1))
+      {
+        parser->line[parser->line_length] = c;
+        parser->line_length++;
+      }
+      else
+      {
+        /* line too long: truncated */
+      }
+    }
+  }
+
+  if (parser->state == HTTP_PARSER_DONE)
+  {
+    parser->complete = true;
+  }
+  *consumed = i;
+  return rc;
+}
+
 /**
  * @brief   Tells whether an HTTP session is still open, or has been closed by the server.
  * @param   In: hnd   Session handle.
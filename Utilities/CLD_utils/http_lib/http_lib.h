@@ -57,6 +57,57 @@ typedef enum {
   HTTP_REQUEST_DELETE
 } http_request_t;
 
+#define HTTP_PARSER_LINE_SIZE   128   /**< Longest status or header line kept by the parser. Longer lines are truncated. */
+
+typedef enum {
+  HTTP_PARSER_STATUS_LINE = 0,
+  HTTP_PARSER_HEADER_LINE,
+  HTTP_PARSER_BODY,                   /**< Body delimited by Content-Length */
+  HTTP_PARSER_BODY_UNTIL_CLOSE,       /**< Body delimited by the end of the connection */
+  HTTP_PARSER_CHUNK_SIZE,
+  HTTP_PARSER_CHUNK_DATA,
+  HTTP_PARSER_CHUNK_DATA_END,
+  HTTP_PARSER_TRAILER,
+  HTTP_PARSER_DONE
+} http_parser_state_t;
+
+typedef struct http_parser_s http_parser_t;
+
+/**
+ * @brief   Body callback of the response parser. Called with each piece of the body as it is parsed,
+ *          after the headers are complete (the parser fields are then all set).
+ * @retval  0 to continue, any other value to abort the parsing.
+ */
+typedef int (*http_body_cb_t)(http_parser_t *parser, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief   Incremental HTTP response parser.
+ *          Consumes the response as it is received, in one pass, and records the useful headers.
+ */
+struct http_parser_s {
+  /* Response information, valid once headers_complete is set */
+  uint32_t status;                    /**< HTTP status code. */
+  bool has_content_length;
+  uint32_t content_length;
+  bool has_content_range;
+  uint32_t range_start;
+  uint32_t range_end;
+  uint32_t resource_size;
+  bool connection_close;              /**< "Connection: close" was received. */
+  bool chunked;                       /**< "Transfer-Encoding: chunked" was received. */
+  bool headers_complete;
+  bool complete;                      /**< The whole response was parsed. */
+  uint32_t body_length;               /**< Number of body bytes delivered so far. */
+  /* Body delivery */
+  http_body_cb_t body_cb;
+  void *body_ctx;                     /**< For use by body_cb. */
+  /* Internal state */
+  http_parser_state_t state;
+  uint32_t remaining;                 /**< Bytes left in the current body or chunk. */
+  uint32_t line_length;
+  char line[HTTP_PARSER_LINE_SIZE];
+};
+
 /**
  * @brief   Create an HTTP session.
  * @note    The internal session context is allocated by the callee.
@@ -189,6 +240,67 @@ int http_sock_setopt(http_handle_t Hnd, const int32_t optname, const void * optb
  *            <0                      Failure
  */
 int http_get(const http_handle_t hnd, const char * query, const char * additional_headers, uint8_t *readbuffer, uint32_t *readbuffer_size);
+
+/**
+ * @brief   Send an HTTP GET request without waiting for the response.
+ * @note    Several requests may be sent in a row on the same session (HTTP/1.1 pipelining).
+ *          The responses are then read in the same order with http_recv_get_response().
+ * @param   In:   hnd                 Handle created by http_create_session().
+ * @param   In:   query               HTTP query string ( "/path/to/request.html" ).
+ *                                    Must begin with '/'.
+ * @param   In:   additional_headers  HTTP headers (each line ending with CRLF)
+ * @retval  Error code
+ *            HTTP_OK                 Success
+ *            <0                      Failure
+ */
+int http_send_get(const http_handle_t hnd, const char * query, const char * additional_headers);
+
+/**
+ * @brief   Receive the response to the oldest GET request sent with http_send_get().
+ * @note    Bytes received past the end of the response are kept for the next call.
+ * @param   In:   hnd                 Handle created by http_create_session().
+ * @param   In:   readbuffer          pointer to read buffer filled with server response (with header and body).
+ * @param   In/out:   size            size of read buffer. Output: number of read bytes.
+ * @retval  Error code
+ *            HTTP_OK                 Success
+ *            HTTP_EOF                Success, but the server closes the connection after this response.
+ *            <0                      Failure
+ */
+int http_recv_get_response(const http_handle_t hnd, uint8_t *readbuffer, uint32_t *readbuffer_size);
+
+/**
+ * @brief   Initialize an HTTP response parser.
+ * @param   In:   parser      Parser to initialize.
+ * @param   In:   body_cb     Body callback. May be NULL if the body is not needed.
+ * @param   In:   body_ctx    User context for body_cb, stored in parser->body_ctx.
+ */
+void http_parser_init(http_parser_t *parser, http_body_cb_t body_cb, void *body_ctx);
+
+/**
+ * @brief   Feed received bytes to an HTTP response parser.
+ * @note    Parsing stops at the end of the response: the remaining bytes belong to the next one.
+ * @param   In:   parser      Parser initialized with http_parser_init().
+ * @param   In:   data        Received bytes.
+ * @param   In:   length      Number of received bytes.
+ * @param   Out:  consumed    Number of bytes which belong to the response.
+ * @retval  Error code
+ *            HTTP_OK         Success (check parser->complete).
+ *            HTTP_ERR (<0)   Malformed response, or parsing aborted by the body callback.
+ */
+int http_parser_execute(http_parser_t *parser, const uint8_t *data, uint32_t length, uint32_t *consumed);
+
+/**
+ * @brief   Receive the response to the oldest GET request sent with http_send_get(),
+ *          and deliver its body through the parser callback, without buffering the response.
+ * @note    The size of the response is not bounded by any buffer.
+ * @param   In:   hnd         Handle created by http_create_session().
+ * @param   In:   parser      Parser initialized with http_parser_init(). Holds the response information on return.
+ * @retval  Error code
+ *            HTTP_OK                 Success
+ *            HTTP_EOF                Success, but the server closes the connection after this response.
+ *            <0                      Failure
+ */
+int http_recv_get_response_stream(const http_handle_t hnd, http_parser_t *parser);
 /**
  * @brief   Send an HTTP POST request.
  * @param   In:       hnd                   HTTP Handle created by http_open().